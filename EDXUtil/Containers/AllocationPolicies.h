@@ -72,16 +72,24 @@ namespace EDX
 	template<typename PredicateType, typename ReferencedType>
 	ReferencedType* IfPThenAElseB(PredicateType Predicate, ReferencedType* A, ReferencedType* B);
 
-	__forceinline int32 DefaultCalculateSlackShrink(int32 NumElements, int32 NumAllocatedElements, SIZE_T BytesPerElement, bool bAllowQuantize, uint32 Alignment = DEFAULT_ALIGNMENT)
+	/** @return The largest element count SizeType can hold. */
+	template<typename SizeType>
+	__forceinline SIZE_T MaxContainerSize()
 	{
-		int32 Retval;
+		return SIZE_T(~0ull >> (65 - sizeof(SizeType) * 8));
+	}
+
+	template<typename SizeType>
+	__forceinline SizeType DefaultCalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T BytesPerElement, bool bAllowQuantize, uint32 Alignment = DEFAULT_ALIGNMENT)
+	{
+		SizeType Retval;
 		Assert(NumElements < NumAllocatedElements);
 
 		// If the container has too much slack, shrink it to exactly fit the number of elements.
-		const uint32 CurrentSlackElements = NumAllocatedElements - NumElements;
+		const SIZE_T CurrentSlackElements = NumAllocatedElements - NumElements;
 		const SIZE_T CurrentSlackBytes = (NumAllocatedElements - NumElements)*BytesPerElement;
 		const bool bTooManySlackBytes = CurrentSlackBytes >= 16384;
-		const bool bTooManySlackElements = 3 * NumElements < 2 * NumAllocatedElements;
+		const bool bTooManySlackElements = 3 * SIZE_T(NumElements) < 2 * SIZE_T(NumAllocatedElements);
 		if ((bTooManySlackBytes || bTooManySlackElements) && (CurrentSlackElements > 64 || !NumElements)) //  hard coded 64 :-(
 		{
 			Retval = NumElements;
@@ -89,7 +97,7 @@ namespace EDX
 			{
 				if (bAllowQuantize)
 				{
-					Retval = Memory::QuantizeSize(Retval * BytesPerElement, Alignment) / BytesPerElement;
+					Retval = SizeType(Memory::QuantizeSize(Retval * BytesPerElement, Alignment) / BytesPerElement);
 				}
 			}
 		}
@@ -101,9 +109,9 @@ namespace EDX
 		return Retval;
 	}
 
-	__forceinline int32 DefaultCalculateSlackGrow(int32 NumElements, int32 NumAllocatedElements, SIZE_T BytesPerElement, bool bAllowQuantize, uint32 Alignment = DEFAULT_ALIGNMENT)
+	template<typename SizeType>
+	__forceinline SizeType DefaultCalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T BytesPerElement, bool bAllowQuantize, uint32 Alignment = DEFAULT_ALIGNMENT)
 	{
-		int32 Retval;
 		Assert(NumElements > NumAllocatedElements && NumElements > 0);
 
 		SIZE_T Grow = 4; // this is the amount for the first alloc
@@ -114,33 +122,22 @@ namespace EDX
 		}
 		if (bAllowQuantize)
 		{
-			Retval = Memory::QuantizeSize(Grow * BytesPerElement, Alignment) / BytesPerElement;
-		}
-		else
-		{
-			Retval = Grow;
-		}
-		// NumElements and MaxElements are stored in 32 bit signed integers so we must be careful not to overflow here.
-		if (NumElements > Retval)
-		{
-			Retval = int32(Math::EDX_INFINITY);
+			Grow = Memory::QuantizeSize(Grow * BytesPerElement, Alignment) / BytesPerElement;
 		}
 
-		return Retval;
+		// Clamp to the largest count SizeType can hold rather than overflowing it
+		return SizeType(Math::Min(Grow, MaxContainerSize<SizeType>()));
 	}
 
-	__forceinline int32 DefaultCalculateSlackReserve(int32 NumElements, SIZE_T BytesPerElement, bool bAllowQuantize, uint32 Alignment = DEFAULT_ALIGNMENT)
+	template<typename SizeType>
+	__forceinline SizeType DefaultCalculateSlackReserve(SizeType NumElements, SIZE_T BytesPerElement, bool bAllowQuantize, uint32 Alignment = DEFAULT_ALIGNMENT)
 	{
-		int32 Retval = NumElements;
+		SizeType Retval = NumElements;
 		Assert(NumElements > 0);
 		if (bAllowQuantize)
 		{
-			Retval = Memory::QuantizeSize(SIZE_T(Retval) * SIZE_T(BytesPerElement), Alignment) / BytesPerElement;
-			// NumElements and MaxElements are stored in 32 bit signed integers so we must be careful not to overflow here.
-			if (NumElements > Retval)
-			{
-				Retval = int32(Math::EDX_INFINITY);
-			}
+			const SIZE_T Quantized = Memory::QuantizeSize(SIZE_T(Retval) * SIZE_T(BytesPerElement), Alignment) / BytesPerElement;
+			Retval = SizeType(Math::Min(Quantized, MaxContainerSize<SizeType>()));
 		}
 
 		return Retval;
@@ -228,6 +225,9 @@ namespace EDX
 		enum { NeedsElementType = true };
 		enum { RequireRangeCheck = true };
 
+		/** The integer type of element counts and indices of the containers using the allocator. */
+		typedef int32 SizeType;
+
 		/**
 		* A class that receives both the explicit allocation policy template parameters specified by the user of the container,
 		* but also the implicit ElementType template parameter from the container type.
@@ -252,8 +252,8 @@ namespace EDX
 			* @param NumBytesPerElement - The number of bytes/element.
 			*/
 			void ResizeAllocation(
-				int32 PreviousNumElements,
-				int32 NumElements,
+				SizeType PreviousNumElements,
+				SizeType NumElements,
 				SIZE_T NumBytesPerElement
 			);
 
@@ -263,9 +263,9 @@ namespace EDX
 			* @param CurrentNumSlackElements - The current number of elements allocated.
 			* @param NumBytesPerElement - The number of bytes/element.
 			*/
-			int32 CalculateSlack(
-				int32 NumElements,
-				int32 CurrentNumSlackElements,
+			SizeType CalculateSlack(
+				SizeType NumElements,
+				SizeType CurrentNumSlackElements,
 				SIZE_T NumBytesPerElement
 			) const;
 
@@ -275,9 +275,9 @@ namespace EDX
 			* @param CurrentNumSlackElements - The current number of elements allocated.
 			* @param NumBytesPerElement - The number of bytes/element.
 			*/
-			int32 CalculateSlackShrink(
-				int32 NumElements,
-				int32 CurrentNumSlackElements,
+			SizeType CalculateSlackShrink(
+				SizeType NumElements,
+				SizeType CurrentNumSlackElements,
 				SIZE_T NumBytesPerElement
 			) const;
 
@@ -287,13 +287,13 @@ namespace EDX
 			* @param CurrentNumSlackElements - The current number of elements allocated.
 			* @param NumBytesPerElement - The number of bytes/element.
 			*/
-			int32 CalculateSlackGrow(
-				int32 NumElements,
-				int32 CurrentNumSlackElements,
+			SizeType CalculateSlackGrow(
+				SizeType NumElements,
+				SizeType CurrentNumSlackElements,
 				SIZE_T NumBytesPerElement
 			) const;
 
-			SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const;
+			SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const;
 		};
 
 		/**
@@ -312,6 +312,8 @@ namespace EDX
 		enum { NeedsElementType = false };
 		enum { RequireRangeCheck = true };
 
+		typedef int32 SizeType;
+
 		class ForAnyElementType
 		{
 		private:
@@ -361,8 +363,8 @@ namespace EDX
 				return Data;
 			}
 			void ResizeAllocation(
-				int32 PreviousNumElements,
-				int32 NumElements,
+				SizeType PreviousNumElements,
+				SizeType NumElements,
 				SIZE_T NumBytesPerElement
 			)
 			{
@@ -373,20 +375,20 @@ namespace EDX
 					Data = (ScriptContainerElement*)Memory::AlignedRealloc(Data, NumElements*NumBytesPerElement, Alignment);
 				}
 			}
-			__forceinline int32 CalculateSlackReserve(int32 NumElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
 			{
 				return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, true, Alignment);
 			}
-			__forceinline int32 CalculateSlackShrink(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, true, Alignment);
 			}
-			__forceinline int32 CalculateSlackGrow(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, true, Alignment);
 			}
 
-			SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return NumAllocatedElements * NumBytesPerElement;
 			}
@@ -420,14 +422,24 @@ namespace EDX
 		enum { IsZeroConstruct = true };
 	};
 
-	/** The indirect allocation policy always allocates the elements indirectly. */
-	class HeapAllocator
+	/**
+	* The indirect allocation policy always allocates the elements indirectly. The allocations are
+	* attributed to Tag when memory tracking is enabled, see MemoryTracker. Example:
+	*
+	* <code>
+	*	Array<Contact, TaggedHeapAllocator<MemoryTag_Physics>> Contacts;
+	* </code>
+	*/
+	template<uint32 Tag, typename InSizeType = int32>
+	class TaggedHeapAllocator
 	{
 	public:
 
 		enum { NeedsElementType = false };
 		enum { RequireRangeCheck = true };
 
+		typedef InSizeType SizeType;
+
 		class ForAnyElementType
 		{
 		private:
@@ -475,29 +487,29 @@ namespace EDX
 			{
 				return Data;
 			}
-			__forceinline void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement)
+			__forceinline void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
 			{
 				// Avoid calling Memory::AlignedRealloc( nullptr, 0 ) as ANSI C mandates returning a valid pointer which is not what we want.
 				if (Data || NumElements)
 				{
 					//check(((uint64)NumElements*(uint64)ElementTypeInfo.GetSize() < (uint64)INT_MAX));
-					Data = (ScriptContainerElement*)Memory::AlignedRealloc(Data, NumElements*NumBytesPerElement);
+					Data = (ScriptContainerElement*)Memory::AlignedRealloc(Data, NumElements*NumBytesPerElement, DEFAULT_ALIGNMENT, Tag);
 				}
 			}
-			__forceinline int32 CalculateSlackReserve(int32 NumElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
 			{
 				return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, true);
 			}
-			__forceinline int32 CalculateSlackShrink(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, true);
 			}
-			__forceinline int32 CalculateSlackGrow(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, true);
 			}
 
-			SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return NumAllocatedElements * NumBytesPerElement;
 			}
@@ -524,6 +536,18 @@ namespace EDX
 		};
 	};
 
+	template <uint32 Tag, typename SizeType>
+	struct AllocatorTraits<TaggedHeapAllocator<Tag, SizeType>> : AllocatorTraitsBase<TaggedHeapAllocator<Tag, SizeType>>
+	{
+		enum { SupportsMove = true };
+		enum { IsZeroConstruct = true };
+	};
+
+	/** The indirect allocation policy, allocations are attributed to the tag of the current ScopeMemoryTag. */
+	class HeapAllocator : public TaggedHeapAllocator<MemoryTag_Scope>
+	{
+	};
+
 	template <>
 	struct AllocatorTraits<HeapAllocator> : AllocatorTraitsBase<HeapAllocator>
 	{
@@ -531,6 +555,157 @@ namespace EDX
 		enum { IsZeroConstruct = true };
 	};
 
+	/**
+	* The indirect allocation policy with 64 bits element counts, for arrays of 2^31 elements or more.
+	* Accessors index with int64, which costs nothing extra on 64 bits targets.
+	*/
+	class HeapAllocator64 : public TaggedHeapAllocator<MemoryTag_Scope, int64>
+	{
+	};
+
+	template <>
+	struct AllocatorTraits<HeapAllocator64> : AllocatorTraitsBase<HeapAllocator64>
+	{
+		enum { SupportsMove = true };
+		enum { IsZeroConstruct = true };
+	};
+
+	/**
+	* The arena allocation policy allocates the elements from a MemoryPool, such as a frame or a task
+	* arena. The most recent allocation of the arena grows and shrinks in place, others keep their
+	* block when shrinking and leave it behind when growing. Everything is reclaimed at once when the
+	* arena is rewound or reset, so containers using it must not outlive that point. Allocations are
+	* 16 bytes aligned.
+	*
+	* Pool is a type with a static Get() method returning the MemoryPool to allocate from, e.g.
+	* ScratchArena for the arena of the calling thread.
+	*/
+	template<typename Pool>
+	class ArenaAllocator
+	{
+	public:
+
+		enum { NeedsElementType = false };
+		enum { RequireRangeCheck = true };
+
+		typedef int32 SizeType;
+
+		class ForAnyElementType
+		{
+		private:
+			/** A pointer to the container's elements. */
+			ScriptContainerElement* Data;
+
+			/** Size of the block Data points to. */
+			SIZE_T NumAllocatedBytes;
+
+		public:
+			/** Default constructor. */
+			ForAnyElementType()
+				: Data(nullptr)
+				, NumAllocatedBytes(0)
+			{}
+
+			ForAnyElementType(const ForAnyElementType&) = delete;
+			ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+			/**
+			* Moves the state of another allocator into this one.
+			* Assumes that the allocator is currently empty, i.e. memory may be allocated but any existing elements have already been destructed (if necessary).
+			* @param Other - The allocator to move the state from.  This allocator should be left in a valid empty state.
+			*/
+			__forceinline void MoveToEmpty(ForAnyElementType& Other)
+			{
+				Assert(this != &Other);
+
+				Data = Other.Data;
+				NumAllocatedBytes = Other.NumAllocatedBytes;
+				Other.Data = nullptr;
+				Other.NumAllocatedBytes = 0;
+			}
+
+			// ContainerAllocatorInterface
+			__forceinline ScriptContainerElement* GetAllocation() const
+			{
+				return Data;
+			}
+			void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+			{
+				auto& Arena = Pool::Get();
+				const SIZE_T NumBytes = NumElements > 0 ? NumElements * NumBytesPerElement : 0;
+
+				if (Data && Arena.ResizeLast(Data, NumAllocatedBytes, NumBytes))
+				{
+					// The last allocation of the arena grows and shrinks in place
+					NumAllocatedBytes = NumBytes;
+				}
+				else if (NumBytes > NumAllocatedBytes)
+				{
+					ScriptContainerElement* OldData = Data;
+					Data = (ScriptContainerElement*)Arena.template Alloc<_byte>(uint(NumBytes));
+					NumAllocatedBytes = NumBytes;
+					if (OldData && PreviousNumElements)
+					{
+						const SizeType NumCopiedElements = Math::Min(NumElements, PreviousNumElements);
+						Memory::Memcpy(Data, OldData, NumCopiedElements * NumBytesPerElement);
+					}
+				}
+
+				// Other allocations keep their block when shrinking
+				if (NumBytes == 0)
+				{
+					Data = nullptr;
+					NumAllocatedBytes = 0;
+				}
+			}
+			__forceinline SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+			{
+				return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false);
+			}
+			__forceinline SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			{
+				// Removing elements keeps the block, Shrink() gives the tail back when it is the last allocation of the arena
+				return NumAllocatedElements;
+			}
+			__forceinline SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			{
+				return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false);
+			}
+
+			SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			{
+				return NumAllocatedElements * NumBytesPerElement;
+			}
+
+			bool HasAllocation()
+			{
+				return !!Data;
+			}
+		};
+
+		template<typename ElementType>
+		class ForElementType : public ForAnyElementType
+		{
+		public:
+
+			/** Default constructor. */
+			ForElementType()
+			{}
+
+			__forceinline ElementType* GetAllocation() const
+			{
+				return (ElementType*)ForAnyElementType::GetAllocation();
+			}
+		};
+	};
+
+	template <typename Pool>
+	struct AllocatorTraits<ArenaAllocator<Pool>> : AllocatorTraitsBase<ArenaAllocator<Pool>>
+	{
+		enum { SupportsMove = true };
+		enum { IsZeroConstruct = true };
+	};
+
 	class DefaultAllocator;
 
 	/**
@@ -546,6 +721,8 @@ namespace EDX
 		enum { NeedsElementType = true };
 		enum { RequireRangeCheck = true };
 
+		typedef typename SecondaryAllocator::SizeType SizeType;
+
 		template<typename ElementType>
 		class ForElementType
 		{
@@ -592,7 +769,7 @@ namespace EDX
 				return IfAThenAElseB<ElementType>(SecondaryData.GetAllocation(), GetInlineElements());
 			}
 
-			void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement)
+			void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
 			{
 				// Check if the new allocation will fit in the inline data area.
 				if (NumElements <= NumInlineElements)
@@ -624,21 +801,21 @@ namespace EDX
 				}
 			}
 
-			__forceinline int32 CalculateSlackReserve(int32 NumElements, SIZE_T NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
 			{
 				// If the elements use less space than the inline allocation, only use the inline allocation as slack.
 				return NumElements <= NumInlineElements ?
 					NumInlineElements :
 					SecondaryData.CalculateSlackReserve(NumElements, NumBytesPerElement);
 			}
-			__forceinline int32 CalculateSlackShrink(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				// If the elements use less space than the inline allocation, only use the inline allocation as slack.
 				return NumElements <= NumInlineElements ?
 					NumInlineElements :
 					SecondaryData.CalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement);
 			}
-			__forceinline int32 CalculateSlackGrow(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				// If the elements use less space than the inline allocation, only use the inline allocation as slack.
 				return NumElements <= NumInlineElements ?
@@ -646,7 +823,7 @@ namespace EDX
 					SecondaryData.CalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement);
 			}
 
-			SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return SecondaryData.GetAllocatedSize(NumAllocatedElements, NumBytesPerElement);
 			}
@@ -685,6 +862,8 @@ namespace EDX
 		enum { NeedsElementType = true };
 		enum { RequireRangeCheck = true };
 
+		typedef int32 SizeType;
+
 		template<typename ElementType>
 		class ForElementType
 		{
@@ -714,32 +893,32 @@ namespace EDX
 				return GetInlineElements();
 			}
 
-			void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement)
+			void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
 			{
 				// Ensure the requested allocation will fit in the inline data area.
 				Assert(NumElements <= NumInlineElements);
 			}
 
-			__forceinline int32 CalculateSlackReserve(int32 NumElements, SIZE_T NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
 			{
 				// Ensure the requested allocation will fit in the inline data area.
 				Assert(NumElements <= NumInlineElements);
 				return NumInlineElements;
 			}
-			__forceinline int32 CalculateSlackShrink(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				// Ensure the requested allocation will fit in the inline data area.
 				Assert(NumAllocatedElements <= NumInlineElements);
 				return NumInlineElements;
 			}
-			__forceinline int32 CalculateSlackGrow(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+			__forceinline SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				// Ensure the requested allocation will fit in the inline data area.
 				Assert(NumElements <= NumInlineElements);
 				return NumInlineElements;
 			}
 
-			SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+			SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
 			{
 				return 0;
 			}
@@ -886,6 +1065,36 @@ namespace EDX
 	};
 
 
+	/** Sparse array allocator drawing the elements and the allocation flags from an arena, see ArenaAllocator. */
+	template<typename Pool>
+	class ArenaSparseArrayAllocator : public SparseArrayAllocator<ArenaAllocator<Pool>, InlineAllocator<4, ArenaAllocator<Pool>>>
+	{
+	};
+
+	/**
+	* Set allocator drawing all the memory of a Set or a Map from an arena, see ArenaAllocator. Example:
+	*
+	* <code>
+	*	Map<int32, float, ArenaSetAllocator<ScratchArena>> Weights;
+	* </code>
+	*/
+	template<typename Pool>
+	class ArenaSetAllocator : public SetAllocator<ArenaSparseArrayAllocator<Pool>, InlineAllocator<1, ArenaAllocator<Pool>>>
+	{
+	};
+
+	/**
+	* Set allocator attributing all the memory of a Set or a Map to Tag, see TaggedHeapAllocator. Example:
+	*
+	* <code>
+	*	Map<String, Texture*, TaggedSetAllocator<MemoryTag_Textures>> TexturesByName;
+	* </code>
+	*/
+	template<uint32 Tag>
+	class TaggedSetAllocator : public SetAllocator<SparseArrayAllocator<TaggedHeapAllocator<Tag>, InlineAllocator<4, TaggedHeapAllocator<Tag>>>, InlineAllocator<1, TaggedHeapAllocator<Tag>>>
+	{
+	};
+
 	/**
 	* 'typedefs' for various allocator defaults.
 	*
@@ -894,11 +1103,13 @@ namespace EDX
 	*/
 
 	class DefaultAllocator : public HeapAllocator { public: typedef HeapAllocator          Typedef; };
+	class DefaultAllocator64 : public HeapAllocator64 { public: typedef HeapAllocator64        Typedef; };
 	class DefaultSetAllocator : public SetAllocator<> { public: typedef SetAllocator<>         Typedef; };
 	class DefaultBitArrayAllocator : public InlineAllocator<4> { public: typedef InlineAllocator<4>     Typedef; };
 	class DefaultSparseArrayAllocator : public SparseArrayAllocator<> { public: typedef SparseArrayAllocator<> Typedef; };
 
 	template <> struct AllocatorTraits<DefaultAllocator> : AllocatorTraits<typename DefaultAllocator::Typedef> {};
+	template <> struct AllocatorTraits<DefaultAllocator64> : AllocatorTraits<typename DefaultAllocator64::Typedef> {};
 	template <> struct AllocatorTraits<DefaultSetAllocator> : AllocatorTraits<typename DefaultSetAllocator::Typedef> {};
 	template <> struct AllocatorTraits<DefaultBitArrayAllocator> : AllocatorTraits<typename DefaultBitArrayAllocator::Typedef> {};
 	template <> struct AllocatorTraits<DefaultSparseArrayAllocator> : AllocatorTraits<typename DefaultSparseArrayAllocator::Typedef> {};
@@ -63,24 +63,24 @@ namespace EDX
 		}
 
 		/** iterator arithmetic support */
-		IndexedContainerIterator& operator+=(int32 Offset)
+		IndexedContainerIterator& operator+=(IndexType Offset)
 		{
 			Index += Offset;
 			return *this;
 		}
 
-		IndexedContainerIterator operator+(int32 Offset) const
+		IndexedContainerIterator operator+(IndexType Offset) const
 		{
 			IndexedContainerIterator Tmp(*this);
 			return Tmp += Offset;
 		}
 
-		IndexedContainerIterator& operator-=(int32 Offset)
+		IndexedContainerIterator& operator-=(IndexType Offset)
 		{
 			return *this += -Offset;
 		}
 
-		IndexedContainerIterator operator-(int32 Offset) const
+		IndexedContainerIterator operator-(IndexType Offset) const
 		{
 			IndexedContainerIterator Tmp(*this);
 			return Tmp -= Offset;
@@ -134,7 +134,7 @@ namespace EDX
 
 	/** operator + */
 	template <typename ContainerType, typename ElementType, typename IndexType>
-	__forceinline IndexedContainerIterator<ContainerType, ElementType, IndexType> operator+(int32 Offset, IndexedContainerIterator<ContainerType, ElementType, IndexType> RHS)
+	__forceinline IndexedContainerIterator<ContainerType, ElementType, IndexType> operator+(IndexType Offset, IndexedContainerIterator<ContainerType, ElementType, IndexType> RHS)
 	{
 		return RHS + Offset;
 	}
@@ -145,7 +145,7 @@ namespace EDX
 	* Pointer-like iterator type for ranged-for loops which checks that the
 	* container hasn't been resized during iteration.
 	*/
-	template <typename ElementType>
+	template <typename ElementType, typename SizeType = int32>
 	struct CheckedPointerIterator
 	{
 		// This iterator type only supports the minimal functionality needed to support
@@ -153,7 +153,7 @@ namespace EDX
 		//
 		// We do add an operator-- to help String implementation
 
-		explicit CheckedPointerIterator(const int32& InNum, ElementType* InPtr)
+		explicit CheckedPointerIterator(const SizeType& InNum, ElementType* InPtr)
 			: Ptr(InPtr)
 			, CurrentNum(InNum)
 			, InitialNum(InNum)
@@ -179,8 +179,8 @@ namespace EDX
 
 	private:
 		ElementType* Ptr;
-		const int32& CurrentNum;
-		int32        InitialNum;
+		const SizeType& CurrentNum;
+		SizeType        InitialNum;
 
 		friend bool operator!=(const CheckedPointerIterator& Lhs, const CheckedPointerIterator& Rhs)
 		{
@@ -287,6 +287,9 @@ namespace EDX
 		typedef InElementType ElementType;
 		typedef InAllocator   Allocator;
 
+		/** Integer type of the sizes and indices, int32 unless the allocator uses 64 bits counts, e.g. DefaultAllocator64. */
+		typedef typename InAllocator::SizeType SizeType;
+
 		/**
 		* Constructor, initializes element number counters.
 		*/
@@ -303,7 +306,7 @@ namespace EDX
 			// This is not strictly legal, as std::initializer_list's iterators are not guaranteed to be pointers, but
 			// this appears to be the case on all of our implementations.  Also, if it's not true on a new implementation,
 			// it will fail to compile rather than behave badly.
-			CopyToEmpty(InitList.begin(), (int32)InitList.size(), 0, 0);
+			CopyToEmpty(InitList.begin(), (SizeType)InitList.size(), 0, 0);
 		}
 
 		/**
@@ -334,7 +337,7 @@ namespace EDX
 		* @param ExtraSlack Tells how much extra memory should be preallocated
 		*                   at the end of the array in the number of elements.
 		*/
-		__forceinline Array(const Array& Other, int32 ExtraSlack)
+		__forceinline Array(const Array& Other, SizeType ExtraSlack)
 		{
 			CopyToEmpty(Other, 0, ExtraSlack);
 		}
@@ -351,7 +354,7 @@ namespace EDX
 			// This is not strictly legal, as std::initializer_list's iterators are not guaranteed to be pointers, but
 			// this appears to be the case on all of our implementations.  Also, if it's not true on a new implementation,
 			// it will fail to compile rather than behave badly.
-			CopyToEmpty(InitList.begin(), (int32)InitList.size(), mCapacity, 0);
+			CopyToEmpty(InitList.begin(), (SizeType)InitList.size(), mCapacity, 0);
 			return *this;
 		}
 
@@ -398,7 +401,7 @@ namespace EDX
 		* @param FromArray Array to move from.
 		*/
 		template <typename FromArrayType, typename ToArrayType>
-		static __forceinline typename EnableIf<Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopy(ToArrayType& ToArray, FromArrayType& FromArray, int32 PrevMax)
+		static __forceinline typename EnableIf<Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopy(ToArrayType& ToArray, FromArrayType& FromArray, SizeType PrevMax)
 		{
 			ToArray.AllocatorInstance.MoveToEmpty(FromArray.AllocatorInstance);
 
@@ -419,7 +422,7 @@ namespace EDX
 		*                   at the end of the array in the number of elements.
 		*/
 		template <typename FromArrayType, typename ToArrayType>
-		static __forceinline typename EnableIf<!Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopy(ToArrayType& ToArray, FromArrayType& FromArray, int32 PrevMax)
+		static __forceinline typename EnableIf<!Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopy(ToArrayType& ToArray, FromArrayType& FromArray, SizeType PrevMax)
 		{
 			ToArray.CopyToEmpty(FromArray, PrevMax, 0);
 		}
@@ -435,7 +438,7 @@ namespace EDX
 		*                   at the end of the array in the number of elements.
 		*/
 		template <typename FromArrayType, typename ToArrayType>
-		static __forceinline typename EnableIf<Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopyWithSlack(ToArrayType& ToArray, FromArrayType& FromArray, int32 PrevMax, int32 ExtraSlack)
+		static __forceinline typename EnableIf<Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopyWithSlack(ToArrayType& ToArray, FromArrayType& FromArray, SizeType PrevMax, SizeType ExtraSlack)
 		{
 			MoveOrCopy(ToArray, FromArray, PrevMax);
 
@@ -453,7 +456,7 @@ namespace EDX
 		*                   at the end of the array in the number of elements.
 		*/
 		template <typename FromArrayType, typename ToArrayType>
-		static __forceinline typename EnableIf<!Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopyWithSlack(ToArrayType& ToArray, FromArrayType& FromArray, int32 PrevMax, int32 ExtraSlack)
+		static __forceinline typename EnableIf<!Array_Private::CanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopyWithSlack(ToArrayType& ToArray, FromArrayType& FromArray, SizeType PrevMax, SizeType ExtraSlack)
 		{
 			ToArray.CopyToEmpty(FromArray, PrevMax, ExtraSlack);
 		}
@@ -488,7 +491,7 @@ namespace EDX
 		*                   at the end of the array in the number of elements.
 		*/
 		template <typename OtherElementType>
-		Array(Array<OtherElementType, Allocator>&& Other, int32 ExtraSlack)
+		Array(Array<OtherElementType, Allocator>&& Other, SizeType ExtraSlack)
 		{
 			// We don't implement move semantics for general OtherAllocators, as there's no way
 			// to tell if they're compatible with the current one.  Probably going to be a pretty
@@ -570,7 +573,7 @@ namespace EDX
 		*
 		* @see Num, Shrink
 		*/
-		__forceinline int32 GetSlack() const
+		__forceinline SizeType GetSlack() const
 		{
 			return mCapacity - mSize;
 		}
@@ -589,7 +592,7 @@ namespace EDX
 		*
 		* @param Index Index to check.
 		*/
-		__forceinline void RangeCheck(int32 Index) const
+		__forceinline void RangeCheck(SizeType Index) const
 		{
 			CheckInvariants();
 
@@ -606,7 +609,7 @@ namespace EDX
 		* @param Index Index to test.
 		* @returns True if index is valid. False otherwise.
 		*/
-		__forceinline bool IsValidIndex(int32 Index) const
+		__forceinline bool IsValidIndex(SizeType Index) const
 		{
 			return Index >= 0 && Index < mSize;
 		}
@@ -617,7 +620,7 @@ namespace EDX
 		* @returns Number of elements in array.
 		* @see GetSlack
 		*/
-		__forceinline int32 Size() const
+		__forceinline SizeType Size() const
 		{
 			return mSize;
 		}
@@ -628,7 +631,7 @@ namespace EDX
 		* @returns Maximum number of elements in array.
 		* @see GetSlack
 		*/
-		__forceinline int32 Capacity() const
+		__forceinline SizeType Capacity() const
 		{
 			return mCapacity;
 		}
@@ -648,7 +651,7 @@ namespace EDX
 		*
 		* @returns Reference to indexed element.
 		*/
-		__forceinline ElementType& operator[](int32 Index)
+		__forceinline ElementType& operator[](SizeType Index)
 		{
 			RangeCheck(Index);
 			return Data()[Index];
@@ -661,7 +664,7 @@ namespace EDX
 		*
 		* @returns Reference to indexed element.
 		*/
-		__forceinline const ElementType& operator[](int32 Index) const
+		__forceinline const ElementType& operator[](SizeType Index) const
 		{
 			RangeCheck(Index);
 			return Data()[Index];
@@ -734,7 +737,7 @@ namespace EDX
 		* @param IndexFromTheEnd (Optional) Index from the end of array (default = 0).
 		* @returns Reference to n-th last element from the array.
 		*/
-		__forceinline ElementType& Last(int32 IndexFromTheEnd = 0)
+		__forceinline ElementType& Last(SizeType IndexFromTheEnd = 0)
 		{
 			RangeCheck(mSize - IndexFromTheEnd - 1);
 			return Data()[mSize - IndexFromTheEnd - 1];
@@ -748,7 +751,7 @@ namespace EDX
 		* @param IndexFromTheEnd (Optional) Index from the end of array (default = 0).
 		* @returns Reference to n-th last element from the array.
 		*/
-		__forceinline const ElementType& Last(int32 IndexFromTheEnd = 0) const
+		__forceinline const ElementType& Last(SizeType IndexFromTheEnd = 0) const
 		{
 			RangeCheck(mSize - IndexFromTheEnd - 1);
 			return Data()[mSize - IndexFromTheEnd - 1];
@@ -776,7 +779,7 @@ namespace EDX
 		* @returns True if found. False otherwise.
 		* @see FindLast, FindLastByPredicate
 		*/
-		__forceinline bool Find(const ElementType& Item, int32& Index) const
+		__forceinline bool Find(const ElementType& Item, SizeType& Index) const
 		{
 			Index = this->Find(Item);
 			return Index != INDEX_NONE;
@@ -789,14 +792,14 @@ namespace EDX
 		* @returns Index of the found element. INDEX_NONE otherwise.
 		* @see FindLast, FindLastByPredicate
 		*/
-		int32 Find(const ElementType& Item) const
+		SizeType Find(const ElementType& Item) const
 		{
 			const ElementType* __restrict Start = Data();
 			for (const ElementType* __restrict Data = Start, *__restrict DataEnd = Data + mSize; Data != DataEnd; ++Data)
 			{
 				if (*Data == Item)
 				{
-					return static_cast<int32>(Data - Start);
+					return static_cast<SizeType>(Data - Start);
 				}
 			}
 			return INDEX_NONE;
@@ -810,7 +813,7 @@ namespace EDX
 		* @returns True if found. False otherwise.
 		* @see Find, FindLastByPredicate
 		*/
-		__forceinline bool FindLast(const ElementType& Item, int32& Index) const
+		__forceinline bool FindLast(const ElementType& Item, SizeType& Index) const
 		{
 			Index = this->FindLast(Item);
 			return Index != INDEX_NONE;
@@ -822,14 +825,14 @@ namespace EDX
 		* @param Item Item to look for.
 		* @returns Index of the found element. INDEX_NONE otherwise.
 		*/
-		int32 FindLast(const ElementType& Item) const
+		SizeType FindLast(const ElementType& Item) const
 		{
 			for (const ElementType* __restrict Start = Data(), *__restrict Data = Start + mSize; Data != Start; )
 			{
 				--Data;
 				if (*Data == Item)
 				{
-					return static_cast<int32>(Data - Start);
+					return static_cast<SizeType>(Data - Start);
 				}
 			}
 			return INDEX_NONE;
@@ -843,7 +846,7 @@ namespace EDX
 		* @returns Index of the found element. INDEX_NONE otherwise.
 		*/
 		template <typename Predicate>
-		int32 FindLastByPredicate(Predicate Pred, int32 StartIndex) const
+		SizeType FindLastByPredicate(Predicate Pred, SizeType StartIndex) const
 		{
 			Assert(StartIndex >= 0 && StartIndex <= this->Size());
 			for (const ElementType* __restrict Start = Data(), *__restrict Data = Start + StartIndex; Data != Start; )
@@ -851,7 +854,7 @@ namespace EDX
 				--Data;
 				if (Pred(*Data))
 				{
-					return static_cast<int32>(Data - Start);
+					return static_cast<SizeType>(Data - Start);
 				}
 			}
 			return INDEX_NONE;
@@ -864,7 +867,7 @@ namespace EDX
 		* @returns Index of the found element. INDEX_NONE otherwise.
 		*/
 		template <typename Predicate>
-		__forceinline int32 FindLastByPredicate(Predicate Pred) const
+		__forceinline SizeType FindLastByPredicate(Predicate Pred) const
 		{
 			return FindLastByPredicate(Pred, mSize);
 		}
@@ -877,14 +880,14 @@ namespace EDX
 		* @returns Index to the first matching element, or INDEX_NONE if none is found.
 		*/
 		template <typename KeyType>
-		int32 IndexOfByKey(const KeyType& Key) const
+		SizeType IndexOfByKey(const KeyType& Key) const
 		{
 			const ElementType* __restrict Start = Data();
 			for (const ElementType* __restrict Data = Start, *__restrict DataEnd = Start + mSize; Data != DataEnd; ++Data)
 			{
 				if (*Data == Key)
 				{
-					return static_cast<int32>(Data - Start);
+					return static_cast<SizeType>(Data - Start);
 				}
 			}
 			return INDEX_NONE;
@@ -897,14 +900,14 @@ namespace EDX
 		* @returns Index to the first matching element, or INDEX_NONE if none is found.
 		*/
 		template <typename Predicate>
-		int32 IndexOfByPredicate(Predicate Pred) const
+		SizeType IndexOfByPredicate(Predicate Pred) const
 		{
 			const ElementType* __restrict Start = Data();
 			for (const ElementType* __restrict Data = Start, *__restrict DataEnd = Start + mSize; Data != DataEnd; ++Data)
 			{
 				if (Pred(*Data))
 				{
-					return static_cast<int32>(Data - Start);
+					return static_cast<SizeType>(Data - Start);
 				}
 			}
 			return INDEX_NONE;
@@ -1041,7 +1044,7 @@ namespace EDX
 		*/
 		bool operator==(const Array& OtherArray) const
 		{
-			int32 Count = Size();
+			SizeType Count = Size();
 
 			return Count == OtherArray.Size() && CompareItems(Data(), OtherArray.Data(), Count);
 		}
@@ -1068,7 +1071,7 @@ namespace EDX
 		{
 			// Save array.
 			stream << A.mSize;
-			for (int32 i = 0; i < A.mSize; i++)
+			for (SizeType i = 0; i < A.mSize; i++)
 			{
 				stream << A[i];
 			}
@@ -1079,10 +1082,10 @@ namespace EDX
 		friend Stream& operator >> (Stream& stream, Array& A)
 		{
 			// Load array.
-			int32 NewNum;
+			SizeType NewNum;
 			stream >> NewNum;
 			A.Clear(NewNum);
-			for (int32 i = 0; i < NewNum; i++)
+			for (SizeType i = 0; i < NewNum; i++)
 			{
 				stream >> *::new(A)ElementType;
 			}
@@ -1116,9 +1119,9 @@ namespace EDX
 		//*/
 		//void BulkSerialize(FArchive& Ar, bool bForcePerElementSerialization = false)
 		//{
-		//	int32 ElementSize = sizeof(ElementType);
+		//	SizeType ElementSize = sizeof(ElementType);
 		//	// Serialize element size to detect mismatch across platforms.
-		//	int32 SerializedElementSize = ElementSize;
+		//	SizeType SerializedElementSize = ElementSize;
 		//	Ar << SerializedElementSize;
 
 		//	if (bForcePerElementSerialization
@@ -1140,7 +1143,7 @@ namespace EDX
 		//			// Serialize the number of elements, block allocate the right amount of memory and deserialize
 		//			// the data as a giant memory blob in a single call to Serialize. Please see the function header
 		//			// for detailed documentation on limitations and implications.
-		//			int32 NewmSize;
+		//			SizeType NewmSize;
 		//			Ar << NewmSize;
 		//			Clear(NewmSize);
 		//			AddUninitialized(NewmSize);
@@ -1148,7 +1151,7 @@ namespace EDX
 		//		}
 		//		else if (Ar.IsSaving())
 		//		{
-		//			int32 ArrayCount = Size();
+		//			SizeType ArrayCount = Size();
 		//			Ar << ArrayCount;
 		//			Ar.Serialize(Data(), ArrayCount * SerializedElementSize);
 		//		}
@@ -1175,12 +1178,12 @@ namespace EDX
 		* @param Count Number of elements to add.
 		* @returns Number of elements in array before addition.
 		*/
-		__forceinline int32 AddUninitialized(int32 Count = 1)
+		__forceinline SizeType AddUninitialized(SizeType Count = 1)
 		{
 			CheckInvariants();
 			Assert(Count >= 0);
 
-			const int32 OldNum = mSize;
+			const SizeType OldNum = mSize;
 			if ((mSize += Count) > mCapacity)
 			{
 				ResizeGrow(OldNum);
@@ -1199,12 +1202,12 @@ namespace EDX
 		* @param Index Tells where to insert the new elements.
 		* @param Count Number of elements to add.
 		*/
-		void InsertUninitialized(int32 Index, int32 Count = 1)
+		void InsertUninitialized(SizeType Index, SizeType Count = 1)
 		{
 			CheckInvariants();
 			Assert((Count >= 0) & (Index >= 0) & (Index <= mSize));
 
-			const int32 OldNum = mSize;
+			const SizeType OldNum = mSize;
 			if ((mSize += Count) > mCapacity)
 			{
 				ResizeGrow(OldNum);
@@ -1225,7 +1228,7 @@ namespace EDX
 		* @param Count Number of elements to add.
 		* @see Insert, InsertUninitialized
 		*/
-		void InsertZeroed(int32 Index, int32 Count = 1)
+		void InsertZeroed(SizeType Index, SizeType Count = 1)
 		{
 			InsertUninitialized(Index, Count);
 			Memory::Memzero((uint8*)AllocatorInstance.GetAllocation() + Index * sizeof(ElementType), Count * sizeof(ElementType));
@@ -1238,11 +1241,11 @@ namespace EDX
 		* @param InIndex Tells where to insert the new elements.
 		* @returns Location at which the item was inserted.
 		*/
-		int32 Insert(std::initializer_list<ElementType> InitList, const int32 InIndex)
+		SizeType Insert(std::initializer_list<ElementType> InitList, const SizeType InIndex)
 		{
-			InsertUninitialized(InIndex, (int32)InitList.size());
+			InsertUninitialized(InIndex, (SizeType)InitList.size());
 
-			int32 Index = InIndex;
+			SizeType Index = InIndex;
 			for (const ElementType& Element : InitList)
 			{
 				new (Data() + Index++) ElementType(Element);
@@ -1257,11 +1260,11 @@ namespace EDX
 		* @param InIndex Tells where to insert the new elements.
 		* @returns Location at which the item was inserted.
 		*/
-		int32 Insert(const Array<ElementType>& Items, const int32 InIndex)
+		SizeType Insert(const Array<ElementType>& Items, const SizeType InIndex)
 		{
 			Assert(this != &Items);
 			InsertUninitialized(InIndex, Items.Size());
-			int32 Index = InIndex;
+			SizeType Index = InIndex;
 			for (auto It = Items.CreateConstIterator(); It; ++It)
 			{
 				RangeCheck(Index);
@@ -1279,7 +1282,7 @@ namespace EDX
 		* @return The index of the first element inserted.
 		* @see Add, Remove
 		*/
-		int32 Insert(const ElementType* Ptr, int32 Count, int32 Index)
+		SizeType Insert(const ElementType* Ptr, SizeType Count, SizeType Index)
 		{
 			Assert(Ptr != nullptr);
 
@@ -1311,7 +1314,7 @@ namespace EDX
 		* @returns Location at which the insert was done.
 		* @see Add, Remove
 		*/
-		int32 Insert(ElementType&& Item, int32 Index)
+		SizeType Insert(ElementType&& Item, SizeType Index)
 		{
 			CheckAddress(&Item);
 
@@ -1330,7 +1333,7 @@ namespace EDX
 		* @returns Location at which the insert was done.
 		* @see Add, Remove
 		*/
-		int32 Insert(const ElementType& Item, int32 Index)
+		SizeType Insert(const ElementType& Item, SizeType Index)
 		{
 			CheckAddress(&Item);
 
@@ -1341,7 +1344,7 @@ namespace EDX
 			return Index;
 		}
 
-		void Assign(const ElementType* Elements, const int32 Count)
+		void Assign(const ElementType* Elements, const SizeType Count)
 		{
 			if (Count > mCapacity)
 			{
@@ -1359,7 +1362,7 @@ namespace EDX
 		* @param Count (Optional) Number of elements to remove. Default is 1.
 		* @param bAllowShrinking (Optional) Tells if this call can shrink array if suitable after remove. Default is true.
 		*/
-		void RemoveAt(int32 Index, int32 Count = 1, bool bAllowShrinking = true)
+		void RemoveAt(SizeType Index, SizeType Count = 1, bool bAllowShrinking = true)
 		{
 			if (Count)
 			{
@@ -1369,7 +1372,7 @@ namespace EDX
 				DestructItems(Data() + Index, Count);
 
 				// Skip memmove in the common case that there is nothing to move.
-				int32 NumToMove = mSize - Index - Count;
+				SizeType NumToMove = mSize - Index - Count;
 				if (NumToMove)
 				{
 					Memory::Memmove
@@ -1400,7 +1403,7 @@ namespace EDX
 		* @param bAllowShrinking (Optional) Tells if this call can shrink array if
 		*                        suitable after remove. Default is true.
 		*/
-		void RemoveAtSwap(int32 Index, int32 Count = 1, bool bAllowShrinking = true)
+		void RemoveAtSwap(SizeType Index, SizeType Count = 1, bool bAllowShrinking = true)
 		{
 			if (Count)
 			{
@@ -1410,9 +1413,9 @@ namespace EDX
 				DestructItems(Data() + Index, Count);
 
 				// Replace the elements in the hole created by the removal with elements from the end of the array, so the range of indices used by the array is contiguous.
-				const int32 NumElementsInHole = Count;
-				const int32 NumElementsAfterHole = mSize - (Index + Count);
-				const int32 NumElementsToMoveIntoHole = Math::Min(NumElementsInHole, NumElementsAfterHole);
+				const SizeType NumElementsInHole = Count;
+				const SizeType NumElementsAfterHole = mSize - (Index + Count);
+				const SizeType NumElementsToMoveIntoHole = Math::Min(NumElementsInHole, NumElementsAfterHole);
 				if (NumElementsToMoveIntoHole)
 				{
 					Memory::Memcpy(
@@ -1436,7 +1439,7 @@ namespace EDX
 		*
 		* @param NewSize The expected usage size after calling this function.
 		*/
-		void Reset(int32 NewSize = 0)
+		void Reset(SizeType NewSize = 0)
 		{
 			// If we have space to hold the excepted size, then don't reallocate
 			if (NewSize <= mCapacity)
@@ -1455,7 +1458,7 @@ namespace EDX
 		*
 		* @param Slack (Optional) The expected usage size after empty operation. Default is 0.
 		*/
-		void Clear(int32 Slack = 0)
+		void Clear(SizeType Slack = 0)
 		{
 			DestructItems(Data(), mSize);
 
@@ -1474,12 +1477,12 @@ namespace EDX
 		* @param NewNum New size of the array.
 		* @param bAllowShrinking Tell if this function can shrink the memory in-use if suitable.
 		*/
-		void Resize(int32 NewNum, bool bAllowShrinking = true)
+		void Resize(SizeType NewNum, bool bAllowShrinking = true)
 		{
 			if (NewNum > Size())
 			{
-				const int32 Diff = NewNum - mSize;
-				const int32 Index = AddUninitialized(Diff);
+				const SizeType Diff = NewNum - mSize;
+				const SizeType Index = AddUninitialized(Diff);
 				DefaultConstructItems<ElementType>((uint8*)AllocatorInstance.GetAllocation() + Index * sizeof(ElementType), Diff);
 			}
 			else if (NewNum < Size())
@@ -1493,7 +1496,7 @@ namespace EDX
 		*
 		* @param NewNum New size of the array.
 		*/
-		void ResizeZeroed(int32 NewNum, bool bAllowShrinking = true)
+		void ResizeZeroed(SizeType NewNum, bool bAllowShrinking = true)
 		{
 			if (NewNum > Size())
 			{
@@ -1510,7 +1513,7 @@ namespace EDX
 		*
 		* @param NewNum New size of the array.
 		*/
-		void ResizeUninitialized(int32 NewNum, bool bAllowShrinking = true)
+		void ResizeUninitialized(SizeType NewNum, bool bAllowShrinking = true)
 		{
 			if (NewNum > Size())
 			{
@@ -1535,7 +1538,7 @@ namespace EDX
 		{
 			Assert((void*)this != (void*)&Source);
 
-			int32 SourceCount = Source.Size();
+			SizeType SourceCount = Source.Size();
 
 			// Do nothing if the source is empty.
 			if (!SourceCount)
@@ -1561,7 +1564,7 @@ namespace EDX
 		{
 			Assert((void*)this != (void*)&Source);
 
-			int32 SourceCount = Source.Size();
+			SizeType SourceCount = Source.Size();
 
 			// Do nothing if the source is empty.
 			if (!SourceCount)
@@ -1584,11 +1587,11 @@ namespace EDX
 		* @param Count The number of elements to insert from Ptr.
 		* @see Add, Insert
 		*/
-		void Append(const ElementType* Ptr, int32 Count)
+		void Append(const ElementType* Ptr, SizeType Count)
 		{
 			Assert(Ptr != nullptr);
 
-			int32 Pos = AddUninitialized(Count);
+			SizeType Pos = AddUninitialized(Count);
 			ConstructItems<ElementType>(Data() + Pos, Ptr, Count);
 		}
 
@@ -1600,9 +1603,9 @@ namespace EDX
 		*/
 		FORCEINLINE void Append(std::initializer_list<ElementType> InitList)
 		{
-			int32 Count = (int32)InitList.size();
+			SizeType Count = (SizeType)InitList.size();
 
-			int32 Pos = AddUninitialized(Count);
+			SizeType Pos = AddUninitialized(Count);
 			ConstructItems<ElementType>(Data() + Pos, InitList.begin(), Count);
 		}
 
@@ -1640,9 +1643,9 @@ namespace EDX
 		* @return		Index to the new item
 		*/
 		template <typename... ArgsType>
-		__forceinline int32 Emplace(ArgsType&&... Args)
+		__forceinline SizeType Emplace(ArgsType&&... Args)
 		{
-			const int32 Index = AddUninitialized(1);
+			const SizeType Index = AddUninitialized(1);
 			new(Data() + Index) ElementType(Forward<ArgsType>(Args)...);
 			return Index;
 		}
@@ -1656,7 +1659,7 @@ namespace EDX
 		* @return Index to the new item
 		* @see AddDefaulted, AddUnique, AddZeroed, Append, Insert
 		*/
-		__forceinline int32 Add(ElementType&& Item) { CheckAddress(&Item); return Emplace(Move(Item)); }
+		__forceinline SizeType Add(ElementType&& Item) { CheckAddress(&Item); return Emplace(Move(Item)); }
 
 		/**
 		* Adds a new item to the end of the array, possibly reallocating the whole array to fit.
@@ -1665,7 +1668,7 @@ namespace EDX
 		* @return Index to the new item
 		* @see AddDefaulted, AddUnique, AddZeroed, Append, Insert
 		*/
-		__forceinline int32 Add(const ElementType& Item) { CheckAddress(&Item); return Emplace(Item); }
+		__forceinline SizeType Add(const ElementType& Item) { CheckAddress(&Item); return Emplace(Item); }
 
 		/**
 		* Adds new items to the end of the array, possibly reallocating the whole
@@ -1679,9 +1682,9 @@ namespace EDX
 		* @return Index to the first of the new items.
 		* @see Add, AddDefaulted, AddUnique, Append, Insert
 		*/
-		int32 AddZeroed(int32 Count = 1)
+		SizeType AddZeroed(SizeType Count = 1)
 		{
-			const int32 Index = AddUninitialized(Count);
+			const SizeType Index = AddUninitialized(Count);
 			Memory::Memzero((uint8*)AllocatorInstance.GetAllocation() + Index * sizeof(ElementType), Count * sizeof(ElementType));
 			return Index;
 		}
@@ -1694,9 +1697,9 @@ namespace EDX
 		* @return Index to the first of the new items.
 		* @see Add, AddZeroed, AddUnique, Append, Insert
 		*/
-		int32 AddDefaulted(int32 Count = 1)
+		SizeType AddDefaulted(SizeType Count = 1)
 		{
-			const int32 Index = AddUninitialized(Count);
+			const SizeType Index = AddUninitialized(Count);
 			DefaultConstructItems<ElementType>((uint8*)AllocatorInstance.GetAllocation() + Index * sizeof(ElementType), Count);
 			return Index;
 		}
@@ -1710,9 +1713,9 @@ namespace EDX
 		* @returns Index of the element in the array.
 		*/
 		template <typename ArgsType>
-		int32 AddUniqueImpl(ArgsType&& Args)
+		SizeType AddUniqueImpl(ArgsType&& Args)
 		{
-			int32 Index;
+			SizeType Index;
 			if (Find(Args, Index))
 			{
 				return Index;
@@ -1732,7 +1735,7 @@ namespace EDX
 		* @returns Index of the element in the array.
 		* @see Add, AddDefaulted, AddZeroed, Append, Insert
 		*/
-		__forceinline int32 AddUnique(ElementType&& Item) { return AddUniqueImpl(Move(Item)); }
+		__forceinline SizeType AddUnique(ElementType&& Item) { return AddUniqueImpl(Move(Item)); }
 
 		/**
 		* Adds unique element to array if it doesn't exist.
@@ -1741,7 +1744,7 @@ namespace EDX
 		* @returns Index of the element in the array.
 		* @see Add, AddDefaulted, AddZeroed, Append, Insert
 		*/
-		__forceinline int32 AddUnique(const ElementType& Item) { return AddUniqueImpl(Item); }
+		__forceinline SizeType AddUnique(const ElementType& Item) { return AddUniqueImpl(Item); }
 
 		/**
 		* Reserves memory such that the array can contain at least Number elements.
@@ -1749,7 +1752,7 @@ namespace EDX
 		* @param Number The number of elements that the array should be able to contain after allocation.
 		* @see Shrink
 		*/
-		__forceinline void Reserve(int32 Number)
+		__forceinline void Reserve(SizeType Number)
 		{
 			if (Number > mCapacity)
 			{
@@ -1763,10 +1766,10 @@ namespace EDX
 		* @param Element The element to fill array with.
 		* @param Number The number of elements that the array should be able to contain after allocation.
 		*/
-		void Init(const ElementType& Element, int32 Number)
+		void Init(const ElementType& Element, SizeType Number)
 		{
 			Clear(Number);
-			for (int32 Index = 0; Index < Number; ++Index)
+			for (SizeType Index = 0; Index < Number; ++Index)
 			{
 				new(*this) ElementType(Element);
 			}
@@ -1780,9 +1783,9 @@ namespace EDX
 		* @returns The number of items removed. For RemoveSingleItem, this is always either 0 or 1.
 		* @see Add, Insert, Remove, RemoveAll, RemoveAllSwap
 		*/
-		int32 RemoveSingle(const ElementType& Item)
+		SizeType RemoveSingle(const ElementType& Item)
 		{
-			int32 Index = Find(Item);
+			SizeType Index = Find(Item);
 			if (Index == INDEX_NONE)
 			{
 				return 0;
@@ -1792,7 +1795,7 @@ namespace EDX
 
 			// Destruct items that match the specified Item.
 			DestructItems(RemovePtr, 1);
-			const int32 NextIndex = Index + 1;
+			const SizeType NextIndex = Index + 1;
 			RelocateConstructItems<ElementType>(RemovePtr, RemovePtr + 1, mSize - (Index + 1));
 
 			// Update the array count
@@ -1810,7 +1813,7 @@ namespace EDX
 		* @returns Number of removed elements.
 		* @see Add, Insert, RemoveAll, RemoveAllSwap, RemoveSingle, RemoveSwap
 		*/
-		int32 Remove(const ElementType& Item)
+		SizeType Remove(const ElementType& Item)
 		{
 			CheckAddress(&Item);
 
@@ -1827,25 +1830,25 @@ namespace EDX
 		* @see Add, Insert, RemoveAllSwap, RemoveSingle, RemoveSwap
 		*/
 		template <class PREDICATE_CLASS>
-		int32 RemoveAll(const PREDICATE_CLASS& Predicate)
+		SizeType RemoveAll(const PREDICATE_CLASS& Predicate)
 		{
-			const int32 OriginalNum = mSize;
+			const SizeType OriginalNum = mSize;
 			if (!OriginalNum)
 			{
 				return 0; // nothing to do, loop assumes one item so need to deal with this edge case here
 			}
 
-			int32 WriteIndex = 0;
-			int32 ReadIndex = 0;
+			SizeType WriteIndex = 0;
+			SizeType ReadIndex = 0;
 			bool NotMatch = !Predicate(Data()[ReadIndex]); // use a ! to guarantee it can't be anything other than zero or one
 			do
 			{
-				int32 RunStartIndex = ReadIndex++;
+				SizeType RunStartIndex = ReadIndex++;
 				while (ReadIndex < OriginalNum && NotMatch == !Predicate(Data()[ReadIndex]))
 				{
 					ReadIndex++;
 				}
-				int32 RunLength = ReadIndex - RunStartIndex;
+				SizeType RunLength = ReadIndex - RunStartIndex;
 				Assert(RunLength > 0);
 				if (NotMatch)
 				{
@@ -1877,7 +1880,7 @@ namespace EDX
 		template <class PREDICATE_CLASS>
 		void RemoveAllSwap(const PREDICATE_CLASS& Predicate, bool bAllowShrinking = true)
 		{
-			for (int32 ItemIndex = 0; ItemIndex < Size();)
+			for (SizeType ItemIndex = 0; ItemIndex < Size();)
 			{
 				if (Predicate((*this)[ItemIndex]))
 				{
@@ -1899,9 +1902,9 @@ namespace EDX
 		* @returns The number of items removed. For RemoveSingleItem, this is always either 0 or 1.
 		* @see Add, Insert, Remove, RemoveAll, RemoveAllSwap, RemoveSwap
 		*/
-		int32 RemoveSingleSwap(const ElementType& Item, bool bAllowShrinking = true)
+		SizeType RemoveSingleSwap(const ElementType& Item, bool bAllowShrinking = true)
 		{
-			int32 Index = Find(Item);
+			SizeType Index = Find(Item);
 			if (Index == INDEX_NONE)
 			{
 				return 0;
@@ -1923,12 +1926,12 @@ namespace EDX
 		* @returns Number of elements removed.
 		* @see Add, Insert, Remove, RemoveAll, RemoveAllSwap
 		*/
-		int32 RemoveSwap(const ElementType& Item)
+		SizeType RemoveSwap(const ElementType& Item)
 		{
 			CheckAddress(&Item);
 
-			const int32 OriginalNum = mSize;
-			for (int32 Index = 0; Index < mSize; Index++)
+			const SizeType OriginalNum = mSize;
+			for (SizeType Index = 0; Index < mSize; Index++)
 			{
 				if ((*this)[Index] == Item)
 				{
@@ -1944,7 +1947,7 @@ namespace EDX
 		* @param FirstIndexToSwap Position of the first element to swap.
 		* @param SecondIndexToSwap Position of the second element to swap.
 		*/
-		__forceinline void SwapMemory(int32 FirstIndexToSwap, int32 SecondIndexToSwap)
+		__forceinline void SwapMemory(SizeType FirstIndexToSwap, SizeType SecondIndexToSwap)
 		{
 			Memory::Memswap(
 				(uint8*)AllocatorInstance.GetAllocation() + (sizeof(ElementType)*FirstIndexToSwap),
@@ -1961,7 +1964,7 @@ namespace EDX
 		* @param FirstIndexToSwap Position of the first element to swap.
 		* @param SecondIndexToSwap Position of the second element to swap.
 		*/
-		__forceinline void Swap(int32 FirstIndexToSwap, int32 SecondIndexToSwap)
+		__forceinline void Swap(SizeType FirstIndexToSwap, SizeType SecondIndexToSwap)
 		{
 			Assert((FirstIndexToSwap >= 0) && (SecondIndexToSwap >= 0));
 			Assert((mSize > FirstIndexToSwap) && (mSize > SecondIndexToSwap));
@@ -1973,8 +1976,8 @@ namespace EDX
 
 
 		// Iterators
-		typedef IndexedContainerIterator<      Array, ElementType, int32> Iterator;
-		typedef IndexedContainerIterator<const Array, const ElementType, int32> ConstIterator;
+		typedef IndexedContainerIterator<      Array, ElementType, SizeType> Iterator;
+		typedef IndexedContainerIterator<const Array, const ElementType, SizeType> ConstIterator;
 
 		/**
 		* Creates an iterator for the contents of this array
@@ -1997,8 +2000,8 @@ namespace EDX
 		}
 
 #if TARRAY_RANGED_FOR_CHECKS
-		typedef CheckedPointerIterator<      ElementType> RangedForIteratorType;
-		typedef CheckedPointerIterator<const ElementType> RangedForConstIteratorType;
+		typedef CheckedPointerIterator<      ElementType, SizeType> RangedForIteratorType;
+		typedef CheckedPointerIterator<const ElementType, SizeType> RangedForConstIteratorType;
 #else
 		typedef       ElementType* RangedForIteratorType;
 		typedef const ElementType* RangedForConstIteratorType;
@@ -2029,7 +2032,7 @@ namespace EDX
 		*/
 		void Sort()
 		{
-			EDX::Sort(Data(), Size());
+			EDX::Sort(Data(), SortNum());
 		}
 
 		/**
@@ -2040,7 +2043,45 @@ namespace EDX
 		template <class PREDICATE_CLASS>
 		void Sort(const PREDICATE_CLASS& Predicate)
 		{
-			EDX::Sort(Data(), Size(), Predicate);
+			EDX::Sort(Data(), SortNum(), Predicate);
+		}
+
+		/**
+		* Sorts the array on the global thread pool assuming < operator is defined for the item type.
+		*/
+		void ParallelSort()
+		{
+			EDX::ParallelSort(Data(), SortNum());
+		}
+
+		/**
+		* Sorts the array on the global thread pool using user defined predicate class.
+		*
+		* @param Predicate Predicate class instance, must be safe to call concurrently.
+		*/
+		template <class PREDICATE_CLASS>
+		void ParallelSort(const PREDICATE_CLASS& Predicate)
+		{
+			EDX::ParallelSort(Data(), SortNum(), Predicate);
+		}
+
+		/**
+		* Radix sorts an array of integer or floating point items. The sort is stable.
+		*/
+		void RadixSort()
+		{
+			EDX::RadixSort(Data(), SortNum());
+		}
+
+		/**
+		* Radix sorts the array on an integer or floating point key extracted from each item. The sort is stable.
+		*
+		* @param GetKey Function returning the key of an item.
+		*/
+		template <class KEY_FUNC>
+		void RadixSort(const KEY_FUNC& GetKey)
+		{
+			EDX::RadixSort(Data(), SortNum(), GetKey);
 		}
 
 		/**
@@ -2050,7 +2091,7 @@ namespace EDX
 		*/
 		void StableSort()
 		{
-			EDX::StableSort(Data(), Size());
+			EDX::StableSort(Data(), SortNum());
 		}
 
 		/**
@@ -2063,7 +2104,7 @@ namespace EDX
 		template <class PREDICATE_CLASS>
 		void StableSort(const PREDICATE_CLASS& Predicate)
 		{
-			EDX::StableSort(Data(), Size(), Predicate);
+			EDX::StableSort(Data(), SortNum(), Predicate);
 		}
 
 #if defined(_MSC_VER) && !defined(__clang__)	// Relies on MSVC-specific lazy template instantiation to support arrays of incomplete types
@@ -2074,7 +2115,7 @@ namespace EDX
 		* @param Index Position to get.
 		* @returns Reference to the element at given position.
 		*/
-		__declspec(noinline) const ElementType& DebugGet(int32 Index) const
+		__declspec(noinline) const ElementType& DebugGet(SizeType Index) const
 		{
 			return Data()[Index];
 		}
@@ -2082,14 +2123,14 @@ namespace EDX
 
 	private:
 
-		__declspec(noinline) void ResizeGrow(int32 OldNum)
+		__declspec(noinline) void ResizeGrow(SizeType OldNum)
 		{
 			mCapacity = AllocatorInstance.CalculateSlackGrow(mSize, mCapacity, sizeof(ElementType));
 			AllocatorInstance.ResizeAllocation(OldNum, mCapacity, sizeof(ElementType));
 		}
 		__declspec(noinline) void ResizeShrink()
 		{
-			const int32 NewmCapacity = AllocatorInstance.CalculateSlackShrink(mSize, mCapacity, sizeof(ElementType));
+			const SizeType NewmCapacity = AllocatorInstance.CalculateSlackShrink(mSize, mCapacity, sizeof(ElementType));
 			if (NewmCapacity != mCapacity)
 			{
 				mCapacity = NewmCapacity;
@@ -2097,7 +2138,7 @@ namespace EDX
 				AllocatorInstance.ResizeAllocation(mSize, mCapacity, sizeof(ElementType));
 			}
 		}
-		__declspec(noinline) void ResizeTo(int32 NewMax)
+		__declspec(noinline) void ResizeTo(SizeType NewMax)
 		{
 			if (NewMax)
 			{
@@ -2109,7 +2150,7 @@ namespace EDX
 				AllocatorInstance.ResizeAllocation(mSize, mCapacity, sizeof(ElementType));
 			}
 		}
-		__declspec(noinline) void ResizeForCopy(int32 NewMax, int32 PrevMax)
+		__declspec(noinline) void ResizeForCopy(SizeType NewMax, SizeType PrevMax)
 		{
 			if (NewMax)
 			{
@@ -2122,6 +2163,12 @@ namespace EDX
 			mCapacity = NewMax;
 		}
 
+		/** @return The number of elements as the int32 count the sorting functions take. */
+		__forceinline int32 SortNum() const
+		{
+			Assert(SIZE_T(mSize) <= MaxContainerSize<int32>());
+			return int32(mSize);
+		}
 
 		/**
 		* Copies data from one array into this array. Uses the fast path if the
@@ -2134,7 +2181,7 @@ namespace EDX
 		*                   default.
 		*/
 		template <typename OtherElementType, typename OtherAllocator>
-		void CopyToEmpty(const Array<OtherElementType, OtherAllocator>& Source, int32 PrevMax, int32 ExtraSlack)
+		void CopyToEmpty(const Array<OtherElementType, OtherAllocator>& Source, SizeType PrevMax, SizeType ExtraSlack)
 		{
 			Assert(ExtraSlack >= 0);
 			mSize = Source.Size();
@@ -2150,7 +2197,7 @@ namespace EDX
 		}
 
 		template <typename OtherElementType>
-		void CopyToEmpty(const OtherElementType* OtherData, int32 OtherNum, int32 PrevMax, int32 ExtraSlack)
+		void CopyToEmpty(const OtherElementType* OtherData, SizeType OtherNum, SizeType PrevMax, SizeType ExtraSlack)
 		{
 			Assert(ExtraSlack >= 0);
 			mSize = OtherNum;
@@ -2174,8 +2221,8 @@ namespace EDX
 		>::Result ElementAllocatorType;
 
 		ElementAllocatorType AllocatorInstance;
-		int32	  mSize;
-		int32	  mCapacity;
+		SizeType	  mSize;
+		SizeType	  mCapacity;
 
 		/**
 		* Implicit heaps
@@ -2192,7 +2239,7 @@ namespace EDX
 		void Heapify(const PREDICATE_CLASS& Predicate)
 		{
 			DereferenceWrapper< ElementType, PREDICATE_CLASS> PredicateWrapper(Predicate);
-			for (int32 Index = HeapGetParentIndex(Size() - 1); Index >= 0; Index--)
+			for (SizeType Index = HeapGetParentIndex(Size() - 1); Index >= 0; Index--)
 			{
 				SiftDown(Index, Size(), PredicateWrapper);
 			}
@@ -2219,12 +2266,12 @@ namespace EDX
 		* @return The index of the new element.
 		*/
 		template <class PREDICATE_CLASS>
-		int32 HeapPush(const ElementType& InItem, const PREDICATE_CLASS& Predicate)
+		SizeType HeapPush(const ElementType& InItem, const PREDICATE_CLASS& Predicate)
 		{
 			// Add at the end, then sift up
 			Add(InItem);
 			DereferenceWrapper<ElementType, PREDICATE_CLASS> PredicateWrapper(Predicate);
-			int32 Result = SiftUp(0, Size() - 1, PredicateWrapper);
+			SizeType Result = SiftUp(0, Size() - 1, PredicateWrapper);
 
 #if DEBUG_HEAP
 			VerifyHeap(PredicateWrapper);
@@ -2240,7 +2287,7 @@ namespace EDX
 		* @param InItem Item to be added.
 		* @return The index of the new element.
 		*/
-		int32 HeapPush(const ElementType& InItem)
+		SizeType HeapPush(const ElementType& InItem)
 		{
 			return HeapPush(InItem, Less<ElementType>());
 		}
@@ -2287,9 +2334,9 @@ namespace EDX
 		{
 			// Verify Predicate
 			ElementType* Heap = Data();
-			for (int32 Index = 1; Index < Size(); Index++)
+			for (SizeType Index = 1; Index < Size(); Index++)
 			{
-				int32 ParentIndex = HeapGetParentIndex(Index);
+				SizeType ParentIndex = HeapGetParentIndex(Index);
 				if (Predicate(Heap[Index], Heap[ParentIndex]))
 				{
 					Assert(false);
@@ -2357,7 +2404,7 @@ namespace EDX
 		*		if suitable after the remove (default = true).
 		*/
 		template <class PREDICATE_CLASS>
-		void HeapRemoveAt(int32 Index, const PREDICATE_CLASS& Predicate, bool bAllowShrinking = true)
+		void HeapRemoveAt(SizeType Index, const PREDICATE_CLASS& Predicate, bool bAllowShrinking = true)
 		{
 			RemoveAtSwap(Index, 1, bAllowShrinking);
 
@@ -2377,7 +2424,7 @@ namespace EDX
 		* @param bAllowShrinking (Optional) Tells if this call can shrink the array allocation
 		*		if suitable after the remove (default = true).
 		*/
-		void HeapRemoveAt(int32 Index, bool bAllowShrinking = true)
+		void HeapRemoveAt(SizeType Index, bool bAllowShrinking = true)
 		{
 			HeapRemoveAt(Index, Less< ElementType >(), bAllowShrinking);
 		}
@@ -2394,7 +2441,7 @@ namespace EDX
 			Heapify(ReversePredicateWrapper);
 
 			ElementType* Heap = Data();
-			for (int32 Index = Size() - 1; Index>0; Index--)
+			for (SizeType Index = Size() - 1; Index>0; Index--)
 			{
 				Exchange(Heap[0], Heap[Index]);
 				SiftDown(0, Index, ReversePredicateWrapper);
@@ -2407,7 +2454,7 @@ namespace EDX
 			VerifyHeap(PredicateWrapper);
 
 			// Also verify Array is properly sorted
-			for (int32 Index = 1; Index<Size(); Index++)
+			for (SizeType Index = 1; Index<Size(); Index++)
 			{
 				if (PredicateWrapper(Heap[Index], Heap[Index - 1]))
 				{
@@ -2434,7 +2481,7 @@ namespace EDX
 		* @param Index Node for which the left child index is to be returned.
 		* @returns Index of the left child.
 		*/
-		__forceinline int32 HeapGetLeftChildIndex(int32 Index) const
+		__forceinline SizeType HeapGetLeftChildIndex(SizeType Index) const
 		{
 			return Index * 2 + 1;
 		}
@@ -2445,7 +2492,7 @@ namespace EDX
 		* @param Index Node index.
 		* @returns true if node is a leaf, false otherwise.
 		*/
-		__forceinline bool HeapIsLeaf(int32 Index, int32 Count) const
+		__forceinline bool HeapIsLeaf(SizeType Index, SizeType Count) const
 		{
 			return HeapGetLeftChildIndex(Index) >= Count;
 		}
@@ -2456,7 +2503,7 @@ namespace EDX
 		* @param Index node index.
 		* @returns Parent index.
 		*/
-		__forceinline int32 HeapGetParentIndex(int32 Index) const
+		__forceinline SizeType HeapGetParentIndex(SizeType Index) const
 		{
 			return (Index - 1) / 2;
 		}
@@ -2471,15 +2518,15 @@ namespace EDX
 		* @param Predicate Predicate class instance.
 		*/
 		template <class PREDICATE_CLASS>
-		__forceinline void SiftDown(int32 Index, const int32 Count, const PREDICATE_CLASS& Predicate)
+		__forceinline void SiftDown(SizeType Index, const SizeType Count, const PREDICATE_CLASS& Predicate)
 		{
 			ElementType* Heap = Data();
 			while (!HeapIsLeaf(Index, Count))
 			{
-				const int32 LeftChildIndex = HeapGetLeftChildIndex(Index);
-				const int32 RightChildIndex = LeftChildIndex + 1;
+				const SizeType LeftChildIndex = HeapGetLeftChildIndex(Index);
+				const SizeType RightChildIndex = LeftChildIndex + 1;
 
-				int32 MinChildIndex = LeftChildIndex;
+				SizeType MinChildIndex = LeftChildIndex;
 				if (RightChildIndex < Count)
 				{
 					MinChildIndex = Predicate(Heap[LeftChildIndex], Heap[RightChildIndex]) ? LeftChildIndex : RightChildIndex;
@@ -2505,12 +2552,12 @@ namespace EDX
 		* @return The new index of the node that was at NodeIndex
 		*/
 		template <class PREDICATE_CLASS>
-		__forceinline int32 SiftUp(int32 RootIndex, int32 NodeIndex, const PREDICATE_CLASS& Predicate)
+		__forceinline SizeType SiftUp(SizeType RootIndex, SizeType NodeIndex, const PREDICATE_CLASS& Predicate)
 		{
 			ElementType* Heap = Data();
 			while (NodeIndex > RootIndex)
 			{
-				int32 ParentIndex = HeapGetParentIndex(NodeIndex);
+				SizeType ParentIndex = HeapGetParentIndex(NodeIndex);
 				if (!Predicate(Heap[NodeIndex], Heap[ParentIndex]))
 				{
 					break;
@@ -2558,6 +2605,10 @@ namespace EDX
 	// Static array
 	template<typename T, int Size>
 	using StaticArray = Array<T, FixedAllocator<Size>>;
+
+	// Array with 64 bits sizes and indices, for more than 2^31 elements
+	template<typename T>
+	using Array64 = Array<T, DefaultAllocator64>;
 }
 
 //
@@ -2566,10 +2617,10 @@ namespace EDX
 template <typename T, typename Allocator> void* operator new(size_t Size, EDX::Array<T, Allocator>& Array)
 {
 	Assert(Size == sizeof(T));
-	const EDX::int32 Index = Array.AddUninitialized(1);
+	const auto Index = Array.AddUninitialized(1);
 	return &Array[Index];
 }
-template <typename T, typename Allocator> void* operator new(size_t Size, EDX::Array<T, Allocator>& Array, EDX::int32 Index)
+template <typename T, typename Allocator> void* operator new(size_t Size, EDX::Array<T, Allocator>& Array, typename EDX::Array<T, Allocator>::SizeType Index)
 {
 	Assert(Size == sizeof(T));
 	Array.InsertUninitialized(Index, 1);
@@ -2580,7 +2631,7 @@ template <typename T, typename Allocator> void operator delete(void* Mem, EDX::A
 {
 
 }
-template <typename T, typename Allocator> void operator delete(void* Mem, EDX::Array<T, Allocator>& Array, EDX::int32 Index)
+template <typename T, typename Allocator> void operator delete(void* Mem, EDX::Array<T, Allocator>& Array, typename EDX::Array<T, Allocator>::SizeType Index)
 {
 
 }
\ No newline at end of file
@@ -63,7 +63,7 @@ namespace EDX
 					{
 						uint32 Current = Data;
 						uint32 Desired = Current | Mask;
-						if (Current == Desired || WindowsAtomics::InterlockedCompareExchange((volatile int32*)&Data, (int32)Desired, (int32)Current) == (int32)Current)
+						if (Current == Desired || PlatformAtomics::InterlockedCompareExchange((volatile int32*)&Data, (int32)Desired, (int32)Current) == (int32)Current)
 						{
 							return;
 						}
@@ -78,7 +78,7 @@ namespace EDX
 					{
 						uint32 Current = Data;
 						uint32 Desired = Current & ~Mask;
-						if (Current == Desired || WindowsAtomics::InterlockedCompareExchange((volatile int32*)&Data, (int32)Desired, (int32)Current) == (int32)Current)
+						if (Current == Desired || PlatformAtomics::InterlockedCompareExchange((volatile int32*)&Data, (int32)Desired, (int32)Current) == (int32)Current)
 						{
 							return;
 						}
@@ -143,6 +143,8 @@ namespace EDX
 	template<typename Allocator/* = DefaultBitArrayAllocator*/>
 	class BitArray
 	{
+		static_assert(sizeof(typename Allocator::SizeType) == sizeof(int32), "BitArray only supports allocators with 32 bits sizes.");
+
 	public:
 
 		template<typename>
@@ -2,7 +2,7 @@
 
 #include "../Core/Types.h"
 #include "DimensionalArray.h"
-#include "Memory.h"
+#include "../Core/Memory.h"
 #include "../Math/Vector.h"
 
 namespace EDX
@@ -21,9 +21,14 @@ namespace EDX
 		ArrayIndex<Dimension> mBlockIndex;
 		ArrayIndex<Dimension> mIntraBlockIndex;
 
+		/** Whether the data is allocated with Memory::AllocLarge, see UseLargeAlloc. */
+		bool mbLargeAlloc;
+		LargeAllocParams mLargeAllocParams;
+
 	public:
 		BlockedDimensionalArray()
 			: mpData(NULL)
+			, mbLargeAlloc(false)
 		{
 		}
 		virtual ~BlockedDimensionalArray()
@@ -44,24 +49,42 @@ namespace EDX
 		}
 		BlockedDimensionalArray& operator = (BlockedDimensionalArray&& rhs)
 		{
-			if (Size() != rhs.Size())
+			if (this != &rhs)
 			{
+				// Take over the allocation policy along with the data, it decides how the data is freed
 				Free();
-				Init(rhs.Size());
+				mLogBlockElemCount = rhs.mLogBlockElemCount;
+				mRoundedSize = rhs.mRoundedSize;
+				mOrgIndex = rhs.mOrgIndex;
+				mBlockIndex = rhs.mBlockIndex;
+				mIntraBlockIndex = rhs.mIntraBlockIndex;
+				mpData = rhs.mpData;
+				mbLargeAlloc = rhs.mbLargeAlloc;
+				mLargeAllocParams = rhs.mLargeAllocParams;
+				rhs.mpData = NULL;
 			}
-			mpData = rhs.mpData;
-			rhs.mpData = NULL;
 			return *this;
 		}
 
+		/**
+		* Makes the array allocate its data with Memory::AllocLarge, for big arrays such as images and
+		* volumes. Releases the current data, the next Init allocates with the new policy.
+		*/
+		void UseLargeAlloc(const LargeAllocParams& largeAllocParams = LargeAllocParams())
+		{
+			Free();
+			mbLargeAlloc = true;
+			mLargeAllocParams = largeAllocParams;
+		}
+
 		void Init(const Vec<Dimension, uint>& size, bool bClear = true)
 		{
 			mOrgIndex.Init(size);
 			Vec<Dimension, uint> roundUpSize = RoundUp(size);
 			mRoundedSize = roundUpSize.Product();
 
-			Memory::Free(mpData);
-			mpData = Memory::AlignedAlloc<T>(mRoundedSize);
+			Free();
+			mpData = mbLargeAlloc ? Memory::AllocLarge<T>(mRoundedSize, mLargeAllocParams) : Memory::AlignedAlloc<T>(mRoundedSize);
 			Assert(mpData);
 
 			if (bClear)
@@ -127,7 +150,15 @@ namespace EDX
 
 		void Free()
 		{
-			Memory::Free(mpData);
+			if (mbLargeAlloc)
+			{
+				Memory::FreeLarge(mpData);
+			}
+			else
+			{
+				Memory::Free(mpData);
+			}
+			mpData = NULL;
 		}
 
 	private:
@@ -0,0 +1,412 @@
+#pragma once
+
+#include "Map.h"
+#include "../Core/Memory.h"
+#include "../Windows/Atomics.h"
+#include "../Windows/Threading.h"
+#include "../Math/EDXMath.h"
+
+namespace EDX
+{
+	/**
+	* A map from keys to values which can be read and added to by several threads at once, with the same KeyFuncs as Map.
+	*
+	* The pairs are kept in a single linked list sorted by bit-reversed hash (a split-ordered list), and the buckets
+	* point into the list, so the bucket count can double without moving any pair. Lookups never take a lock nor
+	* allocate, a bucket not split yet is searched from its closest split parent. Adds split the buckets they reach and
+	* are serialized per lock stripe, chosen from the key hash, which makes FindOrAdd build a missing value exactly once.
+	*
+	* Pairs are never removed or moved while the map is alive, pointers and references to values stay valid until
+	* Reset or destruction, neither of which may run concurrently with anything else. The map only protects its own
+	* structure: concurrent writes to a value must be synchronized by the caller.
+	**/
+	template<typename KeyType, typename ValueType, typename KeyFuncs = DefaultMapKeyFuncs<KeyType, ValueType, false>>
+	class ConcurrentMap
+	{
+	public:
+		typedef typename TypeTraits<KeyType>::ConstPointerType KeyConstPointerType;
+		typedef Pair<KeyType, ValueType> ElementType;
+
+	private:
+		enum
+		{
+			/** Number of locks serializing the adds. */
+			NumLockStripes = 64,
+
+			/** Segment 0 holds buckets 0 and 1, segment i > 0 holds buckets [2^i, 2^(i+1)). */
+			NumSegments = 31,
+			MaxBuckets = 1 << 30,
+
+			/** Average number of pairs per bucket above which the bucket count doubles. */
+			MaxLoadFactor = 2,
+		};
+
+		struct NodeBase
+		{
+			/** Bit-reversed hash, odd for pairs and even for the bucket sentinels. */
+			uint32 SortKey;
+			NodeBase* volatile pNext;
+		};
+
+		struct ElementNode : public NodeBase
+		{
+			ElementType Element;
+		};
+
+		typedef NodeBase* volatile BucketType;
+
+		BucketType* volatile Segments[NumSegments];
+		volatile int32 NumBuckets;
+		volatile int32 NumElements;
+
+		CriticalSection LockStripes[NumLockStripes];
+
+	public:
+		ConcurrentMap()
+		{
+			Init();
+		}
+
+		~ConcurrentMap()
+		{
+			Release();
+		}
+
+		ConcurrentMap(const ConcurrentMap&) = delete;
+		ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+		/**
+		* Removes all elements from the map and frees its memory. Not thread safe, nothing may access the map meanwhile.
+		*/
+		void Reset()
+		{
+			Release();
+			Init();
+		}
+
+		/** @return The number of elements in the map, elements being added by other threads may or may not be counted. */
+		__forceinline int32 Size() const
+		{
+			return NumElements;
+		}
+
+		/**
+		* Returns the value associated with a specified key. Lock free, never allocates.
+		* @param	Key - The key to search for.
+		* @return	A pointer to the value associated with the specified key, or nullptr if the key isn't contained in this map.
+		*			The pointer stays valid until the map is reset.
+		*/
+		__forceinline ValueType* Find(KeyConstPointerType Key) const
+		{
+			if (ElementNode* pNode = FindNode(Key, GetHash(Key)))
+			{
+				return &pNode->Element.Value;
+			}
+
+			return nullptr;
+		}
+
+		/**
+		* Checks if map contains the specified key. Lock free, never allocates.
+		* @param Key - The key to check for.
+		* @return true if the map contains the key.
+		*/
+		__forceinline bool Contains(KeyConstPointerType Key) const
+		{
+			return FindNode(Key, GetHash(Key)) != nullptr;
+		}
+
+		/**
+		* Returns the value associated with a specified key, or if none exists, adds the value returned by Factory.
+		* When several threads ask for the same missing key, exactly one of them calls Factory while the others wait for its
+		* result. Factory runs under a lock shared with other keys, it must not wait for other threads adding to this map.
+		*
+		* @param	Key - The key to search for.
+		* @param	Factory - Callable taking no argument and returning the value to add.
+		* @return	A reference to the value associated with the specified key, valid until the map is reset.
+		*/
+		template <typename FactoryType>
+		ValueType& FindOrAdd(const KeyType& Key, const FactoryType& Factory)
+		{
+			const uint32 Hash = GetHash(Key);
+			if (ElementNode* pNode = FindNode(Key, Hash))
+			{
+				return pNode->Element.Value;
+			}
+
+			ScopeLock Lock(&LockStripes[Hash % NumLockStripes]);
+
+			// Keys with the same hash share the stripe, so no other thread can add this key until the lock is released
+			if (ElementNode* pNode = FindNode(Key, Hash))
+			{
+				return pNode->Element.Value;
+			}
+
+			ElementNode* pNode = AllocNode();
+			new(&pNode->Element) ElementType(PairInitializer<const KeyType&, ValueType&&>(Key, Factory()));
+
+			return InsertNode(pNode, Hash)->Element.Value;
+		}
+
+		/**
+		* Returns the value associated with a specified key, or if none exists, adds a value using the default constructor.
+		* @param	Key - The key to search for.
+		* @return	A reference to the value associated with the specified key, valid until the map is reset.
+		*/
+		__forceinline ValueType& FindOrAdd(const KeyType& Key)
+		{
+			return FindOrAdd(Key, []() { return ValueType(); });
+		}
+
+		/**
+		* Associates a value with a key if the key isn't in the map yet. Existing values are never replaced, since other
+		* threads may be reading them.
+		*
+		* @param InKey - The key to associate the value with.
+		* @param InValue - The value to associate with the key.
+		* @return true if the value was added, false if the key already had a value.
+		*/
+		bool TryAdd(const KeyType& InKey, const ValueType& InValue)
+		{
+			bool bAdded = false;
+			FindOrAdd(InKey, [&]() { bAdded = true; return InValue; });
+			return bAdded;
+		}
+
+		/**
+		* Calls Func on every pair of the map. Can run concurrently with adds, in which case the pairs added meanwhile may
+		* or may not be visited.
+		*/
+		template <typename FuncType>
+		void ForEach(const FuncType& Func) const
+		{
+			for (NodeBase* pNode = PlatformAtomics::LoadAcquire(&Segments[0][0]->pNext); pNode; pNode = PlatformAtomics::LoadAcquire(&pNode->pNext))
+			{
+				if (pNode->SortKey & 1)
+				{
+					Func(static_cast<ElementNode*>(pNode)->Element);
+				}
+			}
+		}
+
+		/**
+		* Generates an array from the keys in this map.
+		*/
+		template<typename Allocator> void GenerateKeyArray(Array<KeyType, Allocator>& OutArray) const
+		{
+			OutArray.Clear(Size());
+			ForEach([&](const ElementType& Pair) { new(OutArray) KeyType(Pair.Key); });
+		}
+
+		/**
+		* Generates an array from the values in this map.
+		*/
+		template<typename Allocator> void GenerateValueArray(Array<ValueType, Allocator>& OutArray) const
+		{
+			OutArray.Clear(Size());
+			ForEach([&](const ElementType& Pair) { new(OutArray) ValueType(Pair.Value); });
+		}
+
+	private:
+		static __forceinline uint32 GetHash(KeyConstPointerType Key)
+		{
+			// The low bits select the bucket, spread them for keys hashing to sequential values
+			uint32 Hash = KeyFuncs::GetKeyHash(Key) * 0x9E3779B1u;
+			return Hash ^ (Hash >> 15);
+		}
+
+		/** The top bit is set before reversing to make the sort key odd, it is never used to select a bucket. */
+		static __forceinline uint32 GetElementSortKey(uint32 Hash)
+		{
+			return ReverseBits(Hash | 0x80000000u);
+		}
+
+		static __forceinline uint32 GetSentinelSortKey(uint32 BucketIndex)
+		{
+			return ReverseBits(BucketIndex);
+		}
+
+		void Init()
+		{
+			Memory::Memzero(const_cast<BucketType**>(Segments), sizeof(Segments));
+			NumBuckets = 2;
+			NumElements = 0;
+
+			NodeBase* pHead = (NodeBase*)Memory::AlignedAlloc(sizeof(NodeBase), DEFAULT_ALIGNMENT, MemoryTag_Containers);
+			pHead->SortKey = GetSentinelSortKey(0);
+			pHead->pNext = nullptr;
+			GetBucketSlot(0) = pHead;
+		}
+
+		void Release()
+		{
+			NodeBase* pNode = Segments[0][0];
+			while (pNode)
+			{
+				NodeBase* pNext = pNode->pNext;
+				if (pNode->SortKey & 1)
+				{
+					DestructItems(&static_cast<ElementNode*>(pNode)->Element, 1);
+				}
+				Memory::Free(pNode);
+				pNode = pNext;
+			}
+
+			for (int32 i = 0; i < NumSegments; i++)
+			{
+				Memory::Free((void*)Segments[i]);
+			}
+		}
+
+		__forceinline ElementNode* AllocNode()
+		{
+			return (ElementNode*)Memory::AlignedAlloc(sizeof(ElementNode), uint32(alignof(ElementNode)), MemoryTag_Containers);
+		}
+
+		/** Gets the bucket array entry of a bucket, allocating its segment on first use. */
+		BucketType& GetBucketSlot(uint32 BucketIndex)
+		{
+			const uint32 Segment = BucketIndex < 2 ? 0 : Math::FloorLog2(BucketIndex);
+			const uint32 SegmentSize = Segment == 0 ? 2 : 1u << Segment;
+			const uint32 Offset = Segment == 0 ? BucketIndex : BucketIndex - SegmentSize;
+
+			if (PlatformAtomics::LoadAcquire(&Segments[Segment]) == nullptr)
+			{
+				BucketType* pNewSegment = (BucketType*)Memory::AlignedAlloc(SegmentSize * sizeof(BucketType), DEFAULT_ALIGNMENT, MemoryTag_Containers);
+				Memory::Memzero((void*)pNewSegment, SegmentSize * sizeof(BucketType));
+				if (PlatformAtomics::InterlockedCompareExchangePointer((void**)&Segments[Segment], pNewSegment, nullptr) != nullptr)
+				{
+					Memory::Free((void*)pNewSegment);
+				}
+			}
+
+			return PlatformAtomics::LoadAcquire(&Segments[Segment])[Offset];
+		}
+
+		/** @return The parent bucket, holding the range of the list a bucket splits: the same index without the top bit. */
+		static __forceinline uint32 GetParentBucketIndex(uint32 BucketIndex)
+		{
+			return BucketIndex & ~(1u << Math::FloorLog2(BucketIndex));
+		}
+
+		/**
+		* Gets the sentinel of the closest initialized bucket on the path from a bucket to bucket 0, never allocates. The
+		* range of the list a bucket covers is included in the range of its parent, so a search can start from there.
+		*/
+		NodeBase* FindBucket(uint32 BucketIndex) const
+		{
+			while (BucketIndex > 0)
+			{
+				const uint32 Segment = BucketIndex < 2 ? 0 : Math::FloorLog2(BucketIndex);
+				const uint32 Offset = Segment == 0 ? BucketIndex : BucketIndex - (1u << Segment);
+
+				BucketType* pSegment = PlatformAtomics::LoadAcquire(&Segments[Segment]);
+				if (pSegment != nullptr)
+				{
+					NodeBase* pSentinel = PlatformAtomics::LoadAcquire(&pSegment[Offset]);
+					if (pSentinel != nullptr)
+					{
+						return pSentinel;
+					}
+				}
+
+				BucketIndex = GetParentBucketIndex(BucketIndex);
+			}
+
+			return Segments[0][0];
+		}
+
+		/** Gets the sentinel of a bucket, splitting it from its parent bucket on first use. */
+		NodeBase* GetBucket(uint32 BucketIndex)
+		{
+			BucketType& Slot = GetBucketSlot(BucketIndex);
+			NodeBase* pExisting = PlatformAtomics::LoadAcquire(&Slot);
+			if (pExisting != nullptr)
+			{
+				return pExisting;
+			}
+
+			NodeBase* pParent = GetBucket(GetParentBucketIndex(BucketIndex));
+
+			NodeBase* pSentinel = (NodeBase*)Memory::AlignedAlloc(sizeof(NodeBase), DEFAULT_ALIGNMENT, MemoryTag_Containers);
+			pSentinel->SortKey = GetSentinelSortKey(BucketIndex);
+
+			NodeBase* pResult = LinkNode(pParent, pSentinel, true);
+			if (pResult != pSentinel)
+			{
+				Memory::Free(pSentinel);
+			}
+
+			// Every thread racing here found the same sentinel in the list
+			PlatformAtomics::StoreRelease(&Slot, pResult);
+			return pResult;
+		}
+
+		/**
+		* Links a node in the list after pStart, keeping the list sorted. Sentinels are unique, if one with the same sort key is
+		* already linked it is returned instead. Pairs with the same sort key are linked in any order.
+		*/
+		static NodeBase* LinkNode(NodeBase* pStart, NodeBase* pNode, bool bSentinel)
+		{
+			while (true)
+			{
+				NodeBase* pPrev = pStart;
+				NodeBase* pCurrent = PlatformAtomics::LoadAcquire(&pPrev->pNext);
+				while (pCurrent && pCurrent->SortKey < pNode->SortKey)
+				{
+					pPrev = pCurrent;
+					pCurrent = PlatformAtomics::LoadAcquire(&pCurrent->pNext);
+				}
+
+				if (bSentinel && pCurrent && pCurrent->SortKey == pNode->SortKey)
+				{
+					return pCurrent;
+				}
+
+				// The node is fully built before the exchange, a full barrier, publishes it to the readers
+				pNode->pNext = pCurrent;
+				if (PlatformAtomics::InterlockedCompareExchangePointer((void**)&pPrev->pNext, pNode, pCurrent) == pCurrent)
+				{
+					return pNode;
+				}
+			}
+		}
+
+		ElementNode* FindNode(KeyConstPointerType Key, uint32 Hash) const
+		{
+			const uint32 SortKey = GetElementSortKey(Hash);
+
+			NodeBase* pNode = FindBucket(Hash & (NumBuckets - 1));
+			while (pNode && pNode->SortKey <= SortKey)
+			{
+				if (pNode->SortKey == SortKey)
+				{
+					ElementNode* pElement = static_cast<ElementNode*>(pNode);
+					if (KeyFuncs::Matches(KeyFuncs::GetSetKey(pElement->Element), Key))
+					{
+						return pElement;
+					}
+				}
+				pNode = PlatformAtomics::LoadAcquire(&pNode->pNext);
+			}
+
+			return nullptr;
+		}
+
+		ElementNode* InsertNode(ElementNode* pNode, uint32 Hash)
+		{
+			pNode->SortKey = GetElementSortKey(Hash);
+			LinkNode(GetBucket(Hash & (NumBuckets - 1)), pNode, false);
+
+			const int32 NewNumElements = PlatformAtomics::InterlockedIncrement(&NumElements);
+			const int32 CurrentNumBuckets = NumBuckets;
+			if (NewNumElements > CurrentNumBuckets * MaxLoadFactor && CurrentNumBuckets < MaxBuckets)
+			{
+				// New buckets are split lazily by the first add reaching them, lookups start from their closest split parent
+				PlatformAtomics::InterlockedCompareExchange(&NumBuckets, CurrentNumBuckets * 2, CurrentNumBuckets);
+			}
+
+			return pNode;
+		}
+	};
+}
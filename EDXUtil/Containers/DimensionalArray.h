@@ -101,14 +101,28 @@ namespace EDX
 		ArrayIndex<Dimension> mIndex;
 		T* mpData;
 
+		/** Whether the data is allocated with Memory::AllocLarge, see UseLargeAlloc. */
+		bool mbLargeAlloc;
+		LargeAllocParams mLargeAllocParams;
+
 	public:
 		DimensionalArray()
 			: mpData(nullptr)
+			, mbLargeAlloc(false)
 		{
 		}
 
 		DimensionalArray(const Vec<Dimension, uint>& size, bool bClear = true)
 			: mpData(nullptr)
+			, mbLargeAlloc(false)
+		{
+			this->Init(size, bClear);
+		}
+
+		DimensionalArray(const Vec<Dimension, uint>& size, const LargeAllocParams& largeAllocParams, bool bClear = true)
+			: mpData(nullptr)
+			, mbLargeAlloc(true)
+			, mLargeAllocParams(largeAllocParams)
 		{
 			this->Init(size, bClear);
 		}
@@ -120,22 +134,36 @@ namespace EDX
 
 		DimensionalArray(const DimensionalArray& rhs)
 			: mpData(NULL)
+			, mbLargeAlloc(rhs.mbLargeAlloc)
+			, mLargeAllocParams(rhs.mLargeAllocParams)
 		{
 			this->operator=(rhs);
 		}
 
 		DimensionalArray(DimensionalArray&& rhs)
 			: mpData(NULL)
+			, mbLargeAlloc(false)
 		{
 			this->operator=(std::move(rhs));
 		}
 
+		/**
+		* Makes the array allocate its data with Memory::AllocLarge, for big arrays such as images and
+		* volumes. Releases the current data, the next Init allocates with the new policy.
+		*/
+		void UseLargeAlloc(const LargeAllocParams& largeAllocParams = LargeAllocParams())
+		{
+			Free();
+			mbLargeAlloc = true;
+			mLargeAllocParams = largeAllocParams;
+		}
+
 		void Init(const Vec<Dimension, uint>& size, bool bClear = true)
 		{
-			Memory::SafeFree(mpData);
+			Free();
 			mIndex.Init(size);
 
-			mpData = Memory::AlignedAlloc<T>(mIndex.LinearSize());
+			mpData = mbLargeAlloc ? Memory::AllocLarge<T>(mIndex.LinearSize(), mLargeAllocParams) : Memory::AlignedAlloc<T>(mIndex.LinearSize());
 			Assert(mpData);
 
 			if (bClear)
@@ -169,13 +197,16 @@ namespace EDX
 		}
 		DimensionalArray& operator = (DimensionalArray&& rhs)
 		{
-			if (Size() != rhs.Size())
+			if (this != &rhs)
 			{
+				// Take over the allocation policy along with the data, it decides how the data is freed
 				Free();
-				Init(rhs.Size());
+				mIndex = rhs.mIndex;
+				mpData = rhs.mpData;
+				mbLargeAlloc = rhs.mbLargeAlloc;
+				mLargeAllocParams = rhs.mLargeAllocParams;
+				rhs.mpData = NULL;
 			}
-			mpData = rhs.mpData;
-			rhs.mpData = NULL;
 			return *this;
 		}
 
@@ -233,7 +264,15 @@ namespace EDX
 
 		void Free()
 		{
-			Memory::SafeFree(mpData);
+			if (mbLargeAlloc)
+			{
+				Memory::FreeLarge(mpData);
+				mpData = nullptr;
+			}
+			else
+			{
+				Memory::SafeFree(mpData);
+			}
 		}
 	};
 
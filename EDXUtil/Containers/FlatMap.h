@@ -0,0 +1,256 @@
+#pragma once
+
+#include "Map.h"
+#include "FlatSet.h"
+
+namespace EDX
+{
+	/**
+	* A map from keys to values stored in a FlatSet of key-value pairs, with the same KeyFuncs as Map.
+	* Lookups are faster than with Map, but the pairs move when the map grows: pointers and references
+	* to values are invalidated by Add, Emplace and FindOrAdd, and the iteration order is arbitrary.
+	**/
+	template<typename KeyType, typename ValueType, typename KeyFuncs = DefaultMapKeyFuncs<KeyType, ValueType, false>>
+	class FlatMap
+	{
+	public:
+		typedef typename TypeTraits<KeyType  >::ConstPointerType KeyConstPointerType;
+		typedef typename TypeTraits<KeyType  >::ConstInitType    KeyInitType;
+		typedef typename TypeTraits<ValueType>::ConstInitType    ValueInitType;
+		typedef Pair<KeyType, ValueType> ElementType;
+
+	private:
+		typedef FlatSet<ElementType, KeyFuncs> PairSetType;
+
+		PairSetType Pairs;
+
+	public:
+		FlatMap() = default;
+		FlatMap(FlatMap&&) = default;
+		FlatMap(const FlatMap&) = default;
+		FlatMap& operator=(FlatMap&&) = default;
+		FlatMap& operator=(const FlatMap&) = default;
+
+		/**
+		* Removes all elements from the map, potentially leaving space allocated for an expected number of elements about to be added.
+		* @param ExpectedNumElements - The number of elements about to be added to the map.
+		*/
+		__forceinline void Clear(int32 ExpectedNumElements = 0)
+		{
+			Pairs.Clear(ExpectedNumElements);
+		}
+
+		/** Removes all elements from the map and frees the table. */
+		__forceinline void Reset()
+		{
+			Pairs.Reset();
+		}
+
+		/** Preallocates enough memory to contain Number elements. */
+		__forceinline void Reserve(int32 Number)
+		{
+			Pairs.Reserve(Number);
+		}
+
+		/** @return The number of elements in the map. */
+		__forceinline int32 Size() const
+		{
+			return Pairs.Size();
+		}
+
+		/** @return The amount of memory allocated by this container, only includes memory allocated by the container itself. */
+		__forceinline uint32 GetAllocatedSize() const
+		{
+			return Pairs.GetAllocatedSize();
+		}
+
+		/**
+		* Sets the value associated with a key.
+		*
+		* @param InKey - The key to associate the value with.
+		* @param InValue - The value to associate with the key.
+		* @return A reference to the value as stored in the map.  The reference is only valid until the next addition to the map.
+		*/
+		__forceinline ValueType& Add(const KeyType&  InKey, const ValueType&  InValue) { return Emplace(InKey, InValue); }
+		__forceinline ValueType& Add(const KeyType&  InKey, ValueType&& InValue) { return Emplace(InKey, Move(InValue)); }
+		__forceinline ValueType& Add(KeyType&& InKey, const ValueType&  InValue) { return Emplace(Move(InKey), InValue); }
+		__forceinline ValueType& Add(KeyType&& InKey, ValueType&& InValue) { return Emplace(Move(InKey), Move(InValue)); }
+
+		/**
+		* Sets a default value associated with a key.
+		*
+		* @param InKey - The key to associate the value with.
+		* @return A reference to the value as stored in the map.  The reference is only valid until the next addition to the map.
+		*/
+		__forceinline ValueType& Add(const KeyType&  InKey) { return Emplace(InKey); }
+		__forceinline ValueType& Add(KeyType&& InKey) { return Emplace(Move(InKey)); }
+
+		/**
+		* Sets the value associated with a key.
+		*
+		* @param InKey - The key to associate the value with.
+		* @param InValue - The value to associate with the key.
+		* @return A reference to the value as stored in the map.  The reference is only valid until the next addition to the map.
+		*/
+		template <typename InitKeyType, typename InitValueType>
+		ValueType& Emplace(InitKeyType&& InKey, InitValueType&& InValue)
+		{
+			return Pairs.Emplace(PairInitializer<InitKeyType&&, InitValueType&&>(Forward<InitKeyType>(InKey), Forward<InitValueType>(InValue))).Value;
+		}
+
+		/**
+		* Sets a default value associated with a key.
+		*
+		* @param InKey - The key to associate the value with.
+		* @return A reference to the value as stored in the map.  The reference is only valid until the next addition to the map.
+		*/
+		template <typename InitKeyType>
+		ValueType& Emplace(InitKeyType&& InKey)
+		{
+			return Pairs.Emplace(KeyInitializer<InitKeyType&&>(Forward<InitKeyType>(InKey))).Value;
+		}
+
+		/**
+		* Removes the value association for a key.
+		* @param InKey - The key to remove the associated value for.
+		* @return The number of values that were associated with the key.
+		*/
+		__forceinline int32 Remove(KeyConstPointerType InKey)
+		{
+			return Pairs.Remove(InKey);
+		}
+
+		/**
+		* Returns the value associated with a specified key.
+		* @param	Key - The key to search for.
+		* @return	A pointer to the value associated with the specified key, or nullptr if the key isn't contained in this map.  The pointer
+		*			is only valid until the next addition to the map.
+		*/
+		__forceinline ValueType* Find(KeyConstPointerType Key)
+		{
+			if (auto* Pair = Pairs.Find(Key))
+			{
+				return &Pair->Value;
+			}
+
+			return nullptr;
+		}
+		__forceinline const ValueType* Find(KeyConstPointerType Key) const
+		{
+			return const_cast<FlatMap*>(this)->Find(Key);
+		}
+
+	private:
+		template <typename ArgType>
+		__forceinline ValueType& FindOrAddImpl(ArgType&& Arg)
+		{
+			if (auto* Pair = Pairs.Find(Arg))
+				return Pair->Value;
+
+			return Add(Forward<ArgType>(Arg));
+		}
+
+	public:
+		/**
+		* Returns the value associated with a specified key, or if none exists,
+		* adds a value using the default constructor.
+		* @param	Key - The key to search for.
+		* @return	A reference to the value associated with the specified key.
+		*/
+		__forceinline ValueType& FindOrAdd(const KeyType&  Key) { return FindOrAddImpl(Key); }
+		__forceinline ValueType& FindOrAdd(KeyType&& Key) { return FindOrAddImpl(Move(Key)); }
+
+		/**
+		* Returns a reference to the value associated with a specified key.
+		* @param	Key - The key to search for.
+		* @return	The value associated with the specified key, or triggers an assertion if the key does not exist.
+		*/
+		__forceinline const ValueType& FindChecked(KeyConstPointerType Key) const
+		{
+			const auto* Pair = Pairs.Find(Key);
+			Assert(Pair != nullptr);
+			return Pair->Value;
+		}
+
+		__forceinline ValueType& FindChecked(KeyConstPointerType Key)
+		{
+			auto* Pair = Pairs.Find(Key);
+			Assert(Pair != nullptr);
+			return Pair->Value;
+		}
+
+		/**
+		* Returns the value associated with a specified key.
+		* @param	Key - The key to search for.
+		* @return	The value associated with the specified key, or the default value for the ValueType if the key isn't contained in this map.
+		*/
+		__forceinline ValueType FindRef(KeyConstPointerType Key) const
+		{
+			if (const auto* Pair = Pairs.Find(Key))
+			{
+				return Pair->Value;
+			}
+
+			return ValueType();
+		}
+
+		/**
+		* Checks if map contains the specified key.
+		* @param Key - The key to check for.
+		* @return true if the map contains the key.
+		*/
+		__forceinline bool Contains(KeyConstPointerType Key) const
+		{
+			return Pairs.Contains(Key);
+		}
+
+		/**
+		* Generates an array from the keys in this map.
+		*/
+		template<typename Allocator> void GenerateKeyArray(Array<KeyType, Allocator>& OutArray) const
+		{
+			OutArray.Clear(Pairs.Size());
+			for (const ElementType& Pair : Pairs)
+			{
+				new(OutArray) KeyType(Pair.Key);
+			}
+		}
+
+		/**
+		* Generates an array from the values in this map.
+		*/
+		template<typename Allocator> void GenerateValueArray(Array<ValueType, Allocator>& OutArray) const
+		{
+			OutArray.Clear(Pairs.Size());
+			for (const ElementType& Pair : Pairs)
+			{
+				new(OutArray) ValueType(Pair.Value);
+			}
+		}
+
+		typedef typename PairSetType::Iterator Iterator;
+		typedef typename PairSetType::ConstIterator ConstIterator;
+
+		/** Creates an iterator over all the pairs in this map */
+		__forceinline Iterator CreateIterator()
+		{
+			return Pairs.CreateIterator();
+		}
+
+		/** Creates a const iterator over all the pairs in this map */
+		__forceinline ConstIterator CreateConstIterator() const
+		{
+			return Pairs.CreateConstIterator();
+		}
+
+	private:
+		/**
+		* DO NOT USE DIRECTLY
+		* STL-like iterators to enable range-based for loop support.
+		*/
+		__forceinline friend Iterator      begin(FlatMap& Map) { return begin(Map.Pairs); }
+		__forceinline friend ConstIterator begin(const FlatMap& Map) { return begin(Map.Pairs); }
+		__forceinline friend Iterator      end(FlatMap& Map) { return end(Map.Pairs); }
+		__forceinline friend ConstIterator end(const FlatMap& Map) { return end(Map.Pairs); }
+	};
+}
@@ -0,0 +1,651 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Core/Memory.h"
+#include "../Core/Template.h"
+#include "../Math/EDXMath.h"
+#include "Set.h"
+
+#include <emmintrin.h>
+#include <initializer_list>
+
+namespace EDX
+{
+	namespace FlatSet_Private
+	{
+		/**
+		* Control byte of a slot: the 7 low bits of the hash for a full slot, or one of the negative
+		* values below for a free slot.
+		*/
+		enum
+		{
+			ControlEmpty = -128,
+			ControlDeleted = -2,
+
+			GroupSize = 16,
+		};
+
+		/** 16 consecutive control bytes, matched in parallel with SSE2. */
+		class Group
+		{
+		private:
+			__m128i Control;
+
+		public:
+			__forceinline explicit Group(const int8* pControl)
+				: Control(_mm_loadu_si128((const __m128i*)pControl))
+			{
+			}
+
+			/** @return Bit i set if slot i holds the 7 hash bits H2 */
+			__forceinline uint32 Match(int8 H2) const
+			{
+				return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Control));
+			}
+
+			__forceinline uint32 MatchEmpty() const
+			{
+				return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(int8(ControlEmpty)), Control));
+			}
+
+			/** Free slots are the only ones with the sign bit set. */
+			__forceinline uint32 MatchFree() const
+			{
+				return _mm_movemask_epi8(Control);
+			}
+		};
+
+		/**
+		* Spreads the 32 bits hash of a key, GetTypeHash of integers being the identity. The bits 32-63
+		* pick the first slot to probe and the bits 25-31 are stored in the control byte.
+		*/
+		__forceinline uint64 MixHash(uint32 Hash)
+		{
+			return uint64(Hash) * 0x9E3779B97F4A7C15ull;
+		}
+
+		__forceinline int8 GetH2(uint64 MixedHash)
+		{
+			return int8((MixedHash >> 25) & 0x7f);
+		}
+	}
+
+	/**
+	* A set stored in a single open addressing table, probed 16 slots at a time.
+	*
+	* Each slot has a control byte holding 7 bits of the hash of its element. A lookup compares the
+	* control bytes of a whole group of 16 slots with one SSE2 instruction and only looks at the
+	* elements whose bits match, so finding a key usually costs one cache miss for the control bytes
+	* and one for the element. It takes the same KeyFuncs as Set, so FlatSet can replace a Set where
+	* element ids and stable iteration order aren't needed.
+	*
+	* Unlike Set, elements move when the table grows: pointers and references to elements are
+	* invalidated by Add and Emplace. Removing elements doesn't move the others.
+	*/
+	template<typename InElementType, typename KeyFuncs = DefaultKeyFuncs<InElementType>>
+	class FlatSet
+	{
+		static_assert(!KeyFuncs::bAllowDuplicateKeys, "FlatSet doesn't support duplicate keys.");
+
+		typedef typename KeyFuncs::KeyInitType KeyInitType;
+
+	public:
+		typedef InElementType ElementType;
+
+	private:
+		/** Control bytes followed by the slots, in one allocation. Capacity + GroupSize control bytes, the last group mirrors the first so groups can be loaded past the end. */
+		int8* pControl;
+		ElementType* pSlots;
+
+		/** Number of slots, 0 or a power of two no smaller than GroupSize. */
+		int32 Capacity;
+		int32 NumElements;
+
+		/** Number of elements which can be added before growing, accounting for the deleted slots. */
+		int32 GrowthLeft;
+
+	public:
+		/** Initialization constructor. */
+		__forceinline FlatSet()
+			: pControl(nullptr)
+			, pSlots(nullptr)
+			, Capacity(0)
+			, NumElements(0)
+			, GrowthLeft(0)
+		{
+		}
+
+		/** Copy constructor. */
+		FlatSet(const FlatSet& Copy)
+			: FlatSet()
+		{
+			*this = Copy;
+		}
+
+		/** Move constructor. */
+		FlatSet(FlatSet&& Other)
+			: FlatSet()
+		{
+			*this = Move(Other);
+		}
+
+		/** Initializer list constructor. */
+		FlatSet(std::initializer_list<ElementType> InitList)
+			: FlatSet()
+		{
+			Append(InitList);
+		}
+
+		/** Destructor. */
+		~FlatSet()
+		{
+			Reset();
+		}
+
+		/** Assignment operator. */
+		FlatSet& operator=(const FlatSet& Copy)
+		{
+			if (this != &Copy)
+			{
+				Reset();
+				if (Copy.NumElements > 0)
+				{
+					// Same capacity and hashes, so every element goes back in the same slot
+					Allocate(Copy.Capacity);
+					Memory::Memcpy(pControl, Copy.pControl, Capacity + FlatSet_Private::GroupSize);
+					for (int32 Index = 0; Index < Capacity; Index++)
+					{
+						if (pControl[Index] >= 0)
+						{
+							new(pSlots + Index) ElementType(Copy.pSlots[Index]);
+						}
+					}
+					NumElements = Copy.NumElements;
+					GrowthLeft = Copy.GrowthLeft;
+				}
+			}
+			return *this;
+		}
+
+		/** Move assignment operator. */
+		FlatSet& operator=(FlatSet&& Other)
+		{
+			if (this != &Other)
+			{
+				Reset();
+				pControl = Other.pControl;
+				pSlots = Other.pSlots;
+				Capacity = Other.Capacity;
+				NumElements = Other.NumElements;
+				GrowthLeft = Other.GrowthLeft;
+
+				Other.pControl = nullptr;
+				Other.pSlots = nullptr;
+				Other.Capacity = 0;
+				Other.NumElements = 0;
+				Other.GrowthLeft = 0;
+			}
+			return *this;
+		}
+
+		/**
+		* Removes all elements from the set, keeping the table allocated if it can hold the expected
+		* number of elements.
+		* @param ExpectedNumElements - The number of elements about to be added to the set.
+		*/
+		void Clear(int32 ExpectedNumElements = 0)
+		{
+			if (ExpectedNumElements > GetMaxLoad(Capacity))
+			{
+				Reset();
+				Reserve(ExpectedNumElements);
+				return;
+			}
+
+			DestructElements();
+			if (Capacity > 0)
+			{
+				Memory::Memset(pControl, uint8(FlatSet_Private::ControlEmpty), Capacity + FlatSet_Private::GroupSize);
+			}
+			NumElements = 0;
+			GrowthLeft = GetMaxLoad(Capacity);
+		}
+
+		/** Removes all elements from the set and frees the table. */
+		void Reset()
+		{
+			DestructElements();
+			Memory::SafeFree(pControl);
+			pSlots = nullptr;
+			Capacity = 0;
+			NumElements = 0;
+			GrowthLeft = 0;
+		}
+
+		/** Preallocates enough memory to contain Number elements. */
+		void Reserve(int32 Number)
+		{
+			if (Number > NumElements + GrowthLeft)
+			{
+				int32 NewCapacity = FlatSet_Private::GroupSize;
+				while (GetMaxLoad(NewCapacity) < Number)
+				{
+					NewCapacity *= 2;
+				}
+				Rehash(NewCapacity);
+			}
+		}
+
+		/** @return the number of elements. */
+		__forceinline int32 Size() const
+		{
+			return NumElements;
+		}
+
+		/** @return the number of slots of the table. */
+		__forceinline int32 GetCapacity() const
+		{
+			return Capacity;
+		}
+
+		/** @return the amount of memory allocated by this container, only includes memory allocated by the container itself. */
+		__forceinline uint32 GetAllocatedSize() const
+		{
+			return Capacity > 0 ? GetControlBytes(Capacity) + Capacity * sizeof(ElementType) : 0;
+		}
+
+		/**
+		* Adds an element to the set, replacing the element with the same key if any.
+		*
+		* @param	InElement					Element to add to set
+		* @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+		* @return	A reference to the element stored in the set, valid until the next addition.
+		*/
+		__forceinline ElementType& Add(const ElementType&  InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(InElement, bIsAlreadyInSetPtr); }
+		__forceinline ElementType& Add(ElementType&& InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(Move(InElement), bIsAlreadyInSetPtr); }
+
+		/**
+		* Adds an element to the set, replacing the element with the same key if any.
+		*
+		* @param	Args						The argument(s) to be forwarded to the set element's constructor.
+		* @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+		* @return	A reference to the element stored in the set, valid until the next addition.
+		*/
+		template <typename ArgsType>
+		ElementType& Emplace(ArgsType&& Args, bool* bIsAlreadyInSetPtr = nullptr)
+		{
+			// The key can only be extracted from a constructed element, build it aside and relocate it in its slot
+			TypeCompatibleBytes<ElementType> Staging;
+			ElementType& NewElement = *new(&Staging) ElementType(Forward<ArgsType>(Args));
+
+			const uint64 MixedHash = FlatSet_Private::MixHash(KeyFuncs::GetKeyHash(KeyFuncs::GetSetKey(NewElement)));
+			int32 Index = FindIndex(KeyFuncs::GetSetKey(NewElement), MixedHash);
+
+			const bool bIsAlreadyInSet = Index != INDEX_NONE;
+			if (bIsAlreadyInSet)
+			{
+				MoveByRelocate(pSlots[Index], NewElement);
+			}
+			else
+			{
+				Index = PrepareInsert(MixedHash);
+				RelocateConstructItems<ElementType>(pSlots + Index, &NewElement, 1);
+			}
+
+			if (bIsAlreadyInSetPtr)
+			{
+				*bIsAlreadyInSetPtr = bIsAlreadyInSet;
+			}
+
+			return pSlots[Index];
+		}
+
+		template<typename ArrayAllocator>
+		void Append(const Array<ElementType, ArrayAllocator>& InElements)
+		{
+			Reserve(NumElements + InElements.Size());
+			for (auto& Element : InElements)
+			{
+				Add(Element);
+			}
+		}
+
+		void Append(std::initializer_list<ElementType> InitList)
+		{
+			Reserve(NumElements + (int32)InitList.size());
+			for (const ElementType& Element : InitList)
+			{
+				Add(Element);
+			}
+		}
+
+		/**
+		* Finds an element with the given key in the set.
+		* @param Key - The key to search for.
+		* @return A pointer to an element with the given key.  If no element in the set has the given key, this will return nullptr.
+		*/
+		__forceinline ElementType* Find(KeyInitType Key)
+		{
+			const int32 Index = FindIndex(Key, FlatSet_Private::MixHash(KeyFuncs::GetKeyHash(Key)));
+			return Index != INDEX_NONE ? pSlots + Index : nullptr;
+		}
+
+		__forceinline const ElementType* Find(KeyInitType Key) const
+		{
+			return const_cast<FlatSet*>(this)->Find(Key);
+		}
+
+		/**
+		* Checks if the set contains an element with the given key.
+		* @param Key - The key to check for.
+		* @return true if the set contains an element with the given key.
+		*/
+		__forceinline bool Contains(KeyInitType Key) const
+		{
+			return FindIndex(Key, FlatSet_Private::MixHash(KeyFuncs::GetKeyHash(Key))) != INDEX_NONE;
+		}
+
+		/**
+		* Removes the element matching the specified key.
+		* @param Key - The key to match elements against.
+		* @return The number of elements removed.
+		*/
+		int32 Remove(KeyInitType Key)
+		{
+			const int32 Index = FindIndex(Key, FlatSet_Private::MixHash(KeyFuncs::GetKeyHash(Key)));
+			if (Index == INDEX_NONE)
+			{
+				return 0;
+			}
+
+			RemoveAt(Index);
+			return 1;
+		}
+
+	private:
+		static __forceinline int32 GetMaxLoad(int32 InCapacity)
+		{
+			// Keep the table at most 7/8 full
+			return InCapacity - InCapacity / 8;
+		}
+
+		static __forceinline uint32 GetControlBytes(int32 InCapacity)
+		{
+			const uint32 Alignment = ALIGNOF(ElementType) > 16 ? ALIGNOF(ElementType) : 16;
+			return (InCapacity + FlatSet_Private::GroupSize + Alignment - 1) & ~(Alignment - 1);
+		}
+
+		/** Allocates an empty table, the previous one must have been released. */
+		void Allocate(int32 NewCapacity)
+		{
+			const uint32 Alignment = ALIGNOF(ElementType) > 16 ? ALIGNOF(ElementType) : 16;
+			const uint32 ControlBytes = GetControlBytes(NewCapacity);
+
+			pControl = (int8*)Memory::AlignedAlloc(ControlBytes + NewCapacity * sizeof(ElementType), Alignment);
+			pSlots = (ElementType*)((_byte*)pControl + ControlBytes);
+			Memory::Memset(pControl, uint8(FlatSet_Private::ControlEmpty), NewCapacity + FlatSet_Private::GroupSize);
+
+			Capacity = NewCapacity;
+			GrowthLeft = GetMaxLoad(NewCapacity);
+		}
+
+		void DestructElements()
+		{
+			if (TypeTraits<ElementType>::NeedsDestructor)
+			{
+				for (int32 Index = 0; Index < Capacity; Index++)
+				{
+					if (pControl[Index] >= 0)
+					{
+						DestructItems(pSlots + Index, 1);
+					}
+				}
+			}
+		}
+
+		__forceinline void SetControl(int32 Index, int8 Value)
+		{
+			pControl[Index] = Value;
+
+			// Mirror the first group after the end
+			if (Index < FlatSet_Private::GroupSize)
+			{
+				pControl[Capacity + Index] = Value;
+			}
+		}
+
+		/** @return The slot holding the key, INDEX_NONE if there is none */
+		__forceinline int32 FindIndex(KeyInitType Key, uint64 MixedHash) const
+		{
+			if (NumElements == 0)
+			{
+				return INDEX_NONE;
+			}
+
+			const int8 H2 = FlatSet_Private::GetH2(MixedHash);
+			const uint32 Mask = Capacity - 1;
+			uint32 Position = uint32(MixedHash >> 32) & Mask;
+
+			// Triangular probing over groups visits every group once when the capacity is a power of two
+			for (uint32 Step = FlatSet_Private::GroupSize;; Step += FlatSet_Private::GroupSize)
+			{
+				const FlatSet_Private::Group Group(pControl + Position);
+				for (uint32 Matches = Group.Match(H2); Matches != 0; Matches &= Matches - 1)
+				{
+					const int32 Index = (Position + Math::CountTrailingZeros(Matches)) & Mask;
+					if (KeyFuncs::Matches(KeyFuncs::GetSetKey(pSlots[Index]), Key))
+					{
+						return Index;
+					}
+				}
+
+				// An empty slot ends the probe sequence of every key which could be here
+				if (Group.MatchEmpty() != 0)
+				{
+					return INDEX_NONE;
+				}
+
+				Position = (Position + Step) & Mask;
+			}
+		}
+
+		/** @return The first free slot of the probe sequence of a hash */
+		__forceinline int32 FindFreeSlot(uint64 MixedHash) const
+		{
+			const uint32 Mask = Capacity - 1;
+			uint32 Position = uint32(MixedHash >> 32) & Mask;
+
+			for (uint32 Step = FlatSet_Private::GroupSize;; Step += FlatSet_Private::GroupSize)
+			{
+				const uint32 Free = FlatSet_Private::Group(pControl + Position).MatchFree();
+				if (Free != 0)
+				{
+					return (Position + Math::CountTrailingZeros(Free)) & Mask;
+				}
+
+				Position = (Position + Step) & Mask;
+			}
+		}
+
+		/** Claims a slot for a new element with the given hash, growing the table if needed. */
+		int32 PrepareInsert(uint64 MixedHash)
+		{
+			int32 Index = Capacity > 0 ? FindFreeSlot(MixedHash) : INDEX_NONE;
+
+			// Reusing a deleted slot doesn't lengthen any probe sequence
+			if (Index == INDEX_NONE || (GrowthLeft == 0 && pControl[Index] != FlatSet_Private::ControlDeleted))
+			{
+				// Drop the deleted slots in place when they make up most of the load, otherwise grow
+				Rehash(Capacity > 0 && NumElements <= GetMaxLoad(Capacity) / 2 ? Capacity : Math::Max(Capacity * 2, int32(FlatSet_Private::GroupSize)));
+				Index = FindFreeSlot(MixedHash);
+			}
+
+			if (pControl[Index] == FlatSet_Private::ControlEmpty)
+			{
+				GrowthLeft--;
+			}
+			SetControl(Index, FlatSet_Private::GetH2(MixedHash));
+			NumElements++;
+
+			return Index;
+		}
+
+		void RemoveAt(int32 Index)
+		{
+			DestructItems(pSlots + Index, 1);
+			NumElements--;
+
+			// The slot can go back to empty if no probe sequence ever went past it while the group
+			// holding it was full, i.e. if there are empty slots close enough on both sides
+			const uint32 Mask = Capacity - 1;
+			const uint32 EmptyBefore = FlatSet_Private::Group(pControl + ((Index - FlatSet_Private::GroupSize) & Mask)).MatchEmpty();
+			const uint32 EmptyAfter = FlatSet_Private::Group(pControl + Index).MatchEmpty();
+			const bool bWasNeverFull = EmptyBefore != 0 && EmptyAfter != 0 &&
+				(Math::CountLeadingZeros(EmptyBefore) - 16) + Math::CountTrailingZeros(EmptyAfter) < FlatSet_Private::GroupSize;
+
+			if (bWasNeverFull)
+			{
+				SetControl(Index, FlatSet_Private::ControlEmpty);
+				GrowthLeft++;
+			}
+			else
+			{
+				SetControl(Index, FlatSet_Private::ControlDeleted);
+			}
+		}
+
+		/** Moves the elements into a new table, dropping the deleted slots. */
+		void Rehash(int32 NewCapacity)
+		{
+			int8* pOldControl = pControl;
+			ElementType* pOldSlots = pSlots;
+			const int32 OldCapacity = Capacity;
+
+			Allocate(NewCapacity);
+			for (int32 Index = 0; Index < OldCapacity; Index++)
+			{
+				if (pOldControl[Index] >= 0)
+				{
+					const uint64 MixedHash = FlatSet_Private::MixHash(KeyFuncs::GetKeyHash(KeyFuncs::GetSetKey(pOldSlots[Index])));
+					const int32 NewIndex = FindFreeSlot(MixedHash);
+					SetControl(NewIndex, FlatSet_Private::GetH2(MixedHash));
+					RelocateConstructItems<ElementType>(pSlots + NewIndex, pOldSlots + Index, 1);
+				}
+			}
+			GrowthLeft -= NumElements;
+
+			Memory::SafeFree(pOldControl);
+		}
+
+		/** The base type of whole set iterators. */
+		template<bool bConst>
+		class BaseIterator
+		{
+		protected:
+			typedef typename ChooseClass<bConst, const FlatSet, FlatSet>::Result SetType;
+			typedef typename ChooseClass<bConst, const ElementType, ElementType>::Result ItElementType;
+
+		public:
+			__forceinline BaseIterator(SetType& InSet, int32 InIndex)
+				: mSet(InSet)
+				, Index(InIndex)
+			{
+				SkipFreeSlots();
+			}
+
+			/** Advances the iterator to the next element. */
+			__forceinline BaseIterator& operator++()
+			{
+				++Index;
+				SkipFreeSlots();
+				return *this;
+			}
+
+			/** conversion to "bool" returning true if the iterator is valid. */
+			__forceinline explicit operator bool() const
+			{
+				return Index < mSet.Capacity;
+			}
+			/** inverse of the "bool" operator */
+			__forceinline bool operator !() const
+			{
+				return !(bool)*this;
+			}
+
+			// Accessors.
+			__forceinline ItElementType* operator->() const
+			{
+				return mSet.pSlots + Index;
+			}
+			__forceinline ItElementType& operator*() const
+			{
+				return mSet.pSlots[Index];
+			}
+
+			__forceinline friend bool operator==(const BaseIterator& Lhs, const BaseIterator& Rhs) { return Lhs.Index == Rhs.Index; }
+			__forceinline friend bool operator!=(const BaseIterator& Lhs, const BaseIterator& Rhs) { return Lhs.Index != Rhs.Index; }
+
+		protected:
+			SetType& mSet;
+			int32 Index;
+
+		private:
+			__forceinline void SkipFreeSlots()
+			{
+				while (Index < mSet.Capacity && mSet.pControl[Index] < 0)
+				{
+					++Index;
+				}
+			}
+		};
+
+	public:
+		/** Used to iterate over the elements of a const FlatSet, in no particular order. */
+		class ConstIterator : public BaseIterator<true>
+		{
+		public:
+			__forceinline ConstIterator(const FlatSet& InSet, int32 InIndex = 0)
+				: BaseIterator<true>(InSet, InIndex)
+			{
+			}
+		};
+
+		/** Used to iterate over the elements of a FlatSet, in no particular order. */
+		class Iterator : public BaseIterator<false>
+		{
+		public:
+			__forceinline Iterator(FlatSet& InSet, int32 InIndex = 0)
+				: BaseIterator<false>(InSet, InIndex)
+			{
+			}
+
+			/** Removes the current element from the set, the iteration goes on with the next one. */
+			__forceinline void RemoveCurrent()
+			{
+				this->mSet.RemoveAt(this->Index);
+			}
+		};
+
+		/** Creates an iterator for the contents of this set */
+		__forceinline Iterator CreateIterator()
+		{
+			return Iterator(*this);
+		}
+
+		/** Creates a const iterator for the contents of this set */
+		__forceinline ConstIterator CreateConstIterator() const
+		{
+			return ConstIterator(*this);
+		}
+
+	private:
+		/**
+		* DO NOT USE DIRECTLY
+		* STL-like iterators to enable range-based for loop support.
+		*/
+		__forceinline friend Iterator      begin(FlatSet& set) { return Iterator(set); }
+		__forceinline friend ConstIterator begin(const FlatSet& set) { return ConstIterator(set); }
+		__forceinline friend Iterator      end(FlatSet& set) { return Iterator(set, set.Capacity); }
+		__forceinline friend ConstIterator end(const FlatSet& set) { return ConstIterator(set, set.Capacity); }
+	};
+}
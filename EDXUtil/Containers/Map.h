@@ -116,7 +116,7 @@ namespace EDX
 		}
 		static __forceinline uint32 GetKeyHash(KeyInitType Key)
 		{
-			return GetTypeHash(Key);
+			return GetKeyTypeHash(Key);
 		}
 	};
 
@@ -266,6 +266,30 @@ namespace EDX
 			return Pairs.Size();
 		}
 
+		/**
+		* Adds a batch of key-value pairs, with the same result as adding them one at a time. See Set::BulkAdd.
+		*
+		* @param pPairs - The pairs to add.
+		* @param NumPairs - The number of pairs to add.
+		* @param bParallel - true to hash and link the pairs on the global thread pool, for tens of thousands of pairs.
+		*/
+		__forceinline void BulkAdd(const PairType* pPairs, int32 NumPairs, bool bParallel = false)
+		{
+			Pairs.BulkAdd(pPairs, NumPairs, bParallel);
+		}
+
+		template<typename ArrayAllocator>
+		__forceinline void BulkAdd(const Array<PairType, ArrayAllocator>& InPairs, bool bParallel = false)
+		{
+			Pairs.BulkAdd(InPairs, bParallel);
+		}
+
+		template<typename ArrayAllocator>
+		__forceinline void BulkAdd(Array<PairType, ArrayAllocator>&& InPairs, bool bParallel = false)
+		{
+			Pairs.BulkAdd(Move(InPairs), bParallel);
+		}
+
 		/**
 		* Returns the unique keys contained within this map
 		* @param	OutKeys	- Upon return, contains the set of unique keys in this map.
@@ -882,6 +906,21 @@ namespace EDX
 		{
 		}
 
+		/**
+		* Constructor building the map from an array of key-value pairs in one batch, see BulkAdd. When keys repeat, the last value wins.
+		*/
+		template<typename ArrayAllocator>
+		explicit Map(const Array<Pair<KeyType, ValueType>, ArrayAllocator>& InPairs, bool bParallel = false)
+		{
+			this->BulkAdd(InPairs, bParallel);
+		}
+
+		template<typename ArrayAllocator>
+		explicit Map(Array<Pair<KeyType, ValueType>, ArrayAllocator>&& InPairs, bool bParallel = false)
+		{
+			this->BulkAdd(Move(InPairs), bParallel);
+		}
+
 		/** Constructor for copying elements from a Map with a different SetAllocator */
 		template<typename OtherSetAllocator>
 		Map(const Map<KeyType, ValueType, OtherSetAllocator, KeyFuncs>& Other)
@@ -0,0 +1,169 @@
+#include "Name.h"
+#include "ConcurrentMap.h"
+
+namespace EDX
+{
+	namespace
+	{
+		/**
+		* The characters of every name. Lookups by characters go through a ConcurrentMap and lookups by index through
+		* blocks of entries which never move, neither takes a lock nor allocates. Adds are serialized by a single lock:
+		* they are rare, and it lets the map keys view the table's own copy of the characters instead of the caller's.
+		*/
+		class NameTable
+		{
+		private:
+			enum
+			{
+				EntriesPerBlock = 1 << 14,
+				MaxEntryBlocks = 1 << 13,
+
+				/** Characters are copied into blocks of this size, longer names get their own allocation. */
+				CharsPerBlock = 1 << 15,
+				MaxPooledChars = CharsPerBlock / 8,
+			};
+
+			ConcurrentMap<StringView, int32> mIndices;
+
+			StringView* volatile mEntryBlocks[MaxEntryBlocks];
+			volatile int32 mNumEntries;
+
+			TCHAR* mpFreeChars;
+			int32 mNumFreeChars;
+
+			CriticalSection mAddLock;
+
+		public:
+			NameTable()
+				: mNumEntries(0)
+				, mpFreeChars(nullptr)
+				, mNumFreeChars(0)
+			{
+				Memory::Memzero((void*)mEntryBlocks, sizeof(mEntryBlocks));
+
+				// Index 0 is None
+				Add(StringView());
+			}
+
+			__forceinline int32 Find(const StringView& Chars) const
+			{
+				const int32* pIndex = mIndices.Find(Chars);
+				return pIndex ? *pIndex : INDEX_NONE;
+			}
+
+			int32 FindOrAdd(const StringView& Chars)
+			{
+				if (const int32* pIndex = mIndices.Find(Chars))
+				{
+					return *pIndex;
+				}
+
+				ScopeLock Lock(&mAddLock);
+
+				// Another thread may have added it while this one was waiting for the lock
+				if (const int32* pIndex = mIndices.Find(Chars))
+				{
+					return *pIndex;
+				}
+
+				return Add(Chars);
+			}
+
+			__forceinline const StringView& GetEntry(int32 Index) const
+			{
+				Assertf(Index >= 0 && Index < mNumEntries, EDX_TEXT("Invalid name index %i, the table holds %i names"), Index, mNumEntries);
+				return mEntryBlocks[Index / EntriesPerBlock][Index % EntriesPerBlock];
+			}
+
+			__forceinline int32 Size() const
+			{
+				return mNumEntries;
+			}
+
+		private:
+			/** Adds a name known to be missing, called under the add lock. */
+			int32 Add(const StringView& Chars)
+			{
+				const int32 Index = mNumEntries;
+				const int32 BlockIndex = Index / EntriesPerBlock;
+				Assertf(BlockIndex < MaxEntryBlocks, EDX_TEXT("The name table is full"));
+
+				if (!mEntryBlocks[BlockIndex])
+				{
+					mEntryBlocks[BlockIndex] = Memory::AlignedAlloc<StringView>(EntriesPerBlock, 64, MemoryTag_Strings);
+				}
+
+				const StringView Stored = CopyChars(Chars);
+				mEntryBlocks[BlockIndex][Index % EntriesPerBlock] = Stored;
+				mNumEntries = Index + 1;
+
+				// Published last, a thread finding the index in the map also sees the entry
+				mIndices.TryAdd(Stored, Index);
+				return Index;
+			}
+
+			/** @return A null terminated copy of the characters, which is never freed. */
+			StringView CopyChars(const StringView& Chars)
+			{
+				const int32 NumChars = Chars.Len() + 1;
+
+				TCHAR* pCopy;
+				if (NumChars > MaxPooledChars)
+				{
+					pCopy = Memory::AlignedAlloc<TCHAR>(NumChars, DEFAULT_ALIGNMENT, MemoryTag_Strings);
+				}
+				else
+				{
+					if (NumChars > mNumFreeChars)
+					{
+						mpFreeChars = Memory::AlignedAlloc<TCHAR>(CharsPerBlock, 64, MemoryTag_Strings);
+						mNumFreeChars = CharsPerBlock;
+					}
+
+					pCopy = mpFreeChars;
+					mpFreeChars += NumChars;
+					mNumFreeChars -= NumChars;
+				}
+
+				Memory::Memcpy(pCopy, Chars.Data(), Chars.Len() * sizeof(TCHAR));
+				pCopy[Chars.Len()] = 0;
+
+				return StringView(pCopy, Chars.Len());
+			}
+		};
+
+		/** Never destroyed, names can still be used by destructors of other static objects. */
+		NameTable& GetNameTable()
+		{
+			static NameTable* pTable = new NameTable;
+			return *pTable;
+		}
+	}
+
+	Name::Name(const StringView& Chars)
+		: mIndex(GetNameTable().FindOrAdd(Chars))
+	{
+	}
+
+	Name Name::Find(const StringView& Chars)
+	{
+		Name Result;
+		const int32 Index = GetNameTable().Find(Chars);
+		if (Index != INDEX_NONE)
+		{
+			Result.mIndex = Index;
+		}
+
+		return Result;
+	}
+
+	int32 Name::GetNumNames()
+	{
+		return GetNameTable().Size();
+	}
+
+	StringView Name::ToView() const
+	{
+		return GetNameTable().GetEntry(mIndex);
+	}
+}
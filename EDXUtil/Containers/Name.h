@@ -0,0 +1,114 @@
+#pragma once
+
+#include "StringView.h"
+#include "StringFormat.h"
+
+namespace EDX
+{
+	/**
+	* An interned string. The characters are stored once in a global table and a Name only holds their index,
+	* so copying, comparing and hashing a Name costs as much as for an int32. Use it as the key of maps looked
+	* up often, like material parameters, where String keys are hashed and compared character by character
+	* on every lookup.
+	*
+	* Like String, names ignore case: Name(EDX_TEXT("Diffuse")) == Name(EDX_TEXT("DIFFUSE")), and both return
+	* the characters the name was first created with. Names are never removed from the table.
+	*
+	* Every function is thread safe. Creating a Name from characters already in the table, Find and getting the
+	* characters of a Name are lock free and never allocate. Only the first creation of a name takes locks and
+	* allocates, to copy its characters and link them into the table.
+	*/
+	class Name
+	{
+	private:
+		/** Index of the characters in the name table, 0 for None. */
+		int32 mIndex;
+
+	public:
+		/** The empty name, None. */
+		__forceinline Name()
+			: mIndex(0)
+		{
+		}
+
+		/** Finds the name with these characters, adding it to the table if it isn't there yet. */
+		explicit Name(const StringView& Chars);
+
+		explicit Name(const TCHAR* pChars)
+			: Name(StringView(pChars))
+		{
+		}
+
+		explicit Name(const String& Str)
+			: Name(StringView(Str))
+		{
+		}
+
+		/**
+		* Finds the name with these characters without ever adding it, for lookups of untrusted input.
+		* @return The name, or None if no name with these characters was created
+		*/
+		static Name Find(const StringView& Chars);
+
+		/** @return The number of names in the table, None included. */
+		static int32 GetNumNames();
+
+		/** @return Index of the name in the table, unique per name. */
+		__forceinline int32 GetIndex() const
+		{
+			return mIndex;
+		}
+
+		__forceinline bool IsNone() const
+		{
+			return mIndex == 0;
+		}
+
+		/** @return The characters of the name, null terminated and valid until the program exits. */
+		StringView ToView() const;
+
+		__forceinline const TCHAR* operator*() const
+		{
+			return ToView().Data();
+		}
+
+		__forceinline String ToString() const
+		{
+			return ToView().ToString();
+		}
+
+		__forceinline friend bool operator==(const Name& Lhs, const Name& Rhs)
+		{
+			return Lhs.mIndex == Rhs.mIndex;
+		}
+
+		__forceinline friend bool operator!=(const Name& Lhs, const Name& Rhs)
+		{
+			return Lhs.mIndex != Rhs.mIndex;
+		}
+
+		/**
+		* Compares the characters of two names, ignoring case. Slower than comparing names, use it to sort by text.
+		* @return 0 if equal, negative if this name sorts first, positive otherwise
+		*/
+		__forceinline int32 Compare(const Name& Other) const
+		{
+			return mIndex == Other.mIndex ? 0 : ToView().Compare(Other.ToView());
+		}
+	};
+
+	template<> struct IsPODType<Name> { enum { Value = true }; };
+
+	/** The index is unique per name, a perfect hash which costs nothing to compute. */
+	__forceinline uint32 GetTypeHash(const Name& InName)
+	{
+		return uint32(InName.GetIndex());
+	}
+
+	/** Writes the characters of a name with StringFormat. */
+	__forceinline void FormatValue(FormatOutput& Out, const Name& InName, const FormatSpec& Spec)
+	{
+		const StringView Chars = InName.ToView();
+		Out.WritePadded(Chars.Data(), Chars.Len(), Spec, false);
+	}
+}
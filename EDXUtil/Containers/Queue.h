@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Windows/Atomics.h"
+#include "../Core/Memory.h"
 
 namespace EDX
 {
@@ -17,6 +18,228 @@ namespace EDX
 	};
 
 
+	/**
+	* Queue node allocation policy that allocates every node from the heap.
+	*/
+	class HeapQueueNodeAllocator
+	{
+	public:
+		template<typename NodeType>
+		class ForNodeType
+		{
+		public:
+			/** Allocates uninitialized memory for one node. */
+			__forceinline void* Allocate()
+			{
+				return ::operator new(sizeof(NodeType));
+			}
+
+			/** Frees the memory of a destructed node. */
+			__forceinline void Free(void* Ptr)
+			{
+				::operator delete(Ptr);
+			}
+
+			/** Nodes are not cached, nothing to reserve. */
+			__forceinline void Reserve(int32 NumNodes)
+			{
+			}
+		};
+	};
+
+
+	/**
+	* Queue node allocation policy that recycles nodes through a lock-free free list.
+	*
+	* Nodes are allocated in blocks of NodesPerBlock and never released before the queue is
+	* destroyed, so once enough nodes have been reserved enqueuing and dequeuing don't touch the
+	* heap. The free list head packs an ABA tag next to the pointer so that it can be popped by
+	* multiple producers with a 64-bit compare-and-swap.
+	*
+	* @param NodesPerBlock Number of nodes allocated at once when the free list runs dry.
+	*/
+	template<uint32 NodesPerBlock = 64>
+	class RecyclingQueueNodeAllocator
+	{
+	public:
+		template<typename NodeType>
+		class ForNodeType
+		{
+		private:
+			/** Overlay of a node sitting in the free list. */
+			struct FreeNode
+			{
+				FreeNode* volatile Next;
+			};
+
+			/** Header in front of each block of nodes. */
+			struct __declspec(align(16)) BlockHeader
+			{
+				BlockHeader* volatile Next;
+			};
+
+			enum
+			{
+				NodeSize = ((sizeof(NodeType) > sizeof(FreeNode) ? sizeof(NodeType) : sizeof(FreeNode)) + 15) & ~15,
+				PointerBits = sizeof(void*) == 8 ? 48 : 32,
+			};
+
+			/** Keeps FreeHead off the cache lines of the queue, padded since queues are embedded in heap allocated objects. */
+			uint8 PadBeforeFreeHead[PLATFORM_CACHE_LINE_SIZE];
+
+			/** Head of the free list, pointer in the low bits and ABA tag in the high bits. */
+			volatile int64 FreeHead;
+
+			/** Blocks allocated so far, only pushed to until destruction. */
+			BlockHeader* volatile Blocks;
+
+			/** The tag wraps around, only its low bits are kept, shifted as unsigned so the top bit can't overflow. */
+			static __forceinline int64 Pack(FreeNode* Ptr, int64 Tag)
+			{
+				return int64(uint64(UPTRINT(Ptr)) | (uint64(Tag) << PointerBits));
+			}
+
+			static __forceinline FreeNode* UnpackPointer(int64 Value)
+			{
+				return (FreeNode*)UPTRINT(Value & ((int64(1) << PointerBits) - 1));
+			}
+
+			static __forceinline int64 UnpackTag(int64 Value)
+			{
+				return uint64(Value) >> PointerBits;
+			}
+
+			/** Pushes a chain of nodes linked through FreeNode::Next to the free list. */
+			void PushChain(FreeNode* First, FreeNode* Last)
+			{
+				int64 Old = FreeHead;
+				for (;;)
+				{
+					Last->Next = UnpackPointer(Old);
+					const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&FreeHead, Pack(First, UnpackTag(Old) + 1), Old);
+					if (Prev == Old)
+					{
+						return;
+					}
+					Old = Prev;
+				}
+			}
+
+			/** Pops a node from the free list, nullptr if it is empty. */
+			FreeNode* Pop()
+			{
+				int64 Old = FreeHead;
+				for (;;)
+				{
+					FreeNode* Ptr = UnpackPointer(Old);
+					if (Ptr == nullptr)
+					{
+						return nullptr;
+					}
+
+					// Nodes are never released while the allocator lives, reading Next is safe even if Ptr was popped meanwhile
+					const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&FreeHead, Pack(Ptr->Next, UnpackTag(Old) + 1), Old);
+					if (Prev == Old)
+					{
+						return Ptr;
+					}
+					Old = Prev;
+				}
+			}
+
+			/**
+			* Allocates a block of nodes and links them together.
+			*
+			* @param OutFirst Will hold the first node of the block
+			* @param OutLast Will hold the last node of the block
+			*/
+			void AllocateBlock(FreeNode*& OutFirst, FreeNode*& OutLast)
+			{
+				BlockHeader* Block = (BlockHeader*)Memory::AlignedAlloc(sizeof(BlockHeader) + NodesPerBlock * NodeSize, 64);
+
+				// Blocks are only freed on destruction, pushing needs no ABA protection
+				BlockHeader* OldBlocks;
+				do
+				{
+					OldBlocks = Blocks;
+					Block->Next = OldBlocks;
+				} while (PlatformAtomics::InterlockedCompareExchangePointer((void**)&Blocks, Block, OldBlocks) != OldBlocks);
+
+				uint8* Nodes = (uint8*)(Block + 1);
+				for (uint32 i = 0; i < NodesPerBlock - 1; i++)
+				{
+					((FreeNode*)(Nodes + i * NodeSize))->Next = (FreeNode*)(Nodes + (i + 1) * NodeSize);
+				}
+
+				OutFirst = (FreeNode*)Nodes;
+				OutLast = (FreeNode*)(Nodes + (NodesPerBlock - 1) * NodeSize);
+				OutLast->Next = nullptr;
+			}
+
+		public:
+			ForNodeType()
+				: FreeHead(0)
+				, Blocks(nullptr)
+			{
+				static_assert(NodesPerBlock > 1, "A block needs at least two nodes.");
+			}
+
+			ForNodeType(const ForNodeType&) = delete;
+			ForNodeType& operator=(const ForNodeType&) = delete;
+
+			~ForNodeType()
+			{
+				while (Blocks)
+				{
+					BlockHeader* Next = Blocks->Next;
+					Memory::Free(Blocks);
+					Blocks = Next;
+				}
+			}
+
+			/** Allocates uninitialized memory for one node, from the free list if possible. */
+			void* Allocate()
+			{
+				FreeNode* Ptr = Pop();
+				if (Ptr == nullptr)
+				{
+					// Keep the first node of a fresh block and hand the others to the free list
+					FreeNode* Last;
+					AllocateBlock(Ptr, Last);
+					if (Ptr != Last)
+					{
+						PushChain(Ptr->Next, Last);
+					}
+				}
+
+				return Ptr;
+			}
+
+			/** Returns the memory of a destructed node to the free list. */
+			void Free(void* Ptr)
+			{
+				PushChain((FreeNode*)Ptr, (FreeNode*)Ptr);
+			}
+
+			/**
+			* Preallocates nodes so that steady-state traffic doesn't hit the heap.
+			*
+			* @param NumNodes Minimum number of nodes to add to the free list
+			*/
+			void Reserve(int32 NumNodes)
+			{
+				for (int32 i = 0; i < NumNodes; i += NodesPerBlock)
+				{
+					FreeNode* First;
+					FreeNode* Last;
+					AllocateBlock(First, Last);
+					PushChain(First, Last);
+				}
+			}
+		};
+	};
+
+
 	/**
 	* Template for queues.
 	*
@@ -30,9 +253,9 @@ namespace EDX
 	*
 	* @param ItemType The type of items stored in the queue.
 	* @param Mode The queue mode (single-producer, single-consumer by default).
-	* @todo gmp: Implement node pooling.
+	* @param NodeAllocator The policy used to allocate the list nodes, see RecyclingQueueNodeAllocator.
 	*/
-	template<typename ItemType, EQueueMode Mode = EQueueMode::Spsc>
+	template<typename ItemType, EQueueMode Mode = EQueueMode::Spsc, typename NodeAllocator = HeapQueueNodeAllocator>
 	class Queue
 	{
 	private:
@@ -63,12 +286,22 @@ namespace EDX
 		/** Holds a pointer to the tail of the list. */
 		Node* Tail;
 
+		/** Allocates and recycles the list nodes. */
+		typename NodeAllocator::template ForNodeType<Node> Allocator;
+
+		/** Destructs a node and hands its memory back to the allocator. */
+		__forceinline void DeleteNode(Node* InNode)
+		{
+			InNode->~Node();
+			Allocator.Free(InNode);
+		}
+
 	public:
 
 		/** Default constructor. */
 		Queue()
 		{
-			Head = Tail = new Node();
+			Head = Tail = new(Allocator.Allocate()) Node();
 		}
 
 		// Non-copyable
@@ -83,7 +316,7 @@ namespace EDX
 				Node* Node = Tail;
 				Tail = Tail->NextNode;
 
-				delete Node;
+				DeleteNode(Node);
 			}
 		}
 
@@ -98,7 +331,7 @@ namespace EDX
 		*/
 		bool Dequeue(ItemType& OutItem)
 		{
-			Node* Popped = Tail->NextNode;
+			Node* Popped = PlatformAtomics::LoadAcquire(&Tail->NextNode);
 
 			if (Popped == nullptr)
 			{
@@ -110,11 +343,21 @@ namespace EDX
 			Node* OldTail = Tail;
 			Tail = Popped;
 			Tail->Item = ItemType();
-			delete OldTail;
+			DeleteNode(OldTail);
 
 			return true;
 		}
 
+		/**
+		* Preallocates list nodes. Only has an effect with a recycling node allocator.
+		*
+		* @param NumNodes Minimum number of nodes to preallocate.
+		*/
+		void ReserveNodes(int32 NumNodes)
+		{
+			Allocator.Reserve(NumNodes);
+		}
+
 		/** Empty the queue, discarding all items. */
 		void Clear()
 		{
@@ -131,18 +374,20 @@ namespace EDX
 		*/
 		bool Enqueue(const ItemType& Item)
 		{
-			Node* NewNode = new Node(Item);
+			void* NodeMemory = Allocator.Allocate();
 
-			if (NewNode == nullptr)
+			if (NodeMemory == nullptr)
 			{
 				return false;
 			}
 
+			Node* NewNode = new(NodeMemory) Node(Item);
+
 			Node* OldHead;
 
 			if (Mode == EQueueMode::Mpsc)
 			{
-				OldHead = (Node*)WindowsAtomics::InterlockedExchangePtr((void**)&Head, NewNode);
+				OldHead = (Node*)PlatformAtomics::InterlockedExchangePtr((void**)&Head, NewNode);
 			}
 			else
 			{
@@ -150,7 +395,8 @@ namespace EDX
 				Head = NewNode;
 			}
 
-			OldHead->NextNode = NewNode;
+			// Publish the node, its item must be visible before the link is
+			PlatformAtomics::StoreRelease(&OldHead->NextNode, NewNode);
 
 			return true;
 		}
@@ -175,15 +421,491 @@ namespace EDX
 		*/
 		bool Peek(ItemType& OutItem) const
 		{
-			if (Tail->NextNode == nullptr)
+			const Node* Next = PlatformAtomics::LoadAcquire(&Tail->NextNode);
+			if (Next == nullptr)
+			{
+				return false;
+			}
+
+			OutItem = Next->Item;
+
+			return true;
+		}
+	};
+
+
+	/**
+	* Template for work stealing deques.
+	*
+	* This template implements a bounded Chase-Lev deque. The owning thread pushes and pops
+	* items at the bottom end in LIFO order without any atomic read-modify-write in the common
+	* case, while any number of other threads can steal items from the top end in FIFO order.
+	* Only the last item is contended, which is resolved with a compare-and-swap on Top.
+	*
+	* The capacity is fixed at construction time and rounded up to a power of two. Push()
+	* fails when the deque is full, callers are expected to fall back to a shared queue.
+	*
+	* @param ItemType The type of items stored in the deque, must be trivially copyable (usually a pointer).
+	*/
+	template<typename ItemType>
+	class WorkStealingQueue
+	{
+	private:
+		/**
+		* The indices are kept a cache line apart from each other and from the surrounding members with padding
+		* rather than __declspec(align), deques are embedded in heap allocated objects which new doesn't over-align.
+		*/
+		uint8 PadBeforeTop[PLATFORM_CACHE_LINE_SIZE];
+
+		/** Index of the next item to steal, only ever incremented. */
+		volatile int64 Top;
+
+		uint8 PadBeforeBottom[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+
+		/** Index one past the last pushed item, only written by the owner thread. */
+		volatile int64 Bottom;
+
+		uint8 PadAfterBottom[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+
+		/** Ring buffer of items. */
+		ItemType* volatile Items;
+
+		/** Capacity - 1, used to wrap indices. */
+		int64 Mask;
+
+	public:
+
+		/**
+		* Creates a deque that can hold up to InCapacity items.
+		*
+		* @param InCapacity The capacity, rounded up to the next power of two.
+		*/
+		WorkStealingQueue(uint32 InCapacity = 1024)
+			: Top(0)
+			, Bottom(0)
+		{
+			const uint32 Capacity = Math::RoundUpPowOfTwo(Math::Max(InCapacity, 2u));
+			Items = Memory::AlignedAlloc<ItemType>(Capacity, 64);
+			Mask = Capacity - 1;
+		}
+
+		// Non-copyable
+		WorkStealingQueue(const WorkStealingQueue&) = delete;
+		WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+		/** Destructor. */
+		~WorkStealingQueue()
+		{
+			Memory::Free(Items);
+		}
+
+	public:
+
+		/**
+		* Pushes an item to the bottom of the deque. Must only be called by the owner thread.
+		*
+		* @param Item The item to add.
+		* @return true if the item was added, false if the deque is full.
+		* @see Pop, Steal
+		*/
+		bool Push(const ItemType& Item)
+		{
+			const int64 B = Bottom;
+			const int64 T = Top;
+
+			if (B - T > Mask)
+			{
+				return false;
+			}
+
+			Items[B & Mask] = Item;
+
+			// Publish the item before making it visible to thieves
+			PlatformAtomics::StoreRelease(&Bottom, B + 1);
+
+			return true;
+		}
+
+		/**
+		* Pops the most recently pushed item. Must only be called by the owner thread.
+		*
+		* @param OutItem Will hold the returned item.
+		* @return true if an item was returned, false if the deque was empty or the last item was stolen.
+		* @see Push, Steal
+		*/
+		bool Pop(ItemType& OutItem)
+		{
+			const int64 B = Bottom - 1;
+
+			// Full barrier, the store to Bottom has to be visible before Top is read
+			PlatformAtomics::InterlockedExchange(&Bottom, B);
+			int64 T = Top;
+
+			if (T > B)
+			{
+				// Empty, restore
+				Bottom = B + 1;
+				return false;
+			}
+
+			OutItem = Items[B & Mask];
+			if (T == B)
+			{
+				// Racing against thieves for the last item
+				const bool bWon = PlatformAtomics::InterlockedCompareExchange(&Top, T + 1, T) == T;
+				Bottom = B + 1;
+
+				return bWon;
+			}
+
+			return true;
+		}
+
+		/**
+		* Steals the oldest item from the top of the deque. Can be called from any thread.
+		*
+		* @param OutItem Will hold the stolen item.
+		* @return true if an item was stolen, false if the deque was empty or another thread won the race.
+		* @see Push, Pop
+		*/
+		bool Steal(ItemType& OutItem)
+		{
+			// Top must be read before Bottom, which pairs with the full barrier in Pop
+			const int64 T = PlatformAtomics::LoadAcquire(&Top);
+			PlatformAtomics::FullBarrier();
+			const int64 B = PlatformAtomics::LoadAcquire(&Bottom);
+
+			if (T >= B)
+			{
+				return false;
+			}
+
+			ItemType Item = Items[T & Mask];
+			if (PlatformAtomics::InterlockedCompareExchange(&Top, T + 1, T) != T)
 			{
 				return false;
 			}
 
-			OutItem = Tail->NextNode->Item;
+			OutItem = Item;
+			return true;
+		}
+
+		/**
+		* Checks whether the deque is empty. The result is only a hint when called from a thief.
+		*
+		* @return true if the deque is empty, false otherwise.
+		*/
+		bool IsEmpty() const
+		{
+			return Bottom <= Top;
+		}
+
+		/**
+		* Gets an estimate of the number of items in the deque.
+		*
+		* @return The number of items.
+		*/
+		int32 Num() const
+		{
+			const int64 Count = Bottom - Top;
+			return Count > 0 ? int32(Count) : 0;
+		}
+	};
+
+
+	/**
+	* Template for bounded queues.
+	*
+	* This template implements a bounded multiple-producers multiple-consumers queue on top of a
+	* power of two ring buffer. Each cell carries a sequence number telling producers and consumers
+	* whether it is free or ready for the current lap (Dmitry Vyukov's algorithm), so operations only
+	* contend on a compare-and-swap of the head or tail position and nothing is allocated per item.
+	*
+	* Head and tail positions live on separate cache lines so that producers and consumers don't
+	* invalidate each other.
+	*
+	* @param ItemType The type of items stored in the queue.
+	*/
+	template<typename ItemType>
+	class BoundedQueue
+	{
+	private:
+		/** Structure for the ring buffer cells. */
+		struct Cell
+		{
+			/** Position the cell is ready for, equals the enqueue position when free and position + 1 when filled. */
+			volatile int64 Sequence;
+
+			/** Holds the cell's item. */
+			ItemType Item;
+		};
+
+		/**
+		* The positions are kept a cache line apart from each other and from the read-only members with padding rather
+		* than __declspec(align), which new doesn't honor for queues embedded in heap allocated objects.
+		*/
+		uint8 PadBeforeCells[PLATFORM_CACHE_LINE_SIZE];
+
+		/** Holds the ring buffer. */
+		Cell* Cells;
+
+		/** Capacity - 1, used to wrap positions. */
+		int64 Mask;
+
+		uint8 PadBeforeEnqueuePos[PLATFORM_CACHE_LINE_SIZE - sizeof(Cell*) - sizeof(int64)];
+
+		/** Position of the next enqueue. */
+		volatile int64 EnqueuePos;
+
+		uint8 PadBeforeDequeuePos[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+
+		/** Position of the next dequeue. */
+		volatile int64 DequeuePos;
+
+		uint8 PadAfterDequeuePos[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+
+	public:
+
+		/**
+		* Creates a queue that can hold up to InCapacity items.
+		*
+		* @param InCapacity The capacity, rounded up to the next power of two.
+		*/
+		BoundedQueue(uint32 InCapacity = 1024)
+			: EnqueuePos(0)
+			, DequeuePos(0)
+		{
+			const uint32 Capacity = Math::RoundUpPowOfTwo(Math::Max(InCapacity, 2u));
+			Cells = Memory::AlignedAlloc<Cell>(Capacity, 64);
+			Mask = Capacity - 1;
+
+			for (uint32 i = 0; i < Capacity; i++)
+			{
+				Cells[i].Sequence = i;
+				new(&Cells[i].Item) ItemType();
+			}
+		}
+
+		// Non-copyable
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+		/** Destructor. */
+		~BoundedQueue()
+		{
+			for (int64 i = 0; i <= Mask; i++)
+			{
+				Cells[i].Item.~ItemType();
+			}
+			Memory::Free(Cells);
+		}
+
+	public:
+
+		/**
+		* Adds an item to the queue.
+		*
+		* @param Item The item to add.
+		* @return true if the item was added, false if the queue is full.
+		* @see Dequeue, EnqueueBatch
+		*/
+		bool Enqueue(const ItemType& Item)
+		{
+			Cell* pCell;
+			int64 Pos = EnqueuePos;
+			for (;;)
+			{
+				pCell = &Cells[Pos & Mask];
+				const int64 Dif = PlatformAtomics::LoadAcquire(&pCell->Sequence) - Pos;
+				if (Dif == 0)
+				{
+					const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&EnqueuePos, Pos + 1, Pos);
+					if (Prev == Pos)
+					{
+						break;
+					}
+					Pos = Prev;
+				}
+				else if (Dif < 0)
+				{
+					// The cell still holds an item from the previous lap
+					return false;
+				}
+				else
+				{
+					Pos = EnqueuePos;
+				}
+			}
+
+			pCell->Item = Item;
+
+			// Publish the item
+			PlatformAtomics::StoreRelease(&pCell->Sequence, Pos + 1);
+
+			return true;
+		}
+
+		/**
+		* Removes the oldest item from the queue.
+		*
+		* @param OutItem Will hold the returned item.
+		* @return true if an item was returned, false if the queue was empty.
+		* @see Enqueue, DequeueBatch
+		*/
+		bool Dequeue(ItemType& OutItem)
+		{
+			Cell* pCell;
+			int64 Pos = DequeuePos;
+			for (;;)
+			{
+				pCell = &Cells[Pos & Mask];
+				const int64 Dif = PlatformAtomics::LoadAcquire(&pCell->Sequence) - (Pos + 1);
+				if (Dif == 0)
+				{
+					const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&DequeuePos, Pos + 1, Pos);
+					if (Prev == Pos)
+					{
+						break;
+					}
+					Pos = Prev;
+				}
+				else if (Dif < 0)
+				{
+					// The cell hasn't been filled yet
+					return false;
+				}
+				else
+				{
+					Pos = DequeuePos;
+				}
+			}
+
+			OutItem = Move(pCell->Item);
+
+			// Hand the cell back to the producers for the next lap
+			PlatformAtomics::StoreRelease(&pCell->Sequence, Pos + Mask + 1);
 
 			return true;
 		}
+
+		/**
+		* Adds up to Count items with a single compare-and-swap on the enqueue position.
+		*
+		* @param Items The items to add.
+		* @param Count Number of items.
+		* @return Number of items added, less than Count if the queue filled up.
+		* @see Enqueue, DequeueBatch
+		*/
+		int32 EnqueueBatch(const ItemType* Items, int32 Count)
+		{
+			int32 NumClaimed = 0;
+			int64 Pos = EnqueuePos;
+			while (Count > 0)
+			{
+				// Count the consecutive free cells starting at Pos
+				NumClaimed = 0;
+				while (NumClaimed < Count && PlatformAtomics::LoadAcquire(&Cells[(Pos + NumClaimed) & Mask].Sequence) == Pos + NumClaimed)
+				{
+					NumClaimed++;
+				}
+
+				if (NumClaimed == 0)
+				{
+					if (PlatformAtomics::LoadAcquire(&Cells[Pos & Mask].Sequence) < Pos)
+					{
+						return 0;
+					}
+					Pos = EnqueuePos;
+					continue;
+				}
+
+				const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&EnqueuePos, Pos + NumClaimed, Pos);
+				if (Prev == Pos)
+				{
+					break;
+				}
+				Pos = Prev;
+			}
+
+			for (int32 i = 0; i < NumClaimed; i++)
+			{
+				Cell* pCell = &Cells[(Pos + i) & Mask];
+				pCell->Item = Items[i];
+				PlatformAtomics::StoreRelease(&pCell->Sequence, Pos + i + 1);
+			}
+
+			return NumClaimed;
+		}
+
+		/**
+		* Removes up to MaxCount of the oldest items with a single compare-and-swap on the dequeue position.
+		*
+		* @param OutItems Will hold the returned items.
+		* @param MaxCount Maximum number of items to return.
+		* @return Number of items returned, 0 if the queue was empty.
+		* @see Dequeue, EnqueueBatch
+		*/
+		int32 DequeueBatch(ItemType* OutItems, int32 MaxCount)
+		{
+			int32 NumClaimed = 0;
+			int64 Pos = DequeuePos;
+			while (MaxCount > 0)
+			{
+				// Count the consecutive filled cells starting at Pos
+				NumClaimed = 0;
+				while (NumClaimed < MaxCount && PlatformAtomics::LoadAcquire(&Cells[(Pos + NumClaimed) & Mask].Sequence) == Pos + NumClaimed + 1)
+				{
+					NumClaimed++;
+				}
+
+				if (NumClaimed == 0)
+				{
+					if (PlatformAtomics::LoadAcquire(&Cells[Pos & Mask].Sequence) < Pos + 1)
+					{
+						return 0;
+					}
+					Pos = DequeuePos;
+					continue;
+				}
+
+				const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&DequeuePos, Pos + NumClaimed, Pos);
+				if (Prev == Pos)
+				{
+					break;
+				}
+				Pos = Prev;
+			}
+
+			for (int32 i = 0; i < NumClaimed; i++)
+			{
+				Cell* pCell = &Cells[(Pos + i) & Mask];
+				OutItems[i] = Move(pCell->Item);
+				PlatformAtomics::StoreRelease(&pCell->Sequence, Pos + i + Mask + 1);
+			}
+
+			return NumClaimed;
+		}
+
+		/**
+		* Checks whether the queue is empty. The result is only a hint if other threads are using the queue.
+		*
+		* @return true if the queue is empty, false otherwise.
+		*/
+		bool IsEmpty() const
+		{
+			const int64 Pos = DequeuePos;
+			return PlatformAtomics::LoadAcquire(&Cells[Pos & Mask].Sequence) != Pos + 1;
+		}
+
+		/**
+		* Gets the capacity of the queue.
+		*
+		* @return The maximum number of items the queue can hold.
+		*/
+		int32 GetCapacity() const
+		{
+			return int32(Mask + 1);
+		}
 	};
 
 }
\ No newline at end of file
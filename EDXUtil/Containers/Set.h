@@ -6,6 +6,7 @@
 #include "../Core/TypeHash.h"
 #include "../Core/Sorting.h"
 #include "../Core/Misc.h"
+#include "../Core/ParallelTasks.h"
 #include <initializer_list>
 
 namespace EDX
@@ -53,7 +54,7 @@ namespace EDX
 		/** Calculates a hash index for a key. */
 		static __forceinline uint32 GetKeyHash(KeyInitType Key)
 		{
-			return GetTypeHash(Key);
+			return GetKeyTypeHash(Key);
 		}
 	};
 
@@ -511,22 +512,13 @@ namespace EDX
 		template<typename ArrayAllocator>
 		void Append(const Array<ElementType, ArrayAllocator>& InElements)
 		{
-			Reserve(Elements.Size() + InElements.Size());
-			for (auto& Element : InElements)
-			{
-				Add(Element);
-			}
+			BulkAdd(InElements);
 		}
 
 		template<typename ArrayAllocator>
 		void Append(Array<ElementType, ArrayAllocator>&& InElements)
 		{
-			Reserve(Elements.Size() + InElements.Size());
-			for (auto& Element : InElements)
-			{
-				Add(Move(Element));
-			}
-			InElements.Reset();
+			BulkAdd(Move(InElements));
 		}
 
 		/**
@@ -556,11 +548,35 @@ namespace EDX
 
 		void Append(std::initializer_list<ElementType> InitList)
 		{
-			Reserve(Elements.Size() + (int32)InitList.size());
-			for (const ElementType& Element : InitList)
-			{
-				Add(Element);
-			}
+			BulkAdd(InitList.begin(), (int32)InitList.size());
+		}
+
+		/**
+		* Adds a batch of elements, with the same result as adding them one at a time except that the slots of duplicate
+		* elements are left as holes. The hash is resized once for the final number of elements, the keys are hashed in a
+		* separate pass, then the elements are linked into their buckets.
+		*
+		* @param pElements - The elements to add.
+		* @param NumElements - The number of elements to add.
+		* @param bParallel - true to hash and link the elements on the global thread pool, each thread owning a range of
+		*                    buckets. Only worth it for tens of thousands of elements, KeyFuncs must be safe to call concurrently.
+		*/
+		void BulkAdd(const ElementType* pElements, int32 NumElements, bool bParallel = false)
+		{
+			BulkAddImpl(pElements, NumElements, bParallel);
+		}
+
+		template<typename ArrayAllocator>
+		void BulkAdd(const Array<ElementType, ArrayAllocator>& InElements, bool bParallel = false)
+		{
+			BulkAddImpl(InElements.Data(), InElements.Size(), bParallel);
+		}
+
+		template<typename ArrayAllocator>
+		void BulkAdd(Array<ElementType, ArrayAllocator>&& InElements, bool bParallel = false)
+		{
+			BulkAddImpl(InElements.Data(), InElements.Size(), bParallel);
+			InElements.Reset();
 		}
 
 		/**
@@ -975,13 +991,146 @@ namespace EDX
 			GetTypedHash(Element.HashIndex) = ElementId;
 		}
 
+		/**
+		* Links an element added by BulkAdd into its bucket. With unique keys, an element matching one already in the
+		* bucket replaces its value instead and is marked for removal with a HashIndex of INDEX_NONE.
+		*/
+		__forceinline void LinkBulkElement(SetElementId ElementId, uint32 KeyHash)
+		{
+			SetElementType& Element = Elements[ElementId];
+			const int32 HashIndex = KeyHash & (HashSize - 1);
+
+			if (!KeyFuncs::bAllowDuplicateKeys)
+			{
+				for (SetElementId ExistingId = GetTypedHash(HashIndex); ExistingId.IsValidId(); ExistingId = Elements[ExistingId].HashNextId)
+				{
+					if (KeyFuncs::Matches(KeyFuncs::GetSetKey(Elements[ExistingId].Value), KeyFuncs::GetSetKey(Element.Value)))
+					{
+						MoveByRelocate(Elements[ExistingId].Value, Element.Value);
+						Element.HashIndex = INDEX_NONE;
+						return;
+					}
+				}
+			}
+
+			Element.HashIndex = HashIndex;
+			Element.HashNextId = GetTypedHash(HashIndex);
+			GetTypedHash(HashIndex) = ElementId;
+		}
+
+		/** Implements BulkAdd, the elements are moved when SourceType isn't const and copied otherwise. */
+		template <typename SourceType>
+		void BulkAddImpl(SourceType* pSource, int32 NumSource, bool bParallel)
+		{
+			if (NumSource <= 0)
+			{
+				return;
+			}
+
+			// Below this many elements the thread pool costs more than it saves
+			const int32 MinParallelElements = 16384;
+			bParallel = bParallel && NumSource >= MinParallelElements;
+
+			// Size the hash for the final number of elements up front, this only relinks the existing elements
+			Reserve(Elements.Size() + NumSource);
+			ConditionalRehash(Elements.Size() + NumSource, false, bParallel);
+
+			// Hash the keys in their own pass over the contiguous source, before the elements are moved
+			Array<uint32> KeyHashes;
+			KeyHashes.AddUninitialized(NumSource);
+			auto HashRange = [&](int32 Begin, int32 End)
+			{
+				for (int32 i = Begin; i < End; i++)
+				{
+					KeyHashes[i] = KeyFuncs::GetKeyHash(KeyFuncs::GetSetKey(pSource[i]));
+				}
+			};
+
+			const int32 NumTasks = bParallel ? Math::Min(64, HashSize) : 1;
+			if (bParallel)
+			{
+				const int32 NumPerTask = (NumSource + NumTasks - 1) / NumTasks;
+				Parallel::RunTasks(NumTasks, [&](int32 TaskIndex)
+				{
+					HashRange(TaskIndex * NumPerTask, Math::Min(NumSource, (TaskIndex + 1) * NumPerTask));
+				});
+			}
+			else
+			{
+				HashRange(0, NumSource);
+			}
+
+			Array<int32> ElementIds;
+			ElementIds.AddUninitialized(NumSource);
+			for (int32 i = 0; i < NumSource; i++)
+			{
+				SparseArrayAllocationInfo Allocation = Elements.AddUninitialized();
+				new(Allocation) SetElementType(Move(pSource[i]));
+				ElementIds[i] = Allocation.Index;
+			}
+
+			if (bParallel)
+			{
+				// Each task owns a contiguous range of buckets, so it can link and deduplicate without locking. The elements
+				// are counting sorted by task first, keeping their order within a task so the chains match the serial ones.
+				const int32 BucketShift = Math::FloorLog2(HashSize) - Math::FloorLog2(NumTasks);
+
+				Array<int32> TaskStart;
+				TaskStart.AddZeroed(NumTasks + 1);
+				for (int32 i = 0; i < NumSource; i++)
+				{
+					TaskStart[((KeyHashes[i] & (HashSize - 1)) >> BucketShift) + 1]++;
+				}
+				for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
+				{
+					TaskStart[TaskIndex + 1] += TaskStart[TaskIndex];
+				}
+
+				Array<int32> TaskOrder;
+				TaskOrder.AddUninitialized(NumSource);
+				Array<int32> TaskEnd(TaskStart);
+				for (int32 i = 0; i < NumSource; i++)
+				{
+					TaskOrder[TaskEnd[(KeyHashes[i] & (HashSize - 1)) >> BucketShift]++] = i;
+				}
+
+				Parallel::RunTasks(NumTasks, [&](int32 TaskIndex)
+				{
+					for (int32 OrderIndex = TaskStart[TaskIndex]; OrderIndex < TaskStart[TaskIndex + 1]; OrderIndex++)
+					{
+						const int32 i = TaskOrder[OrderIndex];
+						LinkBulkElement(SetElementId(ElementIds[i]), KeyHashes[i]);
+					}
+				});
+			}
+			else
+			{
+				for (int32 i = 0; i < NumSource; i++)
+				{
+					LinkBulkElement(SetElementId(ElementIds[i]), KeyHashes[i]);
+				}
+			}
+
+			if (!KeyFuncs::bAllowDuplicateKeys)
+			{
+				for (int32 i = 0; i < NumSource; i++)
+				{
+					if (Elements[ElementIds[i]].HashIndex == INDEX_NONE)
+					{
+						Elements.RemoveAtUninitialized(ElementIds[i]);
+					}
+				}
+			}
+		}
+
 		/**
 		* Checks if the hash has an appropriate number of buckets, and if not resizes it.
 		* @param NumHashedElements - The number of elements to size the hash for.
 		* @param bAllowShrinking - true if the hash is allowed to shrink.
+		* @param bParallel - true to relink the elements on the global thread pool, see Rehash.
 		* @return true if the set was rehashed.
 		*/
-		bool ConditionalRehash(int32 NumHashedElements, bool bAllowShrinking = false) const
+		bool ConditionalRehash(int32 NumHashedElements, bool bAllowShrinking = false, bool bParallel = false) const
 		{
 			// Calculate the desired hash size for the specified number of elements.
 			const int32 DesiredHashSize = Allocator::GetNumberOfHashBuckets(NumHashedElements);
@@ -993,7 +1142,7 @@ namespace EDX
 					(HashSize > DesiredHashSize && bAllowShrinking)))
 			{
 				HashSize = DesiredHashSize;
-				Rehash();
+				Rehash(bParallel);
 				return true;
 			}
 			else
@@ -1002,8 +1151,11 @@ namespace EDX
 			}
 		}
 
-		/** Resizes the hash. */
-		void Rehash() const
+		/**
+		* Resizes the hash.
+		* @param bParallel - true to relink the elements on the global thread pool, for tens of thousands of elements.
+		*/
+		void Rehash(bool bParallel = false) const
 		{
 			// Free the old hash.
 			Hash.ResizeAllocation(0, 0, sizeof(SetElementId));
@@ -1014,6 +1166,15 @@ namespace EDX
 				// Allocate the new hash.
 				Assert(!(LocalHashSize & (HashSize - 1)));
 				Hash.ResizeAllocation(0, LocalHashSize, sizeof(SetElementId));
+
+				// Below this many elements the thread pool costs more than it saves
+				const int32 MinParallelElements = 16384;
+				if (bParallel && Elements.Size() >= MinParallelElements)
+				{
+					ParallelRehash();
+					return;
+				}
+
 				for (int32 HashIndex = 0; HashIndex < LocalHashSize; ++HashIndex)
 				{
 					GetTypedHash(HashIndex) = SetElementId();
@@ -1027,6 +1188,82 @@ namespace EDX
 			}
 		}
 
+		/**
+		* Links the elements into the newly allocated hash on the global thread pool. Like BulkAdd, each task owns a
+		* contiguous range of buckets so it links without locking. The elements are first hashed and counted per range of
+		* indices, then ordered by bucket range keeping their index order, so the chains match the ones of a serial rehash.
+		*/
+		void ParallelRehash() const
+		{
+			const int32 NumTasks = Math::Min(64, HashSize);
+			const int32 BucketShift = Math::FloorLog2(HashSize) - Math::FloorLog2(NumTasks);
+			const int32 BucketsPerTask = HashSize / NumTasks;
+			const int32 MaxIndex = Elements.GetMaxIndex();
+			const int32 IndicesPerTask = (MaxIndex + NumTasks - 1) / NumTasks;
+
+			// Counts[Range * NumTasks + Owner], the number of elements in a range of indices linked by each task
+			Array<int32> Counts;
+			Counts.AddZeroed(NumTasks * NumTasks);
+			Parallel::RunTasks(NumTasks, [&](int32 TaskIndex)
+			{
+				for (int32 HashIndex = TaskIndex * BucketsPerTask; HashIndex < (TaskIndex + 1) * BucketsPerTask; HashIndex++)
+				{
+					GetTypedHash(HashIndex) = SetElementId();
+				}
+
+				int32* pCounts = &Counts[TaskIndex * NumTasks];
+				for (int32 Index = TaskIndex * IndicesPerTask; Index < Math::Min(MaxIndex, (TaskIndex + 1) * IndicesPerTask); Index++)
+				{
+					if (Elements.IsAllocated(Index))
+					{
+						const SetElementType& Element = Elements[Index];
+						Element.HashIndex = KeyFuncs::GetKeyHash(KeyFuncs::GetSetKey(Element.Value)) & (HashSize - 1);
+						pCounts[Element.HashIndex >> BucketShift]++;
+					}
+				}
+			});
+
+			// Turn the counts into the positions each range of indices writes its elements to, grouped by owner
+			Array<int32> OwnerStart;
+			OwnerStart.AddUninitialized(NumTasks + 1);
+			int32 NumOrdered = 0;
+			for (int32 Owner = 0; Owner < NumTasks; Owner++)
+			{
+				OwnerStart[Owner] = NumOrdered;
+				for (int32 Range = 0; Range < NumTasks; Range++)
+				{
+					const int32 Count = Counts[Range * NumTasks + Owner];
+					Counts[Range * NumTasks + Owner] = NumOrdered;
+					NumOrdered += Count;
+				}
+			}
+			OwnerStart[NumTasks] = NumOrdered;
+
+			Array<int32> Order;
+			Order.AddUninitialized(NumOrdered);
+			Parallel::RunTasks(NumTasks, [&](int32 TaskIndex)
+			{
+				int32* pPositions = &Counts[TaskIndex * NumTasks];
+				for (int32 Index = TaskIndex * IndicesPerTask; Index < Math::Min(MaxIndex, (TaskIndex + 1) * IndicesPerTask); Index++)
+				{
+					if (Elements.IsAllocated(Index))
+					{
+						Order[pPositions[Elements[Index].HashIndex >> BucketShift]++] = Index;
+					}
+				}
+			});
+
+			Parallel::RunTasks(NumTasks, [&](int32 TaskIndex)
+			{
+				for (int32 OrderIndex = OwnerStart[TaskIndex]; OrderIndex < OwnerStart[TaskIndex + 1]; OrderIndex++)
+				{
+					const SetElementType& Element = Elements[Order[OrderIndex]];
+					Element.HashNextId = GetTypedHash(Element.HashIndex);
+					GetTypedHash(Element.HashIndex) = SetElementId(Order[OrderIndex]);
+				}
+			});
+		}
+
 		/** The base type of whole set iterators. */
 		template<bool bConst>
 		class BaseIterator
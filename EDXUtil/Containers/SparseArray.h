@@ -47,6 +47,8 @@ namespace EDX
 	{
 		friend struct ContainerTraits<SparseArray>;
 
+		static_assert(sizeof(typename Allocator::ElementAllocator::SizeType) == sizeof(int32), "SparseArray only supports allocators with 32 bits sizes.");
+
 	public:
 
 		/** Destructor. */
@@ -1,4 +1,5 @@
 #include "String.h"
+#include "StringView.h"
 
 namespace EDX
 {
@@ -437,7 +438,7 @@ namespace EDX
 		String TempString;
 		// First create the string
 		TempString = String::Printf(EDX_TEXT("%f"), InFloat);
-		const Array< TCHAR >& Chars = TempString.GetCharArray();
+		const DataType& Chars = TempString.GetCharArray();
 		const TCHAR Zero = '0';
 		const TCHAR Period = '.';
 		int32 TrimIndex = 0;
@@ -553,6 +554,26 @@ namespace EDX
 		return OutArray.Size();
 	}
 
+	int32 String::ParseIntoArray(Array<StringView>& OutArray, const TCHAR* pchDelim, bool InCullEmpty) const
+	{
+		return StringView(*this).ParseIntoArray(OutArray, pchDelim, InCullEmpty);
+	}
+
+	int32 String::ParseIntoArrayWS(Array<StringView>& OutArray, const TCHAR* pchExtraDelim, bool InCullEmpty) const
+	{
+		return StringView(*this).ParseIntoArrayWS(OutArray, pchExtraDelim, InCullEmpty);
+	}
+
+	int32 String::ParseIntoArrayLines(Array<StringView>& OutArray, bool InCullEmpty) const
+	{
+		return StringView(*this).ParseIntoArrayLines(OutArray, InCullEmpty);
+	}
+
+	int32 String::ParseIntoArray(Array<StringView>& OutArray, const TCHAR** DelimArray, int32 NumDelims, bool InCullEmpty) const
+	{
+		return StringView(*this).ParseIntoArray(OutArray, DelimArray, NumDelims, InCullEmpty);
+	}
+
 	bool String::MatchesWildcard(const String& InWildcard, ESearchCase SearchCase) const
 	{
 		String Wildcard(InWildcard);
@@ -3,6 +3,7 @@
 #include "Array.h"
 #include "Map.h"
 #include "../Core/Crc.h"
+#include "../Core/FastHash.h"
 #include "../Core/CString.h"
 #include "../Core/Template.h"
 #include "../Core/Stream.h"
@@ -30,16 +31,26 @@ namespace EDX
 		FromEnd,
 	};
 
+	class StringView;
+
 	/**
 	* A dynamically sizeable string.
 	*/
 	class String
 	{
+	public:
+		/**
+		* Number of characters, including the terminator, stored inline in the string. Shorter strings
+		* don't allocate, longer ones move to the heap. 24 characters keep String at 64 bytes with 2 bytes TCHARs.
+		*/
+		enum { NumInlineChars = 24 };
+
+		/** Array holding the character data, as returned by GetCharArray */
+		typedef Array<TCHAR, InlineAllocator<NumInlineChars>> DataType;
+
 	private:
 		friend struct ContainerTraits<String>;
 
-		/** Array holding the character data */
-		typedef Array<TCHAR> DataType;
 		DataType Data;
 
 	public:
@@ -154,8 +165,8 @@ namespace EDX
 		/**
 		* Iterator typedefs
 		*/
-		typedef Array<TCHAR>::Iterator      Iterator;
-		typedef Array<TCHAR>::ConstIterator ConstIterator;
+		typedef DataType::Iterator      Iterator;
+		typedef DataType::ConstIterator ConstIterator;
 
 		/** Creates an iterator for the characters in this string */
 		__forceinline Iterator CreateIterator()
@@ -1238,6 +1249,7 @@ namespace EDX
 
 		/**
 		* Constructs String object similarly to how classic sprintf works.
+		* Prefer StringFormat in frequently run code, it is type safe and doesn't go through the CRT.
 		*
 		* @param Format	Format string that specifies how String should be built optionally using additional args. Refer to standard printf format.
 		* @param ...		Depending on format function may require additional arguments to build output object.
@@ -1378,6 +1390,15 @@ namespace EDX
 		*/
 		int32 ParseIntoArray(Array<String>& OutArray, const TCHAR** DelimArray, int32 NumDelims, bool InCullEmpty = true) const;
 
+		/**
+		* Versions of the ParseIntoArray family filling an array of views of this string instead of allocating a
+		* String per piece, see StringView. The views are invalidated when this string is modified or destroyed.
+		*/
+		int32 ParseIntoArray(Array<StringView>& OutArray, const TCHAR* pchDelim, bool InCullEmpty = true) const;
+		int32 ParseIntoArrayWS(Array<StringView>& OutArray, const TCHAR* pchExtraDelim = nullptr, bool InCullEmpty = true) const;
+		int32 ParseIntoArrayLines(Array<StringView>& OutArray, bool InCullEmpty = true) const;
+		int32 ParseIntoArray(Array<StringView>& OutArray, const TCHAR** DelimArray, int32 NumDelims, bool InCullEmpty = true) const;
+
 		/**
 		* Takes an array of strings and removes any zero length entries.
 		*
@@ -1596,10 +1617,10 @@ namespace EDX
 		return String.GetCharArray().Size();
 	}
 
-		/** Case insensitive string hash function. */
+	/** Case insensitive string hash function, consistent with operator==. */
 	__forceinline uint32 GetTypeHash(const String& S)
 	{
-		return Crc::StrHash(*S);
+		return FastHash::StriHash(*S, S.Len());
 	}
 
 	/**
@@ -0,0 +1,794 @@
+#include "StringFormat.h"
+#include <limits>
+
+#if defined(_WIN64)
+#include <intrin.h>
+#endif
+
+namespace EDX
+{
+	namespace
+	{
+		const char DigitPairs[201] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		const uint64 Pow10[] =
+		{
+			1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+			10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+			1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+		};
+
+		/** Writes the decimal digits of Value ending at pEnd. @return The first digit */
+		template<typename CharType>
+		__forceinline CharType* WriteDecimal(uint64 Value, CharType* pEnd)
+		{
+			while (Value >= 100)
+			{
+				const uint32 Index = uint32(Value % 100) * 2;
+				Value /= 100;
+				*--pEnd = CharType(DigitPairs[Index + 1]);
+				*--pEnd = CharType(DigitPairs[Index]);
+			}
+
+			if (Value >= 10)
+			{
+				*--pEnd = CharType(DigitPairs[Value * 2 + 1]);
+				*--pEnd = CharType(DigitPairs[Value * 2]);
+			}
+			else
+			{
+				*--pEnd = CharType('0' + Value);
+			}
+
+			return pEnd;
+		}
+
+		/** Writes the hexadecimal digits of Value ending at pEnd. @return The first digit */
+		__forceinline TCHAR* WriteHex(uint64 Value, TCHAR* pEnd, bool bUpper)
+		{
+			const char* Digits = bUpper ? "0123456789ABCDEF" : "0123456789abcdef";
+			do
+			{
+				*--pEnd = TCHAR(Digits[Value & 15]);
+				Value >>= 4;
+			} while (Value);
+
+			return pEnd;
+		}
+
+		/** @return The low half of the 128 bits product, the high half in High. */
+		__forceinline uint64 Multiply128(uint64 A, uint64 B, uint64& High)
+		{
+#if defined(_WIN64)
+			return _umul128(A, B, &High);
+#elif defined(__SIZEOF_INT128__)
+			const unsigned __int128 Product = (unsigned __int128)A * B;
+			High = uint64(Product >> 64);
+			return uint64(Product);
+#else
+			const uint64 ALow = uint32(A), AHigh = A >> 32;
+			const uint64 BLow = uint32(B), BHigh = B >> 32;
+			const uint64 LowLow = ALow * BLow, LowHigh = ALow * BHigh, HighLow = AHigh * BLow, HighHigh = AHigh * BHigh;
+			const uint64 Cross = (LowLow >> 32) + uint32(LowHigh) + uint32(HighLow);
+			High = HighHigh + (LowHigh >> 32) + (HighLow >> 32) + (Cross >> 32);
+			return (Cross << 32) | uint32(LowLow);
+#endif
+		}
+
+		/**
+		* Shortest decimal digits reading back to a float, following Grisu2 (Loitsch, "Printing Floating-Point Numbers
+		* Quickly and Accurately with Integers"): the value and the bounds of its rounding interval are scaled by a cached
+		* power of ten with 64 bits integers, and digits are generated until they fall inside the interval.
+		*/
+		namespace Grisu
+		{
+			/** Floating point number F * 2^E with a 64 bits significand. */
+			struct DiyFp
+			{
+				uint64 F;
+				int32 E;
+
+				__forceinline DiyFp(uint64 InF, int32 InE)
+					: F(InF)
+					, E(InE)
+				{
+				}
+
+				/** @return The product, rounded to the 64 high bits. */
+				__forceinline DiyFp operator*(const DiyFp& Other) const
+				{
+					uint64 High;
+					const uint64 Low = Multiply128(F, Other.F, High);
+					return DiyFp(High + (Low >> 63), E + Other.E + 64);
+				}
+
+				__forceinline DiyFp Normalize() const
+				{
+					DiyFp Result = *this;
+					while ((Result.F >> 63) == 0)
+					{
+						Result.F <<= 1;
+						Result.E--;
+					}
+
+					return Result;
+				}
+			};
+
+			struct CachedPower
+			{
+				uint64 F;
+				int32 E;
+				int32 K;
+			};
+
+			/** The scaled products have binary exponents in [Alpha, Gamma], so the integral part of the digits fits in 32 bits. */
+			enum { Alpha = -60, Gamma = -32 };
+
+			/** Normalized 10^K for K in [-348, 340] by steps of 8, which covers every float and double. */
+			enum { CachedPowersMinK = -348, CachedPowersStepK = 8 };
+			const CachedPower CachedPowers[] =
+			{
+				{ 0xFA8FD5A0081C0288ull, -1220, -348 },
+				{ 0xBAAEE17FA23EBF76ull, -1193, -340 },
+				{ 0x8B16FB203055AC76ull, -1166, -332 },
+				{ 0xCF42894A5DCE35EAull, -1140, -324 },
+				{ 0x9A6BB0AA55653B2Dull, -1113, -316 },
+				{ 0xE61ACF033D1A45DFull, -1087, -308 },
+				{ 0xAB70FE17C79AC6CAull, -1060, -300 },
+				{ 0xFF77B1FCBEBCDC4Full, -1034, -292 },
+				{ 0xBE5691EF416BD60Cull, -1007, -284 },
+				{ 0x8DD01FAD907FFC3Cull, -980, -276 },
+				{ 0xD3515C2831559A83ull, -954, -268 },
+				{ 0x9D71AC8FADA6C9B5ull, -927, -260 },
+				{ 0xEA9C227723EE8BCBull, -901, -252 },
+				{ 0xAECC49914078536Dull, -874, -244 },
+				{ 0x823C12795DB6CE57ull, -847, -236 },
+				{ 0xC21094364DFB5637ull, -821, -228 },
+				{ 0x9096EA6F3848984Full, -794, -220 },
+				{ 0xD77485CB25823AC7ull, -768, -212 },
+				{ 0xA086CFCD97BF97F4ull, -741, -204 },
+				{ 0xEF340A98172AACE5ull, -715, -196 },
+				{ 0xB23867FB2A35B28Eull, -688, -188 },
+				{ 0x84C8D4DFD2C63F3Bull, -661, -180 },
+				{ 0xC5DD44271AD3CDBAull, -635, -172 },
+				{ 0x936B9FCEBB25C996ull, -608, -164 },
+				{ 0xDBAC6C247D62A584ull, -582, -156 },
+				{ 0xA3AB66580D5FDAF6ull, -555, -148 },
+				{ 0xF3E2F893DEC3F126ull, -529, -140 },
+				{ 0xB5B5ADA8AAFF80B8ull, -502, -132 },
+				{ 0x87625F056C7C4A8Bull, -475, -124 },
+				{ 0xC9BCFF6034C13053ull, -449, -116 },
+				{ 0x964E858C91BA2655ull, -422, -108 },
+				{ 0xDFF9772470297EBDull, -396, -100 },
+				{ 0xA6DFBD9FB8E5B88Full, -369, -92 },
+				{ 0xF8A95FCF88747D94ull, -343, -84 },
+				{ 0xB94470938FA89BCFull, -316, -76 },
+				{ 0x8A08F0F8BF0F156Bull, -289, -68 },
+				{ 0xCDB02555653131B6ull, -263, -60 },
+				{ 0x993FE2C6D07B7FACull, -236, -52 },
+				{ 0xE45C10C42A2B3B06ull, -210, -44 },
+				{ 0xAA242499697392D3ull, -183, -36 },
+				{ 0xFD87B5F28300CA0Eull, -157, -28 },
+				{ 0xBCE5086492111AEBull, -130, -20 },
+				{ 0x8CBCCC096F5088CCull, -103, -12 },
+				{ 0xD1B71758E219652Cull, -77, -4 },
+				{ 0x9C40000000000000ull, -50, 4 },
+				{ 0xE8D4A51000000000ull, -24, 12 },
+				{ 0xAD78EBC5AC620000ull, 3, 20 },
+				{ 0x813F3978F8940984ull, 30, 28 },
+				{ 0xC097CE7BC90715B3ull, 56, 36 },
+				{ 0x8F7E32CE7BEA5C70ull, 83, 44 },
+				{ 0xD5D238A4ABE98068ull, 109, 52 },
+				{ 0x9F4F2726179A2245ull, 136, 60 },
+				{ 0xED63A231D4C4FB27ull, 162, 68 },
+				{ 0xB0DE65388CC8ADA8ull, 189, 76 },
+				{ 0x83C7088E1AAB65DBull, 216, 84 },
+				{ 0xC45D1DF942711D9Aull, 242, 92 },
+				{ 0x924D692CA61BE758ull, 269, 100 },
+				{ 0xDA01EE641A708DEAull, 295, 108 },
+				{ 0xA26DA3999AEF774Aull, 322, 116 },
+				{ 0xF209787BB47D6B85ull, 348, 124 },
+				{ 0xB454E4A179DD1877ull, 375, 132 },
+				{ 0x865B86925B9BC5C2ull, 402, 140 },
+				{ 0xC83553C5C8965D3Dull, 428, 148 },
+				{ 0x952AB45CFA97A0B3ull, 455, 156 },
+				{ 0xDE469FBD99A05FE3ull, 481, 164 },
+				{ 0xA59BC234DB398C25ull, 508, 172 },
+				{ 0xF6C69A72A3989F5Cull, 534, 180 },
+				{ 0xB7DCBF5354E9BECEull, 561, 188 },
+				{ 0x88FCF317F22241E2ull, 588, 196 },
+				{ 0xCC20CE9BD35C78A5ull, 614, 204 },
+				{ 0x98165AF37B2153DFull, 641, 212 },
+				{ 0xE2A0B5DC971F303Aull, 667, 220 },
+				{ 0xA8D9D1535CE3B396ull, 694, 228 },
+				{ 0xFB9B7CD9A4A7443Cull, 720, 236 },
+				{ 0xBB764C4CA7A44410ull, 747, 244 },
+				{ 0x8BAB8EEFB6409C1Aull, 774, 252 },
+				{ 0xD01FEF10A657842Cull, 800, 260 },
+				{ 0x9B10A4E5E9913129ull, 827, 268 },
+				{ 0xE7109BFBA19C0C9Dull, 853, 276 },
+				{ 0xAC2820D9623BF429ull, 880, 284 },
+				{ 0x80444B5E7AA7CF85ull, 907, 292 },
+				{ 0xBF21E44003ACDD2Dull, 933, 300 },
+				{ 0x8E679C2F5E44FF8Full, 960, 308 },
+				{ 0xD433179D9C8CB841ull, 986, 316 },
+				{ 0x9E19DB92B4E31BA9ull, 1013, 324 },
+				{ 0xEB96BF6EBADF77D9ull, 1039, 332 },
+				{ 0xAF87023B9BF0EE6Bull, 1066, 340 },
+			};
+
+			/** @return The cached power C such that Alpha <= E + C.E + 64 <= Gamma. */
+			__forceinline const CachedPower& GetCachedPower(int32 E)
+			{
+				// Smallest K with 10^K >= 2^(Alpha - E - 1), 78913 / 2^18 approximates log10(2)
+				const int32 Exponent = Alpha - E - 1;
+				const int32 K = (Exponent * 78913) / (1 << 18) + (Exponent > 0 ? 1 : 0);
+				const int32 Index = (K - CachedPowersMinK + CachedPowersStepK - 1) / CachedPowersStepK;
+				Assert(Index >= 0 && Index < int32(ARRAY_COUNT(CachedPowers)));
+
+				const CachedPower& Cached = CachedPowers[Index];
+				Assert(Alpha <= E + Cached.E + 64 && E + Cached.E + 64 <= Gamma);
+				return Cached;
+			}
+
+			/** Moves the last digit towards the value while the digits stay in the rounding interval. */
+			__forceinline void RoundLastDigit(char* Digits, int32 NumDigits, uint64 Distance, uint64 Delta, uint64 Rest, uint64 TenK)
+			{
+				while (Rest < Distance && Delta - Rest >= TenK && (Rest + TenK < Distance || Distance - Rest > Rest + TenK - Distance))
+				{
+					Digits[NumDigits - 1]--;
+					Rest += TenK;
+				}
+			}
+
+			/**
+			* Generates the digits of a number in [Minus, Plus], as close to W as possible.
+			* @return The number of digits, the number being Digits * 10^DecimalExponent
+			*/
+			int32 GenerateDigits(char* Digits, int32& DecimalExponent, const DiyFp& Minus, const DiyFp& W, const DiyFp& Plus)
+			{
+				const int32 Shift = -Plus.E;
+				const uint64 One = uint64(1) << Shift;
+
+				uint64 Delta = Plus.F - Minus.F;
+				uint64 Distance = Plus.F - W.F;
+
+				uint32 Integral = uint32(Plus.F >> Shift);
+				uint64 Fractional = Plus.F & (One - 1);
+
+				int32 NumIntegralDigits = 1;
+				while (NumIntegralDigits < 10 && Integral >= Pow10[NumIntegralDigits])
+				{
+					NumIntegralDigits++;
+				}
+
+				int32 NumDigits = 0;
+				for (int32 n = NumIntegralDigits - 1; n >= 0; n--)
+				{
+					const uint32 Divisor = uint32(Pow10[n]);
+					Digits[NumDigits++] = char('0' + Integral / Divisor);
+					Integral %= Divisor;
+
+					const uint64 Rest = (uint64(Integral) << Shift) + Fractional;
+					if (Rest <= Delta)
+					{
+						DecimalExponent += n;
+						RoundLastDigit(Digits, NumDigits, Distance, Delta, Rest, uint64(Divisor) << Shift);
+						return NumDigits;
+					}
+				}
+
+				int32 NumFractionalDigits = 0;
+				do
+				{
+					Fractional *= 10;
+					Delta *= 10;
+					Distance *= 10;
+					Digits[NumDigits++] = char('0' + (Fractional >> Shift));
+					Fractional &= One - 1;
+					NumFractionalDigits++;
+				} while (Fractional > Delta);
+
+				DecimalExponent -= NumFractionalDigits;
+				RoundLastDigit(Digits, NumDigits, Distance, Delta, Fractional, One);
+				return NumDigits;
+			}
+
+			/**
+			* Shortest digits of a positive finite float or double, at most 17.
+			* @return The number of digits, the value being Digits * 10^DecimalExponent
+			*/
+			template<typename FloatType, typename BitsType, int32 Precision>
+			int32 ShortestDigits(FloatType Value, char* Digits, int32& DecimalExponent)
+			{
+				const int32 Bias = (1 << (sizeof(FloatType) * 8 - Precision - 1)) - 1 + Precision - 1;
+				const uint64 HiddenBit = uint64(1) << (Precision - 1);
+
+				BitsType Bits;
+				Memory::Memcpy(&Bits, &Value, sizeof(Value));
+				const int32 BiasedExponent = int32(Bits >> (Precision - 1));
+				const uint64 Fraction = Bits & (HiddenBit - 1);
+
+				const DiyFp V = BiasedExponent == 0 ? DiyFp(Fraction, 1 - Bias) : DiyFp(Fraction + HiddenBit, BiasedExponent - Bias);
+
+				// The bounds are halfway to the neighbouring floats, the lower one is closer at powers of two
+				const bool bLowerBoundIsCloser = Fraction == 0 && BiasedExponent > 1;
+				const DiyFp Plus = DiyFp(2 * V.F + 1, V.E - 1).Normalize();
+				DiyFp Minus = bLowerBoundIsCloser ? DiyFp(4 * V.F - 1, V.E - 2) : DiyFp(2 * V.F - 1, V.E - 1);
+				Minus = DiyFp(Minus.F << (Minus.E - Plus.E), Plus.E);
+
+				const CachedPower& Cached = GetCachedPower(Plus.E);
+				const DiyFp C(Cached.F, Cached.E);
+
+				const DiyFp W = V.Normalize() * C;
+				const DiyFp ScaledMinus = Minus * C;
+				const DiyFp ScaledPlus = Plus * C;
+
+				// Shrink the interval by one unit on each side to stay inside it despite the rounding of the products
+				DecimalExponent = -Cached.K;
+				return GenerateDigits(Digits, DecimalExponent, DiyFp(ScaledMinus.F + 1, ScaledMinus.E), W, DiyFp(ScaledPlus.F - 1, ScaledPlus.E));
+			}
+		}
+
+		/**
+		* Writes the shortest digits of a positive value, in fixed notation between 1e-5 and 1e17, scientific otherwise.
+		* @return The number of characters written
+		*/
+		int32 WriteShortest(const char* Digits, int32 NumDigits, int32 DecimalExponent, TCHAR* pOut)
+		{
+			// Position of the decimal point relative to the first digit
+			const int32 Point = NumDigits + DecimalExponent;
+
+			TCHAR* p = pOut;
+			if (Point > -5 && Point <= 17)
+			{
+				if (Point <= 0)
+				{
+					*p++ = '0';
+					*p++ = '.';
+					for (int32 i = Point; i < 0; i++)
+					{
+						*p++ = '0';
+					}
+					for (int32 i = 0; i < NumDigits; i++)
+					{
+						*p++ = TCHAR(Digits[i]);
+					}
+				}
+				else
+				{
+					for (int32 i = 0; i < NumDigits; i++)
+					{
+						if (i == Point)
+						{
+							*p++ = '.';
+						}
+						*p++ = TCHAR(Digits[i]);
+					}
+					for (int32 i = NumDigits; i < Point; i++)
+					{
+						*p++ = '0';
+					}
+				}
+			}
+			else
+			{
+				*p++ = TCHAR(Digits[0]);
+				if (NumDigits > 1)
+				{
+					*p++ = '.';
+					for (int32 i = 1; i < NumDigits; i++)
+					{
+						*p++ = TCHAR(Digits[i]);
+					}
+				}
+
+				*p++ = 'e';
+				int32 Exponent = Point - 1;
+				if (Exponent < 0)
+				{
+					*p++ = '-';
+					Exponent = -Exponent;
+				}
+
+				TCHAR Buffer[4];
+				const TCHAR* pExponent = WriteDecimal(uint64(Exponent), Buffer + ARRAY_COUNT(Buffer));
+				while (pExponent < Buffer + ARRAY_COUNT(Buffer))
+				{
+					*p++ = *pExponent++;
+				}
+			}
+
+			return int32(p - pOut);
+		}
+
+		/**
+		* Scales a positive finite double by 10^Precision and rounds it to an integer, half to even, with exact integer
+		* arithmetic so the result matches a correctly rounded printf.
+		*
+		* @return false if Precision is above 17 or the result doesn't fit in 64 bits
+		*/
+		bool ScaleExact(double Value, int32 Precision, uint64& OutScaled)
+		{
+			if (Precision >= int32(ARRAY_COUNT(Pow10)) - 1)
+			{
+				return false;
+			}
+
+			uint64 Bits;
+			Memory::Memcpy(&Bits, &Value, sizeof(Value));
+			const int32 BiasedExponent = int32(Bits >> 52);
+			const uint64 Fraction = Bits & ((uint64(1) << 52) - 1);
+			const uint64 Mantissa = BiasedExponent ? Fraction | (uint64(1) << 52) : Fraction;
+			const int32 Exponent = (BiasedExponent ? BiasedExponent : 1) - 1075;
+
+			// Value * 10^Precision = Mantissa * 10^Precision * 2^Exponent, the product has at most 110 bits
+			uint64 High;
+			const uint64 Low = Multiply128(Mantissa, Pow10[Precision], High);
+
+			if (Exponent >= 0)
+			{
+				if (High != 0 || Exponent >= 64 || (Exponent > 0 && (Low >> (64 - Exponent)) != 0))
+				{
+					return false;
+				}
+
+				OutScaled = Low << Exponent;
+				return true;
+			}
+
+			const int32 Shift = -Exponent;
+			if (Shift >= 128)
+			{
+				// The product is below half of 2^Shift
+				OutScaled = 0;
+				return true;
+			}
+
+			uint64 Quotient, RemainderHigh, RemainderLow, HalfHigh, HalfLow;
+			if (Shift >= 64)
+			{
+				const int32 HighShift = Shift - 64;
+				Quotient = High >> HighShift;
+				RemainderHigh = HighShift ? High & ((uint64(1) << HighShift) - 1) : 0;
+				RemainderLow = Low;
+				HalfHigh = HighShift ? uint64(1) << (HighShift - 1) : 0;
+				HalfLow = HighShift ? 0 : uint64(1) << 63;
+			}
+			else
+			{
+				if ((High >> Shift) != 0)
+				{
+					return false;
+				}
+
+				Quotient = (High << (64 - Shift)) | (Low >> Shift);
+				RemainderHigh = 0;
+				RemainderLow = Low & ((uint64(1) << Shift) - 1);
+				HalfHigh = 0;
+				HalfLow = uint64(1) << (Shift - 1);
+			}
+
+			const bool bAboveHalf = RemainderHigh > HalfHigh || (RemainderHigh == HalfHigh && RemainderLow > HalfLow);
+			const bool bHalf = RemainderHigh == HalfHigh && RemainderLow == HalfLow;
+			if (bAboveHalf || (bHalf && (Quotient & 1)))
+			{
+				if (Quotient == ~uint64(0))
+				{
+					return false;
+				}
+				Quotient++;
+			}
+
+			OutScaled = Quotient;
+			return true;
+		}
+
+		void WriteInteger(FormatOutput& Out, const StringFormat_Private::FormatArg& Arg, const FormatSpec& Spec)
+		{
+			TCHAR Buffer[24];
+			TCHAR* pEnd = Buffer + ARRAY_COUNT(Buffer);
+			TCHAR* pStart;
+
+			if (Spec.Type == 'x' || Spec.Type == 'X')
+			{
+				// Negative values show their two's complement in the size of their type
+				const uint64 Mask = Arg.Size >= sizeof(uint64) ? ~uint64(0) : (uint64(1) << (Arg.Size * 8)) - 1;
+				pStart = WriteHex(Arg.UnsignedValue & Mask, pEnd, Spec.Type == 'X');
+			}
+			else if (Arg.Type == StringFormat_Private::FormatArg::SignedInt && Arg.SignedValue < 0)
+			{
+				pStart = WriteDecimal(uint64(0) - uint64(Arg.SignedValue), pEnd);
+				*--pStart = '-';
+			}
+			else
+			{
+				pStart = WriteDecimal(Arg.UnsignedValue, pEnd);
+			}
+
+			Out.WritePadded(pStart, int32(pEnd - pStart), Spec, true);
+		}
+
+		void WriteFloat(FormatOutput& Out, double Value, bool bSingle, const FormatSpec& Spec)
+		{
+			if (Math::IsNaN(Value))
+			{
+				Out.WritePadded(EDX_TEXT("nan"), 3, Spec, false);
+				return;
+			}
+
+			const bool bNegative = Value < 0 || (Value == 0 && 1 / Value < 0);
+			const double Magnitude = bNegative ? -Value : Value;
+			if (Magnitude > std::numeric_limits<double>::max())
+			{
+				Out.WritePadded(bNegative ? EDX_TEXT("-inf") : EDX_TEXT("inf"), bNegative ? 4 : 3, Spec, false);
+				return;
+			}
+
+			if (Spec.Type == 'e')
+			{
+				TCHAR Buffer[96];
+				const int32 Length = CString::Snprintf(Buffer, ARRAY_COUNT(Buffer), EDX_TEXT("%.*e"), Spec.Precision == INDEX_NONE ? 6 : Spec.Precision, Value);
+				Out.WritePadded(Buffer, Math::Clamp(Length, 0, int32(ARRAY_COUNT(Buffer)) - 1), Spec, true);
+				return;
+			}
+
+			TCHAR Buffer[64];
+			TCHAR* p = Buffer;
+			if (bNegative)
+			{
+				*p++ = '-';
+			}
+
+			if (Spec.Type == 'f' || Spec.Precision != INDEX_NONE)
+			{
+				const int32 Precision = Spec.Precision == INDEX_NONE ? 6 : Spec.Precision;
+
+				uint64 Scaled;
+				if (!ScaleExact(Magnitude, Precision, Scaled))
+				{
+					// Large values and precisions, rare enough to leave to the CRT
+					TCHAR LongBuffer[FormatSpec::MaxPrecision + 320];
+					const int32 Length = CString::Snprintf(LongBuffer, ARRAY_COUNT(LongBuffer), EDX_TEXT("%.*f"), Precision, Value);
+					Out.WritePadded(LongBuffer, Math::Clamp(Length, 0, int32(ARRAY_COUNT(LongBuffer)) - 1), Spec, true);
+					return;
+				}
+
+				const uint64 Integral = Scaled / Pow10[Precision];
+				TCHAR Digits[24];
+				TCHAR* pDigitsEnd = Digits + ARRAY_COUNT(Digits);
+				for (const TCHAR* pDigit = WriteDecimal(Integral, pDigitsEnd); pDigit < pDigitsEnd; pDigit++)
+				{
+					*p++ = *pDigit;
+				}
+
+				if (Precision > 0)
+				{
+					*p++ = '.';
+					p += Precision;
+
+					uint64 FractionalPart = Scaled - Integral * Pow10[Precision];
+					for (int32 i = 1; i <= Precision; i++)
+					{
+						p[-i] = TCHAR('0' + FractionalPart % 10);
+						FractionalPart /= 10;
+					}
+				}
+			}
+			else if (Magnitude == 0)
+			{
+				*p++ = '0';
+			}
+			else
+			{
+				char Digits[20];
+				int32 DecimalExponent;
+				const int32 NumDigits = bSingle
+					? Grisu::ShortestDigits<float, uint32, 24>(float(Magnitude), Digits, DecimalExponent)
+					: Grisu::ShortestDigits<double, uint64, 53>(Magnitude, Digits, DecimalExponent);
+				p += WriteShortest(Digits, NumDigits, DecimalExponent, p);
+			}
+
+			Out.WritePadded(Buffer, int32(p - Buffer), Spec, true);
+		}
+
+		void WriteArg(FormatOutput& Out, const StringFormat_Private::FormatArg& Arg, const FormatSpec& Spec)
+		{
+			typedef StringFormat_Private::FormatArg FormatArg;
+
+			switch (Arg.Type)
+			{
+			case FormatArg::SignedInt:
+			case FormatArg::UnsignedInt:
+				WriteInteger(Out, Arg, Spec);
+				break;
+
+			case FormatArg::Float:
+				WriteFloat(Out, Arg.FloatValue, true, Spec);
+				break;
+
+			case FormatArg::Double:
+				WriteFloat(Out, Arg.DoubleValue, false, Spec);
+				break;
+
+			case FormatArg::Bool:
+				Out.WritePadded(Arg.BoolValue ? EDX_TEXT("true") : EDX_TEXT("false"), Arg.BoolValue ? 4 : 5, Spec, false);
+				break;
+
+			case FormatArg::Char:
+				Out.WritePadded(&Arg.CharValue, 1, Spec, false);
+				break;
+
+			case FormatArg::Chars:
+				Out.WritePadded(Arg.CharsValue.pChars, Spec.Precision == INDEX_NONE ? Arg.CharsValue.Len : Math::Min(Arg.CharsValue.Len, Spec.Precision), Spec, false);
+				break;
+
+			case FormatArg::Pointer:
+			{
+				TCHAR Buffer[24];
+				TCHAR* pEnd = Buffer + ARRAY_COUNT(Buffer);
+				TCHAR* pStart = WriteHex(uint64(size_t(Arg.pPointerValue)), pEnd, Spec.Type == 'X');
+				*--pStart = 'x';
+				*--pStart = '0';
+				Out.WritePadded(pStart, int32(pEnd - pStart), Spec, false);
+				break;
+			}
+
+			case FormatArg::Custom:
+				Arg.CustomValue.pFormat(Out, Arg.CustomValue.pValue, Spec);
+				break;
+
+			default:
+				Assert(false);
+			}
+		}
+	}
+
+	void FormatOutput::WriteFill(TCHAR Char, int32 Count)
+	{
+		while (Count > 0)
+		{
+			const int32 NumChars = Math::Min(Count, mCapacity - mLength);
+			for (int32 i = 0; i < NumChars; i++)
+			{
+				mpBuffer[mLength + i] = Char;
+			}
+			mLength += NumChars;
+			Count -= NumChars;
+
+			if (Count > 0)
+			{
+				if (!mpString)
+				{
+					return;
+				}
+
+				mpString->AppendChars(mpBuffer, mLength);
+				mLength = 0;
+			}
+		}
+	}
+
+	void FormatOutput::WritePadded(const TCHAR* pChars, int32 NumChars, const FormatSpec& Spec, bool bNumeric)
+	{
+		const int32 NumPadding = Spec.Width - NumChars;
+		if (NumPadding <= 0)
+		{
+			Write(pChars, NumChars);
+		}
+		else if (Spec.bLeftAlign)
+		{
+			Write(pChars, NumChars);
+			WriteFill(' ', NumPadding);
+		}
+		else if (Spec.bZeroPad && bNumeric)
+		{
+			if (NumChars > 0 && (*pChars == '-' || *pChars == '+'))
+			{
+				Write(*pChars);
+				pChars++;
+				NumChars--;
+			}
+			WriteFill('0', NumPadding);
+			Write(pChars, NumChars);
+		}
+		else
+		{
+			WriteFill(' ', NumPadding);
+			Write(pChars, NumChars);
+		}
+	}
+
+	int32 FormatOutput::Finish()
+	{
+		if (mpString)
+		{
+			mpString->AppendChars(mpBuffer, mLength);
+			mLength = 0;
+			return 0;
+		}
+
+		mpBuffer[mLength] = 0;
+		return mLength;
+	}
+
+	void FormatOutput::WriteSlow(const TCHAR* pChars, int32 NumChars)
+	{
+		if (mpString)
+		{
+			// Flush the buffer, and skip it for long runs of characters
+			mpString->AppendChars(mpBuffer, mLength);
+			mLength = 0;
+			if (NumChars > mCapacity)
+			{
+				mpString->AppendChars(pChars, NumChars);
+				return;
+			}
+		}
+		else
+		{
+			NumChars = Math::Min(NumChars, mCapacity - mLength);
+		}
+
+		Memory::Memcpy(mpBuffer + mLength, pChars, NumChars * sizeof(TCHAR));
+		mLength += NumChars;
+	}
+
+	namespace StringFormat_Private
+	{
+		void FormatArgs(FormatOutput& Out, const TCHAR* Fmt, const FormatArg* Args, int32 NumArgs)
+		{
+			int32 ArgIndex = 0;
+			const TCHAR* pLiteral = Fmt;
+			const TCHAR* p = Fmt;
+			while (*p)
+			{
+				if (*p != '{' && *p != '}')
+				{
+					p++;
+					continue;
+				}
+
+				Out.Write(pLiteral, int32(p - pLiteral));
+
+				// "{{" and "}}" write a single brace
+				if (p[1] == *p)
+				{
+					pLiteral = p + 1;
+					p += 2;
+					continue;
+				}
+
+				FormatSpec Spec;
+				const TCHAR* pNext = *p == '{' ? ParseFormatSpec(p + 1, Spec) : nullptr;
+				if (!pNext)
+				{
+					Assertf(false, EDX_TEXT("Malformed placeholder or unmatched brace in format string \"%s\""), Fmt);
+					return;
+				}
+
+				Assertf(ArgIndex < NumArgs, EDX_TEXT("Not enough arguments for format string \"%s\""), Fmt);
+				if (ArgIndex < NumArgs)
+				{
+					WriteArg(Out, Args[ArgIndex++], Spec);
+				}
+
+				pLiteral = p = pNext;
+			}
+
+			Out.Write(pLiteral, int32(p - pLiteral));
+			Assertf(ArgIndex == NumArgs, EDX_TEXT("Too many arguments for format string \"%s\""), Fmt);
+		}
+	}
+}
@@ -0,0 +1,418 @@
+#pragma once
+
+#include "StringView.h"
+
+namespace EDX
+{
+	/**
+	* Options of a placeholder, "{:[<|>][0][Width][.Precision][Type]}" in a format string.
+	*/
+	struct FormatSpec
+	{
+		enum { MaxWidth = 1024, MaxPrecision = 64 };
+
+		/** Minimum number of characters, padded with spaces, or with zeros after the sign if bZeroPad is set. */
+		int32 Width;
+
+		/** Digits after the decimal point of floats, maximum number of characters of strings, INDEX_NONE if not given. */
+		int32 Precision;
+
+		/** 'x' or 'X' for hexadecimal integers, 'f' for fixed or 'e' for scientific floats, 0 for the default. */
+		TCHAR Type;
+
+		/** Pads on the right instead of the left. */
+		bool bLeftAlign;
+		bool bZeroPad;
+
+		constexpr FormatSpec()
+			: Width(0)
+			, Precision(INDEX_NONE)
+			, Type(0)
+			, bLeftAlign(false)
+			, bZeroPad(false)
+		{
+		}
+	};
+
+	/**
+	* Where StringFormat writes to: a caller supplied buffer, dropping the characters which don't fit, or the end
+	* of a String, through a scratch buffer appended to it whenever it fills up.
+	*/
+	class FormatOutput
+	{
+	private:
+		TCHAR* mpBuffer;
+		int32 mCapacity;
+		int32 mLength;
+		String* mpString;
+
+	public:
+		/** Writes to a buffer of BufferSize characters, the null terminator included. */
+		FormatOutput(TCHAR* pBuffer, int32 BufferSize)
+			: mpBuffer(pBuffer)
+			, mCapacity(BufferSize - 1)
+			, mLength(0)
+			, mpString(nullptr)
+		{
+			Assert(pBuffer && BufferSize > 0);
+		}
+
+		/** Appends to Str, pBuffer only holds the characters not appended yet. */
+		FormatOutput(String& Str, TCHAR* pBuffer, int32 BufferSize)
+			: mpBuffer(pBuffer)
+			, mCapacity(BufferSize)
+			, mLength(0)
+			, mpString(&Str)
+		{
+			Assert(pBuffer && BufferSize > 0);
+		}
+
+		__forceinline void Write(TCHAR Char)
+		{
+			if (mLength < mCapacity)
+			{
+				mpBuffer[mLength++] = Char;
+			}
+			else
+			{
+				WriteSlow(&Char, 1);
+			}
+		}
+
+		__forceinline void Write(const TCHAR* pChars, int32 NumChars)
+		{
+			if (NumChars <= mCapacity - mLength)
+			{
+				Memory::Memcpy(mpBuffer + mLength, pChars, NumChars * sizeof(TCHAR));
+				mLength += NumChars;
+			}
+			else
+			{
+				WriteSlow(pChars, NumChars);
+			}
+		}
+
+		/** Writes Count copies of a character. */
+		void WriteFill(TCHAR Char, int32 Count);
+
+		/**
+		* Writes characters padded to the width of a placeholder.
+		*
+		* @param pChars The characters to write
+		* @param NumChars The number of characters
+		* @param Spec The options of the placeholder
+		* @param bNumeric Whether zero padding applies, the zeros are inserted after the sign
+		*/
+		void WritePadded(const TCHAR* pChars, int32 NumChars, const FormatSpec& Spec, bool bNumeric);
+
+		/**
+		* Null terminates the buffer, or appends what is left in it to the String.
+		* @return The number of characters in the buffer, not counting the terminator
+		*/
+		int32 Finish();
+
+	private:
+		void WriteSlow(const TCHAR* pChars, int32 NumChars);
+	};
+
+	namespace StringFormat_Private
+	{
+		/** Argument of StringFormat with its type erased, so the formatting code isn't instantiated per call site. */
+		struct FormatArg
+		{
+			typedef void (*CustomFormatFunc)(FormatOutput& Out, const void* pValue, const FormatSpec& Spec);
+
+			enum EType : uint8 { None, SignedInt, UnsignedInt, Float, Double, Bool, Char, Chars, Pointer, Custom };
+
+			EType Type;
+
+			/** Size in bytes of integers, hexadecimal formats only show these bytes of negative values. */
+			uint8 Size;
+
+			union
+			{
+				int64 SignedValue;
+				uint64 UnsignedValue;
+				float FloatValue;
+				double DoubleValue;
+				bool BoolValue;
+				TCHAR CharValue;
+				const void* pPointerValue;
+				struct { const TCHAR* pChars; int32 Len; } CharsValue;
+				struct { const void* pValue; CustomFormatFunc pFormat; } CustomValue;
+			};
+
+			__forceinline FormatArg() : Type(None), Size(0), UnsignedValue(0) {}
+
+			__forceinline FormatArg(signed char Value) : Type(SignedInt), Size(sizeof(Value)), SignedValue(Value) {}
+			__forceinline FormatArg(short Value) : Type(SignedInt), Size(sizeof(Value)), SignedValue(Value) {}
+			__forceinline FormatArg(int Value) : Type(SignedInt), Size(sizeof(Value)), SignedValue(Value) {}
+			__forceinline FormatArg(long Value) : Type(SignedInt), Size(sizeof(Value)), SignedValue(Value) {}
+			__forceinline FormatArg(long long Value) : Type(SignedInt), Size(sizeof(Value)), SignedValue(Value) {}
+			__forceinline FormatArg(unsigned char Value) : Type(UnsignedInt), Size(sizeof(Value)), UnsignedValue(Value) {}
+			__forceinline FormatArg(unsigned short Value) : Type(UnsignedInt), Size(sizeof(Value)), UnsignedValue(Value) {}
+			__forceinline FormatArg(unsigned int Value) : Type(UnsignedInt), Size(sizeof(Value)), UnsignedValue(Value) {}
+			__forceinline FormatArg(unsigned long Value) : Type(UnsignedInt), Size(sizeof(Value)), UnsignedValue(Value) {}
+			__forceinline FormatArg(unsigned long long Value) : Type(UnsignedInt), Size(sizeof(Value)), UnsignedValue(Value) {}
+			__forceinline FormatArg(float Value) : Type(Float), Size(sizeof(Value)), FloatValue(Value) {}
+			__forceinline FormatArg(double Value) : Type(Double), Size(sizeof(Value)), DoubleValue(Value) {}
+			__forceinline FormatArg(bool Value) : Type(Bool), Size(sizeof(Value)), BoolValue(Value) {}
+			__forceinline FormatArg(ANSICHAR Value) : Type(Char), Size(sizeof(TCHAR)), CharValue(TCHAR(Value)) {}
+			__forceinline FormatArg(WIDECHAR Value) : Type(Char), Size(sizeof(TCHAR)), CharValue(TCHAR(Value)) {}
+
+			__forceinline FormatArg(const TCHAR* Value)
+				: Type(Chars)
+				, Size(0)
+			{
+				CharsValue.pChars = Value ? Value : EDX_TEXT("");
+				CharsValue.Len = CString::Strlen(CharsValue.pChars);
+			}
+
+			__forceinline FormatArg(const String& Value)
+				: Type(Chars)
+				, Size(0)
+			{
+				CharsValue.pChars = *Value;
+				CharsValue.Len = Value.Len();
+			}
+
+			__forceinline FormatArg(const StringView& Value)
+				: Type(Chars)
+				, Size(0)
+			{
+				CharsValue.pChars = Value.Data();
+				CharsValue.Len = Value.Len();
+			}
+
+			__forceinline FormatArg(TCHAR* Value)
+				: FormatArg((const TCHAR*)Value)
+			{
+			}
+
+			/** Other pointers are written as hexadecimal addresses. */
+			template<typename T>
+			__forceinline FormatArg(T* Value)
+				: Type(Pointer)
+				, Size(sizeof(Value))
+				, pPointerValue(Value)
+			{
+			}
+
+			/** Any other type is written by a FormatValue overload found by argument dependent lookup. */
+			template<typename T>
+			__forceinline FormatArg(const T& Value)
+				: Type(Custom)
+				, Size(0)
+			{
+				CustomValue.pValue = &Value;
+				CustomValue.pFormat = &FormatCustom<T>;
+			}
+
+		private:
+			template<typename T>
+			static void FormatCustom(FormatOutput& Out, const void* pValue, const FormatSpec& Spec)
+			{
+				FormatValue(Out, *(const T*)pValue, Spec);
+			}
+		};
+
+		/**
+		* Parses the options of a placeholder, shared by the formatting and by the compile time checks.
+		*
+		* @param p The characters following the opening brace
+		* @param Spec Out the options
+		* @return The character following the closing brace, nullptr if the placeholder is malformed
+		*/
+		constexpr const TCHAR* ParseFormatSpec(const TCHAR* p, FormatSpec& Spec)
+		{
+			if (*p == ':')
+			{
+				p++;
+				if (*p == '<' || *p == '>')
+				{
+					Spec.bLeftAlign = *p++ == '<';
+				}
+				if (*p == '0')
+				{
+					Spec.bZeroPad = true;
+					p++;
+				}
+				for (; *p >= '0' && *p <= '9'; p++)
+				{
+					Spec.Width = Spec.Width * 10 + (*p - '0');
+					if (Spec.Width > FormatSpec::MaxWidth)
+					{
+						return nullptr;
+					}
+				}
+				if (*p == '.')
+				{
+					p++;
+					if (*p < '0' || *p > '9')
+					{
+						return nullptr;
+					}
+
+					Spec.Precision = 0;
+					for (; *p >= '0' && *p <= '9'; p++)
+					{
+						Spec.Precision = Spec.Precision * 10 + (*p - '0');
+						if (Spec.Precision > FormatSpec::MaxPrecision)
+						{
+							return nullptr;
+						}
+					}
+				}
+				if (*p == 'x' || *p == 'X' || *p == 'f' || *p == 'e')
+				{
+					Spec.Type = *p++;
+				}
+			}
+
+			return *p == '}' ? p + 1 : nullptr;
+		}
+
+		/** @return The number of placeholders in a format string, INDEX_NONE if it is malformed. */
+		constexpr int32 CountPlaceholders(const TCHAR* Fmt)
+		{
+			int32 Count = 0;
+			while (*Fmt)
+			{
+				if ((*Fmt == '{' || *Fmt == '}') && Fmt[1] == *Fmt)
+				{
+					Fmt += 2;
+				}
+				else if (*Fmt == '{')
+				{
+					FormatSpec Spec;
+					Fmt = ParseFormatSpec(Fmt + 1, Spec);
+					if (!Fmt)
+					{
+						return INDEX_NONE;
+					}
+					Count++;
+				}
+				else if (*Fmt == '}')
+				{
+					return INDEX_NONE;
+				}
+				else
+				{
+					Fmt++;
+				}
+			}
+
+			return Count;
+		}
+
+		/** Base of the format strings made by EDX_FORMAT. */
+		struct CompileTimeFormat
+		{
+		};
+
+		template<int32 NumArgs>
+		__forceinline const TCHAR* CheckFormat(const TCHAR* Fmt)
+		{
+			return Fmt;
+		}
+
+		template<int32 NumArgs>
+		__forceinline const TCHAR* CheckFormat(const String& Fmt)
+		{
+			return *Fmt;
+		}
+
+		template<int32 NumArgs, typename FormatType>
+		__forceinline typename EnableIf<IsDerivedFrom<FormatType, CompileTimeFormat>::IsDerived, const TCHAR*>::Type CheckFormat(const FormatType&)
+		{
+			static_assert(CountPlaceholders(FormatType::Get()) != INDEX_NONE, "Malformed placeholder or unmatched brace in format string");
+			static_assert(CountPlaceholders(FormatType::Get()) == NumArgs, "The number of placeholders in the format string doesn't match the number of arguments");
+			return FormatType::Get();
+		}
+
+		void FormatArgs(FormatOutput& Out, const TCHAR* Fmt, const FormatArg* Args, int32 NumArgs);
+	}
+
+	/**
+	* Type safe replacement of Printf. Each "{}" in the format string is replaced by the next argument, converted
+	* without going through the CRT: integers in decimal, floats in the shortest form reading back to the same value,
+	* strings, characters and bools as is. "{{" and "}}" write single braces. Placeholders can hold options, see
+	* FormatSpec:
+	*
+	* <code>
+	*	StringFormat::ToString(EDX_TEXT("{} samples in {:.2}ms, {:08X}"), NumSamples, Milliseconds, Flags);
+	* </code>
+	*
+	* Wrapping the format string in EDX_FORMAT checks the placeholders against the arguments at compile time.
+	* Other types are supported by overloading, in their namespace:
+	*
+	* <code>
+	*	void FormatValue(FormatOutput& Out, const Vector3& Value, const FormatSpec& Spec);
+	* </code>
+	*/
+	struct StringFormat
+	{
+		/**
+		* Writes to a caller supplied buffer, always null terminated. Characters which don't fit are dropped.
+		*
+		* @param Dest The buffer to write to
+		* @param DestSize The size of the buffer, in characters
+		* @param Fmt The format string
+		* @param Args The values replacing the placeholders
+		* @return The number of characters written, not counting the terminator
+		*/
+		template<typename FormatType, typename... ArgTypes>
+		static int32 ToBuffer(TCHAR* Dest, int32 DestSize, const FormatType& Fmt, const ArgTypes&... Args)
+		{
+			FormatOutput Out(Dest, DestSize);
+			Format(Out, Fmt, Args...);
+			return Out.Finish();
+		}
+
+		/** Appends to the end of a String. */
+		template<typename FormatType, typename... ArgTypes>
+		static void Append(String& Dest, const FormatType& Fmt, const ArgTypes&... Args)
+		{
+			TCHAR Buffer[256];
+			FormatOutput Out(Dest, Buffer, ARRAY_COUNT(Buffer));
+			Format(Out, Fmt, Args...);
+			Out.Finish();
+		}
+
+		template<typename FormatType, typename... ArgTypes>
+		static String ToString(const FormatType& Fmt, const ArgTypes&... Args)
+		{
+			String Result;
+			Append(Result, Fmt, Args...);
+			return Result;
+		}
+
+		/** Writes to an output, for FormatValue overloads made of several values. */
+		template<typename FormatType, typename... ArgTypes>
+		static void Format(FormatOutput& Out, const FormatType& Fmt, const ArgTypes&... Args)
+		{
+			const TCHAR* pFormat = StringFormat_Private::CheckFormat<sizeof...(ArgTypes)>(Fmt);
+
+			// One more element than arguments, arrays can't be empty
+			const StringFormat_Private::FormatArg ArgArray[] = { StringFormat_Private::FormatArg(Args)..., StringFormat_Private::FormatArg() };
+			StringFormat_Private::FormatArgs(Out, pFormat, ArgArray, sizeof...(ArgTypes));
+		}
+	};
+}
+
+/**
+* Makes a format string literal whose placeholders are checked against the arguments at compile time:
+*
+* <code>
+*	StringFormat::Append(Log, EDX_FORMAT("Frame {} took {:.3}ms\n"), FrameIndex, Milliseconds);
+* </code>
+*/
+#define EDX_FORMAT(Str) \
+	[]() \
+	{ \
+		struct CheckedFormat : EDX::StringFormat_Private::CompileTimeFormat \
+		{ \
+			static constexpr const TCHAR* Get() { return EDX_TEXT(Str); } \
+		}; \
+		return CheckedFormat(); \
+	}()
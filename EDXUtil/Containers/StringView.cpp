@@ -0,0 +1,356 @@
+#include "StringView.h"
+
+namespace EDX
+{
+	namespace
+	{
+		/**
+		* Parses decimal digits into an unsigned value no larger than Limit.
+		* @return false if there are no digits, a character isn't a digit or the value exceeds Limit
+		*/
+		template<typename UnsignedType>
+		bool ParseDigits(const TCHAR* p, const TCHAR* End, UnsignedType Limit, UnsignedType& OutValue)
+		{
+			if (p == End)
+			{
+				return false;
+			}
+
+			UnsignedType Value = 0;
+			for (; p < End; p++)
+			{
+				const UnsignedType Digit = UnsignedType(*p - LITERAL(TCHAR, '0'));
+				if (Digit > 9 || Value > (Limit - Digit) / 10)
+				{
+					return false;
+				}
+				Value = Value * 10 + Digit;
+			}
+
+			OutValue = Value;
+			return true;
+		}
+
+		template<typename SignedType, typename UnsignedType>
+		bool ParseSigned(const StringView& View, SignedType& OutValue)
+		{
+			const TCHAR* p = View.Data();
+			const TCHAR* End = p + View.Len();
+			const bool bNegative = p < End && *p == LITERAL(TCHAR, '-');
+			if (p < End && (*p == LITERAL(TCHAR, '-') || *p == LITERAL(TCHAR, '+')))
+			{
+				p++;
+			}
+
+			// The magnitude of the most negative value is one more than the largest positive one
+			const UnsignedType MaxPositive = UnsignedType(~UnsignedType(0)) >> 1;
+			UnsignedType Magnitude;
+			if (!ParseDigits(p, End, UnsignedType(MaxPositive + (bNegative ? 1 : 0)), Magnitude))
+			{
+				return false;
+			}
+
+			OutValue = bNegative ? SignedType(UnsignedType(0) - Magnitude) : SignedType(Magnitude);
+			return true;
+		}
+
+		template<typename UnsignedType>
+		bool ParseUnsigned(const StringView& View, UnsignedType& OutValue)
+		{
+			const TCHAR* p = View.Data();
+			const TCHAR* End = p + View.Len();
+			if (p < End && *p == LITERAL(TCHAR, '+'))
+			{
+				p++;
+			}
+
+			return ParseDigits(p, End, UnsignedType(~UnsignedType(0)), OutValue);
+		}
+
+		/** @return Whether the view is [+-](digits[.[digits]] | .digits)[(e|E)[+-]digits]. */
+		bool IsFloatLiteral(const StringView& View)
+		{
+			const TCHAR* p = View.Data();
+			const TCHAR* End = p + View.Len();
+			if (p < End && (*p == LITERAL(TCHAR, '-') || *p == LITERAL(TCHAR, '+')))
+			{
+				p++;
+			}
+
+			int32 NumDigits = 0;
+			for (; p < End && TChar<TCHAR>::IsDigit(*p); p++, NumDigits++);
+			if (p < End && *p == LITERAL(TCHAR, '.'))
+			{
+				for (p++; p < End && TChar<TCHAR>::IsDigit(*p); p++, NumDigits++);
+			}
+			if (NumDigits == 0)
+			{
+				return false;
+			}
+
+			if (p < End && (*p == LITERAL(TCHAR, 'e') || *p == LITERAL(TCHAR, 'E')))
+			{
+				p++;
+				if (p < End && (*p == LITERAL(TCHAR, '-') || *p == LITERAL(TCHAR, '+')))
+				{
+					p++;
+				}
+
+				const TCHAR* ExponentStart = p;
+				for (; p < End && TChar<TCHAR>::IsDigit(*p); p++);
+				if (p == ExponentStart)
+				{
+					return false;
+				}
+			}
+
+			return p == End;
+		}
+
+		__forceinline void ConvertNullTerminated(const TCHAR* pStr, float& OutValue)
+		{
+			// Straight to float, narrowing a double would round twice
+			OutValue = CString::Strtof(pStr, nullptr);
+		}
+
+		__forceinline void ConvertNullTerminated(const TCHAR* pStr, double& OutValue)
+		{
+			OutValue = CString::Atod(pStr);
+		}
+
+		/** Converts a validated float literal, CString needs it null terminated. */
+		template<typename FloatType>
+		void ConvertFloatLiteral(const StringView& View, FloatType& OutValue)
+		{
+			enum { MaxInlineLength = 64 };
+			if (View.Len() < MaxInlineLength)
+			{
+				TCHAR Buffer[MaxInlineLength];
+				Memory::Memcpy(Buffer, View.Data(), View.Len() * sizeof(TCHAR));
+				Buffer[View.Len()] = 0;
+				ConvertNullTerminated(Buffer, OutValue);
+				return;
+			}
+
+			ConvertNullTerminated(*View.ToString(), OutValue);
+		}
+	}
+
+	int32 StringView::Compare(const StringView& Other, ESearchCase SearchCase) const
+	{
+		const int32 NumChars = Math::Min(mLength, Other.mLength);
+		if (NumChars > 0)
+		{
+			const int32 Result = SearchCase == ESearchCase::IgnoreCase
+				? CString::Strnicmp(mpData, Other.mpData, NumChars)
+				: CString::Strncmp(mpData, Other.mpData, NumChars);
+			if (Result != 0)
+			{
+				return Result;
+			}
+		}
+
+		return mLength - Other.mLength;
+	}
+
+	int32 StringView::Find(const StringView& SubStr, ESearchCase SearchCase, ESearchDir SearchDir, int32 StartPosition) const
+	{
+		const int32 LastStart = mLength - SubStr.mLength;
+		if (LastStart < 0)
+		{
+			return INDEX_NONE;
+		}
+
+		if (SearchDir == ESearchDir::FromStart)
+		{
+			const int32 FirstStart = StartPosition == INDEX_NONE ? 0 : Math::Max(StartPosition, 0);
+			for (int32 i = FirstStart; i <= LastStart; i++)
+			{
+				if (StringView(mpData + i, SubStr.mLength).Compare(SubStr, SearchCase) == 0)
+				{
+					return i;
+				}
+			}
+		}
+		else
+		{
+			// Like String, matches have to end before StartPosition
+			const int32 FirstStart = StartPosition == INDEX_NONE ? LastStart : Math::Min(StartPosition - SubStr.mLength, LastStart);
+			for (int32 i = FirstStart; i >= 0; i--)
+			{
+				if (StringView(mpData + i, SubStr.mLength).Compare(SubStr, SearchCase) == 0)
+				{
+					return i;
+				}
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	bool StringView::Split(const StringView& Delim, StringView* LeftS, StringView* RightS, ESearchCase SearchCase, ESearchDir SearchDir) const
+	{
+		const int32 Pos = Find(Delim, SearchCase, SearchDir);
+		if (Pos == INDEX_NONE)
+		{
+			return false;
+		}
+
+		if (LeftS) { *LeftS = Left(Pos); }
+		if (RightS) { *RightS = Mid(Pos + Delim.Len()); }
+
+		return true;
+	}
+
+	int32 StringView::ParseIntoArray(Array<StringView>& OutArray, const TCHAR* pchDelim, bool InCullEmpty) const
+	{
+		// Make sure the delimit string is not null or empty
+		Assert(pchDelim);
+		OutArray.Clear();
+
+		const StringView Delim(pchDelim);
+		if (Delim.IsEmpty())
+		{
+			if (!InCullEmpty || mLength)
+			{
+				OutArray.Add(*this);
+			}
+			return OutArray.Size();
+		}
+
+		StringView Remaining = *this;
+		for (int32 At = Remaining.Find(Delim, ESearchCase::CaseSensitive); At != INDEX_NONE; At = Remaining.Find(Delim, ESearchCase::CaseSensitive))
+		{
+			if (!InCullEmpty || At)
+			{
+				OutArray.Add(Remaining.Left(At));
+			}
+			Remaining = Remaining.Mid(At + Delim.Len());
+		}
+		if (!InCullEmpty || Remaining.Len())
+		{
+			OutArray.Add(Remaining);
+		}
+
+		return OutArray.Size();
+	}
+
+	int32 StringView::ParseIntoArray(Array<StringView>& OutArray, const TCHAR** DelimArray, int32 NumDelims, bool InCullEmpty) const
+	{
+		Assert(DelimArray);
+		OutArray.Clear();
+
+		Array<int32, InlineAllocator<8>> DelimLengths;
+		DelimLengths.AddUninitialized(NumDelims);
+		for (int32 DelimIndex = 0; DelimIndex < NumDelims; ++DelimIndex)
+		{
+			DelimLengths[DelimIndex] = CString::Strlen(DelimArray[DelimIndex]);
+		}
+
+		int32 SubstringBeginIndex = 0;
+		for (int32 i = 0; i < mLength;)
+		{
+			int32 DelimiterLength = 0;
+			for (int32 DelimIndex = 0; DelimIndex < NumDelims; ++DelimIndex)
+			{
+				const int32 Length = DelimLengths[DelimIndex];
+				if (Length > 0 && Length <= mLength - i && mpData[i] == DelimArray[DelimIndex][0] && CString::Strncmp(mpData + i, DelimArray[DelimIndex], Length) == 0)
+				{
+					DelimiterLength = Length;
+					break;
+				}
+			}
+
+			if (DelimiterLength > 0)
+			{
+				if (!InCullEmpty || i != SubstringBeginIndex)
+				{
+					OutArray.Add(StringView(mpData + SubstringBeginIndex, i - SubstringBeginIndex));
+				}
+
+				i += DelimiterLength;
+				SubstringBeginIndex = i;
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		if (!InCullEmpty || SubstringBeginIndex != mLength)
+		{
+			OutArray.Add(StringView(mpData + SubstringBeginIndex, mLength - SubstringBeginIndex));
+		}
+
+		return OutArray.Size();
+	}
+
+	int32 StringView::ParseIntoArrayWS(Array<StringView>& OutArray, const TCHAR* pchExtraDelim, bool InCullEmpty) const
+	{
+		const TCHAR* WhiteSpace[] =
+		{
+			EDX_TEXT(" "),
+			EDX_TEXT("\t"),
+			EDX_TEXT("\r"),
+			EDX_TEXT("\n"),
+			pchExtraDelim,
+		};
+
+		const bool bExtraDelim = pchExtraDelim && *pchExtraDelim;
+		return ParseIntoArray(OutArray, WhiteSpace, ARRAY_COUNT(WhiteSpace) - (bExtraDelim ? 0 : 1), InCullEmpty);
+	}
+
+	int32 StringView::ParseIntoArrayLines(Array<StringView>& OutArray, bool InCullEmpty) const
+	{
+		static const TCHAR* LineEndings[] =
+		{
+			EDX_TEXT("\r\n"),
+			EDX_TEXT("\r"),
+			EDX_TEXT("\n"),
+		};
+
+		return ParseIntoArray(OutArray, LineEndings, ARRAY_COUNT(LineEndings), InCullEmpty);
+	}
+
+	bool StringView::ParseInt(int32& OutValue) const
+	{
+		return ParseSigned<int32, uint32>(*this, OutValue);
+	}
+
+	bool StringView::ParseInt(int64& OutValue) const
+	{
+		return ParseSigned<int64, uint64>(*this, OutValue);
+	}
+
+	bool StringView::ParseInt(uint32& OutValue) const
+	{
+		return ParseUnsigned(*this, OutValue);
+	}
+
+	bool StringView::ParseInt(uint64& OutValue) const
+	{
+		return ParseUnsigned(*this, OutValue);
+	}
+
+	bool StringView::ParseFloat(float& OutValue) const
+	{
+		if (!IsFloatLiteral(*this))
+		{
+			return false;
+		}
+
+		ConvertFloatLiteral(*this, OutValue);
+		return true;
+	}
+
+	bool StringView::ParseFloat(double& OutValue) const
+	{
+		if (!IsFloatLiteral(*this))
+		{
+			return false;
+		}
+
+		ConvertFloatLiteral(*this, OutValue);
+		return true;
+	}
+}
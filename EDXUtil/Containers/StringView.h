@@ -0,0 +1,314 @@
+#pragma once
+
+#include "String.h"
+
+namespace EDX
+{
+	/**
+	* A non-owning view of a range of characters: a pointer and a length, not necessarily null terminated.
+	* Views are cheap to copy and never allocate, so parsers can walk a buffer and split it into tokens
+	* without creating a String per token. The viewed characters must outlive the view.
+	*
+	* Comparisons ignore case by default, like String.
+	*/
+	class StringView
+	{
+	private:
+		const TCHAR* mpData;
+		int32 mLength;
+
+	public:
+		__forceinline StringView()
+			: mpData(EDX_TEXT(""))
+			, mLength(0)
+		{
+		}
+
+		/** Views a null terminated string. */
+		__forceinline StringView(const TCHAR* InData)
+			: mpData(InData)
+			, mLength(CString::Strlen(InData))
+		{
+		}
+
+		/** Views Length characters starting at InData. */
+		__forceinline StringView(const TCHAR* InData, int32 InLength)
+			: mpData(InData)
+			, mLength(InLength)
+		{
+			Assert(InLength >= 0);
+		}
+
+		/** Views the characters of a String, valid until the String is modified or destroyed. */
+		__forceinline StringView(const String& Str)
+			: mpData(*Str)
+			, mLength(Str.Len())
+		{
+		}
+
+		/** @return Pointer to the first character, not null terminated. */
+		__forceinline const TCHAR* Data() const
+		{
+			return mpData;
+		}
+
+		/** @return Number of characters in the view. */
+		__forceinline int32 Len() const
+		{
+			return mLength;
+		}
+
+		__forceinline bool IsEmpty() const
+		{
+			return mLength == 0;
+		}
+
+		__forceinline bool IsValidIndex(int32 Index) const
+		{
+			return Index >= 0 && Index < mLength;
+		}
+
+		__forceinline const TCHAR& operator[](int32 Index) const
+		{
+			Assertf(IsValidIndex(Index), EDX_TEXT("StringView index out of bounds: Index %i from a view with a length of %i"), Index, mLength);
+			return mpData[Index];
+		}
+
+		/** @return A String holding a copy of the characters. */
+		__forceinline String ToString() const
+		{
+			return mLength ? String(mLength, mpData) : String();
+		}
+
+		/** @return The first Count characters. */
+		__forceinline StringView Left(int32 Count) const
+		{
+			return StringView(mpData, Math::Clamp(Count, 0, mLength));
+		}
+
+		/** @return The view without its last Count characters. */
+		__forceinline StringView LeftChop(int32 Count) const
+		{
+			return StringView(mpData, Math::Clamp(mLength - Count, 0, mLength));
+		}
+
+		/** @return The last Count characters. */
+		__forceinline StringView Right(int32 Count) const
+		{
+			const int32 NumChars = Math::Clamp(Count, 0, mLength);
+			return StringView(mpData + mLength - NumChars, NumChars);
+		}
+
+		/** @return The view without its first Count characters. */
+		__forceinline StringView RightChop(int32 Count) const
+		{
+			const int32 NumChars = Math::Clamp(mLength - Count, 0, mLength);
+			return StringView(mpData + mLength - NumChars, NumChars);
+		}
+
+		/** @return Count characters starting at Start, clamped to the view. */
+		__forceinline StringView Mid(int32 Start, int32 Count) const
+		{
+			Start = Math::Clamp(Start, 0, mLength);
+			return StringView(mpData + Start, Math::Clamp(Count, 0, mLength - Start));
+		}
+
+		/** @return The characters from Start to the end of the view. */
+		__forceinline StringView Mid(int32 Start) const
+		{
+			return Mid(Start, mLength);
+		}
+
+		/**
+		* Lexicographically compares with another view.
+		*
+		* @param Other The view to compare with
+		* @param SearchCase Whether the comparison is case sensitive or not
+		* @return 0 if equal, negative if this view sorts first, positive otherwise
+		*/
+		int32 Compare(const StringView& Other, ESearchCase SearchCase = ESearchCase::IgnoreCase) const;
+
+		__forceinline bool Equals(const StringView& Other, ESearchCase SearchCase = ESearchCase::IgnoreCase) const
+		{
+			return mLength == Other.mLength && Compare(Other, SearchCase) == 0;
+		}
+
+		/** Case insensitive equality, consistent with String. */
+		__forceinline friend bool operator==(const StringView& Lhs, const StringView& Rhs)
+		{
+			return Lhs.Equals(Rhs);
+		}
+
+		__forceinline friend bool operator!=(const StringView& Lhs, const StringView& Rhs)
+		{
+			return !Lhs.Equals(Rhs);
+		}
+
+		/**
+		* Searches the view for a substring.
+		*
+		* @param SubStr The characters to search for
+		* @param SearchCase Whether the search is case sensitive or not
+		* @param SearchDir Whether the search starts at the beginning or at the end
+		* @param StartPosition The index to search from, or INDEX_NONE for the start or end of the view
+		* @return Index of the first match in the search direction, or INDEX_NONE
+		*/
+		int32 Find(const StringView& SubStr, ESearchCase SearchCase = ESearchCase::IgnoreCase,
+			ESearchDir SearchDir = ESearchDir::FromStart, int32 StartPosition = INDEX_NONE) const;
+
+		/**
+		* Searches the view for a character, case sensitive.
+		*
+		* @param Char The character to search for
+		* @param Index Out the index of the first occurrence, or INDEX_NONE
+		* @return true if the character was found
+		*/
+		__forceinline bool FindChar(TCHAR Char, int32& Index) const
+		{
+			for (int32 i = 0; i < mLength; i++)
+			{
+				if (mpData[i] == Char)
+				{
+					Index = i;
+					return true;
+				}
+			}
+
+			Index = INDEX_NONE;
+			return false;
+		}
+
+		__forceinline bool Contains(const StringView& SubStr, ESearchCase SearchCase = ESearchCase::IgnoreCase) const
+		{
+			return Find(SubStr, SearchCase) != INDEX_NONE;
+		}
+
+		__forceinline bool StartsWith(const StringView& Prefix, ESearchCase SearchCase = ESearchCase::IgnoreCase) const
+		{
+			return Prefix.mLength <= mLength && Left(Prefix.mLength).Compare(Prefix, SearchCase) == 0;
+		}
+
+		__forceinline bool EndsWith(const StringView& Suffix, ESearchCase SearchCase = ESearchCase::IgnoreCase) const
+		{
+			return Suffix.mLength <= mLength && Right(Suffix.mLength).Compare(Suffix, SearchCase) == 0;
+		}
+
+		/** @return The view without leading whitespace. */
+		__forceinline StringView TrimStart() const
+		{
+			int32 Start = 0;
+			while (Start < mLength && TChar<TCHAR>::IsWhitespace(mpData[Start]))
+			{
+				Start++;
+			}
+			return StringView(mpData + Start, mLength - Start);
+		}
+
+		/** @return The view without trailing whitespace. */
+		__forceinline StringView TrimEnd() const
+		{
+			int32 End = mLength;
+			while (End > 0 && TChar<TCHAR>::IsWhitespace(mpData[End - 1]))
+			{
+				End--;
+			}
+			return StringView(mpData, End);
+		}
+
+		/** @return The view without leading and trailing whitespace. */
+		__forceinline StringView Trim() const
+		{
+			return TrimStart().TrimEnd();
+		}
+
+		/**
+		* Splits the view around the first (or last) occurrence of a delimiter.
+		*
+		* @param Delim The delimiter to split at
+		* @param LeftS Out the characters before the delimiter, not updated if return is false
+		* @param RightS Out the characters after the delimiter, not updated if return is false
+		* @param SearchCase Whether the search is case sensitive or not
+		* @param SearchDir Whether the search starts at the beginning or at the end
+		* @return true if the delimiter was found
+		*/
+		bool Split(const StringView& Delim, StringView* LeftS, StringView* RightS, ESearchCase SearchCase = ESearchCase::IgnoreCase,
+			ESearchDir SearchDir = ESearchDir::FromStart) const;
+
+		/**
+		* Breaks up the view into views of the pieces between delimiters. No characters are copied.
+		*
+		* @param OutArray The array to fill with the pieces
+		* @param pchDelim The string to delimit on
+		* @param InCullEmpty If true, empty pieces are not added to the array
+		* @return The number of elements in OutArray
+		*/
+		int32 ParseIntoArray(Array<StringView>& OutArray, const TCHAR* pchDelim, bool InCullEmpty = true) const;
+
+		/**
+		* Breaks up the view into views of the pieces between any of the given delimiters.
+		*
+		* @param OutArray The array to fill with the pieces
+		* @param DelimArray The strings to delimit on, the first one matching at a position is used
+		* @param NumDelims The number of delimiters
+		* @param InCullEmpty If true, empty pieces are not added to the array
+		* @return The number of elements in OutArray
+		*/
+		int32 ParseIntoArray(Array<StringView>& OutArray, const TCHAR** DelimArray, int32 NumDelims, bool InCullEmpty = true) const;
+
+		/**
+		* Breaks up the view at whitespace and an optional extra delimiter, like a ",".
+		*
+		* @param OutArray The array to fill with the pieces
+		* @param pchExtraDelim The extra string to delimit on
+		* @param InCullEmpty If true, empty pieces are not added to the array
+		* @return The number of elements in OutArray
+		*/
+		int32 ParseIntoArrayWS(Array<StringView>& OutArray, const TCHAR* pchExtraDelim = nullptr, bool InCullEmpty = true) const;
+
+		/**
+		* Breaks up the view at line endings.
+		*
+		* @param OutArray The array to fill with the lines
+		* @param InCullEmpty If true, empty lines are not added to the array
+		* @return The number of elements in OutArray
+		*/
+		int32 ParseIntoArrayLines(Array<StringView>& OutArray, bool InCullEmpty = true) const;
+
+		/**
+		* Parses the whole view as a decimal integer, with an optional sign. Surrounding whitespace is not allowed.
+		*
+		* @param OutValue Out the value, not updated if return is false
+		* @return true if the view is a number which fits in the output type
+		*/
+		bool ParseInt(int32& OutValue) const;
+		bool ParseInt(int64& OutValue) const;
+		bool ParseInt(uint32& OutValue) const;
+		bool ParseInt(uint64& OutValue) const;
+
+		/**
+		* Parses the whole view as a floating point number: an optional sign, digits with an optional
+		* fraction and an optional exponent. Surrounding whitespace is not allowed.
+		*
+		* @param OutValue Out the value, not updated if return is false
+		* @return true if the view is a number
+		*/
+		bool ParseFloat(float& OutValue) const;
+		bool ParseFloat(double& OutValue) const;
+
+	private:
+		/**
+		* DO NOT USE DIRECTLY
+		* STL-like iterators to enable range-based for loop support.
+		*/
+		__forceinline friend const TCHAR* begin(const StringView& View) { return View.mpData; }
+		__forceinline friend const TCHAR* end(const StringView& View) { return View.mpData + View.mLength; }
+	};
+
+	template<> struct IsPODType<StringView> { enum { Value = true }; };
+
+	/** Case insensitive hash, the same as the hash of a String with the same characters. */
+	__forceinline uint32 GetTypeHash(const StringView& View)
+	{
+		return FastHash::StriHash(View.Data(), View.Len());
+	}
+}
@@ -270,6 +270,11 @@ namespace EDX
 			return _tcstoui64(Start, End, Base);
 		}
 
+		static __forceinline float Strtof(const WIDECHAR* Start, WIDECHAR** End)
+		{
+			return wcstof(Start, End);
+		}
+
 		static __forceinline WIDECHAR* Strtok(WIDECHAR* StrToken, const WIDECHAR* Delim, WIDECHAR** Context)
 		{
 			return _tcstok_s(StrToken, Delim, Context);
@@ -411,6 +416,11 @@ namespace EDX
 			return _strtoui64(Start, End, Base);
 		}
 
+		static __forceinline float Strtof(const ANSICHAR* Start, ANSICHAR** End)
+		{
+			return strtof(Start, End);
+		}
+
 		static __forceinline ANSICHAR* Strtok(ANSICHAR* StrToken, const ANSICHAR* Delim, ANSICHAR** Context)
 		{
 			return strtok_s(StrToken, Delim, Context);
@@ -893,6 +903,11 @@ namespace EDX
 		*/
 		static __forceinline uint64 Strtoui64(const CharType* Start, CharType** End, int32 Base);
 
+		/**
+		* strtof wrapper, rounds once to float where Atof goes through a double
+		*/
+		static __forceinline float Strtof(const CharType* Start, CharType** End);
+
 		/**
 		* strtok wrapper
 		*/
@@ -1271,6 +1286,12 @@ namespace EDX
 		return CStringUtil::Strtoui64(Start, End, Base);
 	}
 
+	template <typename T> __forceinline
+	float TCString<T>::Strtof(const CharType* Start, CharType** End)
+	{
+		return CStringUtil::Strtof(Start, End);
+	}
+
 
 	template <typename T> __forceinline
 	typename TCString<T>::CharType* TCString<T>::Strtok(CharType* TokenString, const CharType* Delim, CharType** Context)
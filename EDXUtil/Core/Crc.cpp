@@ -1,10 +1,24 @@
 #include "Crc.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+
+#if defined(__GNUC__)
+#define CRC_TARGET(Features) __attribute__((target(Features)))
+#else
+#define CRC_TARGET(Features)
+#endif
+
 namespace EDX
 {
 	/** CRC 32 polynomial */
 	enum { Crc32Poly = 0x04c11db7 };
-	uint32 Crc::CRCTablesSB8[8][256] =
+	const uint32 Crc::CRCTablesSB8[8][256] =
 	{
 		{
 			0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
@@ -198,15 +212,340 @@ namespace EDX
 #endif // _DEBUG
 	}
 
-	uint32 Crc::MemCrc32(const void* InData, int32 Length, uint32 CRC/*=0 */)
+	namespace
 	{
-		// Based on the Slicing-by-8 implementation found here:
-		// http://slicing-by-8.sourceforge.net/
+		/** CRC32C polynomial, bit reflected like the tables */
+		const uint32 Crc32cPoly = 0x82f63b78;
+
+		struct CpuFeatures
+		{
+			bool bSSE42;
+			bool bPclmul;
+
+			CpuFeatures()
+			{
+				uint32 Ecx = 0;
+#if defined(_MSC_VER)
+				int Info[4];
+				__cpuid(Info, 1);
+				Ecx = uint32(Info[2]);
+#else
+				uint32 Eax, Ebx, Edx;
+				if (!__get_cpuid(1, &Eax, &Ebx, &Ecx, &Edx))
+				{
+					Ecx = 0;
+				}
+#endif
+				bSSE42 = (Ecx & (1 << 20)) != 0;
+				// The folding also uses SSE4.1 to extract the result
+				bPclmul = (Ecx & (1 << 1)) != 0 && (Ecx & (1 << 19)) != 0;
+			}
+		};
+
+		const CpuFeatures& GetCpuFeatures()
+		{
+			static const CpuFeatures Features;
+			return Features;
+		}
+
+		/** Multiplies two polynomials modulo the CRC32C polynomial, in the bit reflected representation. */
+		constexpr uint32 MultModP(uint32 A, uint32 B)
+		{
+			uint32 Product = 0;
+			for (uint32 Mask = 1u << 31; Mask; Mask >>= 1)
+			{
+				if (A & Mask)
+				{
+					Product ^= B;
+				}
+				B = (B & 1) ? (B >> 1) ^ Crc32cPoly : B >> 1;
+			}
+			return Product;
+		}
+
+		/** Computes x^(8 * NumBytes) modulo the CRC32C polynomial, the operator appending NumBytes zeros to a CRC. */
+		constexpr uint32 ZerosOperator(uint32 NumBytes)
+		{
+			uint32 Result = 1u << 31;
+			uint32 Power = 1u << 23;
+			for (; NumBytes; NumBytes >>= 1)
+			{
+				if (NumBytes & 1)
+				{
+					Result = MultModP(Power, Result);
+				}
+				Power = MultModP(Power, Power);
+			}
+			return Result;
+		}
+
+		/** Slicing by 8 tables of CRC32C, for CPUs without SSE4.2. */
+		struct Crc32cTableType
+		{
+			uint32 Values[8][256];
+
+			constexpr Crc32cTableType()
+				: Values()
+			{
+				for (uint32 i = 0; i < 256; i++)
+				{
+					uint32 CRC = i;
+					for (uint32 j = 0; j < 8; j++)
+					{
+						CRC = (CRC & 1) ? (CRC >> 1) ^ Crc32cPoly : (CRC >> 1);
+					}
+					Values[0][i] = CRC;
+				}
+
+				for (uint32 i = 0; i < 256; i++)
+				{
+					for (uint32 j = 1; j < 8; j++)
+					{
+						Values[j][i] = (Values[j - 1][i] >> 8) ^ Values[0][Values[j - 1][i] & 0xFF];
+					}
+				}
+			}
+		};
+
+		/**
+		* Tables applying the operator appending NumBytes zeros to a CRC32C one byte at a time, used to merge CRCs
+		* computed in parallel: CRC(A + B) = Shift(CRC(A), Length(B)) ^ CRC(B) when CRC(B) starts from 0.
+		*/
+		template<uint32 NumBytes>
+		struct Crc32cShiftTableType
+		{
+			uint32 Values[4][256];
+
+			constexpr Crc32cShiftTableType()
+				: Values()
+			{
+				// The operator is linear, the entries are sums of its value on each bit
+				uint32 Bits[32] = {};
+				const uint32 Operator = ZerosOperator(NumBytes);
+				for (uint32 Bit = 0; Bit < 32; Bit++)
+				{
+					Bits[Bit] = MultModP(Operator, 1u << Bit);
+				}
+
+				for (uint32 Byte = 0; Byte < 4; Byte++)
+				{
+					for (uint32 i = 0; i < 256; i++)
+					{
+						uint32 Value = 0;
+						for (uint32 Bit = 0; Bit < 8; Bit++)
+						{
+							if (i & (1 << Bit))
+							{
+								Value ^= Bits[Byte * 8 + Bit];
+							}
+						}
+						Values[Byte][i] = Value;
+					}
+				}
+			}
+
+			__forceinline uint32 Shift(uint32 CRC) const
+			{
+				return Values[0][CRC & 0xFF] ^ Values[1][(CRC >> 8) & 0xFF] ^ Values[2][(CRC >> 16) & 0xFF] ^ Values[3][CRC >> 24];
+			}
+		};
+
+		enum
+		{
+			/** Block sizes of the three interleaved crc32 streams, the instruction has a latency of 3 and a throughput of 1. */
+			Crc32cLongBlock = 8192,
+			Crc32cShortBlock = 256,
+
+			/** Shortest buffer worth the setup of the PCLMULQDQ folding, which needs 64 bytes. */
+			PclmulMinLength = 64,
+		};
+
+		constexpr Crc32cTableType Crc32cTables;
+		constexpr Crc32cShiftTableType<Crc32cLongBlock> Crc32cLongShift;
+		constexpr Crc32cShiftTableType<Crc32cShortBlock> Crc32cShortShift;
+
+		uint32 Crc32cSoftware(const uint8* Data, size_t Length, uint32 CRC)
+		{
+			for (; Length && (UPTRINT(Data) & 3); --Length)
+			{
+				CRC = (CRC >> 8) ^ Crc32cTables.Values[0][(CRC ^ *Data++) & 0xFF];
+			}
+
+			for (; Length >= 8; Length -= 8)
+			{
+				const uint32 V1 = *(const uint32*)Data ^ CRC;
+				const uint32 V2 = *(const uint32*)(Data + 4);
+				CRC =
+					Crc32cTables.Values[7][V1 & 0xFF] ^
+					Crc32cTables.Values[6][(V1 >> 8) & 0xFF] ^
+					Crc32cTables.Values[5][(V1 >> 16) & 0xFF] ^
+					Crc32cTables.Values[4][V1 >> 24] ^
+					Crc32cTables.Values[3][V2 & 0xFF] ^
+					Crc32cTables.Values[2][(V2 >> 8) & 0xFF] ^
+					Crc32cTables.Values[1][(V2 >> 16) & 0xFF] ^
+					Crc32cTables.Values[0][V2 >> 24];
+				Data += 8;
+			}
+
+			for (; Length; --Length)
+			{
+				CRC = (CRC >> 8) ^ Crc32cTables.Values[0][(CRC ^ *Data++) & 0xFF];
+			}
+
+			return CRC;
+		}
+
+#if defined(_WIN64) || defined(__x86_64__)
+		CRC_TARGET("sse4.2") __forceinline uint32 Crc32cWord(uint32 CRC, const uint8* Data)
+		{
+			return uint32(_mm_crc32_u64(CRC, *(const uint64*)Data));
+		}
+#else
+		CRC_TARGET("sse4.2") __forceinline uint32 Crc32cWord(uint32 CRC, const uint8* Data)
+		{
+			CRC = _mm_crc32_u32(CRC, *(const uint32*)Data);
+			return _mm_crc32_u32(CRC, *(const uint32*)(Data + 4));
+		}
+#endif
+
+		/** Runs three crc32 streams over consecutive blocks while at least three blocks remain. */
+		template<uint32 BlockSize>
+		CRC_TARGET("sse4.2") __forceinline uint32 Crc32cInterleaved(const uint8*& Data, size_t& Length, uint32 CRC, const Crc32cShiftTableType<BlockSize>& ShiftTable)
+		{
+			for (; Length >= 3 * BlockSize; Length -= 3 * BlockSize)
+			{
+				uint32 Crc0 = CRC, Crc1 = 0, Crc2 = 0;
+				for (const uint8* End = Data + BlockSize; Data < End; Data += 8)
+				{
+					Crc0 = Crc32cWord(Crc0, Data);
+					Crc1 = Crc32cWord(Crc1, Data + BlockSize);
+					Crc2 = Crc32cWord(Crc2, Data + 2 * BlockSize);
+				}
+
+				CRC = ShiftTable.Shift(ShiftTable.Shift(Crc0) ^ Crc1) ^ Crc2;
+				Data += 2 * BlockSize;
+			}
+
+			return CRC;
+		}
+
+		CRC_TARGET("sse4.2") uint32 Crc32cHardware(const uint8* Data, size_t Length, uint32 CRC)
+		{
+			for (; Length && (UPTRINT(Data) & 7); --Length)
+			{
+				CRC = _mm_crc32_u8(CRC, *Data++);
+			}
+
+			CRC = Crc32cInterleaved(Data, Length, CRC, Crc32cLongShift);
+			CRC = Crc32cInterleaved(Data, Length, CRC, Crc32cShortShift);
+
+			for (; Length >= 8; Length -= 8)
+			{
+				CRC = Crc32cWord(CRC, Data);
+				Data += 8;
+			}
+
+			for (; Length; --Length)
+			{
+				CRC = _mm_crc32_u8(CRC, *Data++);
+			}
+
+			return CRC;
+		}
+
+		/**
+		* Folds a buffer into the CRC 32 state with carry-less multiplies, from "Fast CRC Computation for Generic
+		* Polynomials Using PCLMULQDQ Instruction" (Intel). Length must be at least 64 and a multiple of 16.
+		*/
+		CRC_TARGET("sse4.1,pclmul") uint32 Crc32Pclmul(const uint8* Data, size_t Length, uint32 CRC)
+		{
+			// Constants of the bit reflected CRC 32 polynomial: x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32)
+			// and x^64 modulo P, then the Barrett reduction constants P' and mu
+			const __m128i K1K2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+			const __m128i K3K4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+			const __m128i K5K0 = _mm_set_epi64x(0, 0x0163cd6124);
+			const __m128i Poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+			const __m128i Mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+			__m128i X1 = _mm_loadu_si128((const __m128i*)(Data + 0x00));
+			__m128i X2 = _mm_loadu_si128((const __m128i*)(Data + 0x10));
+			__m128i X3 = _mm_loadu_si128((const __m128i*)(Data + 0x20));
+			__m128i X4 = _mm_loadu_si128((const __m128i*)(Data + 0x30));
+			X1 = _mm_xor_si128(X1, _mm_cvtsi32_si128(CRC));
+			Data += 64;
+			Length -= 64;
+
+			// Fold four 128 bits lanes by 64 bytes at a time
+			for (; Length >= 64; Length -= 64)
+			{
+				const __m128i X5 = _mm_clmulepi64_si128(X1, K1K2, 0x00);
+				const __m128i X6 = _mm_clmulepi64_si128(X2, K1K2, 0x00);
+				const __m128i X7 = _mm_clmulepi64_si128(X3, K1K2, 0x00);
+				const __m128i X8 = _mm_clmulepi64_si128(X4, K1K2, 0x00);
+
+				X1 = _mm_clmulepi64_si128(X1, K1K2, 0x11);
+				X2 = _mm_clmulepi64_si128(X2, K1K2, 0x11);
+				X3 = _mm_clmulepi64_si128(X3, K1K2, 0x11);
+				X4 = _mm_clmulepi64_si128(X4, K1K2, 0x11);
+
+				X1 = _mm_xor_si128(_mm_xor_si128(X1, X5), _mm_loadu_si128((const __m128i*)(Data + 0x00)));
+				X2 = _mm_xor_si128(_mm_xor_si128(X2, X6), _mm_loadu_si128((const __m128i*)(Data + 0x10)));
+				X3 = _mm_xor_si128(_mm_xor_si128(X3, X7), _mm_loadu_si128((const __m128i*)(Data + 0x20)));
+				X4 = _mm_xor_si128(_mm_xor_si128(X4, X8), _mm_loadu_si128((const __m128i*)(Data + 0x30)));
+				Data += 64;
+			}
+
+			// Fold the four lanes into one, then the remaining 16 bytes blocks into it
+			__m128i X5 = _mm_clmulepi64_si128(X1, K3K4, 0x00);
+			X1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(X1, K3K4, 0x11), X2), X5);
+			X5 = _mm_clmulepi64_si128(X1, K3K4, 0x00);
+			X1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(X1, K3K4, 0x11), X3), X5);
+			X5 = _mm_clmulepi64_si128(X1, K3K4, 0x00);
+			X1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(X1, K3K4, 0x11), X4), X5);
+
+			for (; Length >= 16; Length -= 16)
+			{
+				X5 = _mm_clmulepi64_si128(X1, K3K4, 0x00);
+				X1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(X1, K3K4, 0x11), _mm_loadu_si128((const __m128i*)Data)), X5);
+				Data += 16;
+			}
+
+			// Fold 128 bits to 64
+			X2 = _mm_clmulepi64_si128(X1, K3K4, 0x10);
+			X1 = _mm_xor_si128(_mm_srli_si128(X1, 8), X2);
+
+			X2 = _mm_srli_si128(X1, 4);
+			X1 = _mm_and_si128(X1, Mask32);
+			X1 = _mm_xor_si128(_mm_clmulepi64_si128(X1, K5K0, 0x00), X2);
+
+			// Barrett reduction to 32 bits
+			X2 = _mm_and_si128(X1, Mask32);
+			X2 = _mm_clmulepi64_si128(X2, Poly, 0x10);
+			X2 = _mm_and_si128(X2, Mask32);
+			X2 = _mm_clmulepi64_si128(X2, Poly, 0x00);
+			X1 = _mm_xor_si128(X1, X2);
+
+			return uint32(_mm_extract_epi32(X1, 1));
+		}
+	}
 
+	uint32 Crc::MemCrc32(const void* InData, int32 Length, uint32 CRC/*=0 */)
+	{
 		CRC = ~CRC;
 
 		const uint8* __restrict Data = (uint8*)InData;
 
+		if (Length >= PclmulMinLength && GetCpuFeatures().bPclmul)
+		{
+			const int32 FoldedLength = Length & ~15;
+			CRC = Crc32Pclmul(Data, FoldedLength, CRC);
+			Data += FoldedLength;
+			Length -= FoldedLength;
+		}
+
+		// Based on the Slicing-by-8 implementation found here:
+		// http://slicing-by-8.sourceforge.net/
+
 		// First we need to align to 32-bits
 		int32 InitBytes = Align(Data, 4) - Data;
 
@@ -246,4 +585,14 @@ namespace EDX
 
 		return ~CRC;
 	}
-}
\ No newline at end of file
+
+	uint32 Crc::MemCrc32C(const void* Data, int32 Length, uint32 CRC/*=0 */)
+	{
+		if (GetCpuFeatures().bSSE42)
+		{
+			return ~Crc32cHardware((const uint8*)Data, Length, ~CRC);
+		}
+
+		return ~Crc32cSoftware((const uint8*)Data, Length, ~CRC);
+	}
+}
@@ -11,15 +11,20 @@ namespace EDX
 	struct Crc
 	{
 		/** lookup table with precalculated CRC values - slicing by 8 implementation */
-		static uint32 CRCTablesSB8[8][256];
+		static const uint32 CRCTablesSB8[8][256];
 
-		/** initializes the CRC lookup table. Must be called before any of the
-		CRC functions are used. */
+		/** verifies the lookup tables in debug builds. The tables are static data, calling it is optional. */
 		static void Init();
 
-		/** generates CRC hash of the memory area */
+		/** generates CRC hash of the memory area, folded with PCLMULQDQ when the CPU supports it */
 		static uint32 MemCrc32(const void* Data, int32 Length, uint32 CRC = 0);
 
+		/**
+		* generates CRC32C hash of the memory area, using the Castagnoli polynomial of the SSE4.2 crc32 instruction
+		* (iSCSI, ext4). Not compatible with MemCrc32, much faster when SSE4.2 is available.
+		*/
+		static uint32 MemCrc32C(const void* Data, int32 Length, uint32 CRC = 0);
+
 		/** String CRC. */
 		template <typename CharType>
 		static typename EnableIf<sizeof(CharType) != 1, uint32>::Type StrHash(const CharType* Data, uint32 CRC = 0)
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Types.h"
+#include "Char.h"
+#include <string.h>
+
+#if defined(_WIN64)
+#include <intrin.h>
+#endif
+
+namespace EDX
+{
+	/**
+	* 64 bits non-cryptographic hash of memory areas, following wyhash: 16 bytes are mixed per
+	* 64x64->128 bits multiply, 48 bytes per loop iteration on three independent lanes.
+	*
+	* The values are only meant for in-memory containers, they may change between versions. Use Crc
+	* for anything persisted.
+	**/
+	struct FastHash
+	{
+		/**
+		* Hashes a memory area.
+		*
+		* @param Data Start of the memory area
+		* @param Length Number of bytes to hash
+		* @param Seed Value to start from, e.g. the hash of a previous memory area to chain them
+		* @return The 64 bits hash
+		*/
+		static inline uint64 MemHash64(const void* Data, size_t Length, uint64 Seed = 0)
+		{
+			const uint8* p = (const uint8*)Data;
+			Seed ^= Mix(Seed ^ Secret0, Secret1);
+
+			uint64 A, B;
+			if (Length <= 16)
+			{
+				if (Length >= 4)
+				{
+					// Two overlapping reads of 4 bytes at each end cover 4 to 16 bytes
+					const size_t Middle = (Length >> 3) << 2;
+					A = (Read4(p) << 32) | Read4(p + Middle);
+					B = (Read4(p + Length - 4) << 32) | Read4(p + Length - 4 - Middle);
+				}
+				else if (Length > 0)
+				{
+					A = (uint64(p[0]) << 16) | (uint64(p[Length >> 1]) << 8) | p[Length - 1];
+					B = 0;
+				}
+				else
+				{
+					A = B = 0;
+				}
+			}
+			else
+			{
+				size_t Remaining = Length;
+				if (Remaining > 48)
+				{
+					uint64 Seed1 = Seed, Seed2 = Seed;
+					do
+					{
+						Seed = Mix(Read8(p) ^ Secret1, Read8(p + 8) ^ Seed);
+						Seed1 = Mix(Read8(p + 16) ^ Secret2, Read8(p + 24) ^ Seed1);
+						Seed2 = Mix(Read8(p + 32) ^ Secret3, Read8(p + 40) ^ Seed2);
+						p += 48;
+						Remaining -= 48;
+					} while (Remaining > 48);
+
+					Seed ^= Seed1 ^ Seed2;
+				}
+
+				while (Remaining > 16)
+				{
+					Seed = Mix(Read8(p) ^ Secret1, Read8(p + 8) ^ Seed);
+					p += 16;
+					Remaining -= 16;
+				}
+
+				// The last 16 bytes, overlapping the previous block when the length isn't a multiple of 16
+				A = Read8(p + Remaining - 16);
+				B = Read8(p + Remaining - 8);
+			}
+
+			A ^= Secret1;
+			B ^= Seed;
+			Multiply128(A, B);
+			return Mix(A ^ Secret0 ^ Length, B ^ Secret1);
+		}
+
+		/** Hashes a memory area, folded to 32 bits for GetTypeHash. */
+		static __forceinline uint32 MemHash(const void* Data, size_t Length, uint64 Seed = 0)
+		{
+			const uint64 Hash = MemHash64(Data, Length, Seed);
+			return uint32(Hash) ^ uint32(Hash >> 32);
+		}
+
+		/**
+		* Hashes the characters of a string ignoring case, consistent with Stricmp. The characters are lowered
+		* by blocks into a local buffer, ASCII ones inline and the other wide ones with TChar::ToLower.
+		*
+		* @param Data The string
+		* @param Length Number of characters
+		* @return The 32 bits hash
+		*/
+		template <typename CharType>
+		static uint32 StriHash(const CharType* Data, int32 Length)
+		{
+			enum { BlockSize = 64 };
+			CharType Lowered[BlockSize];
+
+			uint64 Hash = 0;
+			do
+			{
+				const int32 NumChars = Length < BlockSize ? Length : BlockSize;
+				for (int32 i = 0; i < NumChars; i++)
+				{
+					const CharType Ch = Data[i];
+					if (uint32(Ch) < 128)
+					{
+						Lowered[i] = uint32(Ch) - 'A' < 26u ? CharType(Ch | 0x20) : Ch;
+					}
+					else
+					{
+						// Stricmp leaves the upper half of single byte characters alone
+						Lowered[i] = sizeof(CharType) == 1 ? Ch : TChar<CharType>::ToLower(Ch);
+					}
+				}
+
+				Hash = MemHash64(Lowered, NumChars * sizeof(CharType), Hash);
+				Data += NumChars;
+				Length -= NumChars;
+			} while (Length > 0);
+
+			return uint32(Hash) ^ uint32(Hash >> 32);
+		}
+
+	private:
+		static const uint64 Secret0 = 0x2d358dccaa6c78a5ull;
+		static const uint64 Secret1 = 0x8bb84b93962eacc9ull;
+		static const uint64 Secret2 = 0x4b33a62ed433d4a3ull;
+		static const uint64 Secret3 = 0x4d5a2da51de1aa47ull;
+
+		static __forceinline uint64 Read8(const uint8* p)
+		{
+			uint64 Value;
+			memcpy(&Value, p, 8);
+			return Value;
+		}
+
+		static __forceinline uint64 Read4(const uint8* p)
+		{
+			uint32 Value;
+			memcpy(&Value, p, 4);
+			return Value;
+		}
+
+		/** Replaces A and B with the low and high halves of their 128 bits product. */
+		static __forceinline void Multiply128(uint64& A, uint64& B)
+		{
+#if defined(_WIN64)
+			A = _umul128(A, B, &B);
+#elif defined(__SIZEOF_INT128__)
+			const unsigned __int128 Product = (unsigned __int128)A * B;
+			A = uint64(Product);
+			B = uint64(Product >> 64);
+#else
+			const uint64 ALow = uint32(A), AHigh = A >> 32;
+			const uint64 BLow = uint32(B), BHigh = B >> 32;
+			const uint64 LowLow = ALow * BLow, LowHigh = ALow * BHigh, HighLow = AHigh * BLow, HighHigh = AHigh * BHigh;
+			const uint64 Cross = (LowLow >> 32) + uint32(LowHigh) + uint32(HighLow);
+			A = (Cross << 32) | uint32(LowLow);
+			B = HighHigh + (LowHigh >> 32) + (HighLow >> 32) + (Cross >> 32);
+#endif
+		}
+
+		static __forceinline uint64 Mix(uint64 A, uint64 B)
+		{
+			Multiply128(A, B);
+			return A ^ B;
+		}
+	};
+}
@@ -0,0 +1,519 @@
+#include "MallocBinned.h"
+#include "Assertion.h"
+#include "../Windows/Atomics.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace EDX
+{
+	namespace
+	{
+		/** Link stored in the first bytes of a free block. */
+		struct FreeBlock
+		{
+			FreeBlock* pNext;
+
+			/** Only used by the first block of a batch parked in the depot, links the batches. */
+			FreeBlock* pNextBatch;
+		};
+
+		/** Header in front of the allocations served by the system heap. */
+		struct LargeAllocHeader
+		{
+			void* pRawPtr;
+			size_t Size;
+		};
+
+		/** Free blocks of one size class shared by all the threads. */
+		struct SizeClassDepot
+		{
+			volatile int32 Lock;
+
+			/** Batches of GetBatchSize blocks. */
+			FreeBlock* pBatches;
+
+			/** Blocks left over when thread caches are flushed. */
+			FreeBlock* pLoose;
+		};
+
+		/** Free blocks cached by a thread. */
+		struct ThreadCache
+		{
+			FreeBlock* pHeads[MallocBinned::NumSmallClasses];
+			int32 Counts[MallocBinned::NumSmallClasses];
+			bool bInitialized;
+			bool bDestroyed;
+		};
+
+		/** Flushes the cache of a thread when it exits. */
+		struct ThreadCacheReaper
+		{
+			~ThreadCacheReaper();
+		};
+
+		SizeClassDepot Depots[MallocBinned::NumSmallClasses];
+
+		/**
+		* Size class + 1 of every 64KB page of the address space, 0 for pages not carved into small
+		* blocks. The top level is indexed by bits 32-47 of the address, the leaves by bits 16-31.
+		*/
+		uint8* PageMap[65536];
+
+		thread_local ThreadCache Cache;
+		thread_local ThreadCacheReaper Reaper;
+
+		/** Number of blocks moved between a thread cache and the depot at once, about 8KB worth. */
+		__forceinline int32 GetBatchSize(uint32 SizeClass)
+		{
+			const int32 Count = 8192 / MallocBinned::GetClassSize(SizeClass);
+			return Count < 4 ? 4 : (Count > 128 ? 128 : Count);
+		}
+
+		/**
+		* Gets the size class of the page holding a pointer.
+		*
+		* @return The size class, -1 if the pointer isn't a small block
+		*/
+		__forceinline int32 GetPageSizeClass(const void* Ptr)
+		{
+			const uint64 Address = uint64(UPTRINT(Ptr));
+			const uint8* pLeaf = PageMap[(Address >> 32) & 0xffff];
+			if (pLeaf == nullptr)
+			{
+				return -1;
+			}
+			return int32(pLeaf[(Address >> 16) & 0xffff]) - 1;
+		}
+
+		/**
+		* Maps pages straight from the OS, bypassing the system heap.
+		*
+		* @param Size Number of bytes, a multiple of MallocBinned::PageSize
+		* @return Zeroed memory aligned to MallocBinned::PageSize
+		*/
+		void* AllocPages(size_t Size)
+		{
+#if defined(_WIN32)
+			// VirtualAlloc returns memory aligned to the 64KB allocation granularity
+			void* Result = VirtualAlloc(nullptr, Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+			// mmap only aligns to the 4KB page size, map the slack to align to and trim it
+			const size_t Slack = MallocBinned::PageSize - size_t(sysconf(_SC_PAGESIZE));
+			_byte* pRaw = (_byte*)mmap(nullptr, Size + Slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			Assert(pRaw != MAP_FAILED);
+
+			_byte* Result = (_byte*)((UPTRINT(pRaw) + MallocBinned::PageSize - 1) & ~UPTRINT(MallocBinned::PageSize - 1));
+			if (Result != pRaw)
+			{
+				munmap(pRaw, Result - pRaw);
+			}
+			if (pRaw + Slack != Result)
+			{
+				munmap(Result + Size, pRaw + Slack - Result);
+			}
+#endif
+			Assert(Result);
+			return Result;
+		}
+
+		/** Unmaps pages returned by AllocPages. */
+		void FreePages(void* Ptr, size_t Size)
+		{
+#if defined(_WIN32)
+			VirtualFree(Ptr, 0, MEM_RELEASE);
+#else
+			munmap(Ptr, Size);
+#endif
+		}
+
+		/** Gives the rest of the time slice to another thread. */
+		void YieldThread()
+		{
+#if defined(_WIN32)
+			SwitchToThread();
+#else
+			sched_yield();
+#endif
+		}
+
+		void LockDepot(SizeClassDepot& Depot)
+		{
+			uint32 NumSpins = 0;
+			while (Depot.Lock != 0 || PlatformAtomics::InterlockedExchange(&Depot.Lock, 1) != 0)
+			{
+				if (++NumSpins < 64)
+				{
+					PlatformAtomics::Pause();
+				}
+				else
+				{
+					YieldThread();
+				}
+			}
+		}
+
+		void UnlockDepot(SizeClassDepot& Depot)
+		{
+			PlatformAtomics::InterlockedExchange(&Depot.Lock, 0);
+		}
+
+		/** Links Count consecutive blocks starting at pFirst into a list. */
+		FreeBlock* LinkBlocks(_byte* pFirst, int32 Count, uint32 BlockSize)
+		{
+			for (int32 i = 0; i < Count - 1; i++)
+			{
+				((FreeBlock*)(pFirst + i * BlockSize))->pNext = (FreeBlock*)(pFirst + (i + 1) * BlockSize);
+			}
+			((FreeBlock*)(pFirst + (Count - 1) * BlockSize))->pNext = nullptr;
+
+			return (FreeBlock*)pFirst;
+		}
+
+		/**
+		* Carves a new page into blocks, parks whole batches in the depot and returns the rest.
+		*
+		* @param SizeClass The size class
+		* @param OutCount Number of blocks in the returned list
+		* @return List of free blocks
+		*/
+		FreeBlock* AllocSmallPage(uint32 SizeClass, int32& OutCount)
+		{
+			_byte* pPage = (_byte*)AllocPages(MallocBinned::PageSize);
+
+			// Register the page before any of its blocks can be freed
+			const uint64 Address = uint64(UPTRINT(pPage));
+			uint8** ppLeaf = &PageMap[(Address >> 32) & 0xffff];
+			if (*(uint8* volatile*)ppLeaf == nullptr)
+			{
+				void* pLeaf = AllocPages(65536);
+				if (PlatformAtomics::InterlockedCompareExchangePointer((void**)ppLeaf, pLeaf, nullptr) != nullptr)
+				{
+					FreePages(pLeaf, 65536);
+				}
+			}
+			(*ppLeaf)[(Address >> 16) & 0xffff] = uint8(SizeClass + 1);
+
+			const uint32 BlockSize = MallocBinned::GetClassSize(SizeClass);
+			const int32 NumBlocks = MallocBinned::PageSize / BlockSize;
+			const int32 BatchSize = GetBatchSize(SizeClass);
+
+			// Keep one batch, or the remainder of the page, for the calling thread
+			const int32 NumKept = NumBlocks % BatchSize != 0 ? NumBlocks % BatchSize : BatchSize;
+			FreeBlock* pKept = LinkBlocks(pPage, NumKept, BlockSize);
+
+			if (NumKept < NumBlocks)
+			{
+				SizeClassDepot& Depot = Depots[SizeClass];
+				LockDepot(Depot);
+				for (int32 i = NumKept; i < NumBlocks; i += BatchSize)
+				{
+					FreeBlock* pBatch = LinkBlocks(pPage + i * BlockSize, BatchSize, BlockSize);
+					pBatch->pNextBatch = Depot.pBatches;
+					Depot.pBatches = pBatch;
+				}
+				UnlockDepot(Depot);
+			}
+
+			OutCount = NumKept;
+			return pKept;
+		}
+
+		/**
+		* Gets a list of free blocks from the depot, a whole batch if there is one, then the loose blocks.
+		* Carves a new page if the depot is empty.
+		*/
+		FreeBlock* RefillFromDepot(uint32 SizeClass, int32& OutCount)
+		{
+			const int32 BatchSize = GetBatchSize(SizeClass);
+
+			SizeClassDepot& Depot = Depots[SizeClass];
+			LockDepot(Depot);
+			FreeBlock* pList = Depot.pBatches;
+			if (pList)
+			{
+				Depot.pBatches = pList->pNextBatch;
+				OutCount = BatchSize;
+			}
+			else if (Depot.pLoose)
+			{
+				pList = Depot.pLoose;
+				FreeBlock* pTail = pList;
+				OutCount = 1;
+				while (OutCount < BatchSize && pTail->pNext)
+				{
+					pTail = pTail->pNext;
+					OutCount++;
+				}
+				Depot.pLoose = pTail->pNext;
+				pTail->pNext = nullptr;
+			}
+			UnlockDepot(Depot);
+
+			if (pList)
+			{
+				return pList;
+			}
+
+			return AllocSmallPage(SizeClass, OutCount);
+		}
+
+		/** Parks a list of exactly GetBatchSize blocks in the depot. */
+		void ReleaseToDepot(uint32 SizeClass, FreeBlock* pBatch)
+		{
+			SizeClassDepot& Depot = Depots[SizeClass];
+			LockDepot(Depot);
+			pBatch->pNextBatch = Depot.pBatches;
+			Depot.pBatches = pBatch;
+			UnlockDepot(Depot);
+		}
+
+		/**
+		* Parks a list of any length in the depot, cut into whole batches plus loose blocks. Only
+		* used when a thread cache is flushed, so it can afford walking the list.
+		*/
+		void ReleaseListToDepot(uint32 SizeClass, FreeBlock* pList)
+		{
+			const int32 BatchSize = GetBatchSize(SizeClass);
+			while (pList)
+			{
+				FreeBlock* pTail = pList;
+				int32 Count = 1;
+				while (Count < BatchSize && pTail->pNext)
+				{
+					pTail = pTail->pNext;
+					Count++;
+				}
+				FreeBlock* pRest = pTail->pNext;
+
+				SizeClassDepot& Depot = Depots[SizeClass];
+				LockDepot(Depot);
+				if (Count == BatchSize)
+				{
+					pTail->pNext = nullptr;
+					pList->pNextBatch = Depot.pBatches;
+					Depot.pBatches = pList;
+				}
+				else
+				{
+					pTail->pNext = Depot.pLoose;
+					Depot.pLoose = pList;
+				}
+				UnlockDepot(Depot);
+
+				pList = pRest;
+			}
+		}
+
+		ThreadCache* GetThreadCache()
+		{
+			ThreadCache* pCache = &Cache;
+			if (!pCache->bInitialized)
+			{
+				if (pCache->bDestroyed)
+				{
+					return nullptr;
+				}
+
+				// Touching the reaper registers its destructor for this thread
+				(void)&Reaper;
+				pCache->bInitialized = true;
+			}
+			return pCache;
+		}
+
+		void* MallocSmall(uint32 SizeClass)
+		{
+			ThreadCache* pCache = GetThreadCache();
+			if (pCache == nullptr)
+			{
+				// The thread is exiting, go straight to the depot
+				int32 Count;
+				FreeBlock* pList = RefillFromDepot(SizeClass, Count);
+				FreeBlock* pResult = pList;
+				if (Count > 1)
+				{
+					ReleaseListToDepot(SizeClass, pList->pNext);
+				}
+				return pResult;
+			}
+
+			FreeBlock* pBlock = pCache->pHeads[SizeClass];
+			if (pBlock == nullptr)
+			{
+				pBlock = RefillFromDepot(SizeClass, pCache->Counts[SizeClass]);
+			}
+
+			pCache->pHeads[SizeClass] = pBlock->pNext;
+			pCache->Counts[SizeClass]--;
+			return pBlock;
+		}
+
+		void FreeSmall(void* Ptr, uint32 SizeClass)
+		{
+			FreeBlock* pBlock = (FreeBlock*)Ptr;
+
+			ThreadCache* pCache = GetThreadCache();
+			if (pCache == nullptr)
+			{
+				pBlock->pNext = nullptr;
+				ReleaseListToDepot(SizeClass, pBlock);
+				return;
+			}
+
+			pBlock->pNext = pCache->pHeads[SizeClass];
+			pCache->pHeads[SizeClass] = pBlock;
+
+			// Keep up to two batches so alternating allocations and frees don't bounce on the depot
+			const int32 BatchSize = GetBatchSize(SizeClass);
+			if (++pCache->Counts[SizeClass] >= 2 * BatchSize)
+			{
+				FreeBlock* pTail = pBlock;
+				for (int32 i = 1; i < BatchSize; i++)
+				{
+					pTail = pTail->pNext;
+				}
+				pCache->pHeads[SizeClass] = pTail->pNext;
+				pTail->pNext = nullptr;
+				pCache->Counts[SizeClass] -= BatchSize;
+
+				ReleaseToDepot(SizeClass, pBlock);
+			}
+		}
+
+		void* MallocLarge(size_t Size, uint32 Alignment)
+		{
+			void* pRawPtr = ::malloc(Size + Alignment + sizeof(LargeAllocHeader));
+			if (pRawPtr == nullptr)
+			{
+				return nullptr;
+			}
+
+			const UPTRINT Address = (UPTRINT(pRawPtr) + sizeof(LargeAllocHeader) + Alignment - 1) & ~UPTRINT(Alignment - 1);
+			LargeAllocHeader* pHeader = (LargeAllocHeader*)Address - 1;
+			pHeader->pRawPtr = pRawPtr;
+			pHeader->Size = Size;
+
+			return (void*)Address;
+		}
+
+		__forceinline LargeAllocHeader* GetLargeAllocHeader(void* Ptr)
+		{
+			return (LargeAllocHeader*)Ptr - 1;
+		}
+
+		ThreadCacheReaper::~ThreadCacheReaper()
+		{
+			MallocBinned::FlushThreadCache();
+			Cache.bInitialized = false;
+			Cache.bDestroyed = true;
+		}
+	}
+
+	void* MallocBinned::Malloc(size_t Size, uint32 Alignment)
+	{
+		const int32 SizeClass = FindSizeClass(Size, Alignment);
+		if (SizeClass >= 0)
+		{
+			return MallocSmall(SizeClass);
+		}
+
+		return MallocLarge(Size, Alignment);
+	}
+
+	void* MallocBinned::Realloc(void* Ptr, size_t NewSize, uint32 Alignment)
+	{
+		if (Ptr == nullptr)
+		{
+			return Malloc(NewSize, Alignment);
+		}
+		if (NewSize == 0)
+		{
+			Free(Ptr);
+			return nullptr;
+		}
+
+		size_t OldSize;
+		const int32 OldSizeClass = GetPageSizeClass(Ptr);
+		if (OldSizeClass >= 0)
+		{
+			// Still fits in the same block
+			if (FindSizeClass(NewSize, Alignment) == OldSizeClass)
+			{
+				return Ptr;
+			}
+			OldSize = GetClassSize(OldSizeClass);
+		}
+		else
+		{
+			OldSize = GetLargeAllocHeader(Ptr)->Size;
+		}
+
+		void* Result = Malloc(NewSize, Alignment);
+		if (Result)
+		{
+			memcpy(Result, Ptr, OldSize < NewSize ? OldSize : NewSize);
+			Free(Ptr);
+		}
+
+		return Result;
+	}
+
+	void MallocBinned::Free(void* Ptr)
+	{
+		if (Ptr == nullptr)
+		{
+			return;
+		}
+
+		const int32 SizeClass = GetPageSizeClass(Ptr);
+		if (SizeClass >= 0)
+		{
+			FreeSmall(Ptr, SizeClass);
+			return;
+		}
+
+		::free(GetLargeAllocHeader(Ptr)->pRawPtr);
+	}
+
+	size_t MallocBinned::GetAllocSize(void* Ptr)
+	{
+		if (Ptr == nullptr)
+		{
+			return 0;
+		}
+
+		const int32 SizeClass = GetPageSizeClass(Ptr);
+		if (SizeClass >= 0)
+		{
+			return GetClassSize(SizeClass);
+		}
+
+		return GetLargeAllocHeader(Ptr)->Size;
+	}
+
+	void MallocBinned::FlushThreadCache()
+	{
+		ThreadCache* pCache = &Cache;
+		if (!pCache->bInitialized)
+		{
+			return;
+		}
+
+		for (uint32 SizeClass = 0; SizeClass < NumSmallClasses; SizeClass++)
+		{
+			if (pCache->pHeads[SizeClass])
+			{
+				ReleaseListToDepot(SizeClass, pCache->pHeads[SizeClass]);
+				pCache->pHeads[SizeClass] = nullptr;
+				pCache->Counts[SizeClass] = 0;
+			}
+		}
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Math/EDXMath.h"
+
+namespace EDX
+{
+	/**
+	* Binned allocator backing Memory::AlignedAlloc.
+	*
+	* Requests up to MaxSmallSize bytes are rounded up to one of NumSmallClasses size classes, four
+	* per power of two, and served from 64KB pages carved into blocks of that size. Each thread keeps
+	* a free list per size class and exchanges batches of blocks with a central depot, so most small
+	* allocations and frees touch no shared state. Small pages are never returned to the OS.
+	*
+	* Larger requests go to the system heap with a small header recording the size.
+	*/
+	class MallocBinned
+	{
+	public:
+		enum
+		{
+			/** Largest request served from the size classes. */
+			MaxSmallSize = 4096,
+
+			/** 8 classes 16 bytes apart up to 128 bytes, then 4 classes per power of two. */
+			NumSmallClasses = 28,
+
+			/** Size and alignment of the pages small blocks are carved from. */
+			PageSize = 65536,
+		};
+
+		/**
+		* Gets the size class a request falls into, ignoring alignment.
+		*
+		* @param Size Requested size, between 1 and MaxSmallSize
+		* @return Index of the size class
+		*/
+		static __forceinline uint32 GetSizeClass(size_t Size)
+		{
+			if (Size <= 128)
+			{
+				return Size == 0 ? 0 : uint32(Size - 1) >> 4;
+			}
+
+			const uint32 Value = uint32(Size - 1);
+			const uint32 Log2 = Math::FloorLog2(Value);
+			return 8 + (Log2 - 7) * 4 + ((Value >> (Log2 - 2)) & 3);
+		}
+
+		/**
+		* Gets the block size of a size class.
+		*/
+		static __forceinline uint32 GetClassSize(uint32 SizeClass)
+		{
+			if (SizeClass < 8)
+			{
+				return (SizeClass + 1) << 4;
+			}
+
+			const uint32 Doubling = (SizeClass - 8) >> 2;
+			return (5 + ((SizeClass - 8) & 3)) << (Doubling + 5);
+		}
+
+		/**
+		* Finds the smallest size class whose blocks fit the request and are aligned as requested.
+		* Blocks are aligned to the largest power of two dividing the class size.
+		*
+		* @param Size Requested size
+		* @param Alignment Requested alignment
+		* @return Index of the size class, -1 if the request must go to the system heap
+		*/
+		static __forceinline int32 FindSizeClass(size_t Size, uint32 Alignment)
+		{
+			if (Size > MaxSmallSize)
+			{
+				return -1;
+			}
+			if (Alignment <= 16)
+			{
+				return GetSizeClass(Size);
+			}
+
+			for (uint32 SizeClass = GetSizeClass(Size > Alignment ? Size : Alignment); SizeClass < NumSmallClasses; SizeClass++)
+			{
+				if ((GetClassSize(SizeClass) & (Alignment - 1)) == 0)
+				{
+					return SizeClass;
+				}
+			}
+			return -1;
+		}
+
+		static void* Malloc(size_t Size, uint32 Alignment);
+
+		static void* Realloc(void* Ptr, size_t NewSize, uint32 Alignment);
+
+		static void Free(void* Ptr);
+
+		/**
+		* Gets the usable size of an allocation, the size class for small blocks.
+		*/
+		static size_t GetAllocSize(void* Ptr);
+
+		/**
+		* Gets the size that should be requested to use all of the block a request would get.
+		*/
+		static __forceinline size_t QuantizeSize(size_t Count, uint32 Alignment)
+		{
+			const int32 SizeClass = FindSizeClass(Count, Alignment);
+			return SizeClass >= 0 ? GetClassSize(SizeClass) : Count;
+		}
+
+		/**
+		* Returns the blocks cached by the calling thread to the depot, so other threads can reuse them.
+		* Called automatically when a thread exits.
+		*/
+		static void FlushThreadCache();
+	};
+}
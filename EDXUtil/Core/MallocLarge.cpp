@@ -0,0 +1,376 @@
+#include "MallocLarge.h"
+#include "Assertion.h"
+#include "../Windows/Atomics.h"
+
+#include <stdlib.h>
+
+#if !defined(_WIN32)
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace EDX
+{
+	namespace
+	{
+		/** Entry of the side table recording the size of each mapping, keyed by its base. */
+		struct LargeAllocEntry
+		{
+			void* pBase;
+			size_t MappedSize;
+		};
+
+		/**
+		* Open addressing table of the live mappings. Keeping the sizes out of the mappings lets an
+		* allocation start on its first page and use all of its pages.
+		*/
+		LargeAllocEntry* pEntries = nullptr;
+		uint32 NumEntries = 0;
+		uint32 EntriesCapacity = 0;
+		volatile int32 EntriesLock = 0;
+
+		void LockEntries()
+		{
+			while (EntriesLock != 0 || PlatformAtomics::InterlockedExchange(&EntriesLock, 1) != 0)
+			{
+				PlatformAtomics::Pause();
+			}
+		}
+
+		void UnlockEntries()
+		{
+			PlatformAtomics::InterlockedExchange(&EntriesLock, 0);
+		}
+
+		__forceinline uint32 GetEntryHome(void* pBase)
+		{
+			// Mappings are page aligned, the low bits carry no information
+			return uint32((uint64(UPTRINT(pBase)) >> 12) * 0x9E3779B97F4A7C15ull >> 32) & (EntriesCapacity - 1);
+		}
+
+		/** Gets the slot of pBase, or the empty slot it would go in. Needs the lock. */
+		uint32 FindEntry(void* pBase)
+		{
+			uint32 Index = GetEntryHome(pBase);
+			while (pEntries[Index].pBase != nullptr && pEntries[Index].pBase != pBase)
+			{
+				Index = (Index + 1) & (EntriesCapacity - 1);
+			}
+			return Index;
+		}
+
+		bool AddEntry(void* pBase, size_t MappedSize)
+		{
+			LockEntries();
+
+			if ((NumEntries + 1) * 4 > EntriesCapacity * 3)
+			{
+				const uint32 NewCapacity = EntriesCapacity == 0 ? 64 : EntriesCapacity * 2;
+				LargeAllocEntry* pNewEntries = (LargeAllocEntry*)calloc(NewCapacity, sizeof(LargeAllocEntry));
+				if (pNewEntries == nullptr)
+				{
+					UnlockEntries();
+					return false;
+				}
+
+				LargeAllocEntry* pOldEntries = pEntries;
+				const uint32 OldCapacity = EntriesCapacity;
+				pEntries = pNewEntries;
+				EntriesCapacity = NewCapacity;
+				for (uint32 i = 0; i < OldCapacity; i++)
+				{
+					if (pOldEntries[i].pBase != nullptr)
+					{
+						pEntries[FindEntry(pOldEntries[i].pBase)] = pOldEntries[i];
+					}
+				}
+				free(pOldEntries);
+			}
+
+			LargeAllocEntry& Entry = pEntries[FindEntry(pBase)];
+			Entry.pBase = pBase;
+			Entry.MappedSize = MappedSize;
+			NumEntries++;
+
+			UnlockEntries();
+			return true;
+		}
+
+		/** @return Size of the mapping at pBase, which is removed from the table. */
+		size_t RemoveEntry(void* pBase)
+		{
+			LockEntries();
+
+			uint32 Hole = FindEntry(pBase);
+			Assert(pEntries[Hole].pBase == pBase);
+			const size_t MappedSize = pEntries[Hole].MappedSize;
+
+			// Shift back the entries of the probe sequence that can move into the hole
+			const uint32 Mask = EntriesCapacity - 1;
+			for (uint32 Index = (Hole + 1) & Mask; pEntries[Index].pBase != nullptr; Index = (Index + 1) & Mask)
+			{
+				const uint32 Home = GetEntryHome(pEntries[Index].pBase);
+				if (((Index - Home) & Mask) >= ((Index - Hole) & Mask))
+				{
+					pEntries[Hole] = pEntries[Index];
+					Hole = Index;
+				}
+			}
+			pEntries[Hole].pBase = nullptr;
+			NumEntries--;
+
+			UnlockEntries();
+			return MappedSize;
+		}
+
+		size_t GetEntrySize(void* pBase)
+		{
+			LockEntries();
+
+			const LargeAllocEntry& Entry = pEntries[FindEntry(pBase)];
+			Assert(Entry.pBase == pBase);
+			const size_t MappedSize = Entry.MappedSize;
+
+			UnlockEntries();
+			return MappedSize;
+		}
+
+		__forceinline size_t RoundUpTo(size_t Value, size_t Granularity)
+		{
+			return (Value + Granularity - 1) & ~(Granularity - 1);
+		}
+
+#if defined(_WIN32)
+		enum
+		{
+			/** Granularity at which interleaved allocations alternate between nodes. */
+			InterleaveChunkSize = 65536,
+		};
+
+		void* MapPages(size_t Size, const LargeAllocParams& Params, size_t& OutMappedSize)
+		{
+			const HANDLE Process = GetCurrentProcess();
+			// Nodes the machine doesn't have keep the default placement
+			const bool bValidNode = Params.NumaNode < MallocLarge::GetNumNumaNodes();
+			const DWORD PreferredNode = Params.Numa == NumaPolicy_Bind && bValidNode ? DWORD(Params.NumaNode) : NUMA_NO_PREFERRED_NODE;
+
+			if (Params.Pages == LargePage_Explicit)
+			{
+				// Large pages can't be committed piecewise, interleaving falls back to the default placement
+				const size_t LargePageSize = GetLargePageMinimum();
+				if (LargePageSize != 0)
+				{
+					OutMappedSize = RoundUpTo(Size, LargePageSize);
+					void* pBase = VirtualAllocExNuma(Process, nullptr, OutMappedSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, PreferredNode);
+					if (pBase != nullptr)
+					{
+						return pBase;
+					}
+				}
+			}
+
+			// Windows has no transparent huge pages, LargePage_Transparent maps regular pages
+			OutMappedSize = RoundUpTo(Size, InterleaveChunkSize);
+
+			const uint32 NumNodes = MallocLarge::GetNumNumaNodes();
+			if (Params.Numa != NumaPolicy_Interleave || NumNodes == 1)
+			{
+				return VirtualAllocExNuma(Process, nullptr, OutMappedSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, PreferredNode);
+			}
+
+			_byte* pBase = (_byte*)VirtualAlloc(nullptr, OutMappedSize, MEM_RESERVE, PAGE_READWRITE);
+			if (pBase == nullptr)
+			{
+				return nullptr;
+			}
+
+			for (size_t Offset = 0; Offset < OutMappedSize; Offset += InterleaveChunkSize)
+			{
+				const DWORD Node = DWORD((Offset / InterleaveChunkSize) % NumNodes);
+				if (VirtualAllocExNuma(Process, pBase + Offset, InterleaveChunkSize, MEM_COMMIT, PAGE_READWRITE, Node) == nullptr)
+				{
+					VirtualFree(pBase, 0, MEM_RELEASE);
+					return nullptr;
+				}
+			}
+
+			return pBase;
+		}
+
+		void UnmapPages(void* pBase, size_t MappedSize)
+		{
+			VirtualFree(pBase, 0, MEM_RELEASE);
+		}
+#else
+		enum
+		{
+			HugePageSize = 2 * 1024 * 1024,
+
+			/** Nodes addressable by the node masks, as many as the kernel supports. */
+			MaxNumaNodes = 1024,
+
+			// From linux/mempolicy.h, which isn't available without the libnuma headers
+			MPOL_BIND_MODE = 2,
+			MPOL_INTERLEAVE_MODE = 3,
+		};
+
+		void ApplyNumaPolicy(void* pBase, size_t MappedSize, const LargeAllocParams& Params)
+		{
+			const uint32 NumNodes = MallocLarge::GetNumNumaNodes() < uint32(MaxNumaNodes) ? MallocLarge::GetNumNumaNodes() : uint32(MaxNumaNodes);
+			if (Params.Numa == NumaPolicy_FirstTouch || NumNodes == 1)
+			{
+				return;
+			}
+
+			const uint32 BitsPerWord = sizeof(unsigned long) * 8;
+			unsigned long NodeMask[MaxNumaNodes / (sizeof(unsigned long) * 8)] = {};
+			int32 Mode = 0;
+			if (Params.Numa == NumaPolicy_Bind)
+			{
+				// Nodes the machine doesn't have keep the default placement
+				if (Params.NumaNode >= NumNodes)
+				{
+					return;
+				}
+
+				NodeMask[Params.NumaNode / BitsPerWord] |= 1ul << (Params.NumaNode % BitsPerWord);
+				Mode = MPOL_BIND_MODE;
+			}
+			else
+			{
+				for (uint32 Node = 0; Node < NumNodes; Node++)
+				{
+					NodeMask[Node / BitsPerWord] |= 1ul << (Node % BitsPerWord);
+				}
+				Mode = MPOL_INTERLEAVE_MODE;
+			}
+
+			// The pages haven't been touched yet, so the policy applies to all of them. Failure leaves
+			// the default placement.
+			syscall(SYS_mbind, pBase, MappedSize, Mode, NodeMask, sizeof(NodeMask) * 8 + 1, 0);
+		}
+
+		void* MapPages(size_t Size, const LargeAllocParams& Params, size_t& OutMappedSize)
+		{
+			const bool bHugePages = Params.Pages != LargePage_None;
+			const size_t PageSize = bHugePages ? size_t(HugePageSize) : size_t(sysconf(_SC_PAGESIZE));
+			OutMappedSize = RoundUpTo(Size, PageSize);
+
+			void* pBase = MAP_FAILED;
+			if (Params.Pages == LargePage_Explicit)
+			{
+				pBase = mmap(nullptr, OutMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			}
+
+			if (pBase == MAP_FAILED)
+			{
+				// Transparent huge pages only back the 2MB aligned parts of a mapping, so map one more
+				// huge page and trim the range to an aligned one
+				const size_t Slack = bHugePages ? PageSize : 0;
+				_byte* pRaw = (_byte*)mmap(nullptr, OutMappedSize + Slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (pRaw == MAP_FAILED)
+				{
+					return nullptr;
+				}
+
+				_byte* pAligned = (_byte*)RoundUpTo(size_t(UPTRINT(pRaw)), PageSize);
+				if (pAligned != pRaw)
+				{
+					munmap(pRaw, pAligned - pRaw);
+				}
+				if (pRaw + Slack != pAligned)
+				{
+					munmap(pAligned + OutMappedSize, pRaw + Slack - pAligned);
+				}
+
+				pBase = pAligned;
+				if (bHugePages)
+				{
+					madvise(pBase, OutMappedSize, MADV_HUGEPAGE);
+				}
+			}
+
+			ApplyNumaPolicy(pBase, OutMappedSize, Params);
+			return pBase;
+		}
+
+		void UnmapPages(void* pBase, size_t MappedSize)
+		{
+			munmap(pBase, MappedSize);
+		}
+#endif
+	}
+
+	void* MallocLarge::Malloc(size_t Size, const LargeAllocParams& Params)
+	{
+		size_t MappedSize = 0;
+		void* pBase = MapPages(Size > 0 ? Size : 1, Params, MappedSize);
+		if (pBase == nullptr)
+		{
+			return nullptr;
+		}
+
+		if (!AddEntry(pBase, MappedSize))
+		{
+			UnmapPages(pBase, MappedSize);
+			return nullptr;
+		}
+
+		return pBase;
+	}
+
+	void MallocLarge::Free(void* Ptr)
+	{
+		if (Ptr == nullptr)
+		{
+			return;
+		}
+
+		UnmapPages(Ptr, RemoveEntry(Ptr));
+	}
+
+	size_t MallocLarge::GetAllocSize(void* Ptr)
+	{
+		return GetEntrySize(Ptr);
+	}
+
+	uint32 MallocLarge::GetNumNumaNodes()
+	{
+		static uint32 NumNodes = 0;
+		if (NumNodes != 0)
+		{
+			return NumNodes;
+		}
+
+		uint32 Result = 1;
+#if defined(_WIN32)
+		ULONG HighestNode = 0;
+		if (GetNumaHighestNodeNumber(&HighestNode))
+		{
+			Result = uint32(HighestNode) + 1;
+		}
+#else
+		// The online nodes are listed as ranges, e.g. "0-1", the last number is the highest node
+		if (FILE* pFile = fopen("/sys/devices/system/node/online", "r"))
+		{
+			uint32 Node = 0;
+			int Separator = 0;
+			while (fscanf(pFile, "%u", &Node) == 1)
+			{
+				Result = Node + 1;
+				Separator = fgetc(pFile);
+				if (Separator != '-' && Separator != ',')
+				{
+					break;
+				}
+			}
+			fclose(pFile);
+		}
+#endif
+
+		NumNodes = Result;
+		return NumNodes;
+	}
+}
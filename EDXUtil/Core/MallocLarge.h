@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../Core/Types.h"
+
+namespace EDX
+{
+	/** Page size requested for a large allocation. */
+	enum LargePageMode
+	{
+		/** Regular pages. */
+		LargePage_None,
+
+		/** Regular pages the OS may promote to huge pages, transparent huge pages on Linux. */
+		LargePage_Transparent,
+
+		/**
+		* Huge pages reserved up front, MAP_HUGETLB on Linux and MEM_LARGE_PAGES on Windows, which
+		* requires SeLockMemoryPrivilege. Falls back to LargePage_Transparent when none are available.
+		*/
+		LargePage_Explicit,
+	};
+
+	/** Placement of the pages of a large allocation on a NUMA machine. */
+	enum NumaPolicy
+	{
+		/** Each page goes to the node of the thread touching it first. */
+		NumaPolicy_FirstTouch,
+
+		/** All the pages go to NumaNode. */
+		NumaPolicy_Bind,
+
+		/** Pages are spread round robin over all the nodes, for buffers accessed by every socket. */
+		NumaPolicy_Interleave,
+	};
+
+	struct LargeAllocParams
+	{
+		LargePageMode Pages;
+		NumaPolicy Numa;
+
+		/** Node used by NumaPolicy_Bind. */
+		uint32 NumaNode;
+
+		LargeAllocParams(LargePageMode InPages = LargePage_Transparent, NumaPolicy InNuma = NumaPolicy_FirstTouch, uint32 InNumaNode = 0)
+			: Pages(InPages)
+			, Numa(InNuma)
+			, NumaNode(InNumaNode)
+		{
+		}
+	};
+
+	/**
+	* Allocator mapping large buffers directly from the OS, backing Memory::AllocLarge.
+	*
+	* Each allocation gets its own mapping, rounded up to the page size, so it is only worth it for
+	* buffers of a few megabytes or more: images, volumes, FFT buffers. Allocations start on their
+	* first page, their sizes are kept in a side table. Placement requests are hints, the allocation
+	* succeeds with regular pages and default placement when the OS refuses or the node doesn't exist.
+	*/
+	class MallocLarge
+	{
+	public:
+		enum
+		{
+			/** Minimum alignment of the returned pointers, which start on a page boundary. */
+			Alignment = 64,
+		};
+
+		static void* Malloc(size_t Size, const LargeAllocParams& Params);
+
+		static void Free(void* Ptr);
+
+		/**
+		* Gets the number of bytes usable in an allocation, which can be more than was requested.
+		*/
+		static size_t GetAllocSize(void* Ptr);
+
+		/**
+		* Gets the number of NUMA nodes of the machine, 1 on machines without NUMA.
+		*/
+		static uint32 GetNumNumaNodes();
+	};
+}
@@ -4,6 +4,9 @@
 #include "../Core/Template.h"
 #include "../Math/EDXMath.h"
 #include "../Core/Assertion.h"
+#include "../Core/MallocBinned.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/MallocLarge.h"
 
 namespace EDX
 {
@@ -214,45 +217,40 @@ namespace EDX
 		}
 
 		template<typename T>
-		static __forceinline T* AlignedAlloc(uint32 Num, uint32 Alignment = DEFAULT_ALIGNMENT)
+		static __forceinline T* AlignedAlloc(size_t Num, uint32 Alignment = DEFAULT_ALIGNMENT, uint32 Tag = MemoryTag_Scope)
 		{
 			size_t Size = Num * sizeof(T);
-			return (T*)AlignedAlloc(Size, Alignment);
+			return (T*)AlignedAlloc(Size, Alignment, Tag);
 		}
 
 		//
-		// C style memory allocation stubs.
+		// C style memory allocation stubs, backed by MallocBinned. The tag attributes the allocation
+		// to a subsystem when EDX_TRACK_MEMORY is 1, see MemoryTracker.
 		//
 
-		static __forceinline void* AlignedAlloc(size_t Size, uint32 Alignment = DEFAULT_ALIGNMENT)
+		static __forceinline void* AlignedAlloc(size_t Size, uint32 Alignment = DEFAULT_ALIGNMENT, uint32 Tag = MemoryTag_Scope)
 		{
 			Alignment = Math::Max(Size >= 16 ? (uint32)16 : (uint32)8, Alignment);
 
-			void* Result = _aligned_malloc(Size, Alignment);
+#if EDX_TRACK_MEMORY
+			void* Result = MemoryTracker::Malloc(Size, Alignment, Tag);
+#else
+			void* Result = MallocBinned::Malloc(Size, Alignment);
+#endif
 			Assert(Result);
 
 			return Result;
 		}
 
-		static void* AlignedRealloc(void* Ptr, size_t NewSize, uint32 Alignment = DEFAULT_ALIGNMENT)
+		static void* AlignedRealloc(void* Ptr, size_t NewSize, uint32 Alignment = DEFAULT_ALIGNMENT, uint32 Tag = MemoryTag_Scope)
 		{
-			void* Result;
 			Alignment = Math::Max(NewSize >= 16 ? (uint32)16 : (uint32)8, Alignment);
 
-			if (Ptr && NewSize)
-			{
-				Result = _aligned_realloc(Ptr, NewSize, Alignment);
-			}
-			else if (Ptr == nullptr)
-			{
-				Result = _aligned_malloc(NewSize, Alignment);
-			}
-			else
-			{
-				_aligned_free(Ptr);
-				Result = nullptr;
-			}
-
+#if EDX_TRACK_MEMORY
+			void* Result = MemoryTracker::Realloc(Ptr, NewSize, Alignment, Tag);
+#else
+			void* Result = MallocBinned::Realloc(Ptr, NewSize, Alignment);
+#endif
 			if (Result == nullptr && NewSize != 0)
 			{
 				// Handle out of memory
@@ -263,7 +261,11 @@ namespace EDX
 
 		static void Free(void* Ptr)
 		{
-			_aligned_free(Ptr);
+#if EDX_TRACK_MEMORY
+			MemoryTracker::Free(Ptr);
+#else
+			MallocBinned::Free(Ptr);
+#endif
 		}
 
 		template<class T>
@@ -271,21 +273,21 @@ namespace EDX
 		{
 			if (Ptr != nullptr)
 			{
-				_aligned_free((void*)Ptr);
+				Free((void*)Ptr);
 				Ptr = nullptr;
 			}
 		}
 
+		/**
+		* Gets the number of bytes usable in an allocation, which can be more than was requested.
+		*/
 		static size_t GetAllocSize(void* Ptr)
 		{
-			if (!Ptr)
-			{
-				return 0;
-			}
-
-			size_t SizeOut = _aligned_msize(Ptr, 16, 0); // Assumes alignment of 16
-
-			return SizeOut;
+#if EDX_TRACK_MEMORY
+			return MemoryTracker::GetAllocSize(Ptr);
+#else
+			return MallocBinned::GetAllocSize(Ptr);
+#endif
 		}
 
 		/**
@@ -296,9 +298,43 @@ namespace EDX
 		*/
 		static size_t QuantizeSize(size_t Count, uint32 Alignment = DEFAULT_ALIGNMENT)
 		{
-			return Count;
+			if (Count == 0)
+			{
+				return 0;
+			}
+
+			Alignment = Math::Max(Count >= 16 ? (uint32)16 : (uint32)8, Alignment);
+#if EDX_TRACK_MEMORY
+			return MemoryTracker::QuantizeSize(Count, Alignment);
+#else
+			return MallocBinned::QuantizeSize(Count, Alignment);
+#endif
+		}
+
+
+		/**
+		* Allocates a large buffer directly from the OS, optionally backed by huge pages and placed on
+		* specific NUMA nodes, see MallocLarge. The result is page aligned and must be released
+		* with FreeLarge.
+		*/
+		static __forceinline void* AllocLarge(size_t Size, const LargeAllocParams& Params = LargeAllocParams())
+		{
+			void* Result = MallocLarge::Malloc(Size, Params);
+			Assert(Result);
+
+			return Result;
+		}
+
+		template<typename T>
+		static __forceinline T* AllocLarge(size_t Num, const LargeAllocParams& Params = LargeAllocParams())
+		{
+			return (T*)AllocLarge(Num * sizeof(T), Params);
 		}
 
+		static __forceinline void FreeLarge(void* Ptr)
+		{
+			MallocLarge::Free(Ptr);
+		}
 
 		template<class T>
 		static __forceinline void SafeDelete(T*& pPtr)
@@ -353,8 +389,8 @@ namespace EDX
 	* @param	Elements	The address of the first memory location to construct at.
 	* @param	Count		The number of elements to destruct.
 	*/
-	template <typename ElementType>
-	__forceinline typename EnableIf<!IsZeroConstructType<ElementType>::Value>::Type DefaultConstructItems(void* Address, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<!IsZeroConstructType<ElementType>::Value>::Type DefaultConstructItems(void* Address, SizeType Count)
 	{
 		ElementType* Element = (ElementType*)Address;
 		while (Count)
@@ -366,8 +402,8 @@ namespace EDX
 	}
 
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<IsZeroConstructType<ElementType>::Value>::Type DefaultConstructItems(void* Elements, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<IsZeroConstructType<ElementType>::Value>::Type DefaultConstructItems(void* Elements, SizeType Count)
 	{
 		Memory::Memset(Elements, 0, sizeof(ElementType) * Count);
 	}
@@ -379,8 +415,8 @@ namespace EDX
 	* @param	Elements	A pointer to the first item to destruct.
 	* @param	Count		The number of elements to destruct.
 	*/
-	template <typename ElementType>
-	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsDestructor>::Type DestructItems(ElementType* Element, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsDestructor>::Type DestructItems(ElementType* Element, SizeType Count)
 	{
 		while (Count)
 		{
@@ -394,8 +430,8 @@ namespace EDX
 	}
 
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsDestructor>::Type DestructItems(ElementType* Elements, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsDestructor>::Type DestructItems(ElementType* Elements, SizeType Count)
 	{
 	}
 
@@ -407,8 +443,8 @@ namespace EDX
 	* @param	Source		A pointer to the first argument to pass to the constructor.
 	* @param	Count		The number of elements to copy.
 	*/
-	template <typename DestinationElementType, typename SourceElementType>
-	__forceinline typename EnableIf<!IsBitwiseConstructible<DestinationElementType, SourceElementType>::Value>::Type ConstructItems(void* Dest, const SourceElementType* Source, int32 Count)
+	template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+	__forceinline typename EnableIf<!IsBitwiseConstructible<DestinationElementType, SourceElementType>::Value>::Type ConstructItems(void* Dest, const SourceElementType* Source, SizeType Count)
 	{
 		while (Count)
 		{
@@ -420,8 +456,8 @@ namespace EDX
 	}
 
 
-	template <typename DestinationElementType, typename SourceElementType>
-	__forceinline typename EnableIf<IsBitwiseConstructible<DestinationElementType, SourceElementType>::Value>::Type ConstructItems(void* Dest, const SourceElementType* Source, int32 Count)
+	template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+	__forceinline typename EnableIf<IsBitwiseConstructible<DestinationElementType, SourceElementType>::Value>::Type ConstructItems(void* Dest, const SourceElementType* Source, SizeType Count)
 	{
 		Memory::Memcpy(Dest, Source, sizeof(SourceElementType) * Count);
 	}
@@ -433,8 +469,8 @@ namespace EDX
 	* @param	Source		A pointer to the first item to assign.
 	* @param	Count		The number of elements to assign.
 	*/
-	template <typename ElementType>
-	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsCopyAssignment>::Type CopyAssignItems(ElementType* Dest, const ElementType* Source, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsCopyAssignment>::Type CopyAssignItems(ElementType* Dest, const ElementType* Source, SizeType Count)
 	{
 		while (Count)
 		{
@@ -446,8 +482,8 @@ namespace EDX
 	}
 
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsCopyAssignment>::Type CopyAssignItems(ElementType* Dest, const ElementType* Source, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsCopyAssignment>::Type CopyAssignItems(ElementType* Dest, const ElementType* Source, SizeType Count)
 	{
 		Memory::Memcpy(Dest, Source, sizeof(ElementType) * Count);
 	}
@@ -461,8 +497,8 @@ namespace EDX
 	* @param	Source		A pointer to the first item to relocate.
 	* @param	Count		The number of elements to relocate.
 	*/
-	template <typename DestinationElementType, typename SourceElementType>
-	__forceinline typename EnableIf<!MemoryOps_Private::CanBitwiseRelocate<DestinationElementType, SourceElementType>::Value>::Type RelocateConstructItems(void* Dest, const SourceElementType* Source, int32 Count)
+	template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+	__forceinline typename EnableIf<!MemoryOps_Private::CanBitwiseRelocate<DestinationElementType, SourceElementType>::Value>::Type RelocateConstructItems(void* Dest, const SourceElementType* Source, SizeType Count)
 	{
 		while (Count)
 		{
@@ -476,8 +512,8 @@ namespace EDX
 		}
 	}
 
-	template <typename DestinationElementType, typename SourceElementType>
-	__forceinline typename EnableIf<MemoryOps_Private::CanBitwiseRelocate<DestinationElementType, SourceElementType>::Value>::Type RelocateConstructItems(void* Dest, const SourceElementType* Source, int32 Count)
+	template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+	__forceinline typename EnableIf<MemoryOps_Private::CanBitwiseRelocate<DestinationElementType, SourceElementType>::Value>::Type RelocateConstructItems(void* Dest, const SourceElementType* Source, SizeType Count)
 	{
 		/* All existing containers seem to assume trivial relocatability (i.e. memcpy'able) of their members,
 		* so we're going to assume that this is safe here.  However, it's not generally possible to assume this
@@ -498,8 +534,8 @@ namespace EDX
 	* @param	Source		A pointer to the first item to move from.
 	* @param	Count		The number of elements to move.
 	*/
-	template <typename ElementType>
-	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsMoveConstructor>::Type MoveConstructItems(void* Dest, const ElementType* Source, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsMoveConstructor>::Type MoveConstructItems(void* Dest, const ElementType* Source, SizeType Count)
 	{
 		while (Count)
 		{
@@ -510,8 +546,8 @@ namespace EDX
 		}
 	}
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsMoveConstructor>::Type MoveConstructItems(void* Dest, const ElementType* Source, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsMoveConstructor>::Type MoveConstructItems(void* Dest, const ElementType* Source, SizeType Count)
 	{
 		Memory::Memmove(Dest, Source, sizeof(ElementType) * Count);
 	}
@@ -523,8 +559,8 @@ namespace EDX
 	* @param	Source		A pointer to the first item to move assign.
 	* @param	Count		The number of elements to move assign.
 	*/
-	template <typename ElementType>
-	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsMoveAssignment>::Type MoveAssignItems(ElementType* Dest, const ElementType* Source, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<TypeTraits<ElementType>::NeedsMoveAssignment>::Type MoveAssignItems(ElementType* Dest, const ElementType* Source, SizeType Count)
 	{
 		while (Count)
 		{
@@ -535,21 +571,21 @@ namespace EDX
 		}
 	}
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsMoveAssignment>::Type MoveAssignItems(ElementType* Dest, const ElementType* Source, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<!TypeTraits<ElementType>::NeedsMoveAssignment>::Type MoveAssignItems(ElementType* Dest, const ElementType* Source, SizeType Count)
 	{
 		Memory::Memmove(Dest, Source, sizeof(ElementType) * Count);
 	}
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<TypeTraits<ElementType>::IsBytewiseComparable, bool>::Type CompareItems(const ElementType* A, const ElementType* B, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<TypeTraits<ElementType>::IsBytewiseComparable, bool>::Type CompareItems(const ElementType* A, const ElementType* B, SizeType Count)
 	{
 		return !Memory::Memcmp(A, B, sizeof(ElementType) * Count);
 	}
 
 
-	template <typename ElementType>
-	__forceinline typename EnableIf<!TypeTraits<ElementType>::IsBytewiseComparable, bool>::Type CompareItems(const ElementType* A, const ElementType* B, int32 Count)
+	template <typename ElementType, typename SizeType>
+	__forceinline typename EnableIf<!TypeTraits<ElementType>::IsBytewiseComparable, bool>::Type CompareItems(const ElementType* A, const ElementType* B, SizeType Count)
 	{
 		while (Count)
 		{
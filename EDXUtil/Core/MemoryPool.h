@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Containers/Array.h"
+#include "../Windows/Atomics.h"
 
 namespace EDX
 {
@@ -8,11 +9,19 @@ namespace EDX
 	class MemoryPool
 	{
 	private:
+		/** A block of the pool, blocks bigger than the block size are made for large requests. */
+		struct Block
+		{
+			_byte* pData;
+			uint uiSize;
+		};
+
 		uint mBlockSize;
 		uint mCurrOffset;
 		_byte* mpCurrentBlock;
+		uint mCurrBlockSize;
 
-		Array<_byte*> mUsedBlocks, mAvailableBlocks;
+		Array<Block> mUsedBlocks, mAvailableBlocks;
 
 	public:
 		MemoryPool(uint uiSize = 32768)
@@ -20,6 +29,7 @@ namespace EDX
 			mBlockSize = uiSize;
 			mCurrOffset = 0;
 			mpCurrentBlock = Memory::AlignedAlloc<_byte>(mBlockSize, 64);
+			mCurrBlockSize = mBlockSize;
 		}
 		~MemoryPool()
 		{
@@ -28,12 +38,12 @@ namespace EDX
 
 			for (uint i = 0; i < mUsedBlocks.Size(); i++)
 			{
-				Memory::Free(mUsedBlocks[i]);
+				Memory::Free(mUsedBlocks[i].pData);
 			}
 
 			for (uint i = 0; i < mAvailableBlocks.Size(); i++)
 			{
-				Memory::Free(mAvailableBlocks[i]);
+				Memory::Free(mAvailableBlocks[i].pData);
 			}
 		}
 
@@ -47,20 +57,32 @@ namespace EDX
 			uiSize = (uiSize + 15) & (~15);
 
 			// Handle situation where the current block is used up
-			if (mCurrOffset + uiSize > mBlockSize)
+			if (mCurrOffset + uiSize > mCurrBlockSize)
 			{
 				// Cache the current block for future use
-				mUsedBlocks.Add(mpCurrentBlock);
+				mUsedBlocks.Add(Block{ mpCurrentBlock, mCurrBlockSize });
+
+				// Use a previously allocated block big enough for the request, large blocks are reused too
+				int32 Found = INDEX_NONE;
+				for (int32 i = int32(mAvailableBlocks.Size()) - 1; i >= 0; i--)
+				{
+					if (mAvailableBlocks[i].uiSize >= uiSize)
+					{
+						Found = i;
+						break;
+					}
+				}
 
-				// Use previously allocated blocks if the requested size is within block size
-				if (mAvailableBlocks.Size() > 0 && uiSize < mBlockSize)
+				if (Found != INDEX_NONE)
 				{
-					mpCurrentBlock = mAvailableBlocks.Top();
-					mAvailableBlocks.Pop();
+					mpCurrentBlock = mAvailableBlocks[Found].pData;
+					mCurrBlockSize = mAvailableBlocks[Found].uiSize;
+					mAvailableBlocks.RemoveAtSwap(Found, 1, false);
 				}
 				else // Else allocate new block in requested size
 				{
-					mpCurrentBlock = Memory::AlignedAlloc<_byte>(Math::Max(uiSize, mBlockSize));
+					mCurrBlockSize = Math::Max(uiSize, mBlockSize);
+					mpCurrentBlock = Memory::AlignedAlloc<_byte>(mCurrBlockSize);
 				}
 				// Clear the current block offset
 				mCurrOffset = 0;
@@ -72,6 +94,33 @@ namespace EDX
 			return pRet;
 		}
 
+		/**
+		* Resizes the most recent allocation in place, shrinking it or growing it into the rest of its block.
+		*
+		* @param pAlloc Allocation to resize
+		* @param OldBytes Size the allocation was made with
+		* @param NewBytes Size requested, 0 gives the allocation back
+		* @return true if the allocation was the last one of the pool and the new size fits in its block
+		*/
+		inline bool ResizeLast(void* pAlloc, SIZE_T OldBytes, SIZE_T NewBytes)
+		{
+			const SIZE_T OldSize = (OldBytes + 15) & (~15);
+			const SIZE_T NewSize = (NewBytes + 15) & (~15);
+			if (OldSize > mCurrOffset || (_byte*)pAlloc + OldSize != mpCurrentBlock + mCurrOffset)
+			{
+				return false;
+			}
+
+			const SIZE_T Start = mCurrOffset - OldSize;
+			if (Start + NewSize > mCurrBlockSize)
+			{
+				return false;
+			}
+
+			mCurrOffset = uint(Start + NewSize);
+			return true;
+		}
+
 		inline void FreeAll()
 		{
 			mCurrOffset = 0;
@@ -81,5 +130,420 @@ namespace EDX
 				mUsedBlocks.Pop();
 			}
 		}
+
+		/** Position in the pool, everything allocated after it can be released with Rewind. */
+		struct Marker
+		{
+			_byte* pBlock;
+			uint uiOffset;
+			uint uiNumUsedBlocks;
+		};
+
+		inline Marker GetMarker() const
+		{
+			Marker Ret;
+			Ret.pBlock = mpCurrentBlock;
+			Ret.uiOffset = mCurrOffset;
+			Ret.uiNumUsedBlocks = mUsedBlocks.Size();
+
+			return Ret;
+		}
+
+		/**
+		* Releases everything allocated since the marker was taken. Markers must be rewound in
+		* reverse order, and only blocks filled after the marker are touched.
+		*/
+		inline void Rewind(const Marker& InMarker)
+		{
+			if (mpCurrentBlock != InMarker.pBlock)
+			{
+				// The marked block is the first one retired after the marker, recycle the ones after it
+				mAvailableBlocks.Add(Block{ mpCurrentBlock, mCurrBlockSize });
+				while (mUsedBlocks.Size() > InMarker.uiNumUsedBlocks + 1)
+				{
+					mAvailableBlocks.Add(mUsedBlocks.Top());
+					mUsedBlocks.Pop();
+				}
+
+				mpCurrentBlock = mUsedBlocks.Top().pData;
+				mCurrBlockSize = mUsedBlocks.Top().uiSize;
+				mUsedBlocks.Pop();
+			}
+
+			mCurrOffset = InMarker.uiOffset;
+		}
+	};
+
+	/**
+	* Implements a scope mark on a MemoryPool, everything allocated from the pool within the scope
+	* is released in constant time when it ends. Example:
+	*
+	* <code>
+	*	{
+	*		ScopeMemoryMark Mark(QueuedThread::GetScratchPool());
+	*		float* pTemp = QueuedThread::GetScratchPool().Alloc<float>(Count);
+	*		...
+	*		// pTemp is released when Mark goes out of scope
+	*	}
+	* </code>
+	*/
+	class ScopeMemoryMark
+	{
+	public:
+		ScopeMemoryMark() = delete;
+		ScopeMemoryMark(const ScopeMemoryMark&) = delete;
+		ScopeMemoryMark& operator=(ScopeMemoryMark&) = delete;
+
+		ScopeMemoryMark(MemoryPool& InPool)
+			: mPool(InPool)
+			, mMarker(InPool.GetMarker())
+		{
+		}
+
+		~ScopeMemoryMark()
+		{
+			mPool.Rewind(mMarker);
+		}
+
+	private:
+		MemoryPool& mPool;
+		MemoryPool::Marker mMarker;
+	};
+
+	/**
+	* Thread safe version of MemoryPool, for parallel builders sharing one pool.
+	*
+	* Each thread bump allocates from a block it owns, so allocations don't contend. Full blocks are
+	* replaced with blocks from a lock-free free list shared by all the threads, or new ones. FreeAll
+	* recycles every block at once and must not run concurrently with Alloc. The bytes allocated by
+	* each thread since the last FreeAll, and the peak of that, are tracked for reporting.
+	*/
+	class ConcurrentMemoryPool
+	{
+	public:
+		struct ThreadStats
+		{
+			uint64 CurrentBytes;
+			uint64 PeakBytes;
+		};
+
+	private:
+		struct BlockHeader
+		{
+			/** Every block of the pool, only pushed to until FreeAll. */
+			BlockHeader* NextAll;
+
+			/** Next block in the free list. */
+			BlockHeader* volatile NextFree;
+
+			/** Usable size, more than the pool block size for dedicated blocks of large requests. */
+			size_t Size;
+		};
+
+		struct __declspec(align(64)) ThreadSlot
+		{
+			ThreadSlot* Next;
+			UPTRINT OwnerThread;
+			_byte* pCurrent;
+			_byte* pEnd;
+			volatile uint64 CurrentBytes;
+			volatile uint64 PeakBytes;
+		};
+
+		enum
+		{
+			/** Offset of the payload in a block, keeps it 16 bytes aligned. */
+			HeaderSize = (sizeof(BlockHeader) + 15) & ~15,
+			PointerBits = sizeof(void*) == 8 ? 48 : 32,
+
+			/** Pools whose thread slot is cached per thread, a power of two. */
+			NumCachedPools = 8,
+		};
+
+		uint mBlockSize;
+
+		/** Unique id of the pool, keys the per-thread slot cache. */
+		int32 mPoolId;
+
+		/** Keeps mFreeHead off the cache line of the read-only members, padded so pools can be allocated with new. */
+		uint8 mPadBeforeFreeHead[PLATFORM_CACHE_LINE_SIZE];
+
+		/** Head of the free block list, pointer in the low bits and ABA tag in the high bits. */
+		volatile int64 mFreeHead;
+
+		BlockHeader* volatile mAllBlocks;
+
+		/** One slot per thread that allocated from the pool, only pushed to. */
+		ThreadSlot* volatile mSlots;
+
+		/** Packs a block pointer with the low bits of the ABA tag, the tag wraps around instead of overflowing. */
+		static __forceinline int64 Pack(BlockHeader* Ptr, int64 Tag)
+		{
+			const uint64 TagMask = (uint64(1) << (64 - PointerBits)) - 1;
+			return int64(uint64(UPTRINT(Ptr)) | ((uint64(Tag) & TagMask) << PointerBits));
+		}
+
+		static __forceinline BlockHeader* UnpackPointer(int64 Value)
+		{
+			return (BlockHeader*)UPTRINT(Value & ((int64(1) << PointerBits) - 1));
+		}
+
+		static __forceinline int64 UnpackTag(int64 Value)
+		{
+			return uint64(Value) >> PointerBits;
+		}
+
+		static __forceinline _byte* GetPayload(BlockHeader* pBlock)
+		{
+			return (_byte*)pBlock + HeaderSize;
+		}
+
+		/** Gets a cheap unique identifier of the calling thread. */
+		static __forceinline UPTRINT GetThreadTag()
+		{
+			static thread_local uint8 ThreadTag;
+			return (UPTRINT)&ThreadTag;
+		}
+
+		static int32 NextPoolId()
+		{
+			static volatile int32 PoolCounter = 0;
+			return PlatformAtomics::InterlockedIncrement(&PoolCounter);
+		}
+
+		BlockHeader* AllocBlock(size_t Size)
+		{
+			BlockHeader* pBlock = (BlockHeader*)Memory::AlignedAlloc(HeaderSize + Size, 64);
+			pBlock->NextFree = nullptr;
+			pBlock->Size = Size;
+
+			BlockHeader* pOldBlocks;
+			do
+			{
+				pOldBlocks = mAllBlocks;
+				pBlock->NextAll = pOldBlocks;
+			} while (PlatformAtomics::InterlockedCompareExchangePointer((void**)&mAllBlocks, pBlock, pOldBlocks) != pOldBlocks);
+
+			return pBlock;
+		}
+
+		BlockHeader* PopFreeBlock()
+		{
+			int64 Old = mFreeHead;
+			for (;;)
+			{
+				BlockHeader* pBlock = UnpackPointer(Old);
+				if (pBlock == nullptr)
+				{
+					return nullptr;
+				}
+
+				// Blocks are never released while threads allocate, reading NextFree of a block popped
+				// meanwhile is safe and the tag makes the exchange fail
+				const int64 Prev = PlatformAtomics::InterlockedCompareExchange(&mFreeHead, Pack(pBlock->NextFree, UnpackTag(Old) + 1), Old);
+				if (Prev == Old)
+				{
+					return pBlock;
+				}
+				Old = Prev;
+			}
+		}
+
+		/**
+		* Gets the slot of the calling thread. Each thread caches its slot of the last pools it used,
+		* one entry per pool id modulo NumCachedPools, other pools search their slot list.
+		*/
+		ThreadSlot* GetThreadSlot()
+		{
+			struct SlotCache
+			{
+				int32 PoolId;
+				ThreadSlot* pSlot;
+			};
+			static thread_local SlotCache Cache[NumCachedPools];
+
+			SlotCache& Entry = Cache[mPoolId & (NumCachedPools - 1)];
+			if (Entry.PoolId == mPoolId)
+			{
+				return Entry.pSlot;
+			}
+
+			// Threads which exited leave their slot behind, a new thread with the same tag takes it over
+			const UPTRINT ThreadTag = GetThreadTag();
+			ThreadSlot* pSlot = mSlots;
+			while (pSlot && pSlot->OwnerThread != ThreadTag)
+			{
+				pSlot = pSlot->Next;
+			}
+
+			if (pSlot == nullptr)
+			{
+				// Slots are cache line aligned so that threads don't share lines
+				pSlot = (ThreadSlot*)Memory::AlignedAlloc(sizeof(ThreadSlot), 64);
+				pSlot->OwnerThread = ThreadTag;
+				pSlot->pCurrent = nullptr;
+				pSlot->pEnd = nullptr;
+				pSlot->CurrentBytes = 0;
+				pSlot->PeakBytes = 0;
+
+				ThreadSlot* pOldSlots;
+				do
+				{
+					pOldSlots = mSlots;
+					pSlot->Next = pOldSlots;
+				} while (PlatformAtomics::InterlockedCompareExchangePointer((void**)&mSlots, pSlot, pOldSlots) != pOldSlots);
+			}
+
+			Entry.PoolId = mPoolId;
+			Entry.pSlot = pSlot;
+			return pSlot;
+		}
+
+		void* AllocSlow(ThreadSlot* pSlot, size_t uiSize)
+		{
+			if (uiSize > mBlockSize)
+			{
+				// Dedicated block, the current one keeps serving small requests
+				return GetPayload(AllocBlock(uiSize));
+			}
+
+			BlockHeader* pBlock = PopFreeBlock();
+			if (pBlock == nullptr)
+			{
+				pBlock = AllocBlock(mBlockSize);
+			}
+
+			pSlot->pCurrent = GetPayload(pBlock) + uiSize;
+			pSlot->pEnd = GetPayload(pBlock) + mBlockSize;
+			return GetPayload(pBlock);
+		}
+
+	public:
+		ConcurrentMemoryPool(uint uiSize = 32768)
+			: mBlockSize(uiSize)
+			, mPoolId(NextPoolId())
+			, mFreeHead(0)
+			, mAllBlocks(nullptr)
+			, mSlots(nullptr)
+		{
+		}
+
+		ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+		ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+
+		~ConcurrentMemoryPool()
+		{
+			BlockHeader* pBlock = mAllBlocks;
+			while (pBlock)
+			{
+				BlockHeader* pNext = pBlock->NextAll;
+				Memory::Free(pBlock);
+				pBlock = pNext;
+			}
+
+			ThreadSlot* pSlot = mSlots;
+			while (pSlot)
+			{
+				ThreadSlot* pNext = pSlot->Next;
+				Memory::Free(pSlot);
+				pSlot = pNext;
+			}
+		}
+
+		/**
+		* Allocates from the block of the calling thread, can be called from any number of threads.
+		*/
+		template<class T>
+		inline T* Alloc(uint uiCount = 1)
+		{
+			// Make it aligned to 16 byte
+			const size_t uiSize = (size_t(uiCount) * sizeof(T) + 15) & ~size_t(15);
+
+			ThreadSlot* pSlot = GetThreadSlot();
+
+			const uint64 CurrentBytes = pSlot->CurrentBytes + uiSize;
+			pSlot->CurrentBytes = CurrentBytes;
+			if (CurrentBytes > pSlot->PeakBytes)
+			{
+				pSlot->PeakBytes = CurrentBytes;
+			}
+
+			if (pSlot->pCurrent == nullptr || uiSize > size_t(pSlot->pEnd - pSlot->pCurrent))
+			{
+				return (T*)AllocSlow(pSlot, uiSize);
+			}
+
+			T* pRet = (T*)pSlot->pCurrent;
+			pSlot->pCurrent += uiSize;
+
+			return pRet;
+		}
+
+		/**
+		* Recycles every block at once, dedicated blocks of large requests are released. Must not be
+		* called while other threads allocate from the pool.
+		*/
+		void FreeAll()
+		{
+			BlockHeader* pKept = nullptr;
+			BlockHeader* pBlock = mAllBlocks;
+			while (pBlock)
+			{
+				BlockHeader* pNext = pBlock->NextAll;
+				if (pBlock->Size == mBlockSize)
+				{
+					pBlock->NextAll = pKept;
+					pBlock->NextFree = pKept;
+					pKept = pBlock;
+				}
+				else
+				{
+					Memory::Free(pBlock);
+				}
+				pBlock = pNext;
+			}
+
+			mAllBlocks = pKept;
+			mFreeHead = Pack(pKept, UnpackTag(mFreeHead) + 1);
+
+			for (ThreadSlot* pSlot = mSlots; pSlot; pSlot = pSlot->Next)
+			{
+				pSlot->pCurrent = nullptr;
+				pSlot->pEnd = nullptr;
+				pSlot->CurrentBytes = 0;
+			}
+
+			PlatformAtomics::FullBarrier();
+		}
+
+		/**
+		* Gets the allocation statistics of every thread that allocated from the pool.
+		*
+		* @param OutStats Receives one entry per thread
+		*/
+		void GetThreadStats(Array<ThreadStats>& OutStats) const
+		{
+			OutStats.Clear();
+			for (ThreadSlot* pSlot = mSlots; pSlot; pSlot = pSlot->Next)
+			{
+				ThreadStats Stats;
+				Stats.CurrentBytes = pSlot->CurrentBytes;
+				Stats.PeakBytes = pSlot->PeakBytes;
+				OutStats.Add(Stats);
+			}
+		}
+
+		/**
+		* Gets the bytes allocated from the pool by all the threads since the last FreeAll.
+		*/
+		uint64 GetCurrentBytes() const
+		{
+			uint64 Total = 0;
+			for (ThreadSlot* pSlot = mSlots; pSlot; pSlot = pSlot->Next)
+			{
+				Total += pSlot->CurrentBytes;
+			}
+			return Total;
+		}
 	};
 }
@@ -0,0 +1,439 @@
+#include "MemoryTracker.h"
+#include "MallocBinned.h"
+#include "Assertion.h"
+#include "../Windows/Atomics.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <execinfo.h>
+#endif
+
+namespace EDX
+{
+	namespace
+	{
+		/** Stored right in front of every tracked allocation. */
+		struct AllocHeader
+		{
+			uint64 Size;
+
+			/** Distance from the block returned by MallocBinned to the allocation. */
+			uint32 Offset;
+
+			/** Index + 1 of the call stack in the stack table, 0 if the allocation wasn't sampled. */
+			uint16 StackId;
+			uint8 Tag;
+			uint8 Padding;
+		};
+		static_assert(sizeof(AllocHeader) == 16, "Allocation header must keep 16 bytes alignment.");
+
+		struct TagCounters
+		{
+			volatile int64 CurrentBytes;
+			volatile int64 PeakBytes;
+			volatile int64 NumLive;
+			volatile int64 NumAllocs;
+		};
+
+		struct StackEntry
+		{
+			uint64 Hash;
+			MemoryStackStats Stats;
+		};
+
+		enum
+		{
+			/** Capacity of the stack table, sampling stops once it is three quarters full. */
+			MaxStacks = 4096,
+		};
+
+		TagCounters Counters[MemoryTag_Max];
+		const char* TagNames[MemoryTag_Max] =
+		{
+			"Scope",
+			"Untagged",
+			"Containers",
+			"Strings",
+			"Threading",
+			"Pools",
+		};
+
+		volatile uint32 SampleRate = 0;
+
+		/** Open addressing table of the sampled call stacks, allocated on the first sample. */
+		StackEntry* pStacks = nullptr;
+		int32 NumStacks = 0;
+		volatile int32 StacksLock = 0;
+
+		thread_local uint32 SampleCountdown = 0;
+
+		void LockStacks()
+		{
+			while (StacksLock != 0 || PlatformAtomics::InterlockedExchange(&StacksLock, 1) != 0)
+			{
+				PlatformAtomics::Pause();
+			}
+		}
+
+		void UnlockStacks()
+		{
+			PlatformAtomics::InterlockedExchange(&StacksLock, 0);
+		}
+
+		__forceinline AllocHeader* GetHeader(void* Ptr)
+		{
+			return (AllocHeader*)Ptr - 1;
+		}
+
+		__forceinline uint32 GetHeaderOffset(uint32 Alignment)
+		{
+			return Alignment > sizeof(AllocHeader) ? Alignment : sizeof(AllocHeader);
+		}
+
+		int32 CaptureStack(void** pFrames, int32 MaxFrames)
+		{
+			// Skip CaptureStack and RecordSample, the frames above depend on inlining
+#if defined(_WIN32)
+			return CaptureStackBackTrace(2, MaxFrames, pFrames, nullptr);
+#else
+			void* Frames[MemoryStackStats::MaxFrames + 2];
+			const int32 NumFrames = backtrace(Frames, MaxFrames + 2) - 2;
+			if (NumFrames <= 0)
+			{
+				return 0;
+			}
+			memcpy(pFrames, Frames + 2, NumFrames * sizeof(void*));
+			return NumFrames;
+#endif
+		}
+
+		/**
+		* Captures the current call stack and adds an allocation to it.
+		*
+		* @return Id to store in the allocation header, 0 if the stack table is full
+		*/
+		uint16 RecordSample(size_t Size, uint32 Tag)
+		{
+			void* Frames[MemoryStackStats::MaxFrames];
+			const int32 NumFrames = CaptureStack(Frames, MemoryStackStats::MaxFrames);
+
+			// FNV-1a over the frames and the tag
+			uint64 Hash = 14695981039346656037ull ^ Tag;
+			for (int32 i = 0; i < NumFrames; i++)
+			{
+				Hash = (Hash ^ uint64(UPTRINT(Frames[i]))) * 1099511628211ull;
+			}
+			Hash |= 1;
+
+			uint16 Result = 0;
+			LockStacks();
+
+			if (pStacks == nullptr)
+			{
+				pStacks = (StackEntry*)calloc(MaxStacks, sizeof(StackEntry));
+			}
+
+			for (uint32 Index = uint32(Hash) & (MaxStacks - 1);; Index = (Index + 1) & (MaxStacks - 1))
+			{
+				StackEntry& Entry = pStacks[Index];
+				if (Entry.Hash == Hash)
+				{
+					Entry.Stats.SampledBytes += Size;
+					Entry.Stats.NumSampled++;
+					Result = uint16(Index + 1);
+					break;
+				}
+
+				if (Entry.Hash == 0)
+				{
+					if (NumStacks < MaxStacks * 3 / 4)
+					{
+						Entry.Hash = Hash;
+						memcpy(Entry.Stats.Frames, Frames, NumFrames * sizeof(void*));
+						Entry.Stats.NumFrames = NumFrames;
+						Entry.Stats.Tag = Tag;
+						Entry.Stats.SampledBytes = Size;
+						Entry.Stats.NumSampled = 1;
+						NumStacks++;
+						Result = uint16(Index + 1);
+					}
+					break;
+				}
+			}
+
+			UnlockStacks();
+			return Result;
+		}
+
+		void ReleaseSample(uint16 StackId, size_t Size)
+		{
+			LockStacks();
+
+			MemoryStackStats& Stats = pStacks[StackId - 1].Stats;
+			Stats.SampledBytes -= Size;
+			Stats.NumSampled--;
+
+			UnlockStacks();
+		}
+
+		void OnAlloc(AllocHeader* pHeader)
+		{
+			TagCounters& Counter = Counters[pHeader->Tag];
+
+			const int64 NewBytes = PlatformAtomics::InterlockedAdd(&Counter.CurrentBytes, int64(pHeader->Size)) + int64(pHeader->Size);
+			PlatformAtomics::InterlockedIncrement(&Counter.NumLive);
+			PlatformAtomics::InterlockedIncrement(&Counter.NumAllocs);
+
+			int64 Peak = Counter.PeakBytes;
+			while (NewBytes > Peak)
+			{
+				const int64 Previous = PlatformAtomics::InterlockedCompareExchange(&Counter.PeakBytes, NewBytes, Peak);
+				if (Previous == Peak)
+				{
+					break;
+				}
+				Peak = Previous;
+			}
+
+			const uint32 Rate = SampleRate;
+			if (Rate != 0)
+			{
+				if (SampleCountdown == 0 || SampleCountdown > Rate)
+				{
+					SampleCountdown = Rate;
+				}
+				if (--SampleCountdown == 0)
+				{
+					pHeader->StackId = RecordSample(pHeader->Size, pHeader->Tag);
+				}
+			}
+		}
+
+		void OnFree(AllocHeader* pHeader)
+		{
+			TagCounters& Counter = Counters[pHeader->Tag];
+			PlatformAtomics::InterlockedAdd(&Counter.CurrentBytes, -int64(pHeader->Size));
+			PlatformAtomics::InterlockedDecrement(&Counter.NumLive);
+
+			if (pHeader->StackId != 0)
+			{
+				ReleaseSample(pHeader->StackId, pHeader->Size);
+			}
+		}
+
+		const char* GetTagName(const MemorySnapshot& Snapshot, uint32 Tag, char (&Buffer)[16])
+		{
+			if (Snapshot.Tags[Tag].Name != nullptr)
+			{
+				return Snapshot.Tags[Tag].Name;
+			}
+
+			snprintf(Buffer, sizeof(Buffer), "Tag %u", Tag);
+			return Buffer;
+		}
+
+		void WriteToStdout(const char* Line)
+		{
+			fputs(Line, stdout);
+			fputs("\n", stdout);
+		}
+	}
+
+	void* MemoryTracker::Malloc(size_t Size, uint32 Alignment, uint32 Tag)
+	{
+		// Checked before narrowing to the uint8 of the header, which would wrap invalid tags into range
+		const uint32 ResolvedTag = Tag == MemoryTag_Scope ? GetScopeTag() : Tag;
+		Assertf(ResolvedTag < MemoryTag_Max, EDX_TEXT("Invalid memory tag %u"), ResolvedTag);
+
+		const uint32 Offset = GetHeaderOffset(Alignment);
+
+		_byte* pBlock = (_byte*)MallocBinned::Malloc(Size + Offset, Alignment);
+		if (pBlock == nullptr)
+		{
+			return nullptr;
+		}
+
+		void* Result = pBlock + Offset;
+		AllocHeader* pHeader = GetHeader(Result);
+		pHeader->Size = Size;
+		pHeader->Offset = Offset;
+		pHeader->StackId = 0;
+		pHeader->Tag = uint8(ResolvedTag);
+		pHeader->Padding = 0;
+
+		OnAlloc(pHeader);
+		return Result;
+	}
+
+	void* MemoryTracker::Realloc(void* Ptr, size_t NewSize, uint32 Alignment, uint32 Tag)
+	{
+		if (Ptr == nullptr)
+		{
+			return Malloc(NewSize, Alignment, Tag);
+		}
+		if (NewSize == 0)
+		{
+			Free(Ptr);
+			return nullptr;
+		}
+
+		// Moving keeps the header logic in one place, MallocBinned would copy most small blocks anyway
+		AllocHeader* pHeader = GetHeader(Ptr);
+		void* Result = Malloc(NewSize, Alignment, Tag == MemoryTag_Scope ? pHeader->Tag : Tag);
+		if (Result != nullptr)
+		{
+			memcpy(Result, Ptr, pHeader->Size < NewSize ? size_t(pHeader->Size) : NewSize);
+			Free(Ptr);
+		}
+		return Result;
+	}
+
+	void MemoryTracker::Free(void* Ptr)
+	{
+		if (Ptr == nullptr)
+		{
+			return;
+		}
+
+		AllocHeader* pHeader = GetHeader(Ptr);
+		OnFree(pHeader);
+		MallocBinned::Free((_byte*)Ptr - pHeader->Offset);
+	}
+
+	size_t MemoryTracker::GetAllocSize(void* Ptr)
+	{
+		if (Ptr == nullptr)
+		{
+			return 0;
+		}
+
+		const uint32 Offset = GetHeader(Ptr)->Offset;
+		return MallocBinned::GetAllocSize((_byte*)Ptr - Offset) - Offset;
+	}
+
+	size_t MemoryTracker::QuantizeSize(size_t Count, uint32 Alignment)
+	{
+		const uint32 Offset = GetHeaderOffset(Alignment);
+		return MallocBinned::QuantizeSize(Count + Offset, Alignment) - Offset;
+	}
+
+	uint32& MemoryTracker::GetScopeTag()
+	{
+		thread_local uint32 ScopeTag = MemoryTag_Untagged;
+		return ScopeTag;
+	}
+
+	void MemoryTracker::SetTagName(uint32 Tag, const char* Name)
+	{
+		Assert(Tag < MemoryTag_Max);
+		TagNames[Tag] = Name;
+	}
+
+	void MemoryTracker::SetSampleRate(uint32 OneInN)
+	{
+		SampleRate = OneInN;
+	}
+
+	void MemoryTracker::GetSnapshot(MemorySnapshot& OutSnapshot)
+	{
+		OutSnapshot.Time = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		OutSnapshot.SampleRate = SampleRate;
+
+		for (uint32 Tag = 0; Tag < MemoryTag_Max; Tag++)
+		{
+			MemoryTagStats& Stats = OutSnapshot.Tags[Tag];
+			Stats.Name = TagNames[Tag];
+			Stats.CurrentBytes = Counters[Tag].CurrentBytes;
+			Stats.PeakBytes = Counters[Tag].PeakBytes;
+			Stats.NumLive = Counters[Tag].NumLive;
+			Stats.NumAllocs = Counters[Tag].NumAllocs;
+		}
+
+		// Keep the stacks with the most live sampled bytes with an insertion sort, the output is small
+		OutSnapshot.NumStacks = 0;
+		LockStacks();
+
+		for (int32 Index = 0; pStacks != nullptr && Index < MaxStacks; Index++)
+		{
+			const MemoryStackStats& Stats = pStacks[Index].Stats;
+			if (pStacks[Index].Hash == 0 || Stats.NumSampled == 0)
+			{
+				continue;
+			}
+
+			int32 Position = OutSnapshot.NumStacks;
+			while (Position > 0 && OutSnapshot.Stacks[Position - 1].SampledBytes < Stats.SampledBytes)
+			{
+				Position--;
+			}
+			if (Position >= MemorySnapshot::MaxStacks)
+			{
+				continue;
+			}
+
+			const int32 NumToShift = (OutSnapshot.NumStacks < MemorySnapshot::MaxStacks ? OutSnapshot.NumStacks : MemorySnapshot::MaxStacks - 1) - Position;
+			memmove(&OutSnapshot.Stacks[Position + 1], &OutSnapshot.Stacks[Position], NumToShift * sizeof(MemoryStackStats));
+			OutSnapshot.Stacks[Position] = Stats;
+			if (OutSnapshot.NumStacks < MemorySnapshot::MaxStacks)
+			{
+				OutSnapshot.NumStacks++;
+			}
+		}
+
+		UnlockStacks();
+	}
+
+	void MemoryTracker::DumpReport(const MemorySnapshot& Snapshot, const MemorySnapshot* pPrevious, void(*Output)(const char* Line))
+	{
+		if (Output == nullptr)
+		{
+			Output = WriteToStdout;
+		}
+
+		const double Elapsed = pPrevious ? Snapshot.Time - pPrevious->Time : 0.0;
+		char Line[256];
+		char Name[16];
+
+		snprintf(Line, sizeof(Line), "%-16s %14s %14s %10s %12s", "Tag", "Bytes", "Peak", "Live", "Allocs/s");
+		Output(Line);
+
+		for (uint32 Tag = 0; Tag < MemoryTag_Max; Tag++)
+		{
+			const MemoryTagStats& Stats = Snapshot.Tags[Tag];
+			if (Stats.NumAllocs == 0)
+			{
+				continue;
+			}
+
+			const double Rate = Elapsed > 0.0 ? double(Stats.NumAllocs - pPrevious->Tags[Tag].NumAllocs) / Elapsed : 0.0;
+			snprintf(Line, sizeof(Line), "%-16s %14lld %14lld %10lld %12.0f", GetTagName(Snapshot, Tag, Name), (long long)Stats.CurrentBytes, (long long)Stats.PeakBytes, (long long)Stats.NumLive, Rate);
+			Output(Line);
+		}
+
+		if (Snapshot.NumStacks == 0)
+		{
+			return;
+		}
+
+		snprintf(Line, sizeof(Line), "Top sampled call stacks, 1 in %u allocations:", Snapshot.SampleRate);
+		Output(Line);
+
+		for (int32 i = 0; i < Snapshot.NumStacks; i++)
+		{
+			const MemoryStackStats& Stats = Snapshot.Stacks[i];
+			snprintf(Line, sizeof(Line), "#%d %s: %lld sampled bytes in %lld allocations, ~%lld bytes", i, GetTagName(Snapshot, Stats.Tag, Name),
+				(long long)Stats.SampledBytes, (long long)Stats.NumSampled, (long long)Stats.SampledBytes * Snapshot.SampleRate);
+			Output(Line);
+
+			for (int32 Frame = 0; Frame < Stats.NumFrames; Frame++)
+			{
+				snprintf(Line, sizeof(Line), "    %p", Stats.Frames[Frame]);
+				Output(Line);
+			}
+		}
+	}
+}
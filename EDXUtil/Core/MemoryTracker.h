@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../Core/Types.h"
+
+// Define EDX_TRACK_MEMORY to 1 to route Memory::AlignedAlloc, AlignedRealloc and Free through
+// MemoryTracker. It must be set the same way for every translation unit.
+#ifndef EDX_TRACK_MEMORY
+#define EDX_TRACK_MEMORY 0
+#endif
+
+namespace EDX
+{
+	/**
+	* Tags attributing allocations to a subsystem. Applications define their own tags starting at
+	* MemoryTag_User and name them with MemoryTracker::SetTagName.
+	*/
+	enum MemoryTag
+	{
+		/** Use the tag of the innermost ScopeMemoryTag of the calling thread. */
+		MemoryTag_Scope = 0,
+
+		/** Allocations made outside of any ScopeMemoryTag. */
+		MemoryTag_Untagged,
+		MemoryTag_Containers,
+		MemoryTag_Strings,
+		MemoryTag_Threading,
+		MemoryTag_Pools,
+
+		MemoryTag_User = 16,
+		MemoryTag_Max = 64,
+	};
+
+	/** Counters of one tag. */
+	struct MemoryTagStats
+	{
+		const char* Name;
+
+		/** Bytes requested by the live allocations. */
+		int64 CurrentBytes;
+		int64 PeakBytes;
+		int64 NumLive;
+
+		/** Number of allocations since the start of the program, reallocations included. */
+		int64 NumAllocs;
+	};
+
+	/** Live sampled allocations sharing a call stack. */
+	struct MemoryStackStats
+	{
+		enum { MaxFrames = 16 };
+
+		void* Frames[MaxFrames];
+		int32 NumFrames;
+		uint32 Tag;
+
+		/** Bytes and number of the live sampled allocations, multiply by the sample rate to estimate the totals. */
+		int64 SampledBytes;
+		int64 NumSampled;
+	};
+
+	/** Copy of the counters at a point in time, see MemoryTracker::GetSnapshot. */
+	struct MemorySnapshot
+	{
+		enum { MaxStacks = 32 };
+
+		/** Seconds since an arbitrary origin, used to compute allocation rates between snapshots. */
+		double Time;
+		uint32 SampleRate;
+
+		MemoryTagStats Tags[MemoryTag_Max];
+
+		/** Call stacks with the most sampled live bytes, in decreasing order. */
+		MemoryStackStats Stacks[MaxStacks];
+		int32 NumStacks;
+	};
+
+	/**
+	* Instrumentation layer between Memory and MallocBinned, compiled in when EDX_TRACK_MEMORY is 1.
+	*
+	* Every allocation is prefixed with a small header recording its size and tag, so frees can be
+	* attributed without any lookup. One allocation in SampleRate also records the call stack it
+	* was made from, aggregated by stack so leaks and hot growth paths can be told apart. The
+	* counters are global atomics, tracking is meant for profiling builds, not for shipping.
+	*/
+	class MemoryTracker
+	{
+	public:
+		static void* Malloc(size_t Size, uint32 Alignment, uint32 Tag);
+		static void* Realloc(void* Ptr, size_t NewSize, uint32 Alignment, uint32 Tag);
+		static void Free(void* Ptr);
+		static size_t GetAllocSize(void* Ptr);
+		static size_t QuantizeSize(size_t Count, uint32 Alignment);
+
+		/**
+		* Gets the tag allocations of the calling thread fall back to, set by ScopeMemoryTag.
+		*/
+		static uint32& GetScopeTag();
+
+		/**
+		* Names a tag in the reports. The name must outlive the tracker, usually a string literal.
+		*/
+		static void SetTagName(uint32 Tag, const char* Name);
+
+		/**
+		* Sets how often call stacks are captured, 0 to disable sampling.
+		*
+		* @param OneInN One allocation in OneInN is sampled, per thread
+		*/
+		static void SetSampleRate(uint32 OneInN);
+
+		static void GetSnapshot(MemorySnapshot& OutSnapshot);
+
+		/**
+		* Writes a report of the tags in use and of the top sampled call stacks, addresses are not
+		* symbolized.
+		*
+		* @param Snapshot Counters to report
+		* @param pPrevious Earlier snapshot to compute the allocation rates from, can be nullptr
+		* @param Output Function receiving the report line by line, nullptr writes to stdout
+		*/
+		static void DumpReport(const MemorySnapshot& Snapshot, const MemorySnapshot* pPrevious = nullptr, void(*Output)(const char* Line) = nullptr);
+	};
+
+	/**
+	* Attributes the allocations of the calling thread which don't name a tag to Tag, until the
+	* end of the scope. Does nothing when EDX_TRACK_MEMORY is 0.
+	*/
+	class ScopeMemoryTag
+	{
+	private:
+#if EDX_TRACK_MEMORY
+		uint32 PreviousTag;
+#endif
+
+	public:
+		ScopeMemoryTag(uint32 Tag)
+		{
+#if EDX_TRACK_MEMORY
+			uint32& ScopeTag = MemoryTracker::GetScopeTag();
+			PreviousTag = ScopeTag;
+			ScopeTag = Tag;
+#endif
+		}
+
+		~ScopeMemoryTag()
+		{
+#if EDX_TRACK_MEMORY
+			MemoryTracker::GetScopeTag() = PreviousTag;
+#endif
+		}
+
+		ScopeMemoryTag(const ScopeMemoryTag&) = delete;
+		ScopeMemoryTag& operator=(const ScopeMemoryTag&) = delete;
+	};
+}
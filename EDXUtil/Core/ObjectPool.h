@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../Containers/Array.h"
+
+namespace EDX
+{
+	/**
+	* Pool of objects of a single type, with constant time creation and destruction.
+	*
+	* Objects live in slabs of SlotsPerSlab slots and never move, free slots are chained in an
+	* intrusive free list. Slots are laid out so that an object never straddles more cache lines than
+	* its size requires: small objects get a power of two slot, objects of a cache line or more get a
+	* multiple of 64 bytes. Objects are referenced through handles pairing the slot index with the
+	* generation of the slot, so a handle to a destroyed object is detected instead of aliasing the
+	* object created in its slot afterwards. The pool is not thread safe. Example:
+	*
+	* <code>
+	*	ObjectPool<Particle> Particles;
+	*	ObjectPool<Particle>::Handle Spark = Particles.Create(Position, Velocity);
+	*	...
+	*	Particles.ForEach([&](Particle& P) { P.Update(DeltaTime); });
+	*	...
+	*	Particles.Destroy(Spark);
+	*	Assert(Particles.Get(Spark) == nullptr);
+	* </code>
+	*/
+	template<typename T, uint32 SlotsPerSlab = 64>
+	class ObjectPool
+	{
+		static_assert((SlotsPerSlab & (SlotsPerSlab - 1)) == 0, "SlotsPerSlab must be a power of two.");
+
+	public:
+		/** Reference to an object of the pool, the default handle refers to nothing. */
+		struct Handle
+		{
+			uint32 Index;
+
+			/** Generation of the slot when the object was created, always odd for a valid handle. */
+			uint32 Generation;
+
+			Handle()
+				: Index(0)
+				, Generation(0)
+			{
+			}
+
+			Handle(uint32 InIndex, uint32 InGeneration)
+				: Index(InIndex)
+				, Generation(InGeneration)
+			{
+			}
+
+			/** Whether the handle was returned by Create, the object may have been destroyed since. */
+			bool IsSet() const
+			{
+				return Generation != 0;
+			}
+
+			bool operator==(const Handle& Other) const
+			{
+				return Index == Other.Index && Generation == Other.Generation;
+			}
+
+			bool operator!=(const Handle& Other) const
+			{
+				return !(*this == Other);
+			}
+		};
+
+	private:
+		static constexpr uint32 CalcSlotSize()
+		{
+			uint32 Size = sizeof(T) > sizeof(uint32) ? sizeof(T) : sizeof(uint32);
+			if (Size >= 64)
+			{
+				return (Size + 63) & ~63;
+			}
+
+			uint32 PowerOfTwo = 4;
+			while (PowerOfTwo < Size)
+			{
+				PowerOfTwo *= 2;
+			}
+			return PowerOfTwo < ALIGNOF(T) ? ALIGNOF(T) : PowerOfTwo;
+		}
+
+		enum
+		{
+			SlotSize = CalcSlotSize(),
+			SlabAlignment = ALIGNOF(T) > 64 ? ALIGNOF(T) : 64,
+		};
+
+		/** The slabs holding the objects, slot i lives in slab i / SlotsPerSlab. */
+		Array<_byte*> Slabs;
+
+		/** Generation of each slot, odd while the slot holds an object. */
+		Array<uint32> Generations;
+
+		/** First slot of the free list, the next one is stored in the slot itself. */
+		uint32 FreeHead;
+
+		int32 NumObjects;
+
+		__forceinline _byte* GetSlot(uint32 Index) const
+		{
+			return Slabs[Index / SlotsPerSlab] + (Index % SlotsPerSlab) * SlotSize;
+		}
+
+		__forceinline uint32& GetNextFree(uint32 Index) const
+		{
+			return *(uint32*)GetSlot(Index);
+		}
+
+		void AddSlab()
+		{
+			const uint32 FirstIndex = Slabs.Size() * SlotsPerSlab;
+			Slabs.Add((_byte*)Memory::AlignedAlloc(SlotsPerSlab * SlotSize, SlabAlignment));
+			Generations.AddZeroed(SlotsPerSlab);
+
+			// Chain the slots in memory order so that new objects are packed at the front
+			for (uint32 i = SlotsPerSlab; i > 0; i--)
+			{
+				GetNextFree(FirstIndex + i - 1) = FreeHead;
+				FreeHead = FirstIndex + i - 1;
+			}
+		}
+
+	public:
+		ObjectPool()
+			: FreeHead(uint32(INDEX_NONE))
+			, NumObjects(0)
+		{
+		}
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		~ObjectPool()
+		{
+			Empty();
+
+			for (int32 i = 0; i < Slabs.Size(); i++)
+			{
+				Memory::Free(Slabs[i]);
+			}
+		}
+
+		/**
+		* Constructs an object in a free slot.
+		*
+		* @param Args Arguments forwarded to the constructor of T
+		* @return Handle to the new object
+		*/
+		template<typename... ArgsType>
+		Handle Create(ArgsType&&... Args)
+		{
+			if (FreeHead == uint32(INDEX_NONE))
+			{
+				AddSlab();
+			}
+
+			const uint32 Index = FreeHead;
+			FreeHead = GetNextFree(Index);
+
+			new(GetSlot(Index)) T(Forward<ArgsType>(Args)...);
+			NumObjects++;
+
+			return Handle(Index, ++Generations[Index]);
+		}
+
+		/**
+		* Destructs an object and frees its slot, handles to it become stale.
+		*
+		* @param InHandle Handle to the object, stale handles are ignored
+		* @return true if the object was destroyed, false if the handle was stale
+		*/
+		bool Destroy(const Handle& InHandle)
+		{
+			if (!IsValid(InHandle))
+			{
+				return false;
+			}
+
+			const uint32 Index = InHandle.Index;
+			((T*)GetSlot(Index))->~T();
+			Generations[Index]++;
+
+			GetNextFree(Index) = FreeHead;
+			FreeHead = Index;
+			NumObjects--;
+
+			return true;
+		}
+
+		/** Whether a handle refers to an object which hasn't been destroyed. */
+		__forceinline bool IsValid(const Handle& InHandle) const
+		{
+			return InHandle.Index < uint32(Generations.Size()) && Generations[InHandle.Index] == InHandle.Generation && (InHandle.Generation & 1) != 0;
+		}
+
+		/**
+		* Gets the object referenced by a handle.
+		*
+		* @return The object, nullptr if the handle is stale
+		*/
+		__forceinline T* Get(const Handle& InHandle)
+		{
+			return IsValid(InHandle) ? (T*)GetSlot(InHandle.Index) : nullptr;
+		}
+
+		__forceinline const T* Get(const Handle& InHandle) const
+		{
+			return IsValid(InHandle) ? (const T*)GetSlot(InHandle.Index) : nullptr;
+		}
+
+		/** Number of live objects. */
+		__forceinline int32 Num() const
+		{
+			return NumObjects;
+		}
+
+		/**
+		* Calls Func on every live object, in slot order (memory order within each slab).
+		*
+		* @param Func Function taking a T&, must not create or destroy objects of this pool
+		*/
+		template<typename Function>
+		void ForEach(const Function& Func)
+		{
+			for (int32 SlabIndex = 0; SlabIndex < Slabs.Size(); SlabIndex++)
+			{
+				_byte* pSlab = Slabs[SlabIndex];
+				const uint32* pGenerations = Generations.Data() + SlabIndex * SlotsPerSlab;
+				for (uint32 i = 0; i < SlotsPerSlab; i++)
+				{
+					if (pGenerations[i] & 1)
+					{
+						Func(*(T*)(pSlab + i * SlotSize));
+					}
+				}
+			}
+		}
+
+		/**
+		* Calls Func on every live object with its handle, in slot order.
+		*
+		* @param Func Function taking a const Handle& and a T&, must not create or destroy objects of this pool
+		*/
+		template<typename Function>
+		void ForEachWithHandle(const Function& Func)
+		{
+			for (int32 SlabIndex = 0; SlabIndex < Slabs.Size(); SlabIndex++)
+			{
+				_byte* pSlab = Slabs[SlabIndex];
+				for (uint32 i = 0; i < SlotsPerSlab; i++)
+				{
+					const uint32 Index = SlabIndex * SlotsPerSlab + i;
+					if (Generations[Index] & 1)
+					{
+						Func(Handle(Index, Generations[Index]), *(T*)(pSlab + i * SlotSize));
+					}
+				}
+			}
+		}
+
+		/**
+		* Destroys every object. The slabs are kept for the objects created next, and the generations
+		* move on like in Destroy, so handles created before the call are rejected afterwards.
+		*/
+		void Empty()
+		{
+			ForEach([](T& Object) { Object.~T(); });
+
+			// Chain every slot back in memory order, odd generations become even to mark the slots free
+			FreeHead = uint32(INDEX_NONE);
+			for (uint32 Index = uint32(Generations.Size()); Index > 0; Index--)
+			{
+				Generations[Index - 1] += Generations[Index - 1] & 1;
+				GetNextFree(Index - 1) = FreeHead;
+				FreeHead = Index - 1;
+			}
+
+			NumObjects = 0;
+		}
+	};
+}
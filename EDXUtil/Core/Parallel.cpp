@@ -0,0 +1,15 @@
+#include "Parallel.h"
+
+namespace EDX
+{
+	namespace Parallel
+	{
+		void RunTasks(int32 NumTasks, TaskFunction pFunc, void* pContext)
+		{
+			ParallelFor(0, NumTasks, 1, [&](int32 TaskIndex)
+			{
+				pFunc(pContext, TaskIndex);
+			});
+		}
+	}
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../Windows/Threading.h"
+#include "ParallelTasks.h"
+
+namespace EDX
+{
+	namespace Parallel
+	{
+		/**
+		* Gets the thread pool used by ParallelFor and ParallelReduce. The pool is created with
+		* one thread per core minus the calling thread if nobody created it before, in work stealing
+		* mode so that splitting a range pushes to the splitting thread's own deque and wakes at most
+		* one idle thread, instead of taking the pool lock.
+		*
+		* @return The thread pool, nullptr if the machine only has one core
+		*/
+		inline QueuedThreadPool* GetThreadPool()
+		{
+			static QueuedThreadPool* pPool = []()
+			{
+				QueuedThreadPool* pInstance = QueuedThreadPool::Instance();
+				if (pInstance->GetNumThreads() == 0 && GetNumberOfCores() > 1)
+				{
+					pInstance->Create(GetNumberOfCores() - 1, 0, TPri_Normal, true);
+				}
+				return pInstance;
+			}();
+
+			return pPool->GetNumThreads() > 0 ? pPool : nullptr;
+		}
+
+		/**
+		* Waits for a job living on the caller's stack to finish, running other queued jobs meanwhile.
+		*
+		* @param pPool The pool the job was queued to
+		* @param bFinished Flag set by the job once it is done
+		*/
+		inline void HelpUntilFinished(QueuedThreadPool* pPool, const volatile int32& bFinished)
+		{
+			uint32 NumSpins = 0;
+			while (!bFinished)
+			{
+				if (pPool->TryExecuteJob())
+				{
+					NumSpins = 0;
+				}
+				else if (++NumSpins < 64)
+				{
+					PlatformAtomics::Pause();
+				}
+				else
+				{
+					SwitchToThread();
+				}
+			}
+		}
+
+		/**
+		* Picks a grain size giving each thread a few chunks to balance load when the caller didn't specify one.
+		*/
+		inline int32 DefaultGrainSize(int32 Count, QueuedThreadPool* pPool)
+		{
+			return Math::Max(1, Count / (8 * (pPool->GetNumThreads() + 1)));
+		}
+	}
+
+	/**
+	* Queued work running a sub range of a ParallelFor. Instances live on the stack of the thread that
+	* split the range, which waits for them to finish, so no memory is allocated per call.
+	*/
+	template<typename Function>
+	class ParallelForWork : public QueuedWork
+	{
+	private:
+		const Function& Func;
+		int32 Begin;
+		int32 End;
+		int32 Grain;
+		QueuedThreadPool* pPool;
+		volatile int32 bFinished;
+
+	public:
+		ParallelForWork(const Function& InFunc, int32 InBegin, int32 InEnd, int32 InGrain, QueuedThreadPool* InPool)
+			: Func(InFunc)
+			, Begin(InBegin)
+			, End(InEnd)
+			, Grain(InGrain)
+			, pPool(InPool)
+			, bFinished(0)
+		{
+		}
+
+		/**
+		* Runs the range with lazy binary splitting: the range is only halved when the jobs already
+		* queued from this thread have been picked up, otherwise it keeps running grain sized chunks.
+		*/
+		static void Execute(const Function& Func, int32 Begin, int32 End, int32 Grain, QueuedThreadPool* pPool)
+		{
+			while (End - Begin > Grain)
+			{
+				if (pPool->ShouldSplitWork())
+				{
+					const int32 Mid = Begin + (End - Begin) / 2;
+
+					ParallelForWork RightWork(Func, Mid, End, Grain, pPool);
+					pPool->AddQueuedWork(&RightWork);
+
+					Execute(Func, Begin, Mid, Grain, pPool);
+
+					Parallel::HelpUntilFinished(pPool, RightWork.bFinished);
+					return;
+				}
+
+				for (int32 i = Begin; i < Begin + Grain; i++)
+				{
+					Func(i);
+				}
+				Begin += Grain;
+			}
+
+			for (int32 i = Begin; i < End; i++)
+			{
+				Func(i);
+			}
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			Execute(Func, Begin, End, Grain, pPool);
+
+			// The owner may release this object as soon as the flag is set, it must be the last access
+			PlatformAtomics::InterlockedExchange(&bFinished, 1);
+		}
+
+		virtual void Abandon() override
+		{
+			// The owner is waiting on the range, run it here rather than dropping it
+			DoThreadedWork();
+		}
+	};
+
+	/**
+	* Queued work running a sub range of a ParallelReduce, see ParallelForWork.
+	*/
+	template<typename T, typename Function, typename Reduction>
+	class ParallelReduceWork : public QueuedWork
+	{
+	private:
+		const Function& Func;
+		const Reduction& Reduce;
+		const T& Identity;
+		int32 Begin;
+		int32 End;
+		int32 Grain;
+		QueuedThreadPool* pPool;
+		T Result;
+		volatile int32 bFinished;
+
+	public:
+		ParallelReduceWork(const Function& InFunc, const Reduction& InReduce, const T& InIdentity, int32 InBegin, int32 InEnd, int32 InGrain, QueuedThreadPool* InPool)
+			: Func(InFunc)
+			, Reduce(InReduce)
+			, Identity(InIdentity)
+			, Begin(InBegin)
+			, End(InEnd)
+			, Grain(InGrain)
+			, pPool(InPool)
+			, Result(InIdentity)
+			, bFinished(0)
+		{
+		}
+
+		/**
+		* Reduces the range with lazy binary splitting. Partial results are combined left to right so
+		* the reduction only needs to be associative.
+		*/
+		static T Execute(const Function& Func, const Reduction& Reduce, const T& Identity, int32 Begin, int32 End, int32 Grain, QueuedThreadPool* pPool)
+		{
+			T Value = Identity;
+			while (End - Begin > Grain)
+			{
+				if (pPool->ShouldSplitWork())
+				{
+					const int32 Mid = Begin + (End - Begin) / 2;
+
+					ParallelReduceWork RightWork(Func, Reduce, Identity, Mid, End, Grain, pPool);
+					pPool->AddQueuedWork(&RightWork);
+
+					Value = Reduce(Value, Execute(Func, Reduce, Identity, Begin, Mid, Grain, pPool));
+
+					Parallel::HelpUntilFinished(pPool, RightWork.bFinished);
+					return Reduce(Value, RightWork.Result);
+				}
+
+				Value = Func(Begin, Begin + Grain, Value);
+				Begin += Grain;
+			}
+
+			return Func(Begin, End, Value);
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			Result = Execute(Func, Reduce, Identity, Begin, End, Grain, pPool);
+
+			// The owner may release this object as soon as the flag is set, it must be the last access
+			PlatformAtomics::InterlockedExchange(&bFinished, 1);
+		}
+
+		virtual void Abandon() override
+		{
+			// The owner is waiting on the range, run it here rather than dropping it
+			DoThreadedWork();
+		}
+	};
+
+	/**
+	* Calls Func(i) for every i in [Begin, End) using the global thread pool. The calling thread
+	* takes part in the work and the call returns once every index has been processed.
+	*
+	* @param Begin First index
+	* @param End One past the last index
+	* @param Grain Minimum number of indices processed by one job, 0 picks one based on the number of threads
+	* @param Func Function called with each index, must be safe to call concurrently
+	*/
+	template<typename Function>
+	void ParallelFor(int32 Begin, int32 End, int32 Grain, const Function& Func)
+	{
+		QueuedThreadPool* pPool = Parallel::GetThreadPool();
+		if (Grain <= 0)
+		{
+			Grain = pPool ? Parallel::DefaultGrainSize(End - Begin, pPool) : End - Begin;
+		}
+
+		if (pPool == nullptr || End - Begin <= Grain)
+		{
+			for (int32 i = Begin; i < End; i++)
+			{
+				Func(i);
+			}
+			return;
+		}
+
+		ParallelForWork<Function>::Execute(Func, Begin, End, Grain, pPool);
+	}
+
+	/**
+	* Calls Func(i) for every i in [Begin, End) using the global thread pool, with an automatic grain size.
+	*/
+	template<typename Function>
+	void ParallelFor(int32 Begin, int32 End, const Function& Func)
+	{
+		ParallelFor(Begin, End, 0, Func);
+	}
+
+	/**
+	* Reduces the range [Begin, End) using the global thread pool. Func(RangeBegin, RangeEnd, Init)
+	* accumulates a sub range on top of Init and returns the new value, Reduce(A, B) combines two
+	* partial results. Partial results are combined in index order.
+	*
+	* @param Begin First index
+	* @param End One past the last index
+	* @param Grain Minimum number of indices processed by one job, 0 picks one based on the number of threads
+	* @param Identity Identity value of the reduction
+	* @param Func Function accumulating a sub range
+	* @param Reduce Associative function combining two partial results
+	* @return The reduced value
+	*/
+	template<typename T, typename Function, typename Reduction>
+	T ParallelReduce(int32 Begin, int32 End, int32 Grain, const T& Identity, const Function& Func, const Reduction& Reduce)
+	{
+		QueuedThreadPool* pPool = Parallel::GetThreadPool();
+		if (Grain <= 0)
+		{
+			Grain = pPool ? Parallel::DefaultGrainSize(End - Begin, pPool) : End - Begin;
+		}
+
+		if (pPool == nullptr || End - Begin <= Grain)
+		{
+			return Begin < End ? Func(Begin, End, Identity) : Identity;
+		}
+
+		return ParallelReduceWork<T, Function, Reduction>::Execute(Func, Reduce, Identity, Begin, End, Grain, pPool);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Types.h"
+
+namespace EDX
+{
+	namespace Parallel
+	{
+		typedef void(*TaskFunction)(void* pContext, int32 TaskIndex);
+
+		/**
+		* Calls pFunc(pContext, i) for every i in [0, NumTasks) using the global thread pool, like ParallelFor
+		* with a grain of one task. Not a template, so headers which Parallel.h depends on, such as the
+		* containers, can run work in parallel without including it.
+		*
+		* @param NumTasks Number of tasks
+		* @param pFunc Function called with each task index, must be safe to call concurrently
+		* @param pContext Pointer passed through to pFunc
+		*/
+		void RunTasks(int32 NumTasks, TaskFunction pFunc, void* pContext);
+
+		/**
+		* Calls Func(i) for every i in [0, NumTasks) using the global thread pool, see RunTasks above.
+		*/
+		template<typename Function>
+		__forceinline void RunTasks(int32 NumTasks, const Function& Func)
+		{
+			RunTasks(NumTasks, [](void* pContext, int32 TaskIndex) { (*(const Function*)pContext)(TaskIndex); }, (void*)&Func);
+		}
+	}
+}
@@ -183,7 +183,7 @@ namespace EDX
 			/** Adds a shared reference to this counter */
 			static __forceinline void AddSharedReference(ReferenceControllerBase* ReferenceController)
 			{
-				WindowsAtomics::InterlockedIncrement(&ReferenceController->SharedReferenceCount);
+				PlatformAtomics::InterlockedIncrement(&ReferenceController->SharedReferenceCount);
 			}
 
 			/**
@@ -205,7 +205,7 @@ namespace EDX
 					}
 
 					// Attempt to increment the reference count.
-					const int32 ActualOriginalCount = WindowsAtomics::InterlockedCompareExchange(&ReferenceController->SharedReferenceCount, OriginalCount + 1, OriginalCount);
+					const int32 ActualOriginalCount = PlatformAtomics::InterlockedCompareExchange(&ReferenceController->SharedReferenceCount, OriginalCount + 1, OriginalCount);
 
 					// We need to make sure that we never revive a counter that has already expired, so if the
 					// actual value what we expected (because it was touched by another thread), then we'll try
@@ -222,7 +222,7 @@ namespace EDX
 			{
 				Assert(ReferenceController->SharedReferenceCount > 0);
 
-				if (WindowsAtomics::InterlockedDecrement(&ReferenceController->SharedReferenceCount) == 0)
+				if (PlatformAtomics::InterlockedDecrement(&ReferenceController->SharedReferenceCount) == 0)
 				{
 					// Last shared reference was released!  Destroy the referenced object.
 					ReferenceController->DestroyObject();
@@ -237,7 +237,7 @@ namespace EDX
 			/** Adds a weak reference to this counter */
 			static __forceinline void AddWeakReference(ReferenceControllerBase* ReferenceController)
 			{
-				WindowsAtomics::InterlockedIncrement(&ReferenceController->WeakReferenceCount);
+				PlatformAtomics::InterlockedIncrement(&ReferenceController->WeakReferenceCount);
 			}
 
 			/** Releases a weak reference to this counter */
@@ -245,7 +245,7 @@ namespace EDX
 			{
 				Assert(ReferenceController->WeakReferenceCount > 0);
 
-				if (WindowsAtomics::InterlockedDecrement(&ReferenceController->WeakReferenceCount) == 0)
+				if (PlatformAtomics::InterlockedDecrement(&ReferenceController->WeakReferenceCount) == 0)
 				{
 					// No more references to this reference count.  Destroy it!
 					delete ReferenceController;
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "Types.h"
+#include "Template.h"
+#include "Memory.h"
+#include "ParallelTasks.h"
+
 namespace EDX
 {
 	/**
@@ -51,100 +56,209 @@ namespace EDX
 		}
 	};
 
-	/**
-	* Sort elements using user defined predicate class. The sort is unstable, meaning that the ordering of equal items is not necessarily preserved.
-	* This is the internal sorting function used by Sort overrides.
-	*
-	* @param	First	pointer to the first element to sort
-	* @param	Num		the number of items to sort
-	* @param Predicate predicate class
-	*/
-	template<class T, class PREDICATE_CLASS>
-	void SortInternal(T* First, const int32 Num, const PREDICATE_CLASS& Predicate)
+	namespace Sorting_Private
 	{
-		struct Stack
+		enum
 		{
-			T* Min;
-			T* Max;
+			/** Partitions of this many elements or fewer are finished with an insertion sort. */
+			InsertionSortThreshold = 32,
+
+			/** Partitions larger than this take the median of three medians of three (ninther) as pivot. */
+			NintherThreshold = 256,
+
+			/** Partitions larger than this are split across the thread pool by ParallelSort. */
+			ParallelSortThreshold = 32768,
 		};
 
-		if (Num < 2)
+		template<class T, class PREDICATE_CLASS>
+		void InsertionSort(T* First, const int32 Num, const PREDICATE_CLASS& Predicate)
 		{
-			return;
+			for (int32 Index = 1; Index < Num; Index++)
+			{
+				if (Predicate(First[Index], First[Index - 1]))
+				{
+					T Value = Move(First[Index]);
+					int32 Hole = Index;
+					do
+					{
+						First[Hole] = Move(First[Hole - 1]);
+						Hole--;
+					} while (Hole > 0 && Predicate(Value, First[Hole - 1]));
+					First[Hole] = Move(Value);
+				}
+			}
 		}
-		Stack RecursionStack[32] = { { First,First + Num - 1 } }, Current, Inner;
-		for (Stack* StackTop = RecursionStack; StackTop >= RecursionStack; --StackTop) //-V625
+
+		template<class T, class PREDICATE_CLASS>
+		void HeapSiftDown(T* First, int32 Index, const int32 Num, const PREDICATE_CLASS& Predicate)
 		{
-			Current = *StackTop;
-		Loop:
-			PTRINT Count = Current.Max - Current.Min + 1;
-			if (Count <= 8)
+			for (int32 Child = 2 * Index + 1; Child < Num; Index = Child, Child = 2 * Index + 1)
 			{
-				// Use simple bubble-sort.
-				while (Current.Max > Current.Min)
+				if (Child + 1 < Num && Predicate(First[Child], First[Child + 1]))
 				{
-					T *Max, *Item;
-					for (Max = Current.Min, Item = Current.Min + 1; Item <= Current.Max; Item++)
-					{
-						if (Predicate(*Max, *Item))
-						{
-							Max = Item;
-						}
-					}
-					Exchange(*Max, *Current.Max--);
+					Child++;
+				}
+				if (!Predicate(First[Index], First[Child]))
+				{
+					break;
 				}
+				Exchange(First[Index], First[Child]);
+			}
+		}
+
+		/** Fallback of the introsort when partitioning degenerates, O(n log n) on any input. */
+		template<class T, class PREDICATE_CLASS>
+		void HeapSort(T* First, const int32 Num, const PREDICATE_CLASS& Predicate)
+		{
+			for (int32 Index = Num / 2 - 1; Index >= 0; Index--)
+			{
+				HeapSiftDown(First, Index, Num, Predicate);
+			}
+			for (int32 Index = Num - 1; Index > 0; Index--)
+			{
+				Exchange(First[0], First[Index]);
+				HeapSiftDown(First, 0, Index, Predicate);
+			}
+		}
+
+		/**
+		* @return The median of three elements. None of them is moved: sorting the samples in place breaks patterns such
+		* as reversed ranges into pivots which degrade the following partitions.
+		*/
+		template<class T, class PREDICATE_CLASS>
+		__forceinline T* Median3(T* A, T* B, T* C, const PREDICATE_CLASS& Predicate)
+		{
+			if (Predicate(*A, *B))
+			{
+				return Predicate(*B, *C) ? B : (Predicate(*A, *C) ? C : A);
+			}
+			return Predicate(*A, *C) ? A : (Predicate(*B, *C) ? C : B);
+		}
+
+		/**
+		* Partitions the elements around a median of three, or a ninther for large partitions, with equal elements
+		* stopping both scans so that duplicates split evenly.
+		*
+		* @return The final index of the pivot, the elements before it don't compare greater and the ones after don't compare less.
+		*/
+		template<class T, class PREDICATE_CLASS>
+		int32 Partition(T* First, const int32 Num, const PREDICATE_CLASS& Predicate)
+		{
+			// The ends are not sampled: partitioning moves the pivot to the front and the element it replaces to the
+			// end of a side, so sorted runs come back as e.g. the largest element followed by the rest in order
+			T* Mid = First + Num / 2;
+			T* Last = First + Num - 1;
+			T* Pivot;
+			if (Num > NintherThreshold)
+			{
+				const int32 Step = Num / 8;
+				Pivot = Median3(
+					Median3(First + 1, First + Step, First + 2 * Step, Predicate),
+					Median3(Mid - Step, Mid, Mid + Step, Predicate),
+					Median3(Last - 2 * Step, Last - Step, Last - 1, Predicate),
+					Predicate);
 			}
 			else
 			{
-				// Grab middle element so sort doesn't exhibit worst-cast behavior with presorted lists.
-				Exchange(Current.Min[Count / 2], Current.Min[0]);
+				Pivot = Median3(First + 1, Mid, Last - 1, Predicate);
+			}
+			Exchange(*First, *Pivot);
 
-				// Divide list into two halves, one with items <=Current.Min, the other with items >Current.Max.
-				Inner.Min = Current.Min;
-				Inner.Max = Current.Max + 1;
-				for (; ; )
+			T* Left = First;
+			T* Right = First + Num;
+			for (;;)
+			{
+				while (++Left < First + Num && Predicate(*Left, *First));
+				while (Predicate(*First, *--Right));
+				if (Left >= Right)
 				{
-					while (++Inner.Min <= Current.Max && !Predicate(*Current.Min, *Inner.Min));
-					while (--Inner.Max> Current.Min && !Predicate(*Inner.Max, *Current.Min));
-					if (Inner.Min>Inner.Max)
-					{
-						break;
-					}
-					Exchange(*Inner.Min, *Inner.Max);
+					break;
+				}
+				Exchange(*Left, *Right);
+			}
+			Exchange(*First, *Right);
+
+			return int32(Right - First);
+		}
+
+		/** Depth below which the introsort switches to heap sort, 2 * log2(Num). */
+		__forceinline int32 IntroSortDepthLimit(int32 Num)
+		{
+			int32 Depth = 0;
+			for (; Num > 1; Num >>= 1)
+			{
+				Depth += 2;
+			}
+			return Depth;
+		}
+
+		template<class T, class PREDICATE_CLASS>
+		void IntroSort(T* First, int32 Num, int32 DepthLimit, const PREDICATE_CLASS& Predicate)
+		{
+			while (Num > InsertionSortThreshold)
+			{
+				if (DepthLimit-- == 0)
+				{
+					HeapSort(First, Num, Predicate);
+					return;
 				}
-				Exchange(*Current.Min, *Inner.Max);
 
-				// Save big half and recurse with small half.
-				if (Inner.Max - 1 - Current.Min >= Current.Max - Inner.Min)
+				// Recurse into the smaller side and loop on the larger one, which bounds the stack depth to log2(Num)
+				const int32 PivotIndex = Partition(First, Num, Predicate);
+				const int32 NumRight = Num - PivotIndex - 1;
+				if (PivotIndex < NumRight)
 				{
-					if (Current.Min + 1 < Inner.Max)
-					{
-						StackTop->Min = Current.Min;
-						StackTop->Max = Inner.Max - 1;
-						StackTop++;
-					}
-					if (Current.Max>Inner.Min)
-					{
-						Current.Min = Inner.Min;
-						goto Loop;
-					}
+					IntroSort(First, PivotIndex, DepthLimit, Predicate);
+					First += PivotIndex + 1;
+					Num = NumRight;
 				}
 				else
 				{
-					if (Current.Max>Inner.Min)
-					{
-						StackTop->Min = Inner.Min;
-						StackTop->Max = Current.Max;
-						StackTop++;
-					}
-					if (Current.Min + 1<Inner.Max)
-					{
-						Current.Max = Inner.Max - 1;
-						goto Loop;
-					}
+					IntroSort(First + PivotIndex + 1, NumRight, DepthLimit, Predicate);
+					Num = PivotIndex;
 				}
 			}
+
+			InsertionSort(First, Num, Predicate);
 		}
+
+		template<class T, class PREDICATE_CLASS>
+		void ParallelIntroSort(T* First, const int32 Num, const int32 DepthLimit, const PREDICATE_CLASS& Predicate)
+		{
+			if (Num <= ParallelSortThreshold || DepthLimit == 0)
+			{
+				IntroSort(First, Num, DepthLimit, Predicate);
+				return;
+			}
+
+			const int32 PivotIndex = Partition(First, Num, Predicate);
+			Parallel::RunTasks(2, [&](int32 Side)
+			{
+				if (Side == 0)
+				{
+					ParallelIntroSort(First, PivotIndex, DepthLimit - 1, Predicate);
+				}
+				else
+				{
+					ParallelIntroSort(First + PivotIndex + 1, Num - PivotIndex - 1, DepthLimit - 1, Predicate);
+				}
+			});
+		}
+	}
+
+	/**
+	* Sort elements using user defined predicate class. The sort is unstable, meaning that the ordering of equal items is not necessarily preserved.
+	* This is the internal sorting function used by Sort overrides: an introsort, quick sort with ninther pivots falling back
+	* to heap sort when the recursion gets too deep, and insertion sort for small partitions.
+	*
+	* @param	First	pointer to the first element to sort
+	* @param	Num		the number of items to sort
+	* @param Predicate predicate class
+	*/
+	template<class T, class PREDICATE_CLASS>
+	void SortInternal(T* First, const int32 Num, const PREDICATE_CLASS& Predicate)
+	{
+		Sorting_Private::IntroSort(First, Num, Sorting_Private::IntroSortDepthLimit(Num), Predicate);
 	}
 
 	/**
@@ -198,6 +312,206 @@ namespace EDX
 		SortInternal(First, Num, DereferenceWrapper<T*, Less<T> >(Less<T>()));
 	}
 
+	/**
+	* Sort elements on the global thread pool using user defined predicate class. Each partition step of the introsort
+	* hands its two sides to different threads until they are small enough to be sorted serially. The sort is unstable,
+	* and the predicate must be safe to call concurrently.
+	*
+	* @param	First	pointer to the first element to sort
+	* @param	Num		the number of items to sort
+	* @param Predicate predicate class
+	*/
+	template<class T, class PREDICATE_CLASS>
+	void ParallelSort(T* First, const int32 Num, const PREDICATE_CLASS& Predicate)
+	{
+		Sorting_Private::ParallelIntroSort(First, Num, Sorting_Private::IntroSortDepthLimit(Num), DereferenceWrapper<T, PREDICATE_CLASS>(Predicate));
+	}
+
+	/**
+	* Specialized version of the above ParallelSort function for pointers to elements.
+	*/
+	template<class T, class PREDICATE_CLASS>
+	void ParallelSort(T** First, const int32 Num, const PREDICATE_CLASS& Predicate)
+	{
+		Sorting_Private::ParallelIntroSort(First, Num, Sorting_Private::IntroSortDepthLimit(Num), DereferenceWrapper<T*, PREDICATE_CLASS>(Predicate));
+	}
+
+	/**
+	* Sort elements on the global thread pool. Assumes < operator is defined for the template type.
+	*
+	* @param	First	pointer to the first element to sort
+	* @param	Num		the number of items to sort
+	*/
+	template<class T>
+	void ParallelSort(T* First, const int32 Num)
+	{
+		ParallelSort(First, Num, Less<T>());
+	}
+
+	/**
+	* Specialized version of the above ParallelSort function for pointers to elements.
+	*/
+	template<class T>
+	void ParallelSort(T** First, const int32 Num)
+	{
+		ParallelSort(First, Num, Less<T>());
+	}
+
+	namespace Sorting_Private
+	{
+		/** Maps keys to unsigned integers with the same order, for the radix sort. */
+		__forceinline uint32 RadixKey(uint8 Key) { return Key; }
+		__forceinline uint32 RadixKey(uint16 Key) { return Key; }
+		__forceinline uint32 RadixKey(uint32 Key) { return Key; }
+		__forceinline uint64 RadixKey(uint64 Key) { return Key; }
+		__forceinline uint32 RadixKey(int8 Key) { return uint32(int32(Key)) ^ 0x80000000u; }
+		__forceinline uint32 RadixKey(int16 Key) { return uint32(int32(Key)) ^ 0x80000000u; }
+		__forceinline uint32 RadixKey(int32 Key) { return uint32(Key) ^ 0x80000000u; }
+		__forceinline uint64 RadixKey(int64 Key) { return uint64(Key) ^ 0x8000000000000000ull; }
+
+		/** long and wchar_t have a different size on Windows and Linux, they share the key of the integer of their size. */
+		typedef ChooseClass<sizeof(long) == 8, int64, int32>::Result LongSizedInt;
+		typedef ChooseClass<sizeof(long) == 8, uint64, uint32>::Result ULongSizedInt;
+		typedef ChooseClass<(wchar_t(-1) < 0), int32, uint32>::Result WideCharSizedInt;
+
+		__forceinline ULongSizedInt RadixKey(long Key) { return RadixKey(LongSizedInt(Key)); }
+		__forceinline ULongSizedInt RadixKey(unsigned long Key) { return RadixKey(ULongSizedInt(Key)); }
+		__forceinline uint32 RadixKey(char Key) { return RadixKey(int32(Key)); }
+		__forceinline uint32 RadixKey(wchar_t Key) { return RadixKey(WideCharSizedInt(Key)); }
+		__forceinline uint32 RadixKey(char16_t Key) { return Key; }
+		__forceinline uint32 RadixKey(char32_t Key) { return Key; }
+		__forceinline uint32 RadixKey(bool Key) { return Key ? 1 : 0; }
+
+		/** Flips all the bits of negative values and only the sign bit of positive ones. -0 sorts before +0. */
+		__forceinline uint32 RadixKey(float Key)
+		{
+			uint32 Bits;
+			Memory::Memcpy(&Bits, &Key, sizeof(Bits));
+			return Bits ^ (uint32(-int32(Bits >> 31)) | 0x80000000u);
+		}
+
+		__forceinline uint64 RadixKey(double Key)
+		{
+			uint64 Bits;
+			Memory::Memcpy(&Bits, &Key, sizeof(Bits));
+			return Bits ^ (uint64(-int64(Bits >> 63)) | 0x8000000000000000ull);
+		}
+
+		/** Enums sort by their underlying integer, like operator< compares them. */
+		template<typename T>
+		struct EnumRadixKey
+		{
+			typedef decltype(RadixKey((__underlying_type(T))0)) Type;
+		};
+
+		template<typename T>
+		__forceinline typename EnableIf<IsEnum<T>::Value, EnumRadixKey<T>>::Type::Type RadixKey(T Key)
+		{
+			return RadixKey((__underlying_type(T))Key);
+		}
+
+		/** Any other key type reports an error here instead of an overload resolution failure in RadixSort. */
+		template<typename T>
+		__forceinline typename EnableIf<!IsEnum<T>::Value, uint32>::Type RadixKey(const T& Key)
+		{
+			static_assert(sizeof(T) == 0, "RadixSort keys must be integers, characters, bool, enums, float or double. Pass a key function returning one of them.");
+			return 0;
+		}
+
+		/** Key function of RadixSort when the elements are the keys. */
+		struct IdentityRadixKey
+		{
+			template<typename T>
+			__forceinline const T& operator()(const T& Element) const
+			{
+				return Element;
+			}
+		};
+	}
+
+	/**
+	* Sorts elements with a least significant digit radix sort on keys extracted from them, in O(n) with one 8 bits digit
+	* per pass. Passes on digits all keys share are skipped, e.g. the high bits of small Morton codes. The sort is stable.
+	*
+	* The elements are relocated to a temporary buffer of the same size and back with Memcpy, like the containers do.
+	*
+	* @param	First	pointer to the first element to sort
+	* @param	Num		the number of items to sort
+	* @param	GetKey	returns the key of an element, any integer, character, bool, enum or floating point type
+	*/
+	template<class T, class KEY_FUNC>
+	void RadixSort(T* First, const int32 Num, const KEY_FUNC& GetKey)
+	{
+		typedef decltype(Sorting_Private::RadixKey(GetKey(*First))) KeyType;
+		enum { NumPasses = sizeof(KeyType), NumBuckets = 256 };
+
+		if (Num < 2)
+		{
+			return;
+		}
+
+		// Histograms of all the digits in one pass
+		int32 Counts[NumPasses][NumBuckets] = {};
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const KeyType Key = Sorting_Private::RadixKey(GetKey(First[Index]));
+			for (int32 Pass = 0; Pass < NumPasses; Pass++)
+			{
+				Counts[Pass][(Key >> (Pass * 8)) & 0xFF]++;
+			}
+		}
+
+		T* Source = First;
+		T* Dest = (T*)Memory::AlignedAlloc(sizeof(T) * size_t(Num), uint32(alignof(T)));
+		T* Buffer = Dest;
+
+		const KeyType FirstKey = Sorting_Private::RadixKey(GetKey(First[0]));
+		for (int32 Pass = 0; Pass < NumPasses; Pass++)
+		{
+			const int32 Shift = Pass * 8;
+			if (Counts[Pass][(FirstKey >> Shift) & 0xFF] == Num)
+			{
+				continue;
+			}
+
+			int32 Offsets[NumBuckets];
+			int32 Offset = 0;
+			for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+			{
+				Offsets[Bucket] = Offset;
+				Offset += Counts[Pass][Bucket];
+			}
+
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				const uint32 Digit = (Sorting_Private::RadixKey(GetKey(Source[Index])) >> Shift) & 0xFF;
+				Memory::Memcpy(&Dest[Offsets[Digit]++], &Source[Index], sizeof(T));
+			}
+
+			T* Temp = Source;
+			Source = Dest;
+			Dest = Temp;
+		}
+
+		if (Source != First)
+		{
+			Memory::Memcpy(First, Source, sizeof(T) * Num);
+		}
+		Memory::Free(Buffer);
+	}
+
+	/**
+	* Sorts integer or floating point elements with a least significant digit radix sort, see above.
+	*
+	* @param	First	pointer to the first element to sort
+	* @param	Num		the number of items to sort
+	*/
+	template<class T>
+	void RadixSort(T* First, const int32 Num)
+	{
+		RadixSort(First, Num, Sorting_Private::IdentityRadixKey());
+	}
+
 	/**
 	* Stable merge to perform sort below. Stable sort is slower than non-stable
 	* algorithm.
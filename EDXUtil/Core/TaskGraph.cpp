@@ -0,0 +1,135 @@
+#include "TaskGraph.h"
+
+namespace EDX
+{
+	bool TaskEvent::AddSubsequent(GraphTask* InTask)
+	{
+		ScopeLock Lock(&SubsequentsLock);
+		if (bComplete)
+		{
+			return false;
+		}
+
+		Subsequents.Add(InTask);
+		return true;
+	}
+
+	void TaskEvent::DispatchSubsequents()
+	{
+		Array<GraphTask*> ReadySubsequents;
+		{
+			ScopeLock Lock(&SubsequentsLock);
+			PlatformAtomics::InterlockedExchange(&bComplete, 1);
+			ReadySubsequents = Move(Subsequents);
+		}
+
+		for (auto& Subsequent : ReadySubsequents)
+		{
+			Subsequent->PrerequisiteCompleted();
+		}
+	}
+
+	void TaskEvent::Wait()
+	{
+		if (bComplete)
+		{
+			return;
+		}
+
+		QueuedThreadPool* pPool = Parallel::GetThreadPool();
+		Assertf(pPool != nullptr, EDX_TEXT("Waiting on a task that can never run, is there a dependency cycle?"));
+
+		Parallel::HelpUntilFinished(pPool, bComplete);
+	}
+
+	void GraphTask::Schedule()
+	{
+		QueuedThreadPool* pPool = Parallel::GetThreadPool();
+		if (pPool)
+		{
+			pPool->AddQueuedWork(this);
+		}
+		else
+		{
+			DoThreadedWork();
+		}
+	}
+
+	void GraphTask::DoThreadedWork()
+	{
+		Work();
+
+		// Release the task before dispatching, the subsequents may be waited on and freed right away
+		TaskEventRef Event = Move(CompletionEvent);
+		delete this;
+
+		Event->DispatchSubsequents();
+	}
+
+	void GraphTask::Abandon()
+	{
+		// Nobody will run the work, still complete the event so waiters don't hang
+		TaskEventRef Event = Move(CompletionEvent);
+		delete this;
+
+		Event->DispatchSubsequents();
+	}
+
+	TaskEventRef TaskGraph::Launch(const Function<void()>& InWork)
+	{
+		GraphTask* pTask = new GraphTask(InWork);
+		TaskEventRef Event = pTask->CompletionEvent;
+
+		pTask->PrerequisiteCompleted();
+
+		return Event;
+	}
+
+	TaskEventRef TaskGraph::Launch(const Function<void()>& InWork, const Array<TaskEventRef>& Prerequisites)
+	{
+		GraphTask* pTask = new GraphTask(InWork);
+		TaskEventRef Event = pTask->CompletionEvent;
+
+		for (auto& Prerequisite : Prerequisites)
+		{
+			if (Prerequisite.IsValid())
+			{
+				pTask->NumPrerequisites.Increment();
+				if (!Prerequisite->AddSubsequent(pTask))
+				{
+					// Already complete
+					pTask->NumPrerequisites.Decrement();
+				}
+			}
+		}
+
+		// Release the setup hold, queues the task if every prerequisite already completed
+		pTask->PrerequisiteCompleted();
+
+		return Event;
+	}
+
+	TaskEventRef TaskGraph::ContinueWith(const TaskEventRef& Prerequisite, const Function<void()>& InWork)
+	{
+		Array<TaskEventRef> Prerequisites;
+		Prerequisites.Add(Prerequisite);
+
+		return Launch(InWork, Prerequisites);
+	}
+
+	void TaskGraph::Wait(const TaskEventRef& Event)
+	{
+		if (Event.IsValid())
+		{
+			Event->Wait();
+		}
+	}
+
+	void TaskGraph::WaitAll(const Array<TaskEventRef>& Events)
+	{
+		for (auto& Event : Events)
+		{
+			Wait(Event);
+		}
+	}
+}
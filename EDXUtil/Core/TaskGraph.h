@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Function.h"
+#include "SmartPointer.h"
+#include "Parallel.h"
+
+namespace EDX
+{
+	class TaskEvent;
+	class GraphTask;
+
+	/** Reference to the completion event of a task, kept alive as long as anyone holds it. */
+	typedef SharedPtr<TaskEvent, ESPMode::ThreadSafe> TaskEventRef;
+
+	/**
+	* Completion event of a graph task.
+	*
+	* Tasks depending on an event register themselves as subsequents and get released once the
+	* event completes. Waiting on an event runs queued jobs on the waiting thread instead of sleeping.
+	*/
+	class TaskEvent
+	{
+	private:
+		/** Tasks waiting on this event. */
+		Array<GraphTask*> Subsequents;
+
+		/** The synchronization object used to protect access to the subsequents. */
+		CriticalSection SubsequentsLock;
+
+		/** Set once the owning task has finished, never reset. */
+		volatile int32 bComplete;
+
+	public:
+		TaskEvent()
+			: bComplete(0)
+		{
+		}
+
+		TaskEvent(const TaskEvent&) = delete;
+		TaskEvent& operator=(const TaskEvent&) = delete;
+
+		/**
+		* Registers a task to be released when this event completes.
+		*
+		* @param InTask The task depending on this event
+		* @return true if the task was registered, false if the event already completed
+		*/
+		bool AddSubsequent(GraphTask* InTask);
+
+		/** Marks the event complete and releases all the subsequents. */
+		void DispatchSubsequents();
+
+		bool IsComplete() const
+		{
+			return bComplete != 0;
+		}
+
+		/** Waits for the event to complete, running queued jobs meanwhile. */
+		void Wait();
+	};
+
+	/**
+	* A task of the task graph.
+	*
+	* The task is queued to the thread pool once all its prerequisites have completed, and deletes
+	* itself after running. Its completion event outlives it through TaskEventRef.
+	*/
+	class GraphTask : public QueuedWork
+	{
+	private:
+		/** The work to do. */
+		Function<void()> Work;
+
+		/** Number of prerequisites not completed yet, plus one held while the task is being set up. */
+		AtomicCounter NumPrerequisites;
+
+		/** Event completed once the work is done. */
+		TaskEventRef CompletionEvent;
+
+		GraphTask(const Function<void()>& InWork)
+			: Work(InWork)
+			, NumPrerequisites(1)
+			, CompletionEvent(new TaskEvent)
+		{
+		}
+
+		/** Queues the task to the thread pool, or runs it on the calling thread if there is no pool. */
+		void Schedule();
+
+	public:
+		friend class TaskEvent;
+		friend class TaskGraph;
+
+		/** Called once per completed prerequisite, queues the task when the last one completes. */
+		void PrerequisiteCompleted()
+		{
+			if (NumPrerequisites.Decrement() == 0)
+			{
+				Schedule();
+			}
+		}
+
+		virtual void DoThreadedWork() override;
+
+		virtual void Abandon() override;
+	};
+
+	/**
+	* Task graph built on top of QueuedThreadPool.
+	*
+	* Tasks can depend on the completion of other tasks, and any subset of tasks can be waited
+	* on, unlike QueuedThreadPool::JoinAllThreads which waits for the whole pool to drain. Example:
+	*
+	* <code>
+	*	TaskEventRef Load = TaskGraph::Launch([&]() { LoadMesh(); });
+	*	TaskEventRef Mips = TaskGraph::ContinueWith(Load, [&]() { BuildMipmaps(); });
+	*	TaskEventRef Upload = TaskGraph::ContinueWith(Mips, [&]() { Upload(); });
+	*	...
+	*	TaskGraph::Wait(Upload);
+	* </code>
+	*/
+	class TaskGraph
+	{
+	public:
+		/**
+		* Launches a task with no prerequisites.
+		*
+		* @param InWork The work to do
+		* @return The completion event of the task
+		*/
+		static TaskEventRef Launch(const Function<void()>& InWork);
+
+		/**
+		* Launches a task that runs once all the prerequisites have completed.
+		*
+		* @param InWork The work to do
+		* @param Prerequisites Events to wait for, null references are ignored
+		* @return The completion event of the task
+		*/
+		static TaskEventRef Launch(const Function<void()>& InWork, const Array<TaskEventRef>& Prerequisites);
+
+		/**
+		* Launches a continuation, a task that runs once another task has completed.
+		*
+		* @param Prerequisite The event to wait for
+		* @param InWork The work to do
+		* @return The completion event of the continuation
+		*/
+		static TaskEventRef ContinueWith(const TaskEventRef& Prerequisite, const Function<void()>& InWork);
+
+		/**
+		* Waits for a task to complete, running queued jobs on the calling thread meanwhile.
+		*
+		* @param Event The completion event of the task
+		*/
+		static void Wait(const TaskEventRef& Event);
+
+		/**
+		* Waits for a subset of tasks to complete, running queued jobs on the calling thread meanwhile.
+		*
+		* @param Events The completion events of the tasks
+		*/
+		static void WaitAll(const Array<TaskEventRef>& Events);
+	};
+}
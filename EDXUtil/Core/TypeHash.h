@@ -2,6 +2,7 @@
 
 #include "Types.h"
 #include "Crc.h"
+#include "FastHash.h"
 
 namespace EDX
 {
@@ -105,7 +106,12 @@ namespace EDX
 
 	inline uint32 GetTypeHash(const TCHAR* S)
 	{
-		return Crc::StrHash(S);
+		const TCHAR* End = S;
+		while (*End)
+		{
+			End++;
+		}
+		return FastHash::MemHash(S, (End - S) * sizeof(TCHAR));
 	}
 
 	inline uint32 GetTypeHash(const void* A)
@@ -118,9 +124,52 @@ namespace EDX
 		return PointerHash(A);
 	}
 
+	/**
+	* Hashes the bytes of a value, for plain data keys compared with Memcmp. The type must not have padding
+	* bytes, whose content is undefined.
+	*/
+	template <typename T>
+	inline uint32 GetPodHash(const T& Value)
+	{
+		static_assert(IsPODType<T>::Value, "GetPodHash only hashes plain data types.");
+		return FastHash::MemHash(&Value, sizeof(T));
+	}
+
 	template <typename EnumType>
 	__forceinline  typename EnableIf<IsEnum<EnumType>::Value, uint32>::Type GetTypeHash(EnumType E)
 	{
 		return GetTypeHash((__underlying_type(EnumType))E);
 	}
+
+	/**
+	* Tests if a GetTypeHash overload accepts a type, found here or by argument dependent lookup next to the type.
+	*/
+	template <typename T>
+	struct HasTypeHash
+	{
+	private:
+		template <typename U> static char Test(decltype(GetTypeHash(*(const U*)nullptr))*);
+		template <typename U> static int32 Test(...);
+
+	public:
+		enum { Value = sizeof(Test<T>(nullptr)) == sizeof(char) };
+	};
+
+	/**
+	* Hashes a key of the default key functions of Set, Map, FlatSet and ConcurrentMap. Uses GetTypeHash when the type
+	* has an overload, plain data types without one are hashed by their bytes with GetPodHash, so they must not have
+	* padding bytes either.
+	*/
+	template <typename T>
+	__forceinline typename EnableIf<HasTypeHash<T>::Value, uint32>::Type GetKeyTypeHash(const T& Key)
+	{
+		return GetTypeHash(Key);
+	}
+
+	template <typename T>
+	__forceinline typename EnableIf<!HasTypeHash<T>::Value, uint32>::Type GetKeyTypeHash(const T& Key)
+	{
+		static_assert(IsPODType<T>::Value, "Keys need a GetTypeHash overload, only plain data types can be hashed by their bytes.");
+		return GetPodHash(Key);
+	}
 }
\ No newline at end of file
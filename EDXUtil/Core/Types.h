@@ -12,7 +12,9 @@
 
 // C++ support
 #include <cstdlib>
+#ifdef _MSC_VER
 #include <crtdbg.h>
+#endif
 #include <new>
 #include <malloc.h>
 #include <cstdio>
@@ -28,6 +30,10 @@
 	#define EDX_TEXT(x) x
 #endif
 
+#if !defined(_MSC_VER) && !defined(__forceinline)
+	#define __forceinline inline __attribute__((always_inline))
+#endif
+
 #ifdef __CUDACC__
 	#define EDX_INLINE __forceinline __device__ __host__
 #else
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "../Core/Types.h"
+
+namespace EDX
+{
+	/**
+	* Linux implementation of the Atomics OS functions, on top of the GCC atomic builtins. Every read-modify-write
+	* operation is a full barrier and returns the same value as its Win32 counterpart.
+	*/
+	class LinuxAtomics
+	{
+	public:
+		static __forceinline int32 InterlockedIncrement(volatile int32* Value)
+		{
+			return __atomic_add_fetch(Value, 1, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline int64 InterlockedIncrement(volatile int64* Value)
+		{
+			return __atomic_add_fetch(Value, 1, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline int32 InterlockedDecrement(volatile int32* Value)
+		{
+			return __atomic_sub_fetch(Value, 1, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline int64 InterlockedDecrement(volatile int64* Value)
+		{
+			return __atomic_sub_fetch(Value, 1, __ATOMIC_SEQ_CST);
+		}
+
+		/** @return The value before the addition, like InterlockedExchangeAdd. */
+		static __forceinline int32 InterlockedAdd(volatile int32* Value, int32 Amount)
+		{
+			return __atomic_fetch_add(Value, Amount, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline int64 InterlockedAdd(volatile int64* Value, int64 Amount)
+		{
+			return __atomic_fetch_add(Value, Amount, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline int32 InterlockedExchange(volatile int32* Value, int32 Exchange)
+		{
+			return __atomic_exchange_n(Value, Exchange, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline int64 InterlockedExchange(volatile int64* Value, int64 Exchange)
+		{
+			return __atomic_exchange_n(Value, Exchange, __ATOMIC_SEQ_CST);
+		}
+
+		static __forceinline void* InterlockedExchangePtr(void** Dest, void* Exchange)
+		{
+			return __atomic_exchange_n(Dest, Exchange, __ATOMIC_SEQ_CST);
+		}
+
+		/** @return The value of Dest before the operation, the exchange happened if it equals Comparand. */
+		static __forceinline int32 InterlockedCompareExchange(volatile int32* Dest, int32 Exchange, int32 Comparand)
+		{
+			__atomic_compare_exchange_n(Dest, &Comparand, Exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			return Comparand;
+		}
+
+		static __forceinline int64 InterlockedCompareExchange(volatile int64* Dest, int64 Exchange, int64 Comparand)
+		{
+			__atomic_compare_exchange_n(Dest, &Comparand, Exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			return Comparand;
+		}
+
+		static __forceinline void* InterlockedCompareExchangePointer(void** Dest, void* Exchange, void* Comparand)
+		{
+			__atomic_compare_exchange_n(Dest, &Comparand, Exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			return Comparand;
+		}
+
+		/**
+		* Issues a full hardware memory barrier, no loads or stores can be reordered across it.
+		*/
+		static __forceinline void FullBarrier()
+		{
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		}
+
+		/**
+		* Prevents the compiler from reordering loads and stores across this point, emits no instruction.
+		*/
+		static __forceinline void CompilerBarrier()
+		{
+			__atomic_signal_fence(__ATOMIC_SEQ_CST);
+		}
+
+		/**
+		* Keeps the loads before this point from being reordered with the loads and stores after it.
+		*/
+		static __forceinline void ReadBarrier()
+		{
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		}
+
+		/**
+		* Keeps the loads and stores before this point from being reordered with the stores after it.
+		*/
+		static __forceinline void WriteBarrier()
+		{
+			__atomic_thread_fence(__ATOMIC_RELEASE);
+		}
+
+		/**
+		* Loads a value published by StoreRelease, the loads and stores after it can't move before it. Pairs with
+		* StoreRelease: everything written before the store is visible after the load returns the stored value.
+		*/
+		static __forceinline int32 LoadAcquire(const volatile int32* Src)
+		{
+			return __atomic_load_n(Src, __ATOMIC_ACQUIRE);
+		}
+
+		static __forceinline int64 LoadAcquire(const volatile int64* Src)
+		{
+			return __atomic_load_n(Src, __ATOMIC_ACQUIRE);
+		}
+
+		template<typename T>
+		static __forceinline T* LoadAcquire(T* const volatile* Src)
+		{
+			return __atomic_load_n(Src, __ATOMIC_ACQUIRE);
+		}
+
+		/**
+		* Publishes a value, the loads and stores before it can't move after it.
+		*/
+		static __forceinline void StoreRelease(volatile int32* Dest, int32 Value)
+		{
+			__atomic_store_n(Dest, Value, __ATOMIC_RELEASE);
+		}
+
+		static __forceinline void StoreRelease(volatile int64* Dest, int64 Value)
+		{
+			__atomic_store_n(Dest, Value, __ATOMIC_RELEASE);
+		}
+
+		template<typename T>
+		static __forceinline void StoreRelease(T* volatile* Dest, T* Value)
+		{
+			__atomic_store_n(Dest, Value, __ATOMIC_RELEASE);
+		}
+
+		/**
+		* Hints the processor that the calling thread is spinning, like YieldProcessor.
+		*/
+		static __forceinline void Pause()
+		{
+#if defined(__i386__) || defined(__x86_64__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			__asm__ __volatile__("yield");
+#endif
+		}
+	};
+
+	typedef LinuxAtomics PlatformAtomics;
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+#include "../Core/Types.h"
+#include "Atomics.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <ctime>
+#include <cerrno>
+
+namespace EDX
+{
+	/**
+	* Thin wrappers over the futex system call used by the Linux synchronization primitives, the atomics
+	* come from LinuxAtomics.
+	*/
+	class LinuxFutex
+	{
+	public:
+		/**
+		* Sleeps as long as *Addr equals Expected, until woken up or the timeout elapses.
+		*
+		* @param Addr The futex word
+		* @param Expected Value the word must still hold for the thread to go to sleep
+		* @param WaitTimeMs Timeout in milliseconds, MAX_uint32 waits forever
+		* @return false if the wait timed out, true otherwise
+		*/
+		static bool Wait(volatile int32* Addr, int32 Expected, uint32 WaitTimeMs = 0xffffffff)
+		{
+			timespec Timeout;
+			timespec* pTimeout = nullptr;
+			if (WaitTimeMs != 0xffffffff)
+			{
+				Timeout.tv_sec = WaitTimeMs / 1000;
+				Timeout.tv_nsec = (WaitTimeMs % 1000) * 1000000;
+				pTimeout = &Timeout;
+			}
+
+			const long Result = syscall(SYS_futex, (int32*)Addr, FUTEX_WAIT_PRIVATE, Expected, pTimeout, nullptr, 0);
+			return !(Result == -1 && errno == ETIMEDOUT);
+		}
+
+		/**
+		* Wakes up threads sleeping on a futex word.
+		*
+		* @param Addr The futex word
+		* @param Count Maximum number of threads to wake up
+		*/
+		static void Wake(volatile int32* Addr, int32 Count)
+		{
+			syscall(SYS_futex, (int32*)Addr, FUTEX_WAKE_PRIVATE, Count, nullptr, nullptr, 0);
+		}
+
+		/** @return Milliseconds elapsed since an arbitrary origin, never going backwards. */
+		static __forceinline uint64 GetMonotonicMs()
+		{
+			timespec Now;
+			clock_gettime(CLOCK_MONOTONIC, &Now);
+			return uint64(Now.tv_sec) * 1000 + uint64(Now.tv_nsec) / 1000000;
+		}
+
+		/** Gets a cheap unique identifier of the calling thread. */
+		static __forceinline UPTRINT GetThreadTag()
+		{
+			static thread_local uint8 ThreadTag;
+			return (UPTRINT)&ThreadTag;
+		}
+	};
+
+	/**
+	* This is the Linux version of a critical section. It is a recursive futex lock with the same
+	* semantics as the Windows CRITICAL_SECTION.
+	*
+	* The lock word is 0 when free, 1 when locked and 2 when locked with possible sleepers, so an
+	* uncontended Lock/Unlock pair costs one compare-and-swap and one atomic exchange. A contended
+	* Lock spins before going to sleep, the spin count adapts to how long the lock was held recently.
+	*/
+	class CriticalSection
+	{
+	private:
+		/** The futex word: 0 unlocked, 1 locked, 2 locked with sleepers. */
+		volatile int32 State;
+
+		/** Number of times the owner has entered the lock. */
+		int32 RecursionCount;
+
+		/** Thread tag of the owner, 0 when unlocked. */
+		volatile UPTRINT OwningThread;
+
+		/** Running average of the spins needed to take the lock under contention. */
+		int32 SpinEstimate;
+
+		enum
+		{
+			MaxSpinCount = 4000,
+		};
+
+		void LockSlow()
+		{
+			// Spin for a bit more than it took recently, the owner is likely to be about to release
+			const int32 MaxSpins = SpinEstimate * 2 + 16 < MaxSpinCount ? SpinEstimate * 2 + 16 : MaxSpinCount;
+			for (int32 Spin = 0; Spin < MaxSpins; Spin++)
+			{
+				if (State == 0 && LinuxAtomics::InterlockedCompareExchange(&State, 1, 0) == 0)
+				{
+					SpinEstimate += (Spin - SpinEstimate) / 8;
+					return;
+				}
+				LinuxAtomics::Pause();
+			}
+			SpinEstimate += (MaxSpins - SpinEstimate) / 8;
+
+			// Mark the lock as contended and sleep until it is handed over
+			while (LinuxAtomics::InterlockedExchange(&State, 2) != 0)
+			{
+				LinuxFutex::Wait(&State, 2);
+			}
+		}
+
+	public:
+		friend class ConditionVar;
+
+		CriticalSection(const CriticalSection&) = delete;
+		CriticalSection& operator=(const CriticalSection&) = delete;
+
+		__forceinline CriticalSection()
+			: State(0)
+			, RecursionCount(0)
+			, OwningThread(0)
+			, SpinEstimate(100)
+		{
+		}
+
+		/**
+		* Locks the critical section
+		*/
+		__forceinline void Lock()
+		{
+			const UPTRINT ThreadTag = LinuxFutex::GetThreadTag();
+			if (OwningThread == ThreadTag)
+			{
+				RecursionCount++;
+				return;
+			}
+
+			if (LinuxAtomics::InterlockedCompareExchange(&State, 1, 0) != 0)
+			{
+				LockSlow();
+			}
+
+			OwningThread = ThreadTag;
+			RecursionCount = 1;
+		}
+
+		/**
+		* Attempt to take a lock and returns whether or not a lock was taken.
+		*
+		* @return true if a lock was taken, false otherwise.
+		*/
+		__forceinline bool TryLock()
+		{
+			const UPTRINT ThreadTag = LinuxFutex::GetThreadTag();
+			if (OwningThread == ThreadTag)
+			{
+				RecursionCount++;
+				return true;
+			}
+
+			if (LinuxAtomics::InterlockedCompareExchange(&State, 1, 0) != 0)
+			{
+				return false;
+			}
+
+			OwningThread = ThreadTag;
+			RecursionCount = 1;
+			return true;
+		}
+
+		/**
+		* Releases the lock on the critical section
+		*/
+		__forceinline void Unlock()
+		{
+			// Must be called by the owner
+			if (--RecursionCount > 0)
+			{
+				return;
+			}
+
+			OwningThread = 0;
+			if (LinuxAtomics::InterlockedExchange(&State, 0) == 2)
+			{
+				LinuxFutex::Wake(&State, 1);
+			}
+		}
+	};
+
+	/**
+	* Futex based condition variable. Waiters sleep on a sequence number bumped by every
+	* Signal/Broadcast, so a wake-up between releasing the lock and going to sleep is never lost.
+	*/
+	class ConditionVar
+	{
+	private:
+		volatile int32 Sequence;
+
+	public:
+		ConditionVar()
+			: Sequence(0)
+		{
+		}
+
+		void Wait(CriticalSection& lock)
+		{
+			// Like SleepConditionVariableCS, the lock must not be entered recursively
+			const int32 Seq = LinuxAtomics::LoadAcquire(&Sequence);
+			lock.Unlock();
+			LinuxFutex::Wait(&Sequence, Seq);
+			lock.Lock();
+		}
+		void Signal()
+		{
+			LinuxAtomics::InterlockedIncrement(&Sequence);
+			LinuxFutex::Wake(&Sequence, 1);
+		}
+		void Broadcast()
+		{
+			LinuxAtomics::InterlockedIncrement(&Sequence);
+			LinuxFutex::Wake(&Sequence, INT_MAX);
+		}
+	};
+
+	/**
+	* Futex based event, keeps the name of the Windows version so that code using it is portable.
+	*/
+	class WinEvent
+	{
+	private:
+		/** 1 when signaled, 0 otherwise. */
+		volatile int32 State;
+
+		/** Number of threads sleeping in Wait, lets Trigger skip the system call. */
+		volatile int32 NumWaiters;
+
+		/** Whether the signaled state of the event needs to be reset manually. */
+		bool ManualReset;
+
+		/** Consumes the signaled state, only manual reset events stay signaled. */
+		bool TryConsume()
+		{
+			if (ManualReset)
+			{
+				return LinuxAtomics::LoadAcquire(&State) == 1;
+			}
+			return LinuxAtomics::InterlockedCompareExchange(&State, 0, 1) == 1;
+		}
+
+	public:
+		/**
+		* Creates the event.
+		*
+		* Manually reset events stay triggered until reset.
+		*
+		* @param bIsManualReset Whether the event requires manual reseting or not.
+		* @return true if the event was created, false otherwise.
+		*/
+		bool Create(bool bIsManualReset = false)
+		{
+			State = 0;
+			NumWaiters = 0;
+			ManualReset = bIsManualReset;
+
+			return true;
+		}
+
+		/**
+		* Whether the signaled state of this event needs to be reset manually.
+		*
+		* @return true if the state requires manual resetting, false otherwise.
+		* @see Reset
+		*/
+		bool IsManualReset()
+		{
+			return ManualReset;
+		}
+
+		/**
+		* Triggers the event so any waiting threads are activated.
+		*
+		* @see IsManualReset, Reset
+		*/
+		void Trigger()
+		{
+			LinuxAtomics::InterlockedExchange(&State, 1);
+			if (LinuxAtomics::LoadAcquire(&NumWaiters) > 0)
+			{
+				LinuxFutex::Wake(&State, ManualReset ? INT_MAX : 1);
+			}
+		}
+
+		/**
+		* Resets the event to an untriggered (waitable) state.
+		*
+		* @see IsManualReset, Trigger
+		*/
+		void Reset()
+		{
+			LinuxAtomics::StoreRelease(&State, 0);
+		}
+
+		/**
+		* Waits the specified amount of time for the event to be triggered.
+		*
+		* A wait time of MAX_uint32 is treated as infinite wait.
+		*
+		* @param WaitTime The time to wait (in milliseconds).
+		* @param bIgnoreThreadIdleStats If true, ignores ThreadIdleStats
+		* @return true if the event was triggered, false if the wait timed out.
+		*/
+		bool Wait(uint32 WaitTime, const bool bIgnoreThreadIdleStats = false)
+		{
+			const bool bInfinite = WaitTime == 0xffffffff;
+			const uint64 StartMs = bInfinite ? 0 : LinuxFutex::GetMonotonicMs();
+			uint32 RemainingMs = WaitTime;
+
+			while (!TryConsume())
+			{
+				if (RemainingMs == 0)
+				{
+					return false;
+				}
+
+				LinuxAtomics::InterlockedIncrement(&NumWaiters);
+				const bool bTimedOut = !LinuxFutex::Wait(&State, 0, RemainingMs);
+				LinuxAtomics::InterlockedDecrement(&NumWaiters);
+
+				if (bTimedOut)
+				{
+					return TryConsume();
+				}
+
+				// Woken up without getting the event, spuriously or by another waiter taking it: only wait for what is left
+				if (!bInfinite)
+				{
+					const uint64 ElapsedMs = LinuxFutex::GetMonotonicMs() - StartMs;
+					RemainingMs = ElapsedMs >= WaitTime ? 0 : uint32(WaitTime - ElapsedMs);
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		* Waits an infinite amount of time for the event to be triggered.
+		*
+		* @return true if the event was triggered.
+		*/
+		bool Wait()
+		{
+			return Wait(0xffffffff);
+		}
+
+		/** Default constructor. */
+		WinEvent()
+			: State(0)
+			, NumWaiters(0)
+			, ManualReset(false)
+		{}
+	};
+}
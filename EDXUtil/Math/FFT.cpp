@@ -1,7 +1,5 @@
 #include "FFT.h"
-
-#include <ppl.h>
-using namespace concurrency;
+#include "../Core/Parallel.h"
 
 namespace EDX
 {
@@ -83,7 +81,7 @@ namespace EDX
 			
 			// Copy source data to the pong buffer
 			//for(auto i = 0; i < miDimention; i++)
-			parallel_for(0u, miDimention, [&](int i)
+			ParallelFor(0, int32(miDimention), [&](int i)
 			{
 				for(auto j = 0; j < miDimention; j++)
 				{
@@ -102,7 +100,7 @@ namespace EDX
 				pTempData = mpFDataPing;
 
 			//for(auto i = 0; i < miDimention; i++)
-			parallel_for(0u, miDimention, [&](int i)
+			ParallelFor(0, int32(miDimention), [&](int i)
 			{
 				for(auto j = 0; j < miDimention; j++)
 				{
@@ -118,7 +116,7 @@ namespace EDX
 
 			// Copy source data to the pong buffer
 			//for(auto i = 0; i < miDimention; i++)
-			parallel_for(0u, miDimention, [&](int i)
+			ParallelFor(0, int32(miDimention), [&](int i)
 			{
 				for(auto j = 0; j < miDimention; j++)
 				{
@@ -137,7 +135,7 @@ namespace EDX
 				pTempData = mpFDataPing;
 
 			//for(auto i = 0; i < miDimention; i++)
-			parallel_for(0u, miDimention, [&](int i)
+			ParallelFor(0, int32(miDimention), [&](int i)
 			{
 				for(auto j = 0; j < miDimention; j++)
 				{
@@ -156,7 +154,7 @@ namespace EDX
 				FouriorData* pixelSrc = NULL, *pixelDest = NULL;
 				SwitchPingPongTarget(pixelSrc, pixelDest);
 				//for (auto x = 0; x < miDimention; x++)
-				parallel_for(0u, miDimention, [&](int x)
+				ParallelFor(0, int32(miDimention), [&](int x)
 				{
 					int colAdd = 4 * x;
 					int fIndexA = int(mpButterFlyData[rowAdd + colAdd]);
@@ -203,7 +201,7 @@ namespace EDX
 				FouriorData* pixelSrc = NULL, *pixelDest = NULL;
 				SwitchPingPongTarget(pixelSrc, pixelDest);
 				//for (auto y = 0; y < miDimention; y++)
-				parallel_for(0u, miDimention, [&](int y)
+				ParallelFor(0, int32(miDimention), [&](int y)
 				{
 					int colAdd = 4 * y;
 					int fIndexA = int(mpButterFlyData[rowAdd + colAdd]);
@@ -26,11 +26,30 @@ namespace EDX
 			mutable FouriorData* mpFDataPing;
 			mutable FouriorData* mpFDataPong;
 
+			/** Whether the ping pong buffers are allocated with Memory::AllocLarge, see UseLargeAlloc. */
+			bool mbLargeAlloc;
+			LargeAllocParams mLargeAllocParams;
+
 		public:
 			FFT()
 				: mpButterFlyData(NULL)
+				, mpFDataPing(NULL)
+				, mpFDataPong(NULL)
+				, mbLargeAlloc(false)
 			{
 			}
+
+			/**
+			* Allocates the ping pong buffers with Memory::AllocLarge from now on, worth it for large 2D
+			* transforms. Call it before Init1D, Init2D or SetDim.
+			*/
+			void UseLargeAlloc(const LargeAllocParams& largeAllocParams = LargeAllocParams())
+			{
+				FreeData(mpFDataPing);
+				FreeData(mpFDataPong);
+				mbLargeAlloc = true;
+				mLargeAllocParams = largeAllocParams;
+			}
 			
 			void Init1D(int iDim)
 			{
@@ -42,8 +61,8 @@ namespace EDX
 				mbIsPingTarget = true;
 
 				CreateButterflyRes();
-				mpFDataPing = new FouriorData[miDimention];
-				mpFDataPong = new FouriorData[miDimention];
+				mpFDataPing = AllocData(miDimention);
+				mpFDataPong = AllocData(miDimention);
 			}
 
 			void Init2D(int iDim)
@@ -56,8 +75,8 @@ namespace EDX
 				mbIsPingTarget = true;
 
 				CreateButterflyRes();
-				mpFDataPing = new FouriorData[miDimention * miDimention];
-				mpFDataPong = new FouriorData[miDimention * miDimention];
+				mpFDataPing = AllocData(miDimention * miDimention);
+				mpFDataPong = AllocData(miDimention * miDimention);
 			}
 
 			void PerformForward1D(float* pfDataIn, float* pfDataOut) const;
@@ -76,22 +95,40 @@ namespace EDX
 				mbIsPingTarget = true;
 
 				Memory::SafeDeleteArray(mpButterFlyData);
-				Memory::SafeDeleteArray(mpFDataPing);
-				Memory::SafeDeleteArray(mpFDataPong);
+				FreeData(mpFDataPing);
+				FreeData(mpFDataPong);
 
 				CreateButterflyRes();
 
-				mpFDataPing = new FouriorData[miDimention * miDimention];
-				mpFDataPong = new FouriorData[miDimention * miDimention];
+				mpFDataPing = AllocData(miDimention * miDimention);
+				mpFDataPong = AllocData(miDimention * miDimention);
 			}
 			~FFT()
 			{
 				Memory::SafeDeleteArray(mpButterFlyData);
-				Memory::SafeDeleteArray(mpFDataPing);
-				Memory::SafeDeleteArray(mpFDataPong);
+				FreeData(mpFDataPing);
+				FreeData(mpFDataPong);
 			}
 
 		private:
+			FouriorData* AllocData(size_t Num) const
+			{
+				return mbLargeAlloc ? Memory::AllocLarge<FouriorData>(Num, mLargeAllocParams) : new FouriorData[Num];
+			}
+
+			void FreeData(FouriorData*& pData) const
+			{
+				if (mbLargeAlloc)
+				{
+					Memory::FreeLarge(pData);
+					pData = NULL;
+				}
+				else
+				{
+					Memory::SafeDeleteArray(pData);
+				}
+			}
+
 			void CreateButterflyRes();
 			void CalcIndices(float* pfIndices) const;
 			void CalcWeights(float* pfWeights) const;
@@ -1,9 +1,7 @@
 #pragma once
 
 #include "Containers/Array.h"
-
-#include <ppl.h>
-using namespace concurrency;
+#include "Core/Parallel.h"
 
 namespace EDX
 {
@@ -164,7 +162,7 @@ namespace EDX
 	{
 		Assert(matrix.n == x.Size());
 		result.Resize(matrix.n);
-		parallel_for(0, (int)matrix.n, [&](int i)
+		ParallelFor(0, matrix.n, [&](int i)
 		{
 			result[i] = 0;
 			for (int j = 0; j < matrix.index[i].Size(); ++j)
@@ -180,7 +178,7 @@ namespace EDX
 	{
 		Assert(matrix.n == x.Size());
 		result.Resize(matrix.n);
-		parallel_for(0, (int)matrix.n, [&](int i)
+		ParallelFor(0, matrix.n, [&](int i)
 		{
 			for (int j = 0; j < matrix.index[i].Size(); ++j)
 			{
@@ -249,7 +247,7 @@ namespace EDX
 	{
 		Assert(matrix.n == x.Size());
 		result.Resize(matrix.n);
-		parallel_for(0, (int)matrix.n, [&](int i)
+		ParallelFor(0, matrix.n, [&](int i)
 		{
 			result[i] = 0;
 			for (int j = matrix.rowstart[i]; j < matrix.rowstart[i + 1]; ++j)
@@ -265,7 +263,7 @@ namespace EDX
 	{
 		Assert(matrix.n == x.Size());
 		result.Resize(matrix.n);
-		parallel_for(0, (int)matrix.n, [&](int i)
+		ParallelFor(0, matrix.n, [&](int i)
 		{
 			for (int j = matrix.rowstart[i]; j < matrix.rowstart[i + 1]; ++j)
 			{
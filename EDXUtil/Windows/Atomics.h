@@ -5,6 +5,10 @@
 
 #define PLATFORM_HAS_64BIT_ATOMICS 1
 
+/** Size of a cache line, the distance to keep between variables written by different threads. */
+#define PLATFORM_CACHE_LINE_SIZE 64
+
+#if defined(_WIN32)
 namespace EDX
 {
 	/**
@@ -136,6 +140,103 @@ namespace EDX
 			return ::InterlockedCompareExchangePointer(Dest, Exchange, Comparand);
 		}
 
+		/**
+		* Issues a full hardware memory barrier, no loads or stores can be reordered across it.
+		*/
+		static __forceinline void FullBarrier()
+		{
+			MemoryBarrier();
+		}
+
+		/**
+		* Prevents the compiler from reordering loads and stores across this point, emits no instruction.
+		*/
+		static __forceinline void CompilerBarrier()
+		{
+			_ReadWriteBarrier();
+		}
+
+		/**
+		* Keeps the loads before this point from being reordered with the loads and stores after it. x86 never reorders
+		* these, other processors need a hardware barrier.
+		*/
+		static __forceinline void ReadBarrier()
+		{
+#if defined(_M_IX86) || defined(_M_X64)
+			_ReadWriteBarrier();
+#else
+			MemoryBarrier();
+#endif
+		}
+
+		/**
+		* Keeps the loads and stores before this point from being reordered with the stores after it.
+		*/
+		static __forceinline void WriteBarrier()
+		{
+#if defined(_M_IX86) || defined(_M_X64)
+			_ReadWriteBarrier();
+#else
+			MemoryBarrier();
+#endif
+		}
+
+		/**
+		* Loads a value published by StoreRelease, the loads and stores after it can't move before it. Pairs with
+		* StoreRelease: everything written before the store is visible after the load returns the stored value.
+		*/
+		static __forceinline int32 LoadAcquire(const volatile int32* Src)
+		{
+			const int32 Value = *Src;
+			ReadBarrier();
+			return Value;
+		}
+
+		static __forceinline int64 LoadAcquire(const volatile int64* Src)
+		{
+			const int64 Value = *Src;
+			ReadBarrier();
+			return Value;
+		}
+
+		template<typename T>
+		static __forceinline T* LoadAcquire(T* const volatile* Src)
+		{
+			T* const Value = *Src;
+			ReadBarrier();
+			return Value;
+		}
+
+		/**
+		* Publishes a value, the loads and stores before it can't move after it.
+		*/
+		static __forceinline void StoreRelease(volatile int32* Dest, int32 Value)
+		{
+			WriteBarrier();
+			*Dest = Value;
+		}
+
+		static __forceinline void StoreRelease(volatile int64* Dest, int64 Value)
+		{
+			WriteBarrier();
+			*Dest = Value;
+		}
+
+		template<typename T>
+		static __forceinline void StoreRelease(T* volatile* Dest, T* Value)
+		{
+			WriteBarrier();
+			*Dest = Value;
+		}
+
+		/**
+		* Hints the processor that the calling thread is spinning.
+		*/
+		static __forceinline void Pause()
+		{
+			YieldProcessor();
+		}
+
 		/**
 		* @return true, if the processor we are running on can execute compare and exchange 128-bit operation.
 		* @see cmpxchg16b, early AMD64 processors don't support this operation.
@@ -159,4 +260,8 @@ namespace EDX
 		}
 	};
 
-}
\ No newline at end of file
+	typedef WindowsAtomics PlatformAtomics;
+}
+#else
+#include "../Linux/Atomics.h"
+#endif
@@ -2,8 +2,12 @@
 
 #include "../Core/Types.h"
 
+#if defined(_WIN32)
 #define NOMINMAX
 #include <Windows.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace EDX
 {
@@ -20,7 +24,11 @@ namespace EDX
 	public:
 		static void Sleep(float Seconds)
 		{
+#if defined(_WIN32)
 			::Sleep(static_cast<uint32>(Seconds * 1000.0f));
+#else
+			usleep(static_cast<uint32>(Seconds * 1000000.0f));
+#endif
 		}
 	};
 }
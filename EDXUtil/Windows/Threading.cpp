@@ -4,6 +4,7 @@
 
 namespace EDX
 {
+#if defined(_WIN32)
 	bool WinEvent::Wait(uint32 WaitTime, const bool bIgnoreThreadIdleStats /*= false*/)
 	{
 		Assert(Event);
@@ -22,6 +23,96 @@ namespace EDX
 		Assert(Event);
 		ResetEvent(Event);
 	}
+#endif
+
+	void RWLock::ReadLockSlow()
+	{
+		ScopeLock Lock(&Mutex);
+		while (true)
+		{
+			const int32 Value = State;
+			if ((Value & (WriterBit | PendingBit)) == 0)
+			{
+				if (PlatformAtomics::InterlockedCompareExchange(&State, Value + 1, Value) == Value)
+				{
+					return;
+				}
+				continue;
+			}
+
+			// The pending bit is only cleared under the mutex, by WriteUnlock which wakes us up
+			NumWaitingReaders++;
+			ReadersCond.Wait(Mutex);
+			NumWaitingReaders--;
+		}
+	}
+
+	void RWLock::ReadUnlockSlow()
+	{
+		// The writer checked the reader count under the mutex, so it is either about to see it
+		// is zero or already sleeping
+		ScopeLock Lock(&Mutex);
+		WritersCond.Signal();
+	}
+
+	void RWLock::WriteLock()
+	{
+		// Nobody around, no need for the mutex
+		if (PlatformAtomics::InterlockedCompareExchange(&State, WriterBit | PendingBit, 0) == 0)
+		{
+			return;
+		}
+
+		ScopeLock Lock(&Mutex);
+		NumWaitingWriters++;
+
+		// Keep new readers out, the ones holding the lock wake us up when the last one leaves
+		while (true)
+		{
+			const int32 Value = State;
+			if ((Value & PendingBit) != 0 ||
+				PlatformAtomics::InterlockedCompareExchange(&State, Value | PendingBit, Value) == Value)
+			{
+				break;
+			}
+		}
+
+		while (true)
+		{
+			const int32 Value = State;
+			if ((Value & (WriterBit | ReaderMask)) == 0)
+			{
+				if (PlatformAtomics::InterlockedCompareExchange(&State, Value | WriterBit, Value) == Value)
+				{
+					break;
+				}
+				continue;
+			}
+
+			WritersCond.Wait(Mutex);
+		}
+
+		NumWaitingWriters--;
+	}
+
+	void RWLock::WriteUnlock()
+	{
+		ScopeLock Lock(&Mutex);
+		if (NumWaitingWriters > 0)
+		{
+			// Hand the lock over to the next writer, readers stay blocked by the pending bit
+			PlatformAtomics::InterlockedAdd(&State, -WriterBit);
+			WritersCond.Signal();
+		}
+		else
+		{
+			PlatformAtomics::InterlockedExchange(&State, 0);
+			if (NumWaitingReaders > 0)
+			{
+				ReadersCond.Broadcast();
+			}
+		}
+	}
 
 	RunnableThread* RunnableThread::Create(
 		class Runnable* InRunnable,
@@ -72,8 +163,17 @@ namespace EDX
 		return ExitCode;
 	}
 
+	thread_local QueuedThread* QueuedThread::CurrentThread = nullptr;
+
 	uint32 QueuedThread::Run()
 	{
+		CurrentThread = this;
+
+		if (OwningThreadPool->bWorkStealing)
+		{
+			return RunWorkStealing();
+		}
+
 		while (!OwningThreadPool->bTerminate)
 		{
 			OwningThreadPool->TaskLock.Lock();
@@ -94,7 +194,10 @@ namespace EDX
 			OwningThreadPool->TaskLock.Unlock();
 
 			// Tell the object to do the work
-			pWork->DoThreadedWork();
+			{
+				ScopeMemoryMark Mark(ScratchPool);
+				pWork->DoThreadedWork();
+			}
 
 			if (OwningThreadPool->TaskCounter.Decrement() == 0)
 			{
@@ -120,13 +223,37 @@ namespace EDX
 		return 0;
 	}
 
-	bool QueuedThread::Create(class QueuedThreadPool* InPool, uint32 InStackSize, EThreadPriority ThreadPriority)
+	uint32 QueuedThread::RunWorkStealing()
+	{
+		while (!OwningThreadPool->bTerminate)
+		{
+			QueuedWork* pWork = OwningThreadPool->FindWork(this);
+			if (pWork == nullptr)
+			{
+				pWork = OwningThreadPool->ParkThread(this);
+				if (pWork == nullptr)
+				{
+					continue;
+				}
+			}
+
+			OwningThreadPool->ExecuteWork(pWork);
+		}
+
+		return 0;
+	}
+
+	bool QueuedThread::Create(class QueuedThreadPool* InPool, int32 InThreadIndex, uint32 InStackSize, EThreadPriority ThreadPriority)
 	{
 		static int32 PoolThreadIndex = 0;
 		const String PoolThreadName = String::Printf(EDX_TEXT("PoolThread %d"), PoolThreadIndex);
 		PoolThreadIndex++;
 
 		OwningThreadPool = InPool;
+		ThreadIndex = InThreadIndex;
+		RandomState = 2654435761u * uint32(InThreadIndex + 1);
+		WakeEvent.Create(false);
+
 		Thread = RunnableThread::Create(this, *PoolThreadName, InStackSize, ThreadPriority);
 		Assert(Thread);
 		return true;
@@ -138,8 +265,12 @@ namespace EDX
 
 		// If waiting was specified, wait the amount of time. If that fails,
 		// brute force kill that thread. Very bad as that might leak.
-		Thread->WaitForCompletion();
-		delete Thread;
+		if (Thread != nullptr)
+		{
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
 
 		return bDidExitOK;
 	}
@@ -154,7 +285,7 @@ namespace EDX
 		Destroy();
 	}
 
-	bool QueuedThreadPool::Create(uint32 InNumQueuedThreads, uint32 StackSize, EThreadPriority ThreadPriority)
+	bool QueuedThreadPool::Create(uint32 InNumQueuedThreads, uint32 StackSize, EThreadPriority ThreadPriority, bool bInWorkStealing)
 	{
 		// Make sure we have synch objects
 		bool bWasSuccessful = true;
@@ -171,23 +302,19 @@ namespace EDX
 		}
 
 		bTerminate = false;
+		bWorkStealing = bInWorkStealing;
 
-		// Now create each thread and add it to the array
+		// Fill the array before starting any thread, running threads index it to pick steal victims
+		for (uint32 Count = 0; Count < InNumQueuedThreads; Count++)
+		{
+			QueuedThreads.Add(new QueuedThread());
+		}
+
+		// Now start each thread
 		for (uint32 Count = 0; Count < InNumQueuedThreads && bWasSuccessful == true; Count++)
 		{
-			// Create a new queued thread
-			QueuedThread* pThread = new QueuedThread();
-			// Now create the thread and add it if ok
-			if (pThread->Create(this, StackSize, ThreadPriority) == true)
-			{
-				QueuedThreads.Add(pThread);
-			}
-			else
-			{
-				// Failed to fully create so clean up
-				bWasSuccessful = false;
-				delete pThread;
-			}
+			// Failed to fully create, Destroy skips the threads which were never started
+			bWasSuccessful = QueuedThreads[Count]->Create(this, Count, StackSize, ThreadPriority);
 		}
 		// Destroy any created threads if the full set was not successful
 		if (bWasSuccessful == false)
@@ -216,21 +343,53 @@ namespace EDX
 
 			// Clean up all queued objects
 			QueuedWork* pWork = nullptr;
+			while (SharedWorks.Dequeue(pWork))
+			{
+				pWork->Abandon();
+				NumSharedWorks.Decrement();
+				TaskCounter.Decrement();
+			}
+
+			// Only counted in NumSharedWorks when it takes the overflow of SharedWorks
 			while (QueuedWorks.Dequeue(pWork))
 			{
 				pWork->Abandon();
+				if (bWorkStealing)
+				{
+					NumSharedWorks.Decrement();
+				}
+				TaskCounter.Decrement();
 			}
 
 			// Empty out the invalid pointers
 			QueuedWorks.Clear();
 		}
 
+		// Abandon the jobs left in the per-thread deques, stealing is safe while the threads are still running
+		for (int32 Index = 0; Index < QueuedThreads.Size(); Index++)
+		{
+			QueuedWork* pWork = nullptr;
+			while (!QueuedThreads[Index]->LocalWorks.IsEmpty())
+			{
+				if (QueuedThreads[Index]->LocalWorks.Steal(pWork))
+				{
+					pWork->Abandon();
+					TaskCounter.Decrement();
+				}
+			}
+		}
+
 		JoinAllThreads();
 
 		TaskLock.Lock();
 		TaskCondVar.Broadcast();
 		TaskLock.Unlock();
 
+		for (int32 Index = 0; Index < QueuedThreads.Size(); Index++)
+		{
+			QueuedThreads[Index]->WakeEvent.Trigger();
+		}
+
 		// Delete all threads
 		for (int32 Index = 0; Index < QueuedThreads.Size(); Index++)
 		{
@@ -238,6 +397,9 @@ namespace EDX
 			delete QueuedThreads[Index];
 		}
 		QueuedThreads.Clear();
+		IdleThreads.Clear();
+		NumIdleThreads.Reset();
+		NumSharedWorks.Reset();
 	}
 
 	void QueuedThreadPool::AddQueuedWork(QueuedWork* InQueuedWork)
@@ -248,12 +410,40 @@ namespace EDX
 			return;
 		}
 
+		if (bWorkStealing)
+		{
+			// Count the job before it becomes visible so JoinAllThreads can't see the counter drop to zero early
+			TaskCounter.Increment();
+
+			QueuedThread* pCurrent = QueuedThread::GetCurrent();
+			if (pCurrent == nullptr || pCurrent->OwningThreadPool != this || !pCurrent->LocalWorks.Push(InQueuedWork))
+			{
+				// Counted before it is visible, so a zero count always means both queues are empty
+				NumSharedWorks.Increment();
+
+				if (!SharedWorks.Enqueue(InQueuedWork))
+				{
+					TaskLock.Lock();
+					QueuedWorks.Enqueue(InQueuedWork);
+					TaskLock.Unlock();
+				}
+			}
+
+			// Pairs with the barrier in ParkThread, either we see the parked thread or it sees the job
+			PlatformAtomics::FullBarrier();
+			WakeOneThread();
+
+			return;
+		}
+
 		TaskLock.Lock();
 		QueuedWorks.Enqueue(InQueuedWork);
 		TaskLock.Unlock();
 
 		TaskCounter.Increment();
-		TaskCondVar.Broadcast();
+
+		// One job needs one thread, waking all of them would only have them fight over the lock
+		TaskCondVar.Signal();
 	}
 
 	QueuedWork* QueuedThreadPool::GetNextJob(QueuedThread* InQueuedThread)
@@ -274,4 +464,155 @@ namespace EDX
 
 		return Work;
 	}
+
+	QueuedWork* QueuedThreadPool::FindWork(QueuedThread* InQueuedThread)
+	{
+		QueuedWork* pWork = nullptr;
+
+		// Own deque first, most recently queued job is the most likely to be in cache
+		if (InQueuedThread != nullptr && InQueuedThread->LocalWorks.Pop(pWork))
+		{
+			return pWork;
+		}
+
+		// Then the jobs queued from outside of the pool, the locked queue only holds the overflow
+		if (NumSharedWorks.GetValue() > 0)
+		{
+			if (SharedWorks.Dequeue(pWork))
+			{
+				NumSharedWorks.Decrement();
+				return pWork;
+			}
+
+			ScopeLock Lock(&TaskLock);
+			if (QueuedWorks.Dequeue(pWork))
+			{
+				NumSharedWorks.Decrement();
+				return pWork;
+			}
+		}
+
+		// Then steal the oldest job of another thread, starting from a random victim
+		const int32 NumThreads = QueuedThreads.Size();
+		if (NumThreads > 1)
+		{
+			const int32 Start = InQueuedThread != nullptr ? InQueuedThread->NextRandom() % NumThreads : 0;
+			for (int32 i = 0; i < NumThreads; i++)
+			{
+				QueuedThread* pVictim = QueuedThreads[(Start + i) % NumThreads];
+				if (pVictim != InQueuedThread && pVictim->LocalWorks.Steal(pWork))
+				{
+					return pWork;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	QueuedWork* QueuedThreadPool::ParkThread(QueuedThread* InQueuedThread)
+	{
+		{
+			ScopeLock Lock(&IdleLock);
+			IdleThreads.Add(InQueuedThread);
+
+			// Interlocked, acts as the full barrier pairing with the one in AddQueuedWork
+			NumIdleThreads.Increment();
+		}
+
+		// Look again, a job queued before we registered wouldn't have woken us up
+		QueuedWork* pWork = FindWork(InQueuedThread);
+		if (pWork == nullptr && !bTerminate)
+		{
+			InQueuedThread->WakeEvent.Wait();
+		}
+
+		// Unregister unless the thread waking us up already did it
+		{
+			ScopeLock Lock(&IdleLock);
+			if (IdleThreads.RemoveSingleSwap(InQueuedThread, false) > 0)
+			{
+				NumIdleThreads.Decrement();
+			}
+		}
+
+		return pWork;
+	}
+
+	void QueuedThreadPool::WakeOneThread()
+	{
+		if (NumIdleThreads.GetValue() == 0)
+		{
+			return;
+		}
+
+		QueuedThread* pThread = nullptr;
+		{
+			ScopeLock Lock(&IdleLock);
+			if (IdleThreads.Size() > 0)
+			{
+				pThread = IdleThreads.Pop(false);
+				NumIdleThreads.Decrement();
+			}
+		}
+
+		if (pThread)
+		{
+			pThread->WakeEvent.Trigger();
+		}
+	}
+
+	void QueuedThreadPool::ExecuteWork(QueuedWork* InQueuedWork)
+	{
+		// Tell the object to do the work, its temporaries are released once it's done
+		{
+			ScopeMemoryMark Mark(QueuedThread::GetScratchPool());
+			InQueuedWork->DoThreadedWork();
+		}
+
+		if (TaskCounter.Decrement() == 0)
+		{
+			ScopeLock Lock(&FinishedLock);
+			FinishedCondVar.Broadcast();
+		}
+	}
+
+	bool QueuedThreadPool::TryExecuteJob()
+	{
+		QueuedWork* pWork = nullptr;
+		if (bWorkStealing)
+		{
+			QueuedThread* pCurrent = QueuedThread::GetCurrent();
+			pWork = FindWork(pCurrent != nullptr && pCurrent->OwningThreadPool == this ? pCurrent : nullptr);
+		}
+		else
+		{
+			ScopeLock Lock(&TaskLock);
+			QueuedWorks.Dequeue(pWork);
+		}
+
+		if (pWork == nullptr)
+		{
+			return false;
+		}
+
+		ExecuteWork(pWork);
+		return true;
+	}
+
+	bool QueuedThreadPool::ShouldSplitWork()
+	{
+		if (!bWorkStealing)
+		{
+			return TaskCounter.GetValue() < QueuedThreads.Size();
+		}
+
+		QueuedThread* pCurrent = QueuedThread::GetCurrent();
+		if (pCurrent != nullptr && pCurrent->OwningThreadPool == this)
+		{
+			return pCurrent->LocalWorks.IsEmpty();
+		}
+
+		return NumSharedWorks.GetValue() == 0;
+	}
 }
\ No newline at end of file
@@ -3,8 +3,13 @@
 #include "../Core/Types.h"
 #include "../Containers/Queue.h"
 #include "../Containers/String.h"
+#include "../Core/MemoryPool.h"
 #include "Base.h"
 
+#if !defined(_WIN32)
+#include "../Linux/Synchronization.h"
+#endif
+
 namespace EDX
 {
 	inline int GetNumberOfCores()
@@ -12,14 +17,20 @@ namespace EDX
 		static int32 numCores = 0;
 		if (numCores == 0)
 		{
+#if defined(_WIN32)
 			// Get the number of logical processors, including hyperthreaded ones.
 			SYSTEM_INFO SI;
 			GetSystemInfo(&SI);
 			numCores = (int32)SI.dwNumberOfProcessors;
+#else
+			numCores = (int32)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
 		}
 		return numCores;
 	}
 
+#if defined(_WIN32)
+
 	/**
 	* This is the Windows version of a critical section. It uses an aggregate
 	* CRITICAL_SECTION to implement its locking.
@@ -90,6 +101,8 @@ namespace EDX
 		}
 	};
 
+#endif
+
 	/**
 	* Implements a scope lock.
 	*
@@ -144,6 +157,7 @@ namespace EDX
 		CriticalSection* SynchObject;
 	};
 
+#if defined(_WIN32)
 	class ConditionVar
 	{
 	public:
@@ -262,6 +276,7 @@ namespace EDX
 		~WinEvent()
 		{}
 	};
+#endif
 
 
 	/** Thread safe counter */
@@ -316,7 +331,7 @@ namespace EDX
 		*/
 		int32 Increment()
 		{
-			return WindowsAtomics::InterlockedIncrement(&Counter);
+			return PlatformAtomics::InterlockedIncrement(&Counter);
 		}
 
 		/**
@@ -328,7 +343,7 @@ namespace EDX
 		*/
 		int32 Add(int32 Amount)
 		{
-			return WindowsAtomics::InterlockedAdd(&Counter, Amount);
+			return PlatformAtomics::InterlockedAdd(&Counter, Amount);
 		}
 
 		/**
@@ -339,7 +354,7 @@ namespace EDX
 		*/
 		int32 Decrement()
 		{
-			return WindowsAtomics::InterlockedDecrement(&Counter);
+			return PlatformAtomics::InterlockedDecrement(&Counter);
 		}
 
 		/**
@@ -351,7 +366,7 @@ namespace EDX
 		*/
 		int32 Subtract(int32 Amount)
 		{
-			return WindowsAtomics::InterlockedAdd(&Counter, -Amount);
+			return PlatformAtomics::InterlockedAdd(&Counter, -Amount);
 		}
 
 		/**
@@ -363,7 +378,7 @@ namespace EDX
 		*/
 		int32 Set(int32 Value)
 		{
-			return WindowsAtomics::InterlockedExchange(&Counter, Value);
+			return PlatformAtomics::InterlockedExchange(&Counter, Value);
 		}
 
 		/**
@@ -374,7 +389,7 @@ namespace EDX
 		*/
 		int32 Reset()
 		{
-			return WindowsAtomics::InterlockedExchange(&Counter, 0);
+			return PlatformAtomics::InterlockedExchange(&Counter, 0);
 		}
 
 		/**
@@ -394,6 +409,304 @@ namespace EDX
 	};
 
 
+	/**
+	* Reader-writer lock, any number of readers or a single writer can hold it at once.
+	*
+	* The lock prefers writers: once a writer is waiting, new readers block until it is done, so a
+	* steady stream of readers can't starve writers. Taking and releasing a read lock is a single
+	* compare-and-swap when no writer is around. The lock is not recursive.
+	*/
+	class RWLock
+	{
+	private:
+		enum
+		{
+			/** Set while a writer holds the lock. */
+			WriterBit = 1 << 30,
+			/** Set while writers hold or wait for the lock, keeps readers from entering. */
+			PendingBit = 1 << 29,
+			/** Number of readers holding the lock. */
+			ReaderMask = PendingBit - 1,
+		};
+
+		/** Reader count and writer bits. */
+		volatile int32 State;
+
+		/** Number of writers sleeping on WritersCond, protected by Mutex. */
+		int32 NumWaitingWriters;
+
+		/** Number of readers sleeping on ReadersCond, protected by Mutex. */
+		int32 NumWaitingReaders;
+
+		/** Protects the slow paths, never held while the lock itself is held. */
+		CriticalSection Mutex;
+		ConditionVar ReadersCond;
+		ConditionVar WritersCond;
+
+		void ReadLockSlow();
+
+		void ReadUnlockSlow();
+
+	public:
+		RWLock()
+			: State(0)
+			, NumWaitingWriters(0)
+			, NumWaitingReaders(0)
+		{
+		}
+
+		RWLock(const RWLock&) = delete;
+		RWLock& operator=(const RWLock&) = delete;
+
+		/**
+		* Locks for reading, blocks while a writer holds or waits for the lock.
+		*/
+		__forceinline void ReadLock()
+		{
+			const int32 Value = State;
+			if ((Value & (WriterBit | PendingBit)) != 0 ||
+				PlatformAtomics::InterlockedCompareExchange(&State, Value + 1, Value) != Value)
+			{
+				ReadLockSlow();
+			}
+		}
+
+		/**
+		* Releases a read lock.
+		*/
+		__forceinline void ReadUnlock()
+		{
+			const int32 Value = PlatformAtomics::InterlockedDecrement(&State);
+			if ((Value & ReaderMask) == 0 && (Value & PendingBit) != 0)
+			{
+				// Last reader out while a writer is waiting
+				ReadUnlockSlow();
+			}
+		}
+
+		/**
+		* Locks for writing, blocks until all the readers and the current writer are gone.
+		*/
+		void WriteLock();
+
+		/**
+		* Releases a write lock, hands the lock to the next waiting writer if there is one.
+		*/
+		void WriteUnlock();
+	};
+
+	/**
+	* Implements a scope read lock on a RWLock, see ScopeLock.
+	*
+	* <code>
+	*	{
+	*		ScopeReadLock ReadLock(&TableLock);
+	*		// Read the shared data, other readers can do the same concurrently
+	*		...
+	*	}
+	* </code>
+	*/
+	class ScopeReadLock
+	{
+	public:
+		ScopeReadLock() = delete;
+		ScopeReadLock(const ScopeReadLock&) = delete;
+		ScopeReadLock& operator=(ScopeReadLock&) = delete;
+
+		/**
+		* Constructor that locks the object for reading
+		*
+		* @param InSynchObject The synchronization object to manage
+		*/
+		ScopeReadLock(RWLock* InSynchObject)
+			: SynchObject(InSynchObject)
+		{
+			Assert(SynchObject);
+			SynchObject->ReadLock();
+		}
+
+		/** Destructor that releases the read lock. */
+		~ScopeReadLock()
+		{
+			SynchObject->ReadUnlock();
+		}
+
+	private:
+		RWLock* SynchObject;
+	};
+
+	/**
+	* Implements a scope write lock on a RWLock, see ScopeLock.
+	*/
+	class ScopeWriteLock
+	{
+	public:
+		ScopeWriteLock() = delete;
+		ScopeWriteLock(const ScopeWriteLock&) = delete;
+		ScopeWriteLock& operator=(ScopeWriteLock&) = delete;
+
+		/**
+		* Constructor that locks the object for writing
+		*
+		* @param InSynchObject The synchronization object to manage
+		*/
+		ScopeWriteLock(RWLock* InSynchObject)
+			: SynchObject(InSynchObject)
+		{
+			Assert(SynchObject);
+			SynchObject->WriteLock();
+		}
+
+		/** Destructor that releases the write lock. */
+		~ScopeWriteLock()
+		{
+			SynchObject->WriteUnlock();
+		}
+
+	private:
+		RWLock* SynchObject;
+	};
+
+	/**
+	* Sequence lock, for small plain data read much more often than written.
+	*
+	* Readers never block nor write to shared memory: they copy the data and retry if a writer
+	* touched it meanwhile. Writers are serialized with a critical section. The protected data must be
+	* copyable with memcpy, since a reader may copy it while it is being written. Example:
+	*
+	* <code>
+	*	// Writer
+	*	{
+	*		ScopeSeqWriteLock WriteLock(&CameraLock);
+	*		ViewMatrix = NewViewMatrix;
+	*	}
+	*
+	*	// Reader
+	*	Matrix View = CameraLock.Read(ViewMatrix);
+	* </code>
+	*/
+	class SeqLock
+	{
+	private:
+		/** Odd while a write is in progress. */
+		volatile int32 Sequence;
+
+		/** Serializes the writers. */
+		CriticalSection WriterLock;
+
+	public:
+		SeqLock()
+			: Sequence(0)
+		{
+		}
+
+		SeqLock(const SeqLock&) = delete;
+		SeqLock& operator=(const SeqLock&) = delete;
+
+		/**
+		* Starts an optimistic read, spins while a write is in progress.
+		*
+		* @return The sequence number to pass to ReadRetry
+		*/
+		__forceinline int32 ReadBegin() const
+		{
+			// Acquire, the reads of the data can't start before the sequence is read
+			int32 Seq;
+			while ((Seq = PlatformAtomics::LoadAcquire(&Sequence)) & 1)
+			{
+				PlatformAtomics::Pause();
+			}
+			return Seq;
+		}
+
+		/**
+		* Ends an optimistic read.
+		*
+		* @param Seq The value returned by ReadBegin
+		* @return true if a writer modified the data during the read, which must then be done again
+		*/
+		__forceinline bool ReadRetry(int32 Seq) const
+		{
+			// The reads of the data must be done before the sequence is read again
+			PlatformAtomics::ReadBarrier();
+			return Sequence != Seq;
+		}
+
+		/**
+		* Reads a consistent snapshot of data protected by this lock.
+		*
+		* @param Data The protected data
+		* @return A copy of the data that no writer modified while it was being copied
+		*/
+		template<typename T>
+		T Read(const T& Data) const
+		{
+			T Snapshot;
+			int32 Seq;
+			do
+			{
+				Seq = ReadBegin();
+				Memory::Memcpy((void*)&Snapshot, (const void*)&Data, sizeof(T));
+			} while (ReadRetry(Seq));
+
+			return Snapshot;
+		}
+
+		/**
+		* Locks for writing, readers retry until WriteUnlock is called.
+		*/
+		__forceinline void WriteLock()
+		{
+			WriterLock.Lock();
+			PlatformAtomics::InterlockedIncrement(&Sequence);
+
+			// Readers must see the odd sequence before any write to the data
+			PlatformAtomics::WriteBarrier();
+		}
+
+		/**
+		* Releases the write lock.
+		*/
+		__forceinline void WriteUnlock()
+		{
+			PlatformAtomics::InterlockedIncrement(&Sequence);
+			WriterLock.Unlock();
+		}
+	};
+
+	/**
+	* Implements a scope write lock on a SeqLock, see ScopeLock.
+	*/
+	class ScopeSeqWriteLock
+	{
+	public:
+		ScopeSeqWriteLock() = delete;
+		ScopeSeqWriteLock(const ScopeSeqWriteLock&) = delete;
+		ScopeSeqWriteLock& operator=(ScopeSeqWriteLock&) = delete;
+
+		/**
+		* Constructor that locks the object for writing
+		*
+		* @param InSynchObject The synchronization object to manage
+		*/
+		ScopeSeqWriteLock(SeqLock* InSynchObject)
+			: SynchObject(InSynchObject)
+		{
+			Assert(SynchObject);
+			SynchObject->WriteLock();
+		}
+
+		/** Destructor that releases the write lock. */
+		~ScopeSeqWriteLock()
+		{
+			SynchObject->WriteUnlock();
+		}
+
+	private:
+		SeqLock* SynchObject;
+	};
+
+
 	/**
 	* Interface for "runnable" objects.
 	*
@@ -812,30 +1125,95 @@ namespace EDX
 		/** My Thread  */
 		RunnableThread* Thread;
 
+		/** Jobs queued from this thread in work stealing mode, other threads steal from the top. */
+		WorkStealingQueue<QueuedWork*> LocalWorks;
+
+		/** Event used to wake this thread up when it is parked in work stealing mode. */
+		WinEvent WakeEvent;
+
+		/** Index of this thread in the owning pool. */
+		int32 ThreadIndex;
+
+		/** State of the xorshift generator used to pick steal victims. */
+		uint32 RandomState;
+
+		/** Scratch arena for the temporaries of the jobs run on this thread, rewound after each job. */
+		MemoryPool ScratchPool;
+
+		/** The queued thread running on the calling thread, nullptr if it isn't a pool thread. */
+		static thread_local QueuedThread* CurrentThread;
+
 		/**
 		* The real thread entry point. It waits for work events to be queued. Once
 		* an event is queued, it executes it and goes back to waiting.
 		*/
 		virtual uint32 Run() override;
 
+		/**
+		* Thread loop in work stealing mode. Runs jobs from the local deque first, then the
+		* shared queue, then steals from other threads and parks when nothing is found.
+		*/
+		uint32 RunWorkStealing();
+
+		/** Picks a random thread index to steal from. */
+		uint32 NextRandom()
+		{
+			RandomState ^= RandomState << 13;
+			RandomState ^= RandomState >> 17;
+			RandomState ^= RandomState << 5;
+			return RandomState;
+		}
+
 	public:
+		friend class QueuedThreadPool;
 
 		/** Default constructor **/
 		QueuedThread()
 			: OwningThreadPool(nullptr)
 			, Thread(nullptr)
+			, ThreadIndex(0)
+			, RandomState(1)
 		{ }
 
+		/**
+		* Gets the queued thread running on the calling thread.
+		*
+		* @return The queued thread, nullptr if called from a thread outside of the pool.
+		*/
+		static QueuedThread* GetCurrent()
+		{
+			return CurrentThread;
+		}
+
+		/**
+		* Gets the scratch arena of the calling thread. Memory allocated from it inside a queued job is
+		* released when the job finishes, so it must not be handed to other jobs. Threads outside of
+		* the pool get their own arena the first time they ask for it.
+		*
+		* @return The scratch arena of the calling thread
+		*/
+		static MemoryPool& GetScratchPool()
+		{
+			if (CurrentThread != nullptr)
+			{
+				return CurrentThread->ScratchPool;
+			}
+
+			static thread_local MemoryPool ExternalScratchPool;
+			return ExternalScratchPool;
+		}
+
 		/**
 		* Creates the thread with the specified stack size and creates the various
 		* events to be able to communicate with it.
 		*
 		* @param InPool The thread pool interface used to place this thread back into the pool of available threads when its work is done
+		* @param InThreadIndex Index of this thread in the pool
 		* @param InStackSize The size of the stack to create. 0 means use the current thread's stack size
 		* @param ThreadPriority priority of new thread
 		* @return True if the thread and all of its initialization was successful, false otherwise
 		*/
-		bool Create(class QueuedThreadPool* InPool, uint32 InStackSize = 0, EThreadPriority ThreadPriority = TPri_Normal);
+		bool Create(class QueuedThreadPool* InPool, int32 InThreadIndex, uint32 InStackSize = 0, EThreadPriority ThreadPriority = TPri_Normal);
 
 		/**
 		* Tells the thread to exit. If the caller needs to know when the thread
@@ -849,6 +1227,22 @@ namespace EDX
 
 	};
 
+	/**
+	* Pool type for ArenaAllocator and ArenaSetAllocator drawing from the scratch arena of the calling
+	* thread. Containers using it must not outlive the queued job that created them. Example:
+	*
+	* <code>
+	*	Array<int32, ArenaAllocator<ScratchArena>> Indices;
+	* </code>
+	*/
+	struct ScratchArena
+	{
+		static MemoryPool& Get()
+		{
+			return QueuedThread::GetScratchPool();
+		}
+	};
+
 
 	/**
 	* Interface for queued thread pools.
@@ -864,12 +1258,14 @@ namespace EDX
 		/** Default constructor. */
 		QueuedThreadPool()
 			: bTerminate(false)
+			, bWorkStealing(false)
+			, SharedWorks(4096)
 		{
 		}
 
 	protected:
 		/** The work queue to pull from. */
-		Queue<QueuedWork*> QueuedWorks;
+		Queue<QueuedWork*, EQueueMode::Spsc, RecyclingQueueNodeAllocator<>> QueuedWorks;
 
 		/** The thread pool to dole work out to. */
 		Array<QueuedThread*> QueuedThreads;
@@ -890,6 +1286,51 @@ namespace EDX
 		/** If true, indicates the destruction process has taken place. */
 		bool bTerminate;
 
+		/** If true, each thread owns a deque and idle threads steal from the others. */
+		bool bWorkStealing;
+
+		/** Lock-free queue for jobs queued from outside of the pool in work stealing mode, QueuedWorks takes the overflow. */
+		BoundedQueue<QueuedWork*> SharedWorks;
+
+		/** Number of jobs in SharedWorks and QueuedWorks, lets threads skip both when they are empty. */
+		AtomicCounter NumSharedWorks;
+
+		/** Threads parked waiting for work in work stealing mode. */
+		Array<QueuedThread*> IdleThreads;
+
+		/** The synchronization object used to protect access to the idle threads. */
+		CriticalSection IdleLock;
+
+		/** Number of parked threads, lets producers skip IdleLock when nobody is parked. */
+		AtomicCounter NumIdleThreads;
+
+		/**
+		* Looks for a job in work stealing mode: the thread's own deque, then the shared queue, then
+		* the deques of the other threads starting from a random victim.
+		*
+		* @param InQueuedThread The thread looking for work, nullptr for threads outside of the pool
+		* @return The job to run, nullptr if none was found
+		*/
+		QueuedWork* FindWork(QueuedThread* InQueuedThread);
+
+		/**
+		* Parks the thread until a job is queued or the pool is destroyed.
+		*
+		* @param InQueuedThread The thread to park
+		* @return A job found after registering as idle, nullptr if the thread was woken up
+		*/
+		QueuedWork* ParkThread(QueuedThread* InQueuedThread);
+
+		/** Wakes up one parked thread, if there is any. */
+		void WakeOneThread();
+
+		/**
+		* Runs a job and updates the task counter once it is done.
+		*
+		* @param InQueuedWork The job to run
+		*/
+		void ExecuteWork(QueuedWork* InQueuedWork);
+
 	public:
 		friend class QueuedThread;
 
@@ -923,7 +1364,16 @@ namespace EDX
 		/** Virtual destructor (cleans up the synchronization objects). */
 		~QueuedThreadPool();
 
-		bool Create(uint32 InNumQueuedThreads, uint32 StackSize = 0/*(32 * 1024)*/, EThreadPriority ThreadPriority = TPri_Normal);
+		/**
+		* Creates the threads of the pool.
+		*
+		* @param InNumQueuedThreads Number of threads to create
+		* @param StackSize The size of the stack of each thread
+		* @param ThreadPriority Priority of the threads
+		* @param bInWorkStealing If true, jobs are distributed through per-thread deques with work stealing instead of the single shared queue
+		* @return True if all threads were created, false otherwise
+		*/
+		bool Create(uint32 InNumQueuedThreads, uint32 StackSize = 0/*(32 * 1024)*/, EThreadPriority ThreadPriority = TPri_Normal, bool bInWorkStealing = false);
 
 		void JoinAllThreads();
 		void Destroy();
@@ -940,8 +1390,35 @@ namespace EDX
 			return QueuedThreads.Size();
 		}
 
+		bool IsWorkStealing() const
+		{
+			return bWorkStealing;
+		}
+
+		/**
+		* Queues a job. In work stealing mode jobs queued from a pool thread go onto that
+		* thread's own deque, others go to the shared queue, and one parked thread is woken up.
+		*
+		* @param InQueuedWork The job to run
+		*/
 		void AddQueuedWork(QueuedWork* InQueuedWork);
 		
 		QueuedWork* GetNextJob(QueuedThread* InQueuedThread);
+
+		/**
+		* Runs one queued job on the calling thread, used by threads that wait on jobs
+		* to help instead of sleeping. Pool threads look at their own deque first.
+		*
+		* @return true if a job was run, false if no job was found
+		*/
+		bool TryExecuteJob();
+
+		/**
+		* Whether it is worth splitting work into another job from the calling thread. In work stealing
+		* mode this is the case when the jobs queued from this thread have all been picked up already.
+		*
+		* @return true if a new job would likely be picked up by an idle thread
+		*/
+		bool ShouldSplitWork();
 	};
 }
\ No newline at end of file
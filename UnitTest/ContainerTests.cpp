@@ -0,0 +1,627 @@
+#include "UnitTest.h"
+#include "Containers/FlatMap.h"
+#include "Containers/ConcurrentMap.h"
+#include "Core/MemoryTracker.h"
+
+using namespace EDX;
+using namespace EDX::UnitTest;
+
+namespace
+{
+	/** Distinct keys spread over the whole range, multiplying by an odd constant is a bijection. */
+	__forceinline int32 GetKey(int32 Index)
+	{
+		return int32(uint32(Index) * 2654435761u);
+	}
+
+	/** Threads asking for the same keys in different orders must all get the one value built for each key. */
+	void TestConcurrentMapFindOrAdd()
+	{
+		const int32 NumThreads = 8;
+		const int32 NumKeys = 20000;
+
+		ConcurrentMap<int32, int32> Map;
+		Array<int32> NumBuilt;
+		NumBuilt.Init(0, NumKeys);
+		volatile int32 NumWrongValues = 0;
+
+		RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+		{
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				const int32 Key = (i * (2 * ThreadIndex + 1) + ThreadIndex * 997) % NumKeys;
+				const int32& Value = Map.FindOrAdd(Key, [&]()
+				{
+					PlatformAtomics::InterlockedIncrement((volatile int32*)&NumBuilt[Key]);
+					return 3 * Key;
+				});
+
+				if (Value != 3 * Key)
+				{
+					PlatformAtomics::InterlockedIncrement(&NumWrongValues);
+				}
+			}
+		});
+
+		TEST_CHECK(NumWrongValues == 0);
+		TEST_CHECK(Map.Size() == NumKeys);
+
+		int32 NumBuiltOnce = 0;
+		for (int32 i = 0; i < NumKeys; i++)
+		{
+			NumBuiltOnce += NumBuilt[i] == 1 ? 1 : 0;
+		}
+		TEST_CHECK(NumBuiltOnce == NumKeys);
+		TEST_CHECK(!Map.TryAdd(0, -1) && *Map.Find(0) == 0);
+	}
+
+	/**
+	* Readers look up keys while writers add them and the bucket count keeps doubling. Keys a writer has published must
+	* be found, from a split bucket or from the closest split parent of a bucket not split yet, and others never are.
+	*/
+	void TestConcurrentMapReaders()
+	{
+		const int32 NumWriters = 2;
+		const int32 NumReaders = 4;
+		const int32 KeysPerWriter = 50000;
+
+		ConcurrentMap<int32, int32> Map;
+		volatile int32 NumPublished[NumWriters] = { 0, 0 };
+		volatile int32 NumWritersDone = 0;
+		volatile int32 NumMissed = 0;
+		volatile int32 NumPhantoms = 0;
+
+		RunOnThreads(NumWriters + NumReaders, [&](int32 ThreadIndex)
+		{
+			if (ThreadIndex < NumWriters)
+			{
+				for (int32 i = 0; i < KeysPerWriter; i++)
+				{
+					TEST_CHECK(Map.TryAdd(i * NumWriters + ThreadIndex, i));
+					PlatformAtomics::InterlockedExchange(&NumPublished[ThreadIndex], i + 1);
+				}
+				PlatformAtomics::InterlockedIncrement(&NumWritersDone);
+				return;
+			}
+
+			uint32 Random = 0x12345u + ThreadIndex;
+			while (NumWritersDone < NumWriters)
+			{
+				for (int32 Writer = 0; Writer < NumWriters; Writer++)
+				{
+					const int32 Published = NumPublished[Writer];
+					if (Published == 0)
+					{
+						continue;
+					}
+
+					Random ^= Random << 13;
+					Random ^= Random >> 17;
+					Random ^= Random << 5;
+					const int32 i = int32(Random % uint32(Published));
+					const int32* pValue = Map.Find(i * NumWriters + Writer);
+					if (pValue == nullptr || *pValue != i)
+					{
+						PlatformAtomics::InterlockedIncrement(&NumMissed);
+					}
+				}
+
+				if (Map.Contains(-1 - int32(Random % uint32(KeysPerWriter))))
+				{
+					PlatformAtomics::InterlockedIncrement(&NumPhantoms);
+				}
+				WindowsProcess::Sleep(0.0f);
+			}
+		});
+
+		TEST_CHECK(NumMissed == 0);
+		TEST_CHECK(NumPhantoms == 0);
+		TEST_CHECK(Map.Size() == NumWriters * KeysPerWriter);
+
+		int32 NumVisited = 0;
+		Map.ForEach([&](const Pair<int32, int32>& Pair) { NumVisited += Pair.Key / NumWriters == Pair.Value ? 1 : 0; });
+		TEST_CHECK(NumVisited == NumWriters * KeysPerWriter);
+	}
+
+	/** Lookups of missing keys leave the buckets they reach unsplit, so they must not allocate. */
+	void TestConcurrentMapLookupDoesNotAllocate()
+	{
+		ConcurrentMap<int32, int32> Map;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			Map.TryAdd(GetKey(i), i);
+		}
+
+#if EDX_TRACK_MEMORY
+		MemorySnapshot Before;
+		MemoryTracker::GetSnapshot(Before);
+#endif
+
+		int32 NumFound = 0;
+		for (int32 i = 0; i < 100000; i++)
+		{
+			NumFound += Map.Contains(GetKey(i)) ? 1 : 0;
+		}
+		TEST_CHECK(NumFound == 1000);
+
+#if EDX_TRACK_MEMORY
+		MemorySnapshot After;
+		MemoryTracker::GetSnapshot(After);
+		TEST_CHECK(After.Tags[MemoryTag_Containers].NumAllocs == Before.Tags[MemoryTag_Containers].NumAllocs);
+#endif
+	}
+
+	/**
+	* BulkAdd on a set already holding enough elements relinks them in parallel when the hash grows. The holes left by
+	* removed elements must be skipped, and every key must be found afterwards.
+	*/
+	void TestSetParallelRehash()
+	{
+		const int32 NumExisting = 40000;
+		const int32 NumAdded = 200000;
+
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+		TEST_CHECK(pPool->Create(4));
+
+		Set<int32> Keys;
+		for (int32 i = 0; i < NumExisting; i++)
+		{
+			Keys.Add(GetKey(i));
+		}
+		for (int32 i = 0; i < NumExisting; i += 3)
+		{
+			Keys.Remove(GetKey(i));
+		}
+		const int32 NumKept = Keys.Size();
+
+		Array<int32> NewKeys;
+		for (int32 i = NumExisting; i < NumExisting + NumAdded; i++)
+		{
+			NewKeys.Add(GetKey(i));
+		}
+		Keys.BulkAdd(NewKeys, true);
+		TEST_CHECK(Keys.Size() == NumKept + NumAdded);
+
+		int32 NumFound = 0;
+		for (int32 i = 0; i < NumExisting + NumAdded; i++)
+		{
+			NumFound += Keys.Contains(GetKey(i)) == (i >= NumExisting || i % 3 != 0) ? 1 : 0;
+		}
+		TEST_CHECK(NumFound == NumExisting + NumAdded);
+
+		pPool->Destroy();
+	}
+
+	/** Value owning heap memory, counts its live instances to catch missed and doubled destructions. */
+	struct CountedValue
+	{
+		static int32 NumLive;
+
+		Array<int32> Payload;
+
+		CountedValue(int32 Value = 0)
+		{
+			Payload.Add(Value);
+			NumLive++;
+		}
+		CountedValue(const CountedValue& Other)
+			: Payload(Other.Payload)
+		{
+			NumLive++;
+		}
+		CountedValue(CountedValue&& Other)
+			: Payload(Move(Other.Payload))
+		{
+			NumLive++;
+		}
+		CountedValue& operator=(const CountedValue&) = default;
+		CountedValue& operator=(CountedValue&&) = default;
+		~CountedValue()
+		{
+			NumLive--;
+		}
+
+		int32 Get() const
+		{
+			return Payload.Size() == 1 ? Payload[0] : -1;
+		}
+	};
+	int32 CountedValue::NumLive = 0;
+
+	/** Removing and adding keys at a steady size reuses the deleted slots or rehashes in place, the table never grows. */
+	void TestFlatSetTombstones()
+	{
+		FlatSet<int32> Keys;
+		Keys.Reserve(1000);
+		for (int32 i = 0; i < 1000; i++)
+		{
+			Keys.Add(i);
+		}
+		const int32 Capacity = Keys.GetCapacity();
+
+		int32 NumFound = 0;
+		for (int32 Round = 1; Round < 50; Round++)
+		{
+			// Replace a quarter of the keys with new ones, leaving deleted slots all over the table
+			for (int32 i = 0; i < 1000; i += 4)
+			{
+				Keys.Remove(i);
+				Keys.Add(Round * 1000 + i);
+			}
+
+			for (int32 i = 0; i < 1000; i++)
+			{
+				const bool bReplaced = i % 4 == 0;
+				NumFound += Keys.Contains((bReplaced ? Round : 0) * 1000 + i) && !(bReplaced && Keys.Contains(i)) ? 1 : 0;
+			}
+
+			// Put the original keys back for the next round
+			for (int32 i = 0; i < 1000; i += 4)
+			{
+				Keys.Remove(Round * 1000 + i);
+				Keys.Add(i);
+			}
+		}
+		TEST_CHECK(NumFound == 49 * 1000);
+		TEST_CHECK(Keys.Size() == 1000);
+		TEST_CHECK(Keys.GetCapacity() == Capacity);
+
+		// Emptying the table one key at a time and refilling it doesn't grow it either
+		for (int32 Round = 0; Round < 10; Round++)
+		{
+			for (int32 i = 0; i < 1000; i++)
+			{
+				Keys.Remove(Round * 5000 + i);
+			}
+			for (int32 i = 0; i < 1000; i++)
+			{
+				Keys.Add((Round + 1) * 5000 + i);
+			}
+		}
+		TEST_CHECK(Keys.Size() == 1000 && Keys.Contains(50000) && !Keys.Contains(45000));
+		TEST_CHECK(Keys.GetCapacity() == Capacity);
+	}
+
+	/** RemoveCurrent drops the current element and the iteration visits every other element once. */
+	void TestFlatSetRemoveCurrent()
+	{
+		FlatSet<int32> Keys;
+		for (int32 i = 0; i < 500; i++)
+		{
+			Keys.Add(i);
+		}
+
+		int32 NumVisited = 0;
+		for (FlatSet<int32>::Iterator It = Keys.CreateIterator(); It; ++It)
+		{
+			NumVisited++;
+			if (*It % 3 == 0)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		TEST_CHECK(NumVisited == 500);
+		TEST_CHECK(Keys.Size() == 500 - 167);
+
+		int32 NumMatching = 0;
+		for (int32 i = 0; i < 500; i++)
+		{
+			NumMatching += Keys.Contains(i) == (i % 3 != 0) ? 1 : 0;
+		}
+		TEST_CHECK(NumMatching == 500);
+
+		// Removing everything while iterating leaves an empty, usable set
+		for (FlatSet<int32>::Iterator It = Keys.CreateIterator(); It; ++It)
+		{
+			It.RemoveCurrent();
+		}
+		TEST_CHECK(Keys.Size() == 0 && !Keys.Contains(1));
+		Keys.Add(7);
+		TEST_CHECK(Keys.Size() == 1 && Keys.Contains(7));
+	}
+
+	/** String keys and values owning memory survive growth, rehashing, copies and moves, and are destroyed once. */
+	void TestFlatMapNonTrivial()
+	{
+		{
+			FlatMap<String, CountedValue> Values;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				Values.Add(String::FromInt(i), CountedValue(i));
+			}
+			for (int32 i = 0; i < 2000; i += 2)
+			{
+				Values.Remove(String::FromInt(i));
+			}
+			for (int32 i = 0; i < 2000; i += 4)
+			{
+				Values.Add(String::FromInt(i), CountedValue(-i - 1));
+			}
+
+			// Replacing an existing key keeps one value
+			Values.Add(String::FromInt(1), CountedValue(100));
+			TEST_CHECK(CountedValue::NumLive == Values.Size());
+
+			FlatMap<String, CountedValue> Copy = Values;
+			TEST_CHECK(CountedValue::NumLive == 2 * Values.Size());
+
+			FlatMap<String, CountedValue> Moved = Move(Values);
+			TEST_CHECK(Values.Size() == 0 && !Values.Contains(String::FromInt(1)));
+			TEST_CHECK(CountedValue::NumLive == 2 * Moved.Size());
+
+			int32 NumMatching = 0;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				const bool bPresent = i % 2 == 1 || i % 4 == 0;
+				const int32 Expected = i == 1 ? 100 : i % 4 == 0 ? -i - 1 : i;
+				const CountedValue* pCopied = Copy.Find(String::FromInt(i));
+				const CountedValue* pMoved = Moved.Find(String::FromInt(i));
+				const bool bMatch = bPresent
+					? pCopied && pMoved && pCopied->Get() == Expected && pMoved->Get() == Expected
+					: pCopied == nullptr && pMoved == nullptr;
+				NumMatching += bMatch ? 1 : 0;
+			}
+			TEST_CHECK(NumMatching == 2000);
+			TEST_CHECK(Copy.Size() == 1500);
+
+			// Copy and move assignment release what the target held
+			Copy = Moved;
+			TEST_CHECK(CountedValue::NumLive == 2 * Moved.Size());
+			Copy = Move(Moved);
+			TEST_CHECK(CountedValue::NumLive == Copy.Size());
+
+			for (FlatMap<String, CountedValue>::Iterator It = Copy.CreateIterator(); It; ++It)
+			{
+				if (It->Value.Get() < 0)
+				{
+					It.RemoveCurrent();
+				}
+			}
+			TEST_CHECK(CountedValue::NumLive == Copy.Size() && Copy.Size() == 1000);
+
+			Copy.Clear();
+			TEST_CHECK(CountedValue::NumLive == 0);
+			Copy.Add(String::FromInt(3), CountedValue(3));
+		}
+		TEST_CHECK(CountedValue::NumLive == 0);
+	}
+
+	/**
+	* Array64 past 2^31 elements: growing, inserting, copying, comparing and removing move every
+	* element, which breaks if a count is truncated to 32 bits anywhere. Needs about 4.5GB of memory.
+	*/
+	void TestArray64Large()
+	{
+		const int64 Boundary = int64(1) << 31;
+		const int64 Num = Boundary + (1 << 20);
+
+		Array64<uint8> Items;
+		Items.Reserve(Num + 64);
+		Items.AddZeroed(Num);
+		TEST_CHECK(Items.Size() == Num);
+
+		const int64 Marked[] = { 0, Boundary - 1, Boundary, Boundary + 1000, Num - 1 };
+		for (int32 i = 0; i < 5; i++)
+		{
+			Items[Marked[i]] = uint8(i + 1);
+		}
+
+		// Everything moves up by 16 elements and back
+		Items.InsertZeroed(0, 16);
+		int32 NumShifted = 0;
+		for (int32 i = 0; i < 5; i++)
+		{
+			NumShifted += Items[Marked[i] + 16] == uint8(i + 1) ? 1 : 0;
+		}
+		TEST_CHECK(NumShifted == 5);
+		TEST_CHECK(Items.Size() == Num + 16);
+
+		Items.RemoveAt(0, 16, false);
+		int32 NumRestored = 0;
+		for (int32 i = 0; i < 5; i++)
+		{
+			NumRestored += Items[Marked[i]] == uint8(i + 1) ? 1 : 0;
+		}
+		TEST_CHECK(NumRestored == 5);
+
+		{
+			Array64<uint8> Copy = Items;
+			TEST_CHECK(Copy.Size() == Num);
+			TEST_CHECK(Copy[Num - 1] == 5);
+			TEST_CHECK(Copy == Items);
+
+			Copy[Boundary + 1] = 9;
+			TEST_CHECK(Copy != Items);
+		}
+
+		// Removing 2^31 elements leaves the tail at the front
+		Items.RemoveAt(1, Boundary, false);
+		TEST_CHECK(Items.Size() == Num - Boundary);
+		TEST_CHECK(Items[0] == 1 && Items[1] == 0 && Items[1000] == 4 && Items[Num - Boundary - 1] == 5);
+
+		Items.Clear();
+		TEST_CHECK(Items.Size() == 0 && Items.Capacity() == 0);
+	}
+
+	/**
+	* Times insertion, lookup of present and missing keys, and removal of NumKeys keys in a map.
+	* @param pLabel Name of the map type in the report
+	* @param NumKeys Number of keys
+	*/
+	template<typename MapType>
+	void BenchmarkMap(const char* pLabel, int32 NumKeys)
+	{
+		const int32 NumRuns = NumKeys < 100000 ? 20 : 3;
+		char Name[96];
+
+		snprintf(Name, sizeof(Name), "%s, add %i", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			MapType Map;
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Map.Add(GetKey(i), i);
+			}
+			DoNotOptimize(Map.Size());
+		}, NumRuns));
+
+		MapType Map;
+		for (int32 i = 0; i < NumKeys; i++)
+		{
+			Map.Add(GetKey(i), i);
+		}
+
+		int64 Sum = 0;
+		snprintf(Name, sizeof(Name), "%s, find %i present", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			Sum = 0;
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Sum += *Map.Find(GetKey(i));
+			}
+		}, NumRuns));
+		TEST_CHECK(Sum == int64(NumKeys) * (NumKeys - 1) / 2);
+
+		int32 NumFound = 0;
+		snprintf(Name, sizeof(Name), "%s, find %i missing", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			NumFound = 0;
+			for (int32 i = NumKeys; i < 2 * NumKeys; i++)
+			{
+				NumFound += Map.Find(GetKey(i)) != nullptr ? 1 : 0;
+			}
+		}, NumRuns));
+		TEST_CHECK(NumFound == 0);
+
+		// Removal empties the map, each run works on its own copy
+		Array<MapType> Copies;
+		Copies.AddDefaulted(NumRuns);
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Copies[Run].Add(GetKey(i), i);
+			}
+		}
+
+		int32 Run = 0;
+		snprintf(Name, sizeof(Name), "%s, remove %i", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			MapType& Copy = Copies[Run++];
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Copy.Remove(GetKey(i));
+			}
+		}, NumRuns));
+
+		int32 NumLeft = 0;
+		for (const MapType& Copy : Copies)
+		{
+			NumLeft += Copy.Size();
+		}
+		TEST_CHECK(NumLeft == 0);
+	}
+
+	/** Same as BenchmarkMap for sets. */
+	template<typename SetType>
+	void BenchmarkSet(const char* pLabel, int32 NumKeys)
+	{
+		const int32 NumRuns = NumKeys < 100000 ? 20 : 3;
+		char Name[96];
+
+		snprintf(Name, sizeof(Name), "%s, add %i", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			SetType Set;
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Set.Add(GetKey(i));
+			}
+			DoNotOptimize(Set.Size());
+		}, NumRuns));
+
+		SetType Set;
+		for (int32 i = 0; i < NumKeys; i++)
+		{
+			Set.Add(GetKey(i));
+		}
+
+		int32 NumFound = 0;
+		snprintf(Name, sizeof(Name), "%s, contains %i present", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			NumFound = 0;
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				NumFound += Set.Contains(GetKey(i)) ? 1 : 0;
+			}
+		}, NumRuns));
+		TEST_CHECK(NumFound == NumKeys);
+
+		snprintf(Name, sizeof(Name), "%s, contains %i missing", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			NumFound = 0;
+			for (int32 i = NumKeys; i < 2 * NumKeys; i++)
+			{
+				NumFound += Set.Contains(GetKey(i)) ? 1 : 0;
+			}
+		}, NumRuns));
+		TEST_CHECK(NumFound == 0);
+
+		Array<SetType> Copies;
+		Copies.AddDefaulted(NumRuns);
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Copies[Run].Add(GetKey(i));
+			}
+		}
+
+		int32 Run = 0;
+		snprintf(Name, sizeof(Name), "%s, remove %i", pLabel, NumKeys);
+		ReportTime(Name, BestTimeMs([&]()
+		{
+			SetType& Copy = Copies[Run++];
+			for (int32 i = 0; i < NumKeys; i++)
+			{
+				Copy.Remove(GetKey(i));
+			}
+		}, NumRuns));
+
+		int32 NumLeft = 0;
+		for (const SetType& Copy : Copies)
+		{
+			NumLeft += Copy.Size();
+		}
+		TEST_CHECK(NumLeft == 0);
+	}
+}
+
+void TestContainers()
+{
+	TestConcurrentMapFindOrAdd();
+	TestConcurrentMapReaders();
+	TestConcurrentMapLookupDoesNotAllocate();
+	TestSetParallelRehash();
+	TestFlatSetTombstones();
+	TestFlatSetRemoveCurrent();
+	TestFlatMapNonTrivial();
+	TestArray64Large();
+}
+
+void BenchmarkContainers()
+{
+	const int32 KeyCounts[] = { 1 << 10, 1 << 16, 1 << 20 };
+	for (int32 NumKeys : KeyCounts)
+	{
+		BenchmarkMap<Map<int32, int32>>("Map<int32, int32>", NumKeys);
+		BenchmarkMap<FlatMap<int32, int32>>("FlatMap<int32, int32>", NumKeys);
+		BenchmarkSet<Set<int32>>("Set<int32>", NumKeys);
+		BenchmarkSet<FlatSet<int32>>("FlatSet<int32>", NumKeys);
+	}
+}
@@ -0,0 +1,234 @@
+#include "UnitTest.h"
+#include "Core/FastHash.h"
+#include "Core/Crc.h"
+#include "Containers/Map.h"
+
+using namespace EDX;
+using namespace EDX::UnitTest;
+
+namespace
+{
+	/** Plain data key without a GetTypeHash overload, hashed by its bytes. */
+	struct GridCell
+	{
+		int32 X;
+		int32 Y;
+		int32 Z;
+
+		bool operator==(const GridCell& Other) const
+		{
+			return X == Other.X && Y == Other.Y && Z == Other.Z;
+		}
+	};
+
+	void TestFastHash()
+	{
+		uint8 Bytes[1024];
+		for (int32 i = 0; i < 1024; i++)
+		{
+			Bytes[i] = uint8(i * 7 + 3);
+		}
+
+		// Every length goes through a different tail, none may read past the end or ignore a byte
+		int32 NumSensitive = 0;
+		for (int32 Length = 1; Length <= 200; Length++)
+		{
+			const uint64 Hash = FastHash::MemHash64(Bytes, Length);
+			TEST_CHECK(Hash == FastHash::MemHash64(Bytes, Length));
+
+			bool bSensitive = FastHash::MemHash64(Bytes, Length - 1) != Hash && FastHash::MemHash64(Bytes, Length, 1) != Hash;
+			for (int32 i = 0; i < Length; i++)
+			{
+				Bytes[i] ^= 0x10;
+				bSensitive = bSensitive && FastHash::MemHash64(Bytes, Length) != Hash;
+				Bytes[i] ^= 0x10;
+			}
+			NumSensitive += bSensitive ? 1 : 0;
+		}
+		TEST_CHECK(NumSensitive == 200);
+
+		// The same bytes at a different alignment hash the same
+		uint8 Shifted[1024 + 8];
+		Memory::Memcpy(Shifted + 3, Bytes, 1024);
+		TEST_CHECK(FastHash::MemHash64(Shifted + 3, 1024) == FastHash::MemHash64(Bytes, 1024));
+
+		const TCHAR* pText = EDX_TEXT("Hello World");
+		TCHAR Copy[32];
+		Memory::Memcpy(Copy, pText, 12 * sizeof(TCHAR));
+		TEST_CHECK(GetTypeHash(pText) == GetTypeHash((const TCHAR*)Copy));
+		TEST_CHECK(GetTypeHash(String(EDX_TEXT("Hello World"))) == GetTypeHash(String(EDX_TEXT("hELLO wORLD"))));
+		TEST_CHECK(GetTypeHash(String(EDX_TEXT("Hello World"))) != GetTypeHash(String(EDX_TEXT("Hello Worle"))));
+	}
+
+	/** Bit at a time reference of the reflected CRC32 variants, Polynomial being the reversed polynomial. */
+	uint32 ReferenceCrc(const uint8* pData, int32 Length, uint32 CRC, uint32 Polynomial)
+	{
+		CRC = ~CRC;
+		for (int32 i = 0; i < Length; i++)
+		{
+			CRC ^= pData[i];
+			for (int32 Bit = 0; Bit < 8; Bit++)
+			{
+				CRC = (CRC >> 1) ^ (Polynomial & (0u - (CRC & 1)));
+			}
+		}
+		return ~CRC;
+	}
+
+	void TestCrc()
+	{
+		const uint32 Crc32Polynomial = 0xEDB88320u;
+		const uint32 Crc32CPolynomial = 0x82F63B78u;
+
+		const char* pCheck = "123456789";
+		TEST_CHECK(Crc::MemCrc32(pCheck, 9) == 0xCBF43926u);
+		TEST_CHECK(Crc::MemCrc32C(pCheck, 9) == 0xE3069283u);
+		TEST_CHECK(Crc::MemCrc32(pCheck, 0) == 0 && Crc::MemCrc32C(pCheck, 0) == 0);
+
+		Array<uint8> Data;
+		Data.AddUninitialized(40000);
+		uint32 Random = 0x9E3779B9u;
+		for (int32 i = 0; i < Data.Size(); i++)
+		{
+			Random ^= Random << 13;
+			Random ^= Random >> 17;
+			Random ^= Random << 5;
+			Data[i] = uint8(Random);
+		}
+
+		// Lengths around the 64 byte folding, the 256 byte and 8KB interleaved blocks and the table tails
+		const int32 Lengths[] = { 1, 7, 8, 15, 63, 64, 65, 127, 128, 191, 255, 256, 257, 767, 768, 769, 1000, 4096, 8191, 8192, 8193, 24575, 24576, 24577, 39000 };
+		int32 NumMatches = 0;
+		int32 NumChecks = 0;
+		for (int32 Length : Lengths)
+		{
+			for (int32 Offset = 0; Offset < 16; Offset += 5)
+			{
+				const uint8* pData = Data.Data() + Offset;
+				NumMatches += Crc::MemCrc32(pData, Length) == ReferenceCrc(pData, Length, 0, Crc32Polynomial) ? 1 : 0;
+				NumMatches += Crc::MemCrc32C(pData, Length) == ReferenceCrc(pData, Length, 0, Crc32CPolynomial) ? 1 : 0;
+				NumMatches += Crc::MemCrc32(pData, Length, 0x12345678u) == ReferenceCrc(pData, Length, 0x12345678u, Crc32Polynomial) ? 1 : 0;
+				NumMatches += Crc::MemCrc32C(pData, Length, 0x12345678u) == ReferenceCrc(pData, Length, 0x12345678u, Crc32CPolynomial) ? 1 : 0;
+				NumChecks += 4;
+			}
+		}
+		TEST_CHECK(NumMatches == NumChecks);
+
+		// Passing the CRC of the first part continues it over the second part
+		const int32 Split = 333;
+		TEST_CHECK(Crc::MemCrc32(Data.Data() + Split, 20000 - Split, Crc::MemCrc32(Data.Data(), Split)) == Crc::MemCrc32(Data.Data(), 20000));
+		TEST_CHECK(Crc::MemCrc32C(Data.Data() + Split, 20000 - Split, Crc::MemCrc32C(Data.Data(), Split)) == Crc::MemCrc32C(Data.Data(), 20000));
+
+		// Strings hash as if every character was 4 bytes wide
+		const char* pNarrow = "EDXUtil";
+		const uint32 Wide[] = { 'E', 'D', 'X', 'U', 't', 'i', 'l', 0 };
+		TEST_CHECK(Crc::StrHash(pNarrow) == Crc::MemCrc32(Wide, 7 * sizeof(uint32)));
+		TEST_CHECK(Crc::StrHash(EDX_TEXT("EDXUtil")) == Crc::StrHash(pNarrow));
+	}
+
+	/** Keys without a GetTypeHash overload work in the containers through their bytes. */
+	void TestPodKeys()
+	{
+		static_assert(HasTypeHash<int32>::Value && HasTypeHash<String>::Value, "Types with an overload use it.");
+		static_assert(!HasTypeHash<GridCell>::Value, "Plain data types without an overload are hashed by their bytes.");
+
+		const GridCell Cell = { 1, 2, 3 };
+		TEST_CHECK(GetKeyTypeHash(Cell) == GetPodHash(Cell));
+		TEST_CHECK(GetKeyTypeHash(42) == GetTypeHash(42));
+
+		Map<GridCell, int32> Cells;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			const GridCell Key = { i % 10, i / 10 % 10, i / 100 };
+			Cells.Add(Key, i);
+		}
+
+		int32 NumFound = 0;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			const GridCell Key = { i % 10, i / 10 % 10, i / 100 };
+			const int32* pValue = Cells.Find(Key);
+			NumFound += pValue && *pValue == i ? 1 : 0;
+		}
+		TEST_CHECK(NumFound == 1000);
+
+		const GridCell Missing = { 10, 0, 0 };
+		TEST_CHECK(Cells.Find(Missing) == nullptr);
+	}
+
+	/**
+	* Times hashing keys of a given length, over enough keys to leave the caches warm but not trivially predicted.
+	* @return Throughput in bytes per nanosecond, i.e. GB/s
+	*/
+	template<typename HashFunc>
+	double MeasureHashThroughput(const uint8* pData, int32 Length, const HashFunc& Hash)
+	{
+		const int32 NumKeys = 1000;
+		const int32 NumRounds = Math::Max(1, (1 << 22) / (NumKeys * Length));
+
+		uint32 Sum = 0;
+		const double Time = BestTimeMs([&]()
+		{
+			for (int32 Round = 0; Round < NumRounds; Round++)
+			{
+				for (int32 i = 0; i < NumKeys; i++)
+				{
+					Sum += Hash(pData + i, Length);
+				}
+			}
+		});
+		DoNotOptimize(Sum);
+
+		return double(NumRounds) * NumKeys * Length / (Time * 1e6);
+	}
+}
+
+void TestHashing()
+{
+	TestFastHash();
+	TestCrc();
+	TestPodKeys();
+}
+
+void BenchmarkHashing()
+{
+	Array<uint8> Data;
+	Data.AddUninitialized(1000 + 1024);
+	for (int32 i = 0; i < Data.Size(); i++)
+	{
+		Data[i] = uint8(i * 131 + (i >> 7));
+	}
+
+	const int32 Lengths[] = { 4, 8, 16, 32, 64, 256, 1024 };
+	for (int32 Length : Lengths)
+	{
+		char Name[64];
+		snprintf(Name, sizeof(Name), "FastHash::MemHash, %i bytes", Length);
+		ReportThroughput(Name, MeasureHashThroughput(Data.Data(), Length, [](const uint8* p, int32 Len) { return FastHash::MemHash(p, Len); }));
+
+		snprintf(Name, sizeof(Name), "Crc::MemCrc32, %i bytes", Length);
+		ReportThroughput(Name, MeasureHashThroughput(Data.Data(), Length, [](const uint8* p, int32 Len) { return Crc::MemCrc32(p, Len); }));
+
+		snprintf(Name, sizeof(Name), "Crc::MemCrc32C, %i bytes", Length);
+		ReportThroughput(Name, MeasureHashThroughput(Data.Data(), Length, [](const uint8* p, int32 Len) { return Crc::MemCrc32C(p, Len); }));
+	}
+
+	// Large buffers, where the folding and the interleaved streams are meant to pay off
+	Array<uint8> Buffer;
+	Buffer.AddZeroed(64 * 1024);
+	for (int32 i = 0; i < Buffer.Size(); i++)
+	{
+		Buffer[i] = uint8(i * 131 + (i >> 7));
+	}
+
+	uint32 Sum = 0;
+	const double Crc32Time = BestTimeMs([&]() { for (int32 i = 0; i < 64; i++) { Sum += Crc::MemCrc32(Buffer.Data(), Buffer.Size()); } });
+	ReportThroughput("Crc::MemCrc32, 64KB", 64.0 * Buffer.Size() / (Crc32Time * 1e6));
+
+	const double Crc32CTime = BestTimeMs([&]() { for (int32 i = 0; i < 64; i++) { Sum += Crc::MemCrc32C(Buffer.Data(), Buffer.Size()); } });
+	ReportThroughput("Crc::MemCrc32C, 64KB", 64.0 * Buffer.Size() / (Crc32CTime * 1e6));
+
+	const double ReferenceTime = BestTimeMs([&]() { Sum += ReferenceCrc(Buffer.Data(), Buffer.Size(), 0, 0xEDB88320u); });
+	ReportThroughput("Bitwise CRC32 reference, 64KB", Buffer.Size() / (ReferenceTime * 1e6));
+	DoNotOptimize(Sum);
+}
@@ -1,8 +1,55 @@
 
-#include "EDXPrerequisites.h"
+#include "UnitTest.h"
 
 using namespace EDX;
 
-void main()
+namespace EDX
 {
-}
\ No newline at end of file
+	namespace UnitTest
+	{
+		int32 NumFailures = 0;
+		volatile uint64 BenchmarkSink = 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	bool bRunBenchmarks = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-bench") == 0)
+		{
+			bRunBenchmarks = true;
+		}
+	}
+
+	printf("Tests\n");
+	TestThreading();
+	TestMemory();
+	TestContainers();
+	TestHashing();
+	TestSorting();
+	TestStrings();
+
+	if (bRunBenchmarks)
+	{
+		printf("Benchmarks\n");
+		BenchmarkThreading();
+		BenchmarkMemory();
+		BenchmarkContainers();
+		BenchmarkHashing();
+		BenchmarkSorting();
+		BenchmarkStrings();
+	}
+
+	if (UnitTest::NumFailures > 0)
+	{
+		printf("%i checks failed\n", UnitTest::NumFailures);
+	}
+	else
+	{
+		printf("All tests passed\n");
+	}
+
+	return UnitTest::NumFailures;
+}
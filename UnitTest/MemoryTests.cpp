@@ -0,0 +1,732 @@
+#include "UnitTest.h"
+#include "Core/MallocBinned.h"
+#include "Core/ObjectPool.h"
+#include "Core/MemoryTracker.h"
+#include "Core/MemoryPool.h"
+
+using namespace EDX;
+using namespace EDX::UnitTest;
+
+namespace
+{
+	struct BinnedAllocator
+	{
+		static __forceinline void* Malloc(size_t Size)
+		{
+			return MallocBinned::Malloc(Size, DEFAULT_ALIGNMENT);
+		}
+
+		static __forceinline void Free(void* Ptr)
+		{
+			MallocBinned::Free(Ptr);
+		}
+	};
+
+	struct SystemAllocator
+	{
+		static __forceinline void* Malloc(size_t Size)
+		{
+			return malloc(Size);
+		}
+
+		static __forceinline void Free(void* Ptr)
+		{
+			free(Ptr);
+		}
+	};
+
+	__forceinline uint32 NextRandom(uint32& State)
+	{
+		State ^= State << 13;
+		State ^= State >> 17;
+		State ^= State << 5;
+		return State;
+	}
+
+	/** Counts the live instances, to check that the pool constructs and destructs each object once. */
+	struct Tracked
+	{
+		static int32 NumLive;
+		int32 Value;
+
+		Tracked(int32 InValue)
+			: Value(InValue)
+		{
+			NumLive++;
+		}
+
+		~Tracked()
+		{
+			NumLive--;
+		}
+	};
+	int32 Tracked::NumLive = 0;
+
+	void TestObjectPool()
+	{
+		{
+			ObjectPool<Tracked, 4> Pool;
+			Array<ObjectPool<Tracked, 4>::Handle> Handles;
+			for (int32 i = 0; i < 10; i++)
+			{
+				Handles.Add(Pool.Create(i));
+			}
+			TEST_CHECK(Tracked::NumLive == 10);
+			TEST_CHECK(Pool.Get(Handles[7])->Value == 7);
+
+			// A slot reused after Destroy must not be reachable through the old handle
+			TEST_CHECK(Pool.Destroy(Handles[3]));
+			TEST_CHECK(!Pool.Destroy(Handles[3]));
+			const ObjectPool<Tracked, 4>::Handle Reused = Pool.Create(42);
+			TEST_CHECK(Reused.Index == Handles[3].Index);
+			TEST_CHECK(Pool.Get(Handles[3]) == nullptr);
+			TEST_CHECK(Pool.Get(Reused)->Value == 42);
+
+			// Same after Empty, the slots are reused from the first one with new generations
+			Pool.Empty();
+			TEST_CHECK(Tracked::NumLive == 0);
+			TEST_CHECK(Pool.Get(Reused) == nullptr);
+			const ObjectPool<Tracked, 4>::Handle AfterEmpty = Pool.Create(5);
+			TEST_CHECK(AfterEmpty.Index == Handles[0].Index);
+			TEST_CHECK(AfterEmpty != Handles[0]);
+			TEST_CHECK(Pool.Get(Handles[0]) == nullptr);
+			TEST_CHECK(!Pool.Destroy(Handles[0]));
+			TEST_CHECK(Pool.Get(AfterEmpty)->Value == 5);
+
+			int32 NumVisited = 0;
+			Pool.ForEach([&](Tracked&) { NumVisited++; });
+			TEST_CHECK(NumVisited == 1);
+		}
+		TEST_CHECK(Tracked::NumLive == 0);
+	}
+
+	void TestMemoryTracker()
+	{
+		TEST_CHECK(MemoryTracker::GetAllocSize(nullptr) == 0);
+
+		MemorySnapshot Before;
+		MemoryTracker::GetSnapshot(Before);
+
+		void* Ptr = MemoryTracker::Malloc(100, 64, MemoryTag_Pools);
+		TEST_CHECK(Ptr != nullptr && (UPTRINT(Ptr) & 63) == 0);
+		TEST_CHECK(MemoryTracker::GetAllocSize(Ptr) >= 100);
+
+		MemorySnapshot During;
+		MemoryTracker::GetSnapshot(During);
+		TEST_CHECK(During.Tags[MemoryTag_Pools].CurrentBytes - Before.Tags[MemoryTag_Pools].CurrentBytes == 100);
+
+		// Scoped allocations take the tag of the innermost scope, reallocations keep the tag of the block
+		{
+			ScopeMemoryTag Scope(MemoryTag_Strings);
+			Ptr = MemoryTracker::Realloc(Ptr, 300, 64, MemoryTag_Scope);
+		}
+		MemoryTracker::GetSnapshot(During);
+		TEST_CHECK(During.Tags[MemoryTag_Pools].CurrentBytes - Before.Tags[MemoryTag_Pools].CurrentBytes == 300);
+		TEST_CHECK(During.Tags[MemoryTag_Strings].CurrentBytes == Before.Tags[MemoryTag_Strings].CurrentBytes);
+
+		MemoryTracker::Free(Ptr);
+		MemorySnapshot After;
+		MemoryTracker::GetSnapshot(After);
+		TEST_CHECK(After.Tags[MemoryTag_Pools].CurrentBytes == Before.Tags[MemoryTag_Pools].CurrentBytes);
+	}
+
+	/** Allocates Count runs of Size bytes, filling each with its index. */
+	void AllocRuns(MemoryPool& Pool, int32 Count, uint32 Size, Array<_byte*>& OutPtrs)
+	{
+		OutPtrs.Clear();
+		for (int32 i = 0; i < Count; i++)
+		{
+			_byte* Ptr = Pool.Alloc<_byte>(Size);
+			Memory::Memset(Ptr, uint8(i), Size);
+			OutPtrs.Add(Ptr);
+		}
+	}
+
+	/** Rewinding releases what was allocated after the marker, the same memory is handed out again. */
+	void TestMemoryPoolRewind()
+	{
+		MemoryPool Pool(4096);
+		_byte* pKept = Pool.Alloc<_byte>(100);
+		Memory::Memset(pKept, 0xAB, 100);
+
+		const MemoryPool::Marker Mark = Pool.GetMarker();
+		_byte* pFirst = Pool.Alloc<_byte>(100);
+		Pool.Rewind(Mark);
+		TEST_CHECK(Pool.Alloc<_byte>(100) == pFirst);
+		Pool.Rewind(Mark);
+
+		// Ten runs of 1000 bytes span three blocks, rewinding recycles them instead of allocating new ones
+		Array<_byte*> First;
+		Array<_byte*> Second;
+		AllocRuns(Pool, 10, 1000, First);
+		Pool.Rewind(Mark);
+		AllocRuns(Pool, 10, 1000, Second);
+
+		int32 NumReused = 0;
+		for (_byte* Ptr : Second)
+		{
+			NumReused += First.Contains(Ptr) ? 1 : 0;
+		}
+		TEST_CHECK(NumReused == 10);
+		Pool.Rewind(Mark);
+
+		// Requests bigger than a block get a block of their own, which is recycled as well
+		_byte* pLarge = Pool.Alloc<_byte>(10000);
+		Pool.Rewind(Mark);
+		Pool.Alloc<_byte>(1000);
+		TEST_CHECK(Pool.Alloc<_byte>(10000) == pLarge);
+		Pool.Rewind(Mark);
+
+		// Allocations made before the marker are untouched
+		int32 NumIntact = 0;
+		for (int32 i = 0; i < 100; i++)
+		{
+			NumIntact += pKept[i] == 0xAB ? 1 : 0;
+		}
+		TEST_CHECK(NumIntact == 100);
+	}
+
+	/** Inner marks release only their own allocations, outer ones everything after them. */
+	void TestMemoryPoolNestedMarks()
+	{
+		MemoryPool Pool(4096);
+
+		_byte* pOuterFirst;
+		_byte* pInnerFirst;
+		Array<_byte*> Outer;
+		Array<_byte*> Inner;
+		{
+			ScopeMemoryMark OuterMark(Pool);
+			AllocRuns(Pool, 3, 1000, Outer);
+			pOuterFirst = Outer[0];
+
+			{
+				ScopeMemoryMark InnerMark(Pool);
+				AllocRuns(Pool, 6, 1000, Inner);
+				pInnerFirst = Inner[0];
+			}
+
+			// Inner memory is reused, the outer runs spanning the inner mark still hold their values
+			_byte* pAfterInner = Pool.Alloc<_byte>(1000);
+			TEST_CHECK(pAfterInner == pInnerFirst);
+
+			int32 NumIntact = 0;
+			for (int32 i = 0; i < Outer.Size(); i++)
+			{
+				NumIntact += Outer[i][0] == uint8(i) && Outer[i][999] == uint8(i) ? 1 : 0;
+			}
+			TEST_CHECK(NumIntact == 3);
+		}
+
+		TEST_CHECK(Pool.Alloc<_byte>(1000) == pOuterFirst);
+	}
+
+	/** Arena for the allocator tests, the small block size makes the containers cross blocks. */
+	struct TestArena
+	{
+		static MemoryPool& Get()
+		{
+			static MemoryPool Pool(4096);
+			return Pool;
+		}
+	};
+
+	typedef Array<int32, ArenaAllocator<TestArena>> ArenaArray;
+
+	/** The last allocation of the arena grows and shrinks in place, others move when growing and stay when shrinking. */
+	void TestArenaAllocatorArray()
+	{
+		MemoryPool& Pool = TestArena::Get();
+		ScopeMemoryMark Mark(Pool);
+
+		ArenaArray Grown;
+		Grown.Add(0);
+		int32* pFirst = Grown.Data();
+		for (int32 i = 1; i < 512; i++)
+		{
+			Grown.Add(i);
+		}
+		TEST_CHECK(Grown.Data() == pFirst);
+
+		// With another allocation on top, growing moves the elements
+		ArenaArray Other;
+		Other.Add(-1);
+		Grown.AddZeroed(Grown.Capacity() - Grown.Size() + 1);
+		TEST_CHECK(Grown.Data() != pFirst);
+
+		int32 NumKept = 0;
+		for (int32 i = 0; i < 512; i++)
+		{
+			NumKept += Grown[i] == i ? 1 : 0;
+		}
+		TEST_CHECK(NumKept == 512);
+		TEST_CHECK(Other[0] == -1);
+
+		// Shrinking keeps the block, the last allocation gives its tail back to the arena
+		int32* pMoved = Grown.Data();
+		Grown.RemoveAt(16, Grown.Size() - 16);
+		Grown.Shrink();
+		TEST_CHECK(Grown.Data() == pMoved);
+		TEST_CHECK(Pool.Alloc<_byte>(16) == (_byte*)(pMoved + 16));
+
+		// Below the top of the arena now, shrinking keeps the block
+		Grown.Clear(1);
+		TEST_CHECK(Grown.Data() == pMoved);
+
+		// Emptying the last allocation gives it back
+		ArenaArray Temp;
+		Temp.AddZeroed(64);
+		_byte* pTemp = (_byte*)Temp.Data();
+		Temp.Clear();
+		TEST_CHECK(Pool.Alloc<_byte>(1) == pTemp);
+
+		ArenaArray Source;
+		for (int32 i = 0; i < 100; i++)
+		{
+			Source.Add(i * 3);
+		}
+		ArenaArray Copy = Source;
+		ArenaArray Moved = std::move(Source);
+		TEST_CHECK(Copy == Moved);
+		TEST_CHECK(Copy.Data() != Moved.Data());
+		TEST_CHECK(Source.Size() == 0);
+	}
+
+	/** Sets and maps with all of their memory on an arena, released by rewinding it. */
+	void TestArenaAllocatorSetMap()
+	{
+		MemoryPool& Pool = TestArena::Get();
+		const MemoryPool::Marker Start = Pool.GetMarker();
+		{
+			ScopeMemoryMark Mark(Pool);
+
+			Set<int32, DefaultKeyFuncs<int32>, ArenaSetAllocator<TestArena>> Keys;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				Keys.Add(i * 7);
+			}
+			for (int32 i = 0; i < 2000; i += 2)
+			{
+				Keys.Remove(i * 7);
+			}
+
+			int32 NumFound = 0;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				NumFound += Keys.Contains(i * 7) == (i % 2 == 1) ? 1 : 0;
+			}
+			TEST_CHECK(NumFound == 2000);
+			TEST_CHECK(Keys.Size() == 1000);
+
+			Map<int32, int32, ArenaSetAllocator<TestArena>> Values;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				Values.Add(i, i * i);
+			}
+			Values.Remove(10);
+
+			Map<int32, int32, ArenaSetAllocator<TestArena>> Copy = Values;
+			Values.Add(10, -1);
+
+			int32 NumMatching = 0;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				const int32* pValue = Copy.Find(i);
+				NumMatching += i == 10 ? (pValue == nullptr) : (pValue && *pValue == i * i);
+			}
+			TEST_CHECK(NumMatching == 2000);
+			TEST_CHECK(*Values.Find(10) == -1);
+		}
+
+		// Everything was released by the mark
+		const MemoryPool::Marker End = Pool.GetMarker();
+		TEST_CHECK(End.pBlock == Start.pBlock && End.uiOffset == Start.uiOffset && End.uiNumUsedBlocks == Start.uiNumUsedBlocks);
+	}
+
+	/** Fills Count words at Ptr with a value identifying the allocation. */
+	__forceinline void FillWords(uint32* Ptr, uint32 Count, uint32 Value)
+	{
+		for (uint32 i = 0; i < Count; i++)
+		{
+			Ptr[i] = Value;
+		}
+	}
+
+	/** @return true if the Count words at Ptr all hold Value. */
+	__forceinline bool CheckWords(const uint32* Ptr, uint32 Count, uint32 Value)
+	{
+		for (uint32 i = 0; i < Count; i++)
+		{
+			if (Ptr[i] != Value)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Threads allocate concurrently without sharing memory, FreeAll recycles the blocks and resets the statistics. */
+	void TestConcurrentMemoryPool()
+	{
+		enum
+		{
+			NumThreads = 4,
+			NumAllocs = 2000,
+		};
+
+		struct Allocation
+		{
+			uint32* Ptr;
+			uint32 Count;
+		};
+
+		ConcurrentMemoryPool Pool(4096);
+		Array<Allocation> Allocs[NumThreads];
+		uint64 NumBytes[NumThreads] = {};
+
+		for (int32 Round = 0; Round < 3; Round++)
+		{
+			RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+			{
+				Allocs[ThreadIndex].Clear();
+				NumBytes[ThreadIndex] = 0;
+
+				uint32 Random = ThreadIndex + 1;
+				for (int32 i = 0; i < NumAllocs; i++)
+				{
+					// Every 500th request is larger than a block and gets a dedicated one
+					const uint32 Count = i % 500 == 499 ? 2000 : 1 + (NextRandom(Random) & 63);
+					uint32* Ptr = Pool.Alloc<uint32>(Count);
+					FillWords(Ptr, Count, (ThreadIndex << 16) | i);
+
+					Allocs[ThreadIndex].Add(Allocation{ Ptr, Count });
+					NumBytes[ThreadIndex] += (Count * sizeof(uint32) + 15) & ~15;
+				}
+			});
+
+			int32 NumIntact = 0;
+			int32 NumAligned = 0;
+			uint64 TotalBytes = 0;
+			for (int32 Thread = 0; Thread < NumThreads; Thread++)
+			{
+				for (int32 i = 0; i < NumAllocs; i++)
+				{
+					const Allocation& Alloc = Allocs[Thread][i];
+					NumIntact += CheckWords(Alloc.Ptr, Alloc.Count, (Thread << 16) | i) ? 1 : 0;
+					NumAligned += (UPTRINT(Alloc.Ptr) & 15) == 0 ? 1 : 0;
+				}
+				TotalBytes += NumBytes[Thread];
+			}
+			TEST_CHECK(NumIntact == NumThreads * NumAllocs);
+			TEST_CHECK(NumAligned == NumThreads * NumAllocs);
+
+			// Threads which exited hand their slot over to new ones, the totals are exact either way
+			Array<ConcurrentMemoryPool::ThreadStats> Stats;
+			Pool.GetThreadStats(Stats);
+			uint64 StatsBytes = 0;
+			int32 NumValidPeaks = 0;
+			for (const ConcurrentMemoryPool::ThreadStats& Entry : Stats)
+			{
+				StatsBytes += Entry.CurrentBytes;
+				NumValidPeaks += Entry.PeakBytes >= Entry.CurrentBytes ? 1 : 0;
+			}
+			TEST_CHECK(Stats.Size() >= 1 && Stats.Size() <= NumThreads * (Round + 1));
+			TEST_CHECK(NumValidPeaks == Stats.Size());
+			TEST_CHECK(StatsBytes == TotalBytes);
+			TEST_CHECK(Pool.GetCurrentBytes() == TotalBytes);
+
+			Pool.FreeAll();
+			TEST_CHECK(Pool.GetCurrentBytes() == 0);
+		}
+
+		// Peaks survive FreeAll
+		Array<ConcurrentMemoryPool::ThreadStats> Stats;
+		Pool.GetThreadStats(Stats);
+		uint64 MaxPeak = 0;
+		for (const ConcurrentMemoryPool::ThreadStats& Entry : Stats)
+		{
+			MaxPeak = Math::Max(MaxPeak, Entry.PeakBytes);
+		}
+		TEST_CHECK(MaxPeak >= NumBytes[0]);
+
+#if EDX_TRACK_MEMORY
+		// Small requests after FreeAll are served by the recycled blocks
+		Pool.Alloc<uint32>(1);
+		Pool.FreeAll();
+
+		MemorySnapshot Before;
+		MemoryTracker::GetSnapshot(Before);
+		for (int32 i = 0; i < 1000; i++)
+		{
+			Pool.Alloc<uint32>(16);
+		}
+		MemorySnapshot After;
+		MemoryTracker::GetSnapshot(After);
+
+		int32 NumNewAllocs = 0;
+		for (int32 Tag = 0; Tag < MemoryTag_Max; Tag++)
+		{
+			NumNewAllocs += int32(After.Tags[Tag].NumAllocs - Before.Tags[Tag].NumAllocs);
+		}
+		TEST_CHECK(NumNewAllocs == 0);
+#endif
+	}
+
+	/** A thread alternating between pools keeps bump allocating from its block of each of them. */
+	void TestConcurrentMemoryPoolAlternating()
+	{
+		ConcurrentMemoryPool PoolA(4096);
+		ConcurrentMemoryPool PoolB(4096);
+
+		_byte* pPrevA = PoolA.Alloc<_byte>(16);
+		_byte* pPrevB = PoolB.Alloc<_byte>(16);
+		int32 NumContiguous = 0;
+		for (int32 i = 0; i < 100; i++)
+		{
+			_byte* pA = PoolA.Alloc<_byte>(16);
+			_byte* pB = PoolB.Alloc<_byte>(16);
+			NumContiguous += (pA == pPrevA + 16 ? 1 : 0) + (pB == pPrevB + 16 ? 1 : 0);
+			pPrevA = pA;
+			pPrevB = pB;
+		}
+		TEST_CHECK(NumContiguous == 200);
+		TEST_CHECK(PoolA.GetCurrentBytes() == 101 * 16 && PoolB.GetCurrentBytes() == 101 * 16);
+	}
+
+	/** Large allocations start on a page, page multiples map nothing extra, and freeing in any order keeps the others valid. */
+	void TestAllocLarge()
+	{
+		const size_t HugePageSize = 2 * 1024 * 1024;
+
+		// Placement requests are hints, nodes the machine doesn't have are ignored
+		const LargeAllocParams Modes[] =
+		{
+			LargeAllocParams(LargePage_None),
+			LargeAllocParams(LargePage_Transparent),
+			LargeAllocParams(LargePage_Explicit),
+			LargeAllocParams(LargePage_Transparent, NumaPolicy_Bind, 0),
+			LargeAllocParams(LargePage_Transparent, NumaPolicy_Bind, 64),
+			LargeAllocParams(LargePage_None, NumaPolicy_Bind, 5000),
+			LargeAllocParams(LargePage_Transparent, NumaPolicy_Interleave),
+		};
+
+		int32 NumValid = 0;
+		int32 NumExact = 0;
+		for (const LargeAllocParams& Params : Modes)
+		{
+			_byte* Ptr = (_byte*)Memory::AllocLarge(2 * HugePageSize, Params);
+			Ptr[0] = 1;
+			Ptr[2 * HugePageSize - 1] = 2;
+
+			NumValid += (UPTRINT(Ptr) & 4095) == 0 && Ptr[0] == 1 && Ptr[2 * HugePageSize - 1] == 2 ? 1 : 0;
+			NumExact += MallocLarge::GetAllocSize(Ptr) == 2 * HugePageSize ? 1 : 0;
+			Memory::FreeLarge(Ptr);
+		}
+		TEST_CHECK(NumValid == sizeof(Modes) / sizeof(Modes[0]));
+		TEST_CHECK(NumExact == sizeof(Modes) / sizeof(Modes[0]));
+
+		_byte* pSmall = (_byte*)Memory::AllocLarge(1, LargeAllocParams(LargePage_None));
+		TEST_CHECK(MallocLarge::GetAllocSize(pSmall) >= 1 && MallocLarge::GetAllocSize(pSmall) <= 65536);
+		Memory::FreeLarge(pSmall);
+		Memory::FreeLarge(nullptr);
+
+		// Enough live allocations to grow the side table, freed in a scrambled order
+		const int32 NumAllocs = 300;
+		Array<_byte*> Ptrs;
+		Array<size_t> Sizes;
+		for (int32 i = 0; i < NumAllocs; i++)
+		{
+			const size_t Size = 4096 * (1 + i % 3);
+			_byte* Ptr = (_byte*)Memory::AllocLarge(Size, LargeAllocParams(LargePage_None));
+			Memory::Memset(Ptr, 0xCD, Size);
+			Ptrs.Add(Ptr);
+			Sizes.Add(Size);
+		}
+
+		uint32 Random = 7;
+		int32 NumIntact = 0;
+		while (Ptrs.Size() > 0)
+		{
+			const int32 Index = NextRandom(Random) % Ptrs.Size();
+			Memory::FreeLarge(Ptrs[Index]);
+			Ptrs.RemoveAtSwap(Index);
+			Sizes.RemoveAtSwap(Index);
+
+			bool bIntact = true;
+			for (int32 i = 0; i < Ptrs.Size(); i += 17)
+			{
+				bIntact = bIntact && MallocLarge::GetAllocSize(Ptrs[i]) >= Sizes[i] && Ptrs[i][Sizes[i] - 1] == 0xCD;
+			}
+			NumIntact += bIntact ? 1 : 0;
+		}
+		TEST_CHECK(NumIntact == NumAllocs);
+	}
+
+	/** Fills an array on the scratch arena of the pool thread running it and records where it landed. */
+	class ScratchJob : public QueuedWork
+	{
+	public:
+		struct Result
+		{
+			MemoryPool* pPool = nullptr;
+			int32* pData = nullptr;
+		};
+
+	private:
+		Result* mpResult;
+		volatile int32* mpNumDone;
+
+	public:
+		ScratchJob(Result* pResult, volatile int32* pNumDone)
+			: mpResult(pResult)
+			, mpNumDone(pNumDone)
+		{
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			Array<int32, ArenaAllocator<ScratchArena>> Scratch;
+			Scratch.AddZeroed(20000);
+			mpResult->pPool = &ScratchArena::Get();
+			mpResult->pData = Scratch.Data();
+
+			PlatformAtomics::InterlockedIncrement(mpNumDone);
+			delete this;
+		}
+
+		virtual void Abandon() override
+		{
+			PlatformAtomics::InterlockedIncrement(mpNumDone);
+			delete this;
+		}
+	};
+
+	/** Pool threads and outside threads each get their own arena, and a job's allocations are released when it ends. */
+	void TestScratchArena()
+	{
+		const int32 NumThreads = 4;
+		MemoryPool* Pools[NumThreads];
+		volatile int32 NumStable = 0;
+		RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+		{
+			Pools[ThreadIndex] = &QueuedThread::GetScratchPool();
+			if (&ScratchArena::Get() == Pools[ThreadIndex])
+			{
+				PlatformAtomics::InterlockedIncrement(&NumStable);
+			}
+		});
+		TEST_CHECK(NumStable == NumThreads);
+
+		int32 NumDistinct = 0;
+		for (int32 i = 0; i < NumThreads; i++)
+		{
+			bool bDistinct = Pools[i] != &QueuedThread::GetScratchPool();
+			for (int32 j = 0; j < i; j++)
+			{
+				bDistinct = bDistinct && Pools[j] != Pools[i];
+			}
+			NumDistinct += bDistinct ? 1 : 0;
+		}
+		TEST_CHECK(NumDistinct == NumThreads);
+
+		// Every job of a single thread pool gets the same scratch memory, released by the job before it
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+		TEST_CHECK(pPool->Create(1));
+
+		const int32 NumJobs = 8;
+		ScratchJob::Result Results[NumJobs];
+		volatile int32 NumDone = 0;
+		for (int32 i = 0; i < NumJobs; i++)
+		{
+			pPool->AddQueuedWork(new ScratchJob(&Results[i], &NumDone));
+		}
+
+		while (NumDone < NumJobs)
+		{
+			WindowsProcess::Sleep(0.001f);
+		}
+		pPool->Destroy();
+
+		int32 NumSame = 0;
+		for (int32 i = 0; i < NumJobs; i++)
+		{
+			NumSame += Results[i].pData == Results[0].pData && Results[i].pPool != &QueuedThread::GetScratchPool() ? 1 : 0;
+		}
+		TEST_CHECK(NumSame == NumJobs);
+	}
+
+	enum
+	{
+		NumLiveAllocs = 1024,
+		NumAllocsPerThread = 1 << 20,
+	};
+
+	/**
+	* Times allocations of 16 to 1024 bytes, the sizes MallocBinned serves from its bins.
+	* @param NumThreads Number of threads allocating at once
+	* @param bRandomFrees If true, each allocation replaces a random live one, otherwise all the live allocations are freed in batches
+	* @return The time in milliseconds for all the threads to finish
+	*/
+	template<typename AllocatorType>
+	double TimeSmallAllocs(int32 NumThreads, bool bRandomFrees)
+	{
+		return BestTimeMs([&]()
+		{
+			RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+			{
+				void* Ptrs[NumLiveAllocs] = {};
+				uint32 State = 2654435761u * uint32(ThreadIndex + 1);
+
+				for (int32 i = 0; i < NumAllocsPerThread; i++)
+				{
+					const int32 Slot = bRandomFrees ? NextRandom(State) % NumLiveAllocs : i % NumLiveAllocs;
+					if (Ptrs[Slot] != nullptr)
+					{
+						AllocatorType::Free(Ptrs[Slot]);
+					}
+
+					const size_t Size = 16 + NextRandom(State) % 1009;
+					Ptrs[Slot] = AllocatorType::Malloc(Size);
+					*(uint8*)Ptrs[Slot] = uint8(i);
+				}
+
+				for (int32 i = 0; i < NumLiveAllocs; i++)
+				{
+					AllocatorType::Free(Ptrs[i]);
+				}
+			});
+		});
+	}
+}
+
+void TestMemory()
+{
+	TestObjectPool();
+	TestMemoryTracker();
+	TestMemoryPoolRewind();
+	TestMemoryPoolNestedMarks();
+	TestScratchArena();
+	TestArenaAllocatorArray();
+	TestArenaAllocatorSetMap();
+	TestConcurrentMemoryPool();
+	TestConcurrentMemoryPoolAlternating();
+	TestAllocLarge();
+}
+
+void BenchmarkMemory()
+{
+	const int32 ThreadCounts[] = { 1, 4 };
+	for (int32 NumThreads : ThreadCounts)
+	{
+		char Name[64];
+		snprintf(Name, sizeof(Name), "MallocBinned, FIFO frees, %i threads", NumThreads);
+		ReportTime(Name, TimeSmallAllocs<BinnedAllocator>(NumThreads, false));
+		snprintf(Name, sizeof(Name), "malloc, FIFO frees, %i threads", NumThreads);
+		ReportTime(Name, TimeSmallAllocs<SystemAllocator>(NumThreads, false));
+
+		snprintf(Name, sizeof(Name), "MallocBinned, random frees, %i threads", NumThreads);
+		ReportTime(Name, TimeSmallAllocs<BinnedAllocator>(NumThreads, true));
+		snprintf(Name, sizeof(Name), "malloc, random frees, %i threads", NumThreads);
+		ReportTime(Name, TimeSmallAllocs<SystemAllocator>(NumThreads, true));
+	}
+}
@@ -0,0 +1,216 @@
+#include "UnitTest.h"
+#include "Core/Sorting.h"
+
+#include <algorithm>
+
+using namespace EDX;
+using namespace EDX::UnitTest;
+
+namespace
+{
+	enum class SortTestColor : int8
+	{
+		Blue = -3,
+		Red = 1,
+		Green = 7,
+	};
+
+	struct KeyedItem
+	{
+		uint32 Key;
+		int32 Order;
+	};
+
+	/** Inputs known to trouble quick sorts, each filled from a xorshift seed. */
+	enum class SortInput
+	{
+		Random,
+		FewValues,
+		Sorted,
+		Reversed,
+		NearlySorted,
+		Equal,
+		Count,
+	};
+
+	void FillInput(Array<int64>& Values, int32 Num, SortInput Input, uint32 Seed)
+	{
+		Values.Clear(Num);
+		for (int32 i = 0; i < Num; i++)
+		{
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 17;
+			Seed ^= Seed << 5;
+			switch (Input)
+			{
+			case SortInput::Random:			Values.Add(int64(Seed) - 0x80000000ll); break;
+			case SortInput::FewValues:		Values.Add(Seed % 7); break;
+			case SortInput::Sorted:			Values.Add(i); break;
+			case SortInput::Reversed:		Values.Add(Num - i); break;
+			case SortInput::NearlySorted:	Values.Add(i + Seed % 16); break;
+			default:						Values.Add(42); break;
+			}
+		}
+	}
+
+	/** Sort and ParallelSort must give the same order as std::sort, whatever the shape of the input. */
+	void TestSort()
+	{
+		const int32 Sizes[] = { 0, 1, 2, 3, 15, 16, 17, 100, 129, 1000, 40000 };
+		int32 NumSorted = 0;
+		int32 NumChecks = 0;
+
+		Array<int64> Values;
+		for (int32 Num : Sizes)
+		{
+			for (int32 Input = 0; Input < int32(SortInput::Count); Input++)
+			{
+				FillInput(Values, Num, SortInput(Input), 0x1234567u + Num);
+				Array<int64> Expected(Values);
+				std::sort(Expected.Data(), Expected.Data() + Num);
+
+				Array<int64> Sorted(Values);
+				Sorted.Sort();
+				NumSorted += Sorted == Expected ? 1 : 0;
+
+				Sorted = Values;
+				Sorted.Sort([](int64 A, int64 B) { return A > B; });
+				std::reverse(Expected.Data(), Expected.Data() + Num);
+				NumSorted += Sorted == Expected ? 1 : 0;
+				NumChecks += 2;
+			}
+		}
+		TEST_CHECK(NumSorted == NumChecks);
+
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+		TEST_CHECK(pPool->Create(4));
+		for (int32 Input = 0; Input < int32(SortInput::Count); Input++)
+		{
+			FillInput(Values, 300000, SortInput(Input), 0x9E3779B9u);
+			Array<int64> Expected(Values);
+			std::sort(Expected.Data(), Expected.Data() + Expected.Size());
+
+			Values.ParallelSort();
+			TEST_CHECK(Values == Expected);
+		}
+		pPool->Destroy();
+	}
+
+	template<typename T>
+	bool RadixSortsLikeSort(Array<T> Values)
+	{
+		Array<T> Expected(Values);
+		std::sort(Expected.Data(), Expected.Data() + Expected.Size());
+		Values.RadixSort();
+		return Values == Expected;
+	}
+
+	void TestRadixSort()
+	{
+		Array<int32> Ints;
+		Array<float> Floats;
+		Array<char> Chars;
+		Array<wchar_t> WideChars;
+		Array<long> Longs;
+		Array<unsigned long> ULongs;
+		Array<bool> Bools;
+		Array<SortTestColor> Colors;
+
+		const SortTestColor AllColors[] = { SortTestColor::Green, SortTestColor::Blue, SortTestColor::Red };
+		uint32 Seed = 0x2545F491u;
+		for (int32 i = 0; i < 5000; i++)
+		{
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 17;
+			Seed ^= Seed << 5;
+			Ints.Add(int32(Seed));
+			Floats.Add(float(int32(Seed)) * 1e-6f);
+			Chars.Add(char(Seed));
+			WideChars.Add(wchar_t(Seed & 0xFFFF));
+			Longs.Add(long(int32(Seed)) * 3);
+			ULongs.Add((unsigned long)(Seed));
+			Bools.Add((Seed & 1) != 0);
+			Colors.Add(AllColors[Seed % 3]);
+		}
+
+		TEST_CHECK(RadixSortsLikeSort(Ints));
+		TEST_CHECK(RadixSortsLikeSort(Floats));
+		TEST_CHECK(RadixSortsLikeSort(Chars));
+		TEST_CHECK(RadixSortsLikeSort(WideChars));
+		TEST_CHECK(RadixSortsLikeSort(Longs));
+		TEST_CHECK(RadixSortsLikeSort(ULongs));
+		TEST_CHECK(RadixSortsLikeSort(Bools));
+		TEST_CHECK(RadixSortsLikeSort(Colors));
+
+		// Stable on keys extracted from the elements
+		Array<KeyedItem> Items;
+		for (int32 i = 0; i < 5000; i++)
+		{
+			Items.Add(KeyedItem{ uint32(Ints[i]) % 100, i });
+		}
+		RadixSort(Items.Data(), Items.Size(), [](const KeyedItem& Item) { return Item.Key; });
+
+		int32 NumOrdered = 0;
+		for (int32 i = 1; i < Items.Size(); i++)
+		{
+			const bool bOrdered = Items[i - 1].Key < Items[i].Key || (Items[i - 1].Key == Items[i].Key && Items[i - 1].Order < Items[i].Order);
+			NumOrdered += bOrdered ? 1 : 0;
+		}
+		TEST_CHECK(NumOrdered == Items.Size() - 1);
+	}
+
+	/** 62 bits Morton code like keys, the case the introsort thresholds were tuned on. */
+	void FillCodes(Array<uint64>& Codes, int32 Num)
+	{
+		uint64 Seed = 88172645463325252ull;
+		Codes.Clear(Num);
+		for (int32 i = 0; i < Num; i++)
+		{
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 7;
+			Seed ^= Seed << 17;
+			Codes.Add(Seed >> 2);
+		}
+	}
+}
+
+void TestSorting()
+{
+	TestSort();
+	TestRadixSort();
+}
+
+void BenchmarkSorting()
+{
+	const int32 Sizes[] = { 1000, 100000, 10000000 };
+	for (int32 Num : Sizes)
+	{
+		Array<uint64> Codes;
+		FillCodes(Codes, Num);
+
+		// The same number of elements is sorted at every size
+		const int32 NumRounds = 10000000 / Num;
+		Array<uint64> Work;
+		auto TimeRounds = [&](auto SortFunc)
+		{
+			return BestTimeMs([&]()
+			{
+				for (int32 Round = 0; Round < NumRounds; Round++)
+				{
+					Work = Codes;
+					SortFunc(Work.Data(), Work.Size());
+				}
+			});
+		};
+
+		char Name[64];
+		snprintf(Name, sizeof(Name), "Sort, %i codes x %i", Num, NumRounds);
+		ReportTime(Name, TimeRounds([](uint64* pData, int32 Size) { Sort(pData, Size); }));
+
+		snprintf(Name, sizeof(Name), "std::sort, %i codes x %i", Num, NumRounds);
+		ReportTime(Name, TimeRounds([](uint64* pData, int32 Size) { std::sort(pData, pData + Size); }));
+
+		snprintf(Name, sizeof(Name), "RadixSort, %i codes x %i", Num, NumRounds);
+		ReportTime(Name, TimeRounds([](uint64* pData, int32 Size) { RadixSort(pData, Size); }));
+	}
+}
@@ -0,0 +1,451 @@
+#include "UnitTest.h"
+#include "Containers/Name.h"
+#include "Containers/StringFormat.h"
+#include "Core/MemoryTracker.h"
+
+#include <string>
+
+using namespace EDX;
+using namespace EDX::UnitTest;
+
+namespace
+{
+	/** Labels short enough to be stored inline, the common case for names and keys. */
+	const TCHAR* const ShortLabels[] = {
+		EDX_TEXT("Diffuse"), EDX_TEXT("Normal"), EDX_TEXT("Roughness"), EDX_TEXT("Metallic"),
+		EDX_TEXT("Emissive"), EDX_TEXT("Opacity"), EDX_TEXT("Specular"), EDX_TEXT("AO"),
+	};
+
+	__forceinline bool IsStoredInline(const String& Str)
+	{
+		const uint8* pChars = (const uint8*)Str.GetCharArray().Data();
+		return pChars >= (const uint8*)&Str && pChars < (const uint8*)(&Str + 1);
+	}
+
+	/** Short strings live inside the object, longer ones spill to the heap and come back once shrunk. */
+	void TestInlineStrings()
+	{
+		String Short(EDX_TEXT("Roughness"));
+		TEST_CHECK(IsStoredInline(Short));
+
+		String Copy(Short);
+		TEST_CHECK(IsStoredInline(Copy) && Copy == Short);
+
+		String Moved(Move(Copy));
+		TEST_CHECK(IsStoredInline(Moved) && Moved == Short);
+
+		const int32 MaxInlineLen = String::NumInlineChars - 1;
+		String Long = Short;
+		while (Long.Len() <= MaxInlineLen)
+		{
+			Long += Short;
+		}
+		TEST_CHECK(!IsStoredInline(Long));
+		TEST_CHECK(Long.Left(Short.Len()) == Short);
+
+		String::DataType& Chars = Long.GetCharArray();
+		Chars.RemoveAt(Short.Len(), Chars.Size() - 1 - Short.Len());
+		Long.Shrink();
+		TEST_CHECK(IsStoredInline(Long) && Long == Short);
+
+		String Concat = Short + EDX_TEXT("Map");
+		TEST_CHECK(IsStoredInline(Concat) && Concat == EDX_TEXT("RoughnessMap"));
+	}
+
+	/** Threads creating the same names at once must all get the same index, and the first spelling is kept. */
+	void TestNames()
+	{
+		const int32 NumThreads = 6;
+		const int32 NumNames = 3000;
+		const int32 FirstIndex = Name::GetNumNames();
+
+		Array<int32> Indices;
+		Indices.Init(0, NumThreads * NumNames);
+
+		RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+		{
+			for (int32 i = 0; i < NumNames; i++)
+			{
+				const int32 NameIndex = (i * 7 + ThreadIndex * 131) % NumNames;
+				const String Chars = String::Printf(ThreadIndex & 1 ? EDX_TEXT("UNITTESTNAME_%i") : EDX_TEXT("UnitTestName_%i"), NameIndex);
+				Indices[ThreadIndex * NumNames + NameIndex] = Name(Chars).GetIndex();
+			}
+		});
+
+		int32 NumConsistent = 0;
+		for (int32 i = 0; i < NumNames; i++)
+		{
+			bool bConsistent = Indices[i] >= FirstIndex;
+			for (int32 Thread = 1; Thread < NumThreads; Thread++)
+			{
+				bConsistent = bConsistent && Indices[Thread * NumNames + i] == Indices[i];
+			}
+			NumConsistent += bConsistent ? 1 : 0;
+		}
+		TEST_CHECK(NumConsistent == NumNames);
+		TEST_CHECK(Name::GetNumNames() == FirstIndex + NumNames);
+
+		const Name Found = Name::Find(StringView(EDX_TEXT("unittestname_42")));
+		TEST_CHECK(!Found.IsNone() && Found == Name(EDX_TEXT("UnitTestName_42")));
+		TEST_CHECK(Found.ToView() == StringView(EDX_TEXT("UnitTestName_42")) || Found.ToView() == StringView(EDX_TEXT("UNITTESTNAME_42")));
+		TEST_CHECK(Name::Find(StringView(EDX_TEXT("UnitTestName_Missing"))).IsNone());
+
+#if EDX_TRACK_MEMORY
+		// Names already in the table are found without allocating
+		MemorySnapshot Before;
+		MemoryTracker::GetSnapshot(Before);
+#endif
+
+		int32 NumFound = 0;
+		for (int32 i = 0; i < 1000; i++)
+		{
+			NumFound += Name(EDX_TEXT("UnitTestName_42")) == Found ? 1 : 0;
+			NumFound += Name::Find(StringView(EDX_TEXT("UnitTestName_Missing"))).IsNone() ? 1 : 0;
+		}
+		TEST_CHECK(NumFound == 2000);
+
+#if EDX_TRACK_MEMORY
+		MemorySnapshot After;
+		MemoryTracker::GetSnapshot(After);
+		TEST_CHECK(After.Tags[MemoryTag_Containers].NumAllocs == Before.Tags[MemoryTag_Containers].NumAllocs);
+		TEST_CHECK(After.Tags[MemoryTag_Strings].NumAllocs == Before.Tags[MemoryTag_Strings].NumAllocs);
+#endif
+	}
+
+	bool FormatsTo(const TCHAR* pExpected, const String& Formatted)
+	{
+		return Formatted == pExpected;
+	}
+
+	/** Placeholders and their options, checked against what Printf writes for the same options. */
+	void TestStringFormat()
+	{
+		TEST_CHECK(FormatsTo(EDX_TEXT("7 -42 true c abc"), StringFormat::ToString(EDX_FORMAT("{} {} {} {} {}"), 7u, -42, true, 'c', EDX_TEXT("abc"))));
+		TEST_CHECK(FormatsTo(EDX_TEXT("{7} }{"), StringFormat::ToString(EDX_FORMAT("{{{}}} }}{{"), 7)));
+		TEST_CHECK(FormatsTo(EDX_TEXT("ff BEEF ff ffffffff"), StringFormat::ToString(EDX_FORMAT("{:x} {:X} {:x} {:x}"), 255u, 0xBEEFu, int8(-1), -1)));
+		TEST_CHECK(FormatsTo(EDX_TEXT("-00042|42    |    ab|abc"), StringFormat::ToString(EDX_FORMAT("{:06}|{:<6}|{:>6}|{:.3}"), -42, 42, EDX_TEXT("ab"), EDX_TEXT("abcdef"))));
+		TEST_CHECK(FormatsTo(EDX_TEXT("-003.142 2.50 1.234500e+03"), StringFormat::ToString(EDX_FORMAT("{:08.3} {:.2} {:e}"), -3.14159, 2.5f, 1234.5)));
+		TEST_CHECK(FormatsTo(EDX_TEXT("0.1 0.1 1 -0 1e22 1.5e-7 5e-324 nan -inf"), StringFormat::ToString(EDX_FORMAT("{} {} {} {} {} {} {} {} {}"),
+			0.1, 0.1f, 1.0, -0.0, 1e22, 1.5e-7, 5e-324, std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::infinity())));
+
+		// Fixed precision is correctly rounded, as Printf is
+		int32 NumMatches = 0;
+		uint32 Seed = 0x6C078965u;
+		for (int32 i = 0; i < 2000; i++)
+		{
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 17;
+			Seed ^= Seed << 5;
+			const double Value = double(int32(Seed)) / double(1 << (Seed & 15));
+			const int32 Precision = int32(Seed >> 28) % 10;
+			const String Format = String::Printf(EDX_TEXT("{:.%i}"), Precision);
+			NumMatches += StringFormat::ToString(Format, Value) == String::Printf(EDX_TEXT("%.*f"), Precision, Value) ? 1 : 0;
+		}
+		TEST_CHECK(NumMatches == 2000);
+
+		// A name is written by its FormatValue overload, padding included
+		const Name Material(EDX_TEXT("Roughness"));
+		TEST_CHECK(FormatsTo(EDX_TEXT("[Roughness  ]"), StringFormat::ToString(EDX_FORMAT("[{:<11}]"), Material)));
+
+		// Buffers drop what doesn't fit but stay terminated, Strings grow past the scratch buffer
+		TCHAR Small[8];
+		TEST_CHECK(StringFormat::ToBuffer(Small, 8, EDX_FORMAT("{}-{}"), 123456, 789) == 7 && FormatsTo(EDX_TEXT("123456-"), String(Small)));
+
+		String Long;
+		StringFormat::Append(Long, EDX_FORMAT("{:>300}|{}"), EDX_TEXT("x"), Material);
+		TEST_CHECK(Long.Len() == 310 && Long[298] == ' ' && Long[299] == 'x' && Long.Right(10) == EDX_TEXT("|Roughness"));
+
+		// Format strings built at run time are checked when formatting instead
+		const String RuntimeFormat(EDX_TEXT("{}/{}"));
+		TEST_CHECK(FormatsTo(EDX_TEXT("1/2"), StringFormat::ToString(RuntimeFormat, 1, 2)));
+	}
+
+	/** The shortest digits of a float or a double read back to the exact same bits. */
+	void TestShortestRoundTrip()
+	{
+		int32 NumDoubles = 0;
+		int32 NumFloats = 0;
+		uint64 Seed = 88172645463325252ull;
+		TCHAR Buffer[64];
+		for (int32 i = 0; i < 100000; i++)
+		{
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 7;
+			Seed ^= Seed << 17;
+
+			// Random bits cover every exponent, those of infinities and NaNs are cleared
+			const uint64 DoubleBits = Seed & ~(uint64(1) << 62);
+			double Double;
+			Memory::Memcpy(&Double, &DoubleBits, sizeof(Double));
+			StringFormat::ToBuffer(Buffer, 64, EDX_FORMAT("{}"), Double);
+			const double ReadDouble = CString::Atod(Buffer);
+			NumDoubles += Memory::Memcmp(&ReadDouble, &Double, sizeof(Double)) == 0 ? 1 : 0;
+
+			const uint32 FloatBits = uint32(Seed >> 32) & ~(1u << 30);
+			float Float;
+			Memory::Memcpy(&Float, &FloatBits, sizeof(Float));
+			StringFormat::ToBuffer(Buffer, 64, EDX_FORMAT("{}"), Float);
+			const float ReadFloat = CString::Atof(Buffer);
+			NumFloats += Memory::Memcmp(&ReadFloat, &Float, sizeof(Float)) == 0 ? 1 : 0;
+		}
+		TEST_CHECK(NumDoubles == 100000);
+		TEST_CHECK(NumFloats == 100000);
+	}
+
+	__forceinline bool ViewsEqual(const Array<StringView>& Views, std::initializer_list<const TCHAR*> Expected)
+	{
+		if (Views.Size() != int32(Expected.size()))
+		{
+			return false;
+		}
+
+		int32 Index = 0;
+		for (const TCHAR* pExpected : Expected)
+		{
+			if (!Views[Index++].Equals(StringView(pExpected), ESearchCase::CaseSensitive))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Searches honor the case, the direction and the start position, trimming and splitting never copy. */
+	void TestStringViewSearch()
+	{
+		const StringView Path(EDX_TEXT("Textures/Wood/Oak.Diffuse.png"));
+		TEST_CHECK(Path.Find(EDX_TEXT("/")) == 8);
+		TEST_CHECK(Path.Find(EDX_TEXT("/"), ESearchCase::IgnoreCase, ESearchDir::FromEnd) == 13);
+		TEST_CHECK(Path.Find(EDX_TEXT("/"), ESearchCase::IgnoreCase, ESearchDir::FromStart, 9) == 13);
+		TEST_CHECK(Path.Find(EDX_TEXT("."), ESearchCase::IgnoreCase, ESearchDir::FromEnd, 25) == 17);
+		TEST_CHECK(Path.Find(EDX_TEXT("wood")) == 9);
+		TEST_CHECK(Path.Find(EDX_TEXT("wood"), ESearchCase::CaseSensitive) == INDEX_NONE);
+		TEST_CHECK(Path.Find(EDX_TEXT("png.")) == INDEX_NONE);
+		TEST_CHECK(Path.Find(Path) == 0 && StringView(EDX_TEXT("ab")).Find(EDX_TEXT("abc")) == INDEX_NONE);
+
+		// A view into the middle of a buffer doesn't see past its end
+		const StringView Middle = Path.Mid(9, 4);
+		TEST_CHECK(Middle.Equals(EDX_TEXT("Wood"), ESearchCase::CaseSensitive));
+		TEST_CHECK(Middle.Find(EDX_TEXT("d/")) == INDEX_NONE);
+		TEST_CHECK(Path.Mid(100).IsEmpty() && Path.Left(-1).IsEmpty() && Path.Right(100) == Path);
+
+		TEST_CHECK(Path.StartsWith(EDX_TEXT("textures")) && !Path.StartsWith(EDX_TEXT("textures"), ESearchCase::CaseSensitive));
+		TEST_CHECK(Path.EndsWith(EDX_TEXT(".PNG")) && !Path.EndsWith(EDX_TEXT(".PNG"), ESearchCase::CaseSensitive));
+		TEST_CHECK(Middle.StartsWith(EDX_TEXT("")) && !Middle.StartsWith(EDX_TEXT("Wood/")));
+
+		const StringView Padded(EDX_TEXT(" \t Oak \r\n"));
+		TEST_CHECK(Padded.Trim().Equals(EDX_TEXT("Oak"), ESearchCase::CaseSensitive) && Padded.Trim().Data() == Padded.Data() + 3);
+		TEST_CHECK(Padded.TrimStart().Equals(EDX_TEXT("Oak \r\n")));
+		TEST_CHECK(Padded.TrimEnd().Equals(EDX_TEXT(" \t Oak")));
+		TEST_CHECK(StringView(EDX_TEXT(" \t ")).Trim().IsEmpty());
+
+		StringView Dir;
+		StringView File;
+		TEST_CHECK(Path.Split(EDX_TEXT("/"), &Dir, &File, ESearchCase::IgnoreCase, ESearchDir::FromEnd));
+		TEST_CHECK(Dir.Equals(EDX_TEXT("Textures/Wood")) && File.Equals(EDX_TEXT("Oak.Diffuse.png")));
+
+		StringView Stem;
+		StringView Extension;
+		TEST_CHECK(File.Split(EDX_TEXT("."), &Stem, &Extension));
+		TEST_CHECK(Stem.Equals(EDX_TEXT("Oak")) && Extension.Equals(EDX_TEXT("Diffuse.png")));
+
+		// A failed split leaves the outputs untouched
+		TEST_CHECK(!File.Split(EDX_TEXT("\\"), &Stem, &Extension));
+		TEST_CHECK(Stem.Equals(EDX_TEXT("Oak")) && Extension.Equals(EDX_TEXT("Diffuse.png")));
+	}
+
+	/** Pieces between delimiters, with and without the empty ones. */
+	void TestStringViewParseIntoArray()
+	{
+		Array<StringView> Pieces;
+
+		const StringView List(EDX_TEXT("a,,b,c,"));
+		TEST_CHECK(List.ParseIntoArray(Pieces, EDX_TEXT(",")) == 3 && ViewsEqual(Pieces, { EDX_TEXT("a"), EDX_TEXT("b"), EDX_TEXT("c") }));
+		TEST_CHECK(List.ParseIntoArray(Pieces, EDX_TEXT(","), false) == 5 && ViewsEqual(Pieces, { EDX_TEXT("a"), EDX_TEXT(""), EDX_TEXT("b"), EDX_TEXT("c"), EDX_TEXT("") }));
+		TEST_CHECK(List.ParseIntoArray(Pieces, EDX_TEXT(",,")) == 2 && ViewsEqual(Pieces, { EDX_TEXT("a"), EDX_TEXT("b,c,") }));
+		TEST_CHECK(List.ParseIntoArray(Pieces, EDX_TEXT("")) == 1 && ViewsEqual(Pieces, { EDX_TEXT("a,,b,c,") }));
+		TEST_CHECK(StringView().ParseIntoArray(Pieces, EDX_TEXT(",")) == 0);
+		TEST_CHECK(StringView().ParseIntoArray(Pieces, EDX_TEXT(","), false) == 1 && Pieces[0].IsEmpty());
+
+		// Pieces point into the viewed characters
+		TEST_CHECK(List.ParseIntoArray(Pieces, EDX_TEXT(",")) == 3 && Pieces[1].Data() == List.Data() + 3);
+
+		const StringView Words(EDX_TEXT("  x\t y,z\r\n,  w "));
+		TEST_CHECK(Words.ParseIntoArrayWS(Pieces) == 4 && ViewsEqual(Pieces, { EDX_TEXT("x"), EDX_TEXT("y,z"), EDX_TEXT(","), EDX_TEXT("w") }));
+		TEST_CHECK(Words.ParseIntoArrayWS(Pieces, EDX_TEXT(",")) == 4 && ViewsEqual(Pieces, { EDX_TEXT("x"), EDX_TEXT("y"), EDX_TEXT("z"), EDX_TEXT("w") }));
+
+		const StringView Lines(EDX_TEXT("one\r\ntwo\n\nthree\rfour\r\n"));
+		TEST_CHECK(Lines.ParseIntoArrayLines(Pieces) == 4 && ViewsEqual(Pieces, { EDX_TEXT("one"), EDX_TEXT("two"), EDX_TEXT("three"), EDX_TEXT("four") }));
+		TEST_CHECK(Lines.ParseIntoArrayLines(Pieces, false) == 6 && ViewsEqual(Pieces, { EDX_TEXT("one"), EDX_TEXT("two"), EDX_TEXT(""), EDX_TEXT("three"), EDX_TEXT("four"), EDX_TEXT("") }));
+	}
+
+	/** Integers parse up to the limits of their type and fail one past them, failures leave the output alone. */
+	void TestStringViewParseInt()
+	{
+		int32 Int32 = 7;
+		TEST_CHECK(StringView(EDX_TEXT("2147483647")).ParseInt(Int32) && Int32 == 2147483647);
+		TEST_CHECK(StringView(EDX_TEXT("-2147483648")).ParseInt(Int32) && Int32 == int32(0x80000000));
+		TEST_CHECK(StringView(EDX_TEXT("+42")).ParseInt(Int32) && Int32 == 42);
+		TEST_CHECK(StringView(EDX_TEXT("-0")).ParseInt(Int32) && Int32 == 0);
+
+		Int32 = 7;
+		const TCHAR* const BadInt32[] =
+		{
+			EDX_TEXT("2147483648"), EDX_TEXT("-2147483649"), EDX_TEXT("99999999999"), EDX_TEXT(""), EDX_TEXT("-"),
+			EDX_TEXT("+"), EDX_TEXT(" 1"), EDX_TEXT("1 "), EDX_TEXT("1a"), EDX_TEXT("--1"), EDX_TEXT("1.0"),
+		};
+		int32 NumRejected = 0;
+		for (const TCHAR* pText : BadInt32)
+		{
+			NumRejected += !StringView(pText).ParseInt(Int32) && Int32 == 7 ? 1 : 0;
+		}
+		TEST_CHECK(NumRejected == int32(ARRAY_COUNT(BadInt32)));
+
+		int64 Int64 = 0;
+		TEST_CHECK(StringView(EDX_TEXT("9223372036854775807")).ParseInt(Int64) && Int64 == 9223372036854775807ll);
+		TEST_CHECK(StringView(EDX_TEXT("-9223372036854775808")).ParseInt(Int64) && Int64 == int64(0x8000000000000000ull));
+		TEST_CHECK(!StringView(EDX_TEXT("9223372036854775808")).ParseInt(Int64));
+		TEST_CHECK(!StringView(EDX_TEXT("-9223372036854775809")).ParseInt(Int64));
+
+		uint32 UInt32 = 0;
+		TEST_CHECK(StringView(EDX_TEXT("4294967295")).ParseInt(UInt32) && UInt32 == 0xffffffff);
+		TEST_CHECK(!StringView(EDX_TEXT("4294967296")).ParseInt(UInt32));
+		TEST_CHECK(!StringView(EDX_TEXT("-1")).ParseInt(UInt32));
+
+		uint64 UInt64 = 0;
+		TEST_CHECK(StringView(EDX_TEXT("18446744073709551615")).ParseInt(UInt64) && UInt64 == 0xffffffffffffffffull);
+		TEST_CHECK(!StringView(EDX_TEXT("18446744073709551616")).ParseInt(UInt64));
+		TEST_CHECK(!StringView(EDX_TEXT("100000000000000000000")).ParseInt(UInt64));
+
+		// Only the viewed digits count
+		TEST_CHECK(StringView(EDX_TEXT("12345"), 3).ParseInt(Int32) && Int32 == 123);
+	}
+
+	/** Float literals are validated before conversion, floats are rounded once from the digits. */
+	void TestStringViewParseFloat()
+	{
+		const TCHAR* const Valid[] =
+		{
+			EDX_TEXT("1"), EDX_TEXT("-1.5"), EDX_TEXT(".5"), EDX_TEXT("5."), EDX_TEXT("1e10"), EDX_TEXT("1E-3"), EDX_TEXT("+2.5e+2"), EDX_TEXT("-0.0"),
+		};
+		const double Values[] = { 1.0, -1.5, 0.5, 5.0, 1e10, 1e-3, 250.0, 0.0 };
+
+		int32 NumParsed = 0;
+		for (int32 i = 0; i < int32(ARRAY_COUNT(Valid)); i++)
+		{
+			double Double = 0.0;
+			float Float = 0.0f;
+			NumParsed += StringView(Valid[i]).ParseFloat(Double) && StringView(Valid[i]).ParseFloat(Float) &&
+				Double == Values[i] && Float == float(Values[i]) ? 1 : 0;
+		}
+		TEST_CHECK(NumParsed == int32(ARRAY_COUNT(Valid)));
+
+		const TCHAR* const Invalid[] =
+		{
+			EDX_TEXT(""), EDX_TEXT("."), EDX_TEXT("-"), EDX_TEXT("e5"), EDX_TEXT("1e"), EDX_TEXT("1e+"), EDX_TEXT("1.5f"), EDX_TEXT(" 1"),
+			EDX_TEXT("1 "), EDX_TEXT("--1"), EDX_TEXT("1..2"), EDX_TEXT("inf"), EDX_TEXT("nan"), EDX_TEXT("0x10"), EDX_TEXT("1e5.0"),
+		};
+		int32 NumRejected = 0;
+		for (const TCHAR* pText : Invalid)
+		{
+			double Double = 3.0;
+			float Float = 3.0f;
+			NumRejected += !StringView(pText).ParseFloat(Double) && !StringView(pText).ParseFloat(Float) && Double == 3.0 && Float == 3.0f ? 1 : 0;
+		}
+		TEST_CHECK(NumRejected == int32(ARRAY_COUNT(Invalid)));
+
+		// Just above halfway between 1 and the next float: through a double it lands on the halfway
+		// point and then rounds to even, 1.0
+		float Float = 0.0f;
+		TEST_CHECK(StringView(EDX_TEXT("1.00000005960464477550")).ParseFloat(Float) && Float == 1.00000011920928955078125f);
+
+		// The view isn't null terminated, and literals longer than the inline buffer take the slow path
+		double Double = 0.0;
+		TEST_CHECK(StringView(EDX_TEXT("3.25xyz"), 4).ParseFloat(Double) && Double == 3.25);
+
+		String Long(EDX_TEXT("0."));
+		for (int32 i = 0; i < 80; i++)
+		{
+			Long += EDX_TEXT("0");
+		}
+		Long += EDX_TEXT("1e81");
+		TEST_CHECK(StringView(Long).ParseFloat(Double) && Double == 1.0);
+	}
+
+	/**
+	* Times NumOps operations on the short labels.
+	* @param Body Called with the index of the label to use
+	*/
+	template<typename FuncType>
+	double TimeLabelOps(int32 NumOps, const FuncType& Body)
+	{
+		return BestTimeMs([&]()
+		{
+			for (int32 i = 0; i < NumOps; i++)
+			{
+				Body(i & 7);
+			}
+		});
+	}
+}
+
+void TestStrings()
+{
+	TestInlineStrings();
+	TestNames();
+	TestStringFormat();
+	TestShortestRoundTrip();
+	TestStringViewSearch();
+	TestStringViewParseIntoArray();
+	TestStringViewParseInt();
+	TestStringViewParseFloat();
+}
+
+void BenchmarkStrings()
+{
+	typedef std::basic_string<TCHAR> StdString;
+	const int32 NumOps = 2000000;
+
+	String Labels[8];
+	StdString StdLabels[8];
+	for (int32 i = 0; i < 8; i++)
+	{
+		Labels[i] = ShortLabels[i];
+		StdLabels[i] = ShortLabels[i];
+	}
+
+	uint64 Sum = 0;
+	ReportTime("String, construct 2M short", TimeLabelOps(NumOps, [&](int32 i) { String Str(ShortLabels[i]); Sum += Str.Len(); }));
+	ReportTime("std::basic_string, construct 2M short", TimeLabelOps(NumOps, [&](int32 i) { StdString Str(ShortLabels[i]); Sum += Str.size(); }));
+
+	ReportTime("String, copy 2M short", TimeLabelOps(NumOps, [&](int32 i) { String Str(Labels[i]); Sum += Str.Len(); }));
+	ReportTime("std::basic_string, copy 2M short", TimeLabelOps(NumOps, [&](int32 i) { StdString Str(StdLabels[i]); Sum += Str.size(); }));
+
+	ReportTime("String, concat 2M short", TimeLabelOps(NumOps, [&](int32 i) { String Str = Labels[i] + Labels[(i + 1) & 7]; Sum += Str.Len(); }));
+	ReportTime("std::basic_string, concat 2M short", TimeLabelOps(NumOps, [&](int32 i) { StdString Str = StdLabels[i] + StdLabels[(i + 1) & 7]; Sum += Str.size(); }));
+
+	// A typical log line, then doubles alone where the shortest digits replace "%.17g"
+	const int32 NumFormats = 200000;
+	TCHAR Buffer[128];
+	ReportTime("StringFormat::ToBuffer, 200K log lines", BestTimeMs([&]() { for (int32 i = 0; i < NumFormats; i++) { Sum += StringFormat::ToBuffer(Buffer, 128, EDX_FORMAT("Frame {}: {:f} ms, {}"), i, i * 0.37, ShortLabels[i & 7]); } }));
+	ReportTime("StringFormat::ToString, 200K log lines", BestTimeMs([&]() { for (int32 i = 0; i < NumFormats; i++) { Sum += StringFormat::ToString(EDX_FORMAT("Frame {}: {:f} ms, {}"), i, i * 0.37, ShortLabels[i & 7]).Len(); } }));
+	ReportTime("String::Printf, 200K log lines", BestTimeMs([&]() { for (int32 i = 0; i < NumFormats; i++) { Sum += String::Printf(EDX_TEXT("Frame %i: %f ms, %s"), i, i * 0.37, ShortLabels[i & 7]).Len(); } }));
+
+	Array<double> Doubles;
+	uint64 Seed = 88172645463325252ull;
+	for (int32 i = 0; i < 1024; i++)
+	{
+		Seed ^= Seed << 13;
+		Seed ^= Seed >> 7;
+		Seed ^= Seed << 17;
+
+		// Random significands with exponents between 2^-60 and 2^60
+		const uint64 Bits = (Seed >> 12) | (uint64(1023 - 60 + Seed % 120) << 52);
+		double Value;
+		Memory::Memcpy(&Value, &Bits, sizeof(Value));
+		Doubles.Add(Value);
+	}
+	ReportTime("StringFormat::ToBuffer, 200K shortest doubles", BestTimeMs([&]() { for (int32 i = 0; i < NumFormats; i++) { Sum += StringFormat::ToBuffer(Buffer, 128, EDX_FORMAT("{}"), Doubles[i & 1023]); } }));
+	ReportTime("Snprintf %.17g, 200K doubles", BestTimeMs([&]() { for (int32 i = 0; i < NumFormats; i++) { Sum += CString::Snprintf(Buffer, 128, EDX_TEXT("%.17g"), Doubles[i & 1023]); } }));
+	DoNotOptimize(Sum);
+}
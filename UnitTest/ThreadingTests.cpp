@@ -0,0 +1,1059 @@
+#include "UnitTest.h"
+#include "Windows/Threading.h"
+#include "Core/Parallel.h"
+#include "Core/TaskGraph.h"
+#include "Core/MemoryTracker.h"
+
+#include <mutex>
+#include <condition_variable>
+
+using namespace EDX;
+using namespace EDX::UnitTest;
+
+namespace
+{
+	/** Counts its runs and queues Fanout children from the pool thread running it, until Depth reaches 0. */
+	class TreeWork : public QueuedWork
+	{
+	private:
+		volatile int32* mpNumRuns;
+		int32 mDepth;
+		int32 mFanout;
+
+	public:
+		TreeWork(volatile int32* pNumRuns, int32 Depth, int32 Fanout)
+			: mpNumRuns(pNumRuns)
+			, mDepth(Depth)
+			, mFanout(Fanout)
+		{
+		}
+
+		/** @return Number of jobs in a tree, root included. */
+		static int32 TreeSize(int32 Depth, int32 Fanout)
+		{
+			return Depth == 0 ? 1 : 1 + Fanout * TreeSize(Depth - 1, Fanout);
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			for (int32 i = 0; i < (mDepth > 0 ? mFanout : 0); i++)
+			{
+				QueuedThreadPool::Instance()->AddQueuedWork(new TreeWork(mpNumRuns, mDepth - 1, mFanout));
+			}
+
+			PlatformAtomics::InterlockedIncrement(mpNumRuns);
+			delete this;
+		}
+
+		virtual void Abandon() override
+		{
+			delete this;
+		}
+	};
+
+	/** Sleeps, keeping the only thread of a pool busy while more jobs queue up behind it. */
+	class CountingWork : public QueuedWork
+	{
+	private:
+		volatile int32* mpNumRuns;
+		volatile int32* mpNumAbandoned;
+		float mSleepSeconds;
+
+	public:
+		CountingWork(volatile int32* pNumRuns, volatile int32* pNumAbandoned, float SleepSeconds)
+			: mpNumRuns(pNumRuns)
+			, mpNumAbandoned(pNumAbandoned)
+			, mSleepSeconds(SleepSeconds)
+		{
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			if (mSleepSeconds > 0.0f)
+			{
+				WindowsProcess::Sleep(mSleepSeconds);
+			}
+
+			PlatformAtomics::InterlockedIncrement(mpNumRuns);
+			delete this;
+		}
+
+		virtual void Abandon() override
+		{
+			PlatformAtomics::InterlockedIncrement(mpNumAbandoned);
+			delete this;
+		}
+	};
+
+	/** Creates and destroys the pool repeatedly, new threads look for work to steal as soon as they start. */
+	void TestQueuedThreadPool(bool bWorkStealing)
+	{
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+
+		for (int32 Round = 0; Round < 20; Round++)
+		{
+			TEST_CHECK(pPool->Create(4, 0, TPri_Normal, bWorkStealing));
+			TEST_CHECK(pPool->GetNumThreads() == 4);
+			TEST_CHECK(pPool->IsWorkStealing() == bWorkStealing);
+
+			const int32 NumRoots = 16;
+			volatile int32 NumRuns = 0;
+			for (int32 i = 0; i < NumRoots; i++)
+			{
+				pPool->AddQueuedWork(new TreeWork(&NumRuns, 3, 4));
+			}
+
+			pPool->JoinAllThreads();
+			TEST_CHECK(NumRuns == NumRoots * TreeWork::TreeSize(3, 4));
+			TEST_CHECK(pPool->GetNumQueuedJobs() == 0);
+
+			pPool->Destroy();
+		}
+	}
+
+	/** Jobs still queued when the pool is destroyed are abandoned, and leave the counters of the pool at zero. */
+	void TestQueuedThreadPoolAbandon()
+	{
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+
+		const int32 NumJobs = 64;
+		volatile int32 NumRuns = 0;
+		volatile int32 NumAbandoned = 0;
+
+		TEST_CHECK(pPool->Create(1));
+		TEST_CHECK(!pPool->IsWorkStealing());
+		pPool->AddQueuedWork(new CountingWork(&NumRuns, &NumAbandoned, 0.05f));
+		for (int32 i = 1; i < NumJobs; i++)
+		{
+			pPool->AddQueuedWork(new CountingWork(&NumRuns, &NumAbandoned, 0.0f));
+		}
+
+		pPool->Destroy();
+		TEST_CHECK(NumAbandoned > 0);
+		TEST_CHECK(NumRuns + NumAbandoned == NumJobs);
+		TEST_CHECK(pPool->GetNumQueuedJobs() == 0);
+
+		// An outside thread may split work only while the shared queues are empty, which needs an exact count
+		TEST_CHECK(pPool->Create(2, 0, TPri_Normal, true));
+		TEST_CHECK(pPool->ShouldSplitWork());
+		pPool->Destroy();
+	}
+
+	void TestBoundedQueue()
+	{
+		BoundedQueue<int32> Queue(6);
+		TEST_CHECK(Queue.GetCapacity() == 8);
+		TEST_CHECK(Queue.IsEmpty());
+
+		// Several laps around the ring, full and empty queues must be detected at any position
+		int32 Item = -1;
+		for (int32 Lap = 0; Lap < 5; Lap++)
+		{
+			for (int32 i = 0; i < 8; i++)
+			{
+				TEST_CHECK(Queue.Enqueue(Lap * 8 + i));
+			}
+			TEST_CHECK(!Queue.Enqueue(-1));
+
+			for (int32 i = 0; i < 5; i++)
+			{
+				TEST_CHECK(Queue.Dequeue(Item) && Item == Lap * 8 + i);
+			}
+
+			const int32 Refill[3] = { -2, -3, -4 };
+			TEST_CHECK(Queue.EnqueueBatch(Refill, 3) == 3);
+			TEST_CHECK(Queue.EnqueueBatch(Refill, 3) == 2);
+			TEST_CHECK(Queue.EnqueueBatch(Refill, 3) == 0);
+
+			int32 Drained[16];
+			TEST_CHECK(Queue.DequeueBatch(Drained, 16) == 8);
+			TEST_CHECK(Drained[0] == Lap * 8 + 5 && Drained[2] == Lap * 8 + 7 && Drained[3] == -2 && Drained[5] == -4 && Drained[7] == -3);
+			TEST_CHECK(!Queue.Dequeue(Item));
+		}
+	}
+
+	/** Each item must be dequeued exactly once, and the items of one producer in the order it queued them. */
+	void TestBoundedQueueConcurrent()
+	{
+		const int32 NumProducers = 4;
+		const int32 NumConsumers = 4;
+		const int32 ItemsPerProducer = 50000;
+
+		BoundedQueue<int32> Queue(256);
+		Array<uint8> Seen;
+		Seen.Init(0, NumProducers * ItemsPerProducer);
+		volatile int32 NumConsumed = 0;
+		volatile int32 NumOrderErrors = 0;
+
+		RunOnThreads(NumProducers + NumConsumers, [&](int32 ThreadIndex)
+		{
+			if (ThreadIndex < NumProducers)
+			{
+				for (int32 i = 0; i < ItemsPerProducer; i++)
+				{
+					while (!Queue.Enqueue(ThreadIndex * ItemsPerProducer + i))
+					{
+						WindowsProcess::Sleep(0.0f);
+					}
+				}
+				return;
+			}
+
+			int32 LastSeen[NumProducers] = { -1, -1, -1, -1 };
+			int32 Item;
+			while (NumConsumed < NumProducers * ItemsPerProducer)
+			{
+				if (Queue.Dequeue(Item))
+				{
+					const int32 Producer = Item / ItemsPerProducer;
+					if (Item <= LastSeen[Producer])
+					{
+						PlatformAtomics::InterlockedIncrement(&NumOrderErrors);
+					}
+					LastSeen[Producer] = Item;
+
+					Seen[Item]++;
+					PlatformAtomics::InterlockedIncrement(&NumConsumed);
+				}
+				else
+				{
+					WindowsProcess::Sleep(0.0f);
+				}
+			}
+		});
+
+		TEST_CHECK(NumOrderErrors == 0);
+		TEST_CHECK(NumConsumed == NumProducers * ItemsPerProducer);
+
+		int32 NumSeenOnce = 0;
+		for (int32 i = 0; i < Seen.Size(); i++)
+		{
+			NumSeenOnce += Seen[i] == 1 ? 1 : 0;
+		}
+		TEST_CHECK(NumSeenOnce == NumProducers * ItemsPerProducer);
+		TEST_CHECK(Queue.IsEmpty());
+	}
+
+	/** Every index of the range must be visited exactly once, whatever the grain and the length of the range. */
+	void TestParallelForRanges()
+	{
+		const int32 Ranges[][2] = { { 0, 0 }, { 5, 5 }, { 10, 3 }, { 0, 1 }, { -7, -5 }, { 0, 3 }, { -1000, 1000 }, { 0, 100000 } };
+		const int32 Grains[] = { 0, 1, 7, 100000 };
+
+		int32 NumCovered = 0;
+		int32 NumChecks = 0;
+		for (const auto& Range : Ranges)
+		{
+			const int32 Begin = Range[0];
+			const int32 End = Range[1];
+			for (int32 Grain : Grains)
+			{
+				Array<int32> Visits;
+				Visits.Init(0, Math::Max(End - Begin, 0));
+				volatile int32 NumOutside = 0;
+
+				ParallelFor(Begin, End, Grain, [&](int32 i)
+				{
+					if (i < Begin || i >= End)
+					{
+						PlatformAtomics::InterlockedIncrement(&NumOutside);
+						return;
+					}
+					PlatformAtomics::InterlockedIncrement((volatile int32*)&Visits[i - Begin]);
+				});
+
+				bool bCovered = NumOutside == 0;
+				for (int32 i = 0; i < Visits.Size(); i++)
+				{
+					bCovered = bCovered && Visits[i] == 1;
+				}
+				NumCovered += bCovered ? 1 : 0;
+				NumChecks++;
+			}
+		}
+		TEST_CHECK(NumCovered == NumChecks);
+	}
+
+	/** Sub range of a reduction, merging only with the sub range right after it. */
+	struct Span
+	{
+		int32 Begin;
+		int32 End;
+		bool bValid;
+	};
+
+	void TestParallelReduceResults()
+	{
+		auto SumSquares = [](int32 Begin, int32 End, int64 Sum)
+		{
+			for (int32 i = Begin; i < End; i++)
+			{
+				Sum += int64(i) * i;
+			}
+			return Sum;
+		};
+		auto Add = [](int64 A, int64 B) { return A + B; };
+
+		const int64 N = 200000;
+		TEST_CHECK(ParallelReduce(0, int32(N), 0, int64(0), SumSquares, Add) == (N - 1) * N * (2 * N - 1) / 6);
+		TEST_CHECK(ParallelReduce(0, int32(N), 1, int64(0), SumSquares, Add) == (N - 1) * N * (2 * N - 1) / 6);
+		TEST_CHECK(ParallelReduce(0, 0, 0, int64(-1), SumSquares, Add) == -1);
+		TEST_CHECK(ParallelReduce(9, 3, 0, int64(-1), SumSquares, Add) == -1);
+		TEST_CHECK(ParallelReduce(4, 5, 1, int64(0), SumSquares, Add) == 16);
+
+		// Partial results are combined in index order, the reduction only needs to be associative
+		const Span Empty = { 0, 0, true };
+		auto Extend = [](int32 Begin, int32 End, Span Value)
+		{
+			const Span Result = { Value.Begin == Value.End ? Begin : Value.Begin, End, Value.bValid && (Value.Begin == Value.End || Value.End == Begin) };
+			return Result;
+		};
+		auto Concat = [](Span A, Span B)
+		{
+			if (A.Begin == A.End)
+			{
+				return B;
+			}
+			if (B.Begin == B.End)
+			{
+				return A;
+			}
+			const Span Result = { A.Begin, B.End, A.bValid && B.bValid && A.End == B.Begin };
+			return Result;
+		};
+
+		const Span Whole = ParallelReduce(-5000, 50000, 3, Empty, Extend, Concat);
+		TEST_CHECK(Whole.bValid && Whole.Begin == -5000 && Whole.End == 50000);
+	}
+
+	/** A ParallelFor running inside another one, the waiting threads run the inner jobs. */
+	void TestParallelForNested()
+	{
+		const int32 NumOuter = 64;
+		const int32 NumInner = 2000;
+		volatile int32 NumVisits = 0;
+		Array<int64> Sums;
+		Sums.Init(0, NumOuter);
+
+		ParallelFor(0, NumOuter, 1, [&](int32 Outer)
+		{
+			ParallelFor(0, NumInner, 16, [&](int32 Inner)
+			{
+				PlatformAtomics::InterlockedIncrement(&NumVisits);
+			});
+
+			Sums[Outer] = ParallelReduce(0, NumInner, 0, int64(0), [](int32 Begin, int32 End, int64 Sum)
+			{
+				for (int32 i = Begin; i < End; i++)
+				{
+					Sum += i;
+				}
+				return Sum;
+			}, [](int64 A, int64 B) { return A + B; });
+		});
+
+		TEST_CHECK(NumVisits == NumOuter * NumInner);
+
+		int32 NumCorrect = 0;
+		for (int32 Outer = 0; Outer < NumOuter; Outer++)
+		{
+			NumCorrect += Sums[Outer] == int64(NumInner - 1) * NumInner / 2 ? 1 : 0;
+		}
+		TEST_CHECK(NumCorrect == NumOuter);
+	}
+
+	/** ParallelFor and ParallelReduce on a pool of either mode, and without a pool where they run serially. */
+	void TestParallelFor()
+	{
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+		for (int32 Mode = 0; Mode < 3; Mode++)
+		{
+			if (Mode < 2)
+			{
+				TEST_CHECK(pPool->Create(4, 0, TPri_Normal, Mode == 1));
+			}
+
+			TestParallelForRanges();
+			TestParallelReduceResults();
+			TestParallelForNested();
+
+			if (Mode < 2)
+			{
+				TEST_CHECK(pPool->GetNumQueuedJobs() == 0);
+				pPool->Destroy();
+			}
+		}
+	}
+
+	/** A task runs after all its prerequisites, continuations in chain order. */
+	void TestTaskGraphDependencies()
+	{
+		volatile int32 Clock = 0;
+		int32 Stamps[4] = { -1, -1, -1, -1 };
+		auto Stamp = [&](int32 Index) { Stamps[Index] = PlatformAtomics::InterlockedIncrement(&Clock); };
+
+		Array<TaskEventRef> Prerequisites;
+		Prerequisites.Add(TaskGraph::Launch([&]() { WindowsProcess::Sleep(0.002f); Stamp(0); }));
+		Prerequisites.Add(TaskGraph::Launch([&]() { Stamp(1); }));
+		Prerequisites.Add(TaskEventRef());
+		const TaskEventRef Joined = TaskGraph::Launch([&]() { Stamp(2); }, Prerequisites);
+		const TaskEventRef Continued = TaskGraph::ContinueWith(Joined, [&]() { Stamp(3); });
+
+		TaskGraph::Wait(Continued);
+		TEST_CHECK(Joined->IsComplete() && Continued->IsComplete());
+		TEST_CHECK(Stamps[0] > 0 && Stamps[1] > 0 && Stamps[2] > Stamps[0] && Stamps[2] > Stamps[1] && Stamps[3] > Stamps[2]);
+
+		// A prerequisite which already completed doesn't hold the task back
+		volatile int32 bRan = 0;
+		TaskGraph::Wait(TaskGraph::ContinueWith(Joined, [&]() { bRan = 1; }));
+		TEST_CHECK(bRan == 1);
+
+		const int32 NumLinks = 100;
+		Array<int32> Order;
+		TaskEventRef Last = TaskGraph::Launch([&]() { Order.Add(0); });
+		for (int32 i = 1; i < NumLinks; i++)
+		{
+			Last = TaskGraph::ContinueWith(Last, [&Order, i]() { Order.Add(i); });
+		}
+		TaskGraph::Wait(Last);
+
+		int32 NumInOrder = 0;
+		for (int32 i = 0; i < Order.Size(); i++)
+		{
+			NumInOrder += Order[i] == i ? 1 : 0;
+		}
+		TEST_CHECK(Order.Size() == NumLinks && NumInOrder == NumLinks);
+	}
+
+	/** Waiting on some tasks returns while others are still held back by a prerequisite. */
+	void TestTaskGraphWaitSubset()
+	{
+		TaskEventRef Gate(new TaskEvent);
+		Array<TaskEventRef> GatePrerequisites;
+		GatePrerequisites.Add(Gate);
+
+		volatile int32 NumGated = 0;
+		Array<TaskEventRef> Gated;
+		for (int32 i = 0; i < 8; i++)
+		{
+			Gated.Add(TaskGraph::Launch([&]() { PlatformAtomics::InterlockedIncrement(&NumGated); }, GatePrerequisites));
+		}
+
+		volatile int32 NumFree = 0;
+		Array<TaskEventRef> Free;
+		for (int32 i = 0; i < 64; i++)
+		{
+			Free.Add(TaskGraph::Launch([&]() { PlatformAtomics::InterlockedIncrement(&NumFree); }));
+		}
+
+		TaskGraph::WaitAll(Free);
+		TEST_CHECK(NumFree == 64);
+		TEST_CHECK(NumGated == 0 && !Gated[0]->IsComplete());
+
+		Gate->DispatchSubsequents();
+		TaskGraph::WaitAll(Gated);
+		TEST_CHECK(NumGated == 8);
+	}
+
+	/** With the only pool thread busy, a thread waiting on tasks runs them itself. */
+	void TestTaskGraphWaiterRunsTasks()
+	{
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+		TEST_CHECK(pPool->Create(1, 0, TPri_Normal, true));
+
+		volatile int32 bBlockerStarted = 0;
+		volatile int32 bReleaseBlocker = 0;
+		const TaskEventRef Blocker = TaskGraph::Launch([&]()
+		{
+			bBlockerStarted = 1;
+			while (!bReleaseBlocker)
+			{
+				WindowsProcess::Sleep(0.0f);
+			}
+		});
+		while (!bBlockerStarted)
+		{
+			WindowsProcess::Sleep(0.0f);
+		}
+
+		volatile int32 NumOnWaiter = 0;
+		Array<TaskEventRef> Tasks;
+		for (int32 i = 0; i < 16; i++)
+		{
+			Tasks.Add(TaskGraph::Launch([&]()
+			{
+				if (QueuedThread::GetCurrent() == nullptr)
+				{
+					PlatformAtomics::InterlockedIncrement(&NumOnWaiter);
+				}
+			}));
+		}
+
+		TaskGraph::WaitAll(Tasks);
+		TEST_CHECK(NumOnWaiter == 16);
+
+		bReleaseBlocker = 1;
+		TaskGraph::Wait(Blocker);
+		pPool->Destroy();
+	}
+
+	void TestTaskGraph()
+	{
+		QueuedThreadPool* pPool = QueuedThreadPool::Instance();
+		for (int32 Mode = 0; Mode < 3; Mode++)
+		{
+			// Without a pool the tasks run as soon as they are ready, on the thread releasing them
+			if (Mode < 2)
+			{
+				TEST_CHECK(pPool->Create(4, 0, TPri_Normal, Mode == 1));
+			}
+
+			TestTaskGraphDependencies();
+			TestTaskGraphWaitSubset();
+
+			if (Mode < 2)
+			{
+				pPool->Destroy();
+			}
+		}
+
+		TestTaskGraphWaiterRunsTasks();
+	}
+
+	/** Node of the size a Queue<int64> would use. */
+	struct QueueTestNode
+	{
+		void* pNext;
+		int64 Item;
+	};
+
+	/** Freed nodes are handed out again before any new block, reserved nodes cover steady state traffic. */
+	void TestRecyclingNodeAllocator()
+	{
+		typedef RecyclingQueueNodeAllocator<64>::ForNodeType<QueueTestNode> AllocatorType;
+		AllocatorType Allocator;
+
+		// Two blocks of 64 nodes
+		Allocator.Reserve(100);
+
+		Array<void*> Nodes;
+		for (int32 i = 0; i < 128; i++)
+		{
+			Nodes.Add(Allocator.Allocate());
+		}
+
+		int32 NumDistinct = 0;
+		for (int32 i = 0; i < Nodes.Size(); i++)
+		{
+			bool bDistinct = Nodes[i] != nullptr && IsAligned(Nodes[i], alignof(QueueTestNode));
+			for (int32 j = 0; j < i; j++)
+			{
+				bDistinct = bDistinct && Nodes[j] != Nodes[i];
+			}
+			NumDistinct += bDistinct ? 1 : 0;
+		}
+		TEST_CHECK(NumDistinct == 128);
+
+		for (int32 i = 0; i < Nodes.Size(); i++)
+		{
+			Allocator.Free(Nodes[i]);
+		}
+
+		int32 NumRecycled = 0;
+		for (int32 i = 0; i < 128; i++)
+		{
+			NumRecycled += Nodes.Contains(Allocator.Allocate()) ? 1 : 0;
+		}
+		TEST_CHECK(NumRecycled == 128);
+
+		// The free list is empty, the next node comes from a new block
+		TEST_CHECK(!Nodes.Contains(Allocator.Allocate()));
+	}
+
+	/** Threads allocating and freeing at once, a node handed to two threads at the same time would be overwritten. */
+	void TestRecyclingNodeAllocatorConcurrent()
+	{
+		typedef RecyclingQueueNodeAllocator<16>::ForNodeType<QueueTestNode> AllocatorType;
+		AllocatorType Allocator;
+		volatile int32 NumCorrupted = 0;
+
+		RunOnThreads(6, [&](int32 ThreadIndex)
+		{
+			QueueTestNode* Held[8];
+			for (int32 Round = 0; Round < 20000; Round++)
+			{
+				const int32 NumHeld = 1 + Round % 8;
+				for (int32 i = 0; i < NumHeld; i++)
+				{
+					Held[i] = (QueueTestNode*)Allocator.Allocate();
+					Held[i]->Item = int64(ThreadIndex) << 32 | i;
+				}
+
+				for (int32 i = 0; i < NumHeld; i++)
+				{
+					if (Held[i]->Item != (int64(ThreadIndex) << 32 | i))
+					{
+						PlatformAtomics::InterlockedIncrement(&NumCorrupted);
+					}
+					Allocator.Free(Held[i]);
+				}
+			}
+		});
+
+		TEST_CHECK(NumCorrupted == 0);
+	}
+
+	/** Producers queue through the recycled nodes of a reserved MPSC queue, the consumer must get every item in order. */
+	void TestRecyclingQueue()
+	{
+		const int32 NumProducers = 4;
+		const int32 ItemsPerProducer = 50000;
+
+		Queue<int32, EQueueMode::Mpsc, RecyclingQueueNodeAllocator<>> Items;
+		Items.ReserveNodes(1024);
+
+		volatile int32 NumOrderErrors = 0;
+		int32 NumConsumed = 0;
+		RunOnThreads(NumProducers + 1, [&](int32 ThreadIndex)
+		{
+			if (ThreadIndex < NumProducers)
+			{
+				for (int32 i = 0; i < ItemsPerProducer; i++)
+				{
+					Items.Enqueue(ThreadIndex * ItemsPerProducer + i);
+				}
+				return;
+			}
+
+			int32 LastSeen[NumProducers] = { -1, -1, -1, -1 };
+			int32 Item;
+			while (NumConsumed < NumProducers * ItemsPerProducer)
+			{
+				if (!Items.Dequeue(Item))
+				{
+					WindowsProcess::Sleep(0.0f);
+					continue;
+				}
+
+				const int32 Producer = Item / ItemsPerProducer;
+				if (Item <= LastSeen[Producer])
+				{
+					PlatformAtomics::InterlockedIncrement(&NumOrderErrors);
+				}
+				LastSeen[Producer] = Item;
+				NumConsumed++;
+			}
+		});
+
+		TEST_CHECK(NumOrderErrors == 0);
+		TEST_CHECK(NumConsumed == NumProducers * ItemsPerProducer);
+		TEST_CHECK(Items.IsEmpty());
+
+#if EDX_TRACK_MEMORY
+		// Reserved nodes are enough for traffic staying under the reserve
+		MemorySnapshot Before;
+		MemoryTracker::GetSnapshot(Before);
+#endif
+
+		int32 Sum = 0;
+		for (int32 Round = 0; Round < 1000; Round++)
+		{
+			for (int32 i = 0; i < 500; i++)
+			{
+				Items.Enqueue(i);
+			}
+			int32 Item;
+			while (Items.Dequeue(Item))
+			{
+				Sum += Item;
+			}
+		}
+		TEST_CHECK(Sum == 1000 * (499 * 500 / 2));
+
+#if EDX_TRACK_MEMORY
+		MemorySnapshot After;
+		MemoryTracker::GetSnapshot(After);
+
+		int32 NumNewAllocs = 0;
+		for (int32 Tag = 0; Tag < MemoryTag_Max; Tag++)
+		{
+			NumNewAllocs += int32(After.Tags[Tag].NumAllocs - Before.Tags[Tag].NumAllocs);
+		}
+		TEST_CHECK(NumNewAllocs == 0);
+#endif
+	}
+
+	/** The lock is recursive, excludes other threads, and serializes increments of a plain counter. */
+	void TestCriticalSection()
+	{
+		CriticalSection Lock;
+		Lock.Lock();
+		TEST_CHECK(Lock.TryLock());
+		Lock.Unlock();
+
+		volatile int32 bOtherGotLock = 1;
+		RunOnThreads(1, [&](int32) { bOtherGotLock = Lock.TryLock() ? 1 : 0; });
+		TEST_CHECK(bOtherGotLock == 0);
+
+		Lock.Unlock();
+		RunOnThreads(1, [&](int32)
+		{
+			bOtherGotLock = Lock.TryLock() ? 1 : 0;
+			if (bOtherGotLock)
+			{
+				Lock.Unlock();
+			}
+		});
+		TEST_CHECK(bOtherGotLock == 1);
+
+		// Holding the lock across a sleep now and then sends the other threads to the sleeping path
+		const int32 NumThreads = 8;
+		const int32 NumOps = 20000;
+		int64 Counter = 0;
+		RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+		{
+			for (int32 i = 0; i < NumOps; i++)
+			{
+				ScopeLock Scope(&Lock);
+				Counter++;
+				if ((i & 4095) == ThreadIndex)
+				{
+					WindowsProcess::Sleep(0.001f);
+				}
+			}
+		});
+		TEST_CHECK(Counter == NumThreads * NumOps);
+	}
+
+	/** Producers and consumers of a small buffer, waiting on condition variables whenever it is full or empty. */
+	void TestConditionVar()
+	{
+		const int32 NumProducers = 3;
+		const int32 NumConsumers = 3;
+		const int32 ItemsPerProducer = 20000;
+		const int32 MaxBuffered = 16;
+
+		CriticalSection Lock;
+		ConditionVar NotEmpty;
+		ConditionVar NotFull;
+		Array<int32> Buffer;
+		int32 NumProduced = 0;
+		int64 ConsumedSum = 0;
+		int32 NumConsumed = 0;
+
+		RunOnThreads(NumProducers + NumConsumers, [&](int32 ThreadIndex)
+		{
+			if (ThreadIndex < NumProducers)
+			{
+				for (int32 i = 0; i < ItemsPerProducer; i++)
+				{
+					ScopeLock Scope(&Lock);
+					while (Buffer.Size() == MaxBuffered)
+					{
+						NotFull.Wait(Lock);
+					}
+					Buffer.Add(ThreadIndex * ItemsPerProducer + i);
+					NumProduced++;
+					NotEmpty.Signal();
+				}
+				return;
+			}
+
+			for (;;)
+			{
+				ScopeLock Scope(&Lock);
+				while (Buffer.Size() == 0 && NumConsumed < NumProducers * ItemsPerProducer)
+				{
+					NotEmpty.Wait(Lock);
+				}
+				if (Buffer.Size() == 0)
+				{
+					// Everything was consumed, let the other consumers see it too
+					NotEmpty.Broadcast();
+					return;
+				}
+
+				ConsumedSum += Buffer.Pop();
+				if (++NumConsumed == NumProducers * ItemsPerProducer)
+				{
+					NotEmpty.Broadcast();
+				}
+				NotFull.Signal();
+			}
+		});
+
+		const int64 NumItems = NumProducers * ItemsPerProducer;
+		TEST_CHECK(NumProduced == NumItems && NumConsumed == NumItems);
+		TEST_CHECK(ConsumedSum == (NumItems - 1) * NumItems / 2);
+	}
+
+	void TestWinEvent()
+	{
+		WinEvent AutoReset;
+		TEST_CHECK(AutoReset.Create(false));
+		TEST_CHECK(!AutoReset.Wait(0));
+		AutoReset.Trigger();
+		TEST_CHECK(AutoReset.Wait(0));
+		TEST_CHECK(!AutoReset.Wait(0));
+
+		WinEvent ManualReset;
+		TEST_CHECK(ManualReset.Create(true) && ManualReset.IsManualReset());
+		ManualReset.Trigger();
+		TEST_CHECK(ManualReset.Wait(0) && ManualReset.Wait(10));
+		ManualReset.Reset();
+		TEST_CHECK(!ManualReset.Wait(0));
+
+		// A timed out wait lasts about the timeout, not less and not a lot more
+		const double WaitMs = TimeMs([&]() { TEST_CHECK(!AutoReset.Wait(50)); });
+		TEST_CHECK(WaitMs >= 45.0 && WaitMs < 1000.0);
+
+		// Each trigger of an auto reset event releases exactly one of the threads sleeping on it
+		const int32 NumWaiters = 4;
+		volatile int32 NumReleased = 0;
+		volatile int32 NumExtra = 0;
+		RunOnThreads(NumWaiters + 1, [&](int32 ThreadIndex)
+		{
+			if (ThreadIndex < NumWaiters)
+			{
+				AutoReset.Wait();
+				PlatformAtomics::InterlockedIncrement(&NumReleased);
+				return;
+			}
+
+			for (int32 i = 1; i <= NumWaiters; i++)
+			{
+				WindowsProcess::Sleep(0.005f);
+				AutoReset.Trigger();
+				while (NumReleased < i)
+				{
+					WindowsProcess::Sleep(0.0f);
+				}
+				WindowsProcess::Sleep(0.005f);
+				if (NumReleased > i)
+				{
+					PlatformAtomics::InterlockedIncrement(&NumExtra);
+				}
+			}
+		});
+		TEST_CHECK(NumReleased == NumWaiters && NumExtra == 0);
+	}
+
+	/** Writers keep two values equal, readers holding the lock must never see them differ. */
+	void TestRWLock()
+	{
+		RWLock Lock;
+		int64 Values[2] = { 0, 0 };
+		volatile int32 NumTornReads = 0;
+		const int32 NumWrites = 20000;
+
+		RunOnThreads(6, [&](int32 ThreadIndex)
+		{
+			for (int32 i = 0; i < NumWrites; i++)
+			{
+				if (ThreadIndex < 2)
+				{
+					ScopeWriteLock WriteLock(&Lock);
+					Values[0]++;
+					Values[1]++;
+				}
+				else
+				{
+					ScopeReadLock ReadLock(&Lock);
+					if (Values[0] != Values[1])
+					{
+						PlatformAtomics::InterlockedIncrement(&NumTornReads);
+					}
+				}
+			}
+		});
+
+		TEST_CHECK(NumTornReads == 0);
+		TEST_CHECK(Values[0] == 2 * NumWrites && Values[1] == 2 * NumWrites);
+	}
+
+	void TestSeqLock()
+	{
+		struct Pair
+		{
+			int64 First;
+			int64 Second;
+		};
+
+		SeqLock Lock;
+		Pair Data = { 0, 0 };
+		volatile int32 NumTornReads = 0;
+		const int32 NumWrites = 20000;
+
+		RunOnThreads(4, [&](int32 ThreadIndex)
+		{
+			for (int32 i = 0; i < NumWrites; i++)
+			{
+				if (ThreadIndex == 0)
+				{
+					ScopeSeqWriteLock WriteLock(&Lock);
+					Data.First++;
+					Data.Second--;
+				}
+				else
+				{
+					const Pair Snapshot = Lock.Read(Data);
+					if (Snapshot.First != -Snapshot.Second)
+					{
+						PlatformAtomics::InterlockedIncrement(&NumTornReads);
+					}
+				}
+			}
+		});
+
+		TEST_CHECK(NumTornReads == 0);
+		TEST_CHECK(Data.First == NumWrites);
+	}
+
+	/**
+	* Times lock, increment, unlock cycles on one lock shared by all the threads.
+	* @return The time in milliseconds for all the threads to finish
+	*/
+	template<typename LockType>
+	double TimeContendedLock(int32 NumThreads, int32 NumOps)
+	{
+		LockType Lock;
+		int64 Counter = 0;
+
+		const double Time = TimeMs([&]()
+		{
+			RunOnThreads(NumThreads, [&](int32 ThreadIndex)
+			{
+				for (int32 i = 0; i < NumOps / NumThreads; i++)
+				{
+					Lock.lock();
+					Counter++;
+					Lock.unlock();
+				}
+			});
+		});
+
+		TEST_CHECK(Counter == NumOps / NumThreads * NumThreads);
+		return Time;
+	}
+
+	/** Adapts CriticalSection to the lock interface of std::mutex. */
+	class CriticalSectionLockable
+	{
+	private:
+		CriticalSection mLock;
+
+	public:
+		void lock()
+		{
+			mLock.Lock();
+		}
+
+		void unlock()
+		{
+			mLock.Unlock();
+		}
+	};
+
+	/**
+	* Times two threads handing a token back and forth through two auto reset events, each hand-off wakes a sleeping thread.
+	* @return The time in milliseconds for NumRoundTrips round trips
+	*/
+	double TimeEventPingPong(int32 NumRoundTrips)
+	{
+		WinEvent Ping;
+		WinEvent Pong;
+		Ping.Create(false);
+		Pong.Create(false);
+
+		return TimeMs([&]()
+		{
+			RunOnThreads(2, [&](int32 ThreadIndex)
+			{
+				for (int32 i = 0; i < NumRoundTrips; i++)
+				{
+					if (ThreadIndex == 0)
+					{
+						Ping.Trigger();
+						Pong.Wait();
+					}
+					else
+					{
+						Ping.Wait();
+						Pong.Trigger();
+					}
+				}
+			});
+		});
+	}
+
+	/** The same hand-off through a std::mutex and a std::condition_variable. */
+	double TimeStdPingPong(int32 NumRoundTrips)
+	{
+		std::mutex Mutex;
+		std::condition_variable Cond;
+		int32 Turn = 0;
+
+		return TimeMs([&]()
+		{
+			RunOnThreads(2, [&](int32 ThreadIndex)
+			{
+				for (int32 i = 0; i < NumRoundTrips; i++)
+				{
+					std::unique_lock<std::mutex> Lock(Mutex);
+					Cond.wait(Lock, [&]() { return Turn == ThreadIndex; });
+					Turn = 1 - ThreadIndex;
+					Cond.notify_one();
+				}
+			});
+		});
+	}
+}
+
+void TestThreading()
+{
+	TestQueuedThreadPool(false);
+	TestQueuedThreadPool(true);
+	TestQueuedThreadPoolAbandon();
+	TestParallelFor();
+	TestTaskGraph();
+	TestBoundedQueue();
+	TestBoundedQueueConcurrent();
+	TestRecyclingNodeAllocator();
+	TestRecyclingNodeAllocatorConcurrent();
+	TestRecyclingQueue();
+	TestCriticalSection();
+	TestConditionVar();
+	TestWinEvent();
+	TestRWLock();
+	TestSeqLock();
+}
+
+void BenchmarkThreading()
+{
+	// CriticalSection wraps CRITICAL_SECTION on Windows, it is the futex lock of Linux/Synchronization.h elsewhere
+#if defined(_WIN32)
+	const char* pLockName = "CriticalSection";
+	const char* pEventName = "WinEvent";
+#else
+	const char* pLockName = "CriticalSection (futex)";
+	const char* pEventName = "WinEvent (futex)";
+#endif
+
+	const int32 NumOps = 1 << 20;
+	const int32 ThreadCounts[] = { 1, 4, 16, 64 };
+	for (int32 NumThreads : ThreadCounts)
+	{
+		char Name[64];
+		snprintf(Name, sizeof(Name), "%s, %i threads", pLockName, NumThreads);
+		ReportTime(Name, TimeContendedLock<CriticalSectionLockable>(NumThreads, NumOps));
+
+		snprintf(Name, sizeof(Name), "std::mutex, %i threads", NumThreads);
+		ReportTime(Name, TimeContendedLock<std::mutex>(NumThreads, NumOps));
+	}
+
+	const int32 NumRoundTrips = 20000;
+	char Name[64];
+	snprintf(Name, sizeof(Name), "%s ping-pong, 20K round trips", pEventName);
+	ReportTime(Name, TimeEventPingPong(NumRoundTrips));
+	ReportTime("std::condition_variable ping-pong, 20K round trips", TimeStdPingPong(NumRoundTrips));
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "EDXPrerequisites.h"
+#include "Windows/Timer.h"
+#include "Windows/Threading.h"
+
+namespace EDX
+{
+	namespace UnitTest
+	{
+		/** Number of failed checks so far, returned by main as the exit code. */
+		extern int32 NumFailures;
+
+		/** Written by DoNotOptimize, never read. */
+		extern volatile uint64 BenchmarkSink;
+
+		inline void ReportFailure(const char* pExpr, const char* pFile, int32 Line)
+		{
+			printf("FAILED: %s (%s:%i)\n", pExpr, pFile, Line);
+			NumFailures++;
+		}
+
+		/**
+		* Runs a function and measures how long it took.
+		* @param Body The function to time
+		* @return The time it took in milliseconds
+		*/
+		template<typename FuncType>
+		double TimeMs(const FuncType& Body)
+		{
+			Timer Clock;
+			const double Start = Clock.GetAbsoluteTime();
+			Body();
+			return (Clock.GetAbsoluteTime() - Start) * 1000.0;
+		}
+
+		/**
+		* Runs a function a few times and keeps the fastest run, which is the least disturbed by the rest of the system.
+		* @param Body The function to time
+		* @param NumRuns Number of times to run it
+		* @return The time of the fastest run in milliseconds
+		*/
+		template<typename FuncType>
+		double BestTimeMs(const FuncType& Body, int32 NumRuns = 3)
+		{
+			double Best = TimeMs(Body);
+			for (int32 i = 1; i < NumRuns; i++)
+			{
+				const double Time = TimeMs(Body);
+				Best = Time < Best ? Time : Best;
+			}
+
+			return Best;
+		}
+
+		inline void ReportTime(const char* pName, double Ms)
+		{
+			printf("  %-56s %10.3f ms\n", pName, Ms);
+		}
+
+		inline void ReportThroughput(const char* pName, double GBPerSecond)
+		{
+			printf("  %-56s %10.3f GB/s\n", pName, GBPerSecond);
+		}
+
+		/** Runnable calling a function with the index of its thread. */
+		template<typename FuncType>
+		class FunctionRunnable : public Runnable
+		{
+		private:
+			const FuncType* mpBody;
+			int32 mThreadIndex;
+
+		public:
+			FunctionRunnable(const FuncType* pBody, int32 ThreadIndex)
+				: mpBody(pBody)
+				, mThreadIndex(ThreadIndex)
+			{
+			}
+
+			virtual uint32 Run() override
+			{
+				(*mpBody)(mThreadIndex);
+				return 0;
+			}
+		};
+
+		/**
+		* Runs a function on several threads at once and waits for all of them to return.
+		* @param NumThreads Number of threads to create
+		* @param Body The function to run, called with the index of the thread from 0 to NumThreads - 1
+		*/
+		template<typename FuncType>
+		void RunOnThreads(int32 NumThreads, const FuncType& Body)
+		{
+			Array<FunctionRunnable<FuncType>*> Runnables;
+			Array<RunnableThread*> Threads;
+			for (int32 i = 0; i < NumThreads; i++)
+			{
+				Runnables.Add(new FunctionRunnable<FuncType>(&Body, i));
+				Threads.Add(RunnableThread::Create(Runnables[i], EDX_TEXT("UnitTest")));
+			}
+
+			for (int32 i = 0; i < NumThreads; i++)
+			{
+				Threads[i]->WaitForCompletion();
+				delete Threads[i];
+				delete Runnables[i];
+			}
+		}
+
+		/** Keeps the compiler from optimizing away a result computed only for a benchmark. */
+		template<typename T>
+		__forceinline void DoNotOptimize(const T& Value)
+		{
+			BenchmarkSink += uint64(Value);
+		}
+	}
+}
+
+#define TEST_CHECK(Expr) do { if (!(Expr)) { EDX::UnitTest::ReportFailure(#Expr, __FILE__, __LINE__); } } while (0)
+
+/** Behaviour tests, always run. */
+void TestThreading();
+void TestMemory();
+void TestContainers();
+void TestHashing();
+void TestSorting();
+void TestStrings();
+
+/** Benchmarks, run with -bench. */
+void BenchmarkThreading();
+void BenchmarkMemory();
+void BenchmarkContainers();
+void BenchmarkHashing();
+void BenchmarkSorting();
+void BenchmarkStrings();